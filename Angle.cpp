@@ -0,0 +1,296 @@
+#include "Angle.h"
+#include <cstdint>
+#include <cstring>
+
+//pi/2 in three 33 bit parts, k * part is exact for the k up to REDUCE_LIMIT, and the
+//53 bit tail after them, which is all that is left of x near a multiple of pi/2
+static const double PIO2_1 = 1.57079632673412561417e+00;
+static const double PIO2_2 = 6.07710050630396597660e-11;
+static const double PIO2_3 = 2.02226624871116645580e-21;
+static const double PIO2_3T = 8.47842766036889956997e-32;
+static const double TWO_OVER_PI = 6.36619772367581382433e-01;
+static const double REDUCE_LIMIT = 8e5;
+//adding 1.5 * 2^52 rounds to an integer and leaves it in the low mantissa bits
+static const double ROUNDER = 6755399441055744.0;
+static const double PI = 3.14159265358979311600e+00;
+static const double PI_2 = 1.57079632679489655800e+00;
+static const double PI_4 = 7.85398163397448278999e-01;
+static const double TAN_PI_8 = 4.14213562373095034e-01;
+
+//fdlibm __kernel_sin and __kernel_cos on [-pi/4, pi/4]
+static const double S1 = -1.66666666666666324348e-01;
+static const double S2 = 8.33333333332248946124e-03;
+static const double S3 = -1.98412698298579493134e-04;
+static const double S4 = 2.75573137070700676789e-06;
+static const double S5 = -2.50507602534068634195e-08;
+static const double S6 = 1.58969099521155010221e-10;
+static const double C1 = 4.16666666666666019037e-02;
+static const double C2 = -1.38888888888741095749e-03;
+static const double C3 = 2.48015872894767294178e-05;
+static const double C4 = -2.75573143513906633035e-07;
+static const double C5 = 2.08757232129817482790e-09;
+static const double C6 = -1.13596475577881948265e-11;
+
+//Cephes atan, x + x^3 P(x^2) / Q(x^2) for |x| <= 0.66
+static const double P0 = -8.750608600031904122785e-01;
+static const double P1 = -1.615753718733365076637e+01;
+static const double P2 = -7.500855792314704667340e+01;
+static const double P3 = -1.228866684490136173410e+02;
+static const double P4 = -6.485021904942025371773e+01;
+static const double Q0 = 2.485846490142306297962e+01;
+static const double Q1 = 1.650270098316988542046e+02;
+static const double Q2 = 4.328810604912902668951e+02;
+static const double Q3 = 4.853903996359136964868e+02;
+static const double Q4 = 1.945506571482613964425e+02;
+
+//least squares fits for the fast versions, errors as listed in Angle.h
+static const double FAST_S1 = -0.16666665615262363;
+static const double FAST_S2 = 0.008332823122629679;
+static const double FAST_S3 = -0.00019598367340516648;
+static const double FAST_C0 = 0.9999999867061452;
+static const double FAST_C1 = -0.4999988078267363;
+static const double FAST_C2 = 0.04165589652611643;
+static const double FAST_C3 = -0.0013594459869243172;
+static const double FAST_A0 = 0.9999999917527557;
+static const double FAST_A1 = -0.33332902670922987;
+static const double FAST_A2 = 0.19976941439469;
+static const double FAST_A3 = -0.1387274272886;
+static const double FAST_A4 = 0.08042823909820507;
+
+static inline uint64_t doubleBits(double val) {
+	uint64_t bits;
+	std::memcpy(&bits, &val, sizeof(bits));
+	return bits;
+}
+
+//x - k pi/2 in [-pi/4, pi/4], and the quadrant k mod 4
+static inline double reduce(double x, uint64_t& quadrant) {
+	double k = x * TWO_OVER_PI + ROUNDER;
+	quadrant = doubleBits(k);
+	k -= ROUNDER;
+	return (((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3) - k * PIO2_3T;
+}
+
+static inline double sinPoly(double r, double z) {
+	return r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+}
+
+static inline double cosPoly(double z) {
+	return 1 - 0.5 * z + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+}
+
+static inline double fastSinPoly(double r, double z) {
+	return r + r * z * (FAST_S1 + z * (FAST_S2 + z * FAST_S3));
+}
+
+static inline double fastCosPoly(double z) {
+	return FAST_C0 + z * (FAST_C1 + z * (FAST_C2 + z * FAST_C3));
+}
+
+//sin of the reduced argument in quadrant q, cos is the same one quadrant on
+static inline double quadrantSin(double s, double c, uint64_t q) {
+	double v = (q & 1) ? c : s;
+	return (q & 2) ? -v : v;
+}
+
+static inline double atanPoly(double t) {
+	double z = t * t;
+	double p = (((P0 * z + P1) * z + P2) * z + P3) * z + P4;
+	double q = ((((z + Q0) * z + Q1) * z + Q2) * z + Q3) * z + Q4;
+	return t + t * z * p / q;
+}
+
+static inline double fastAtanPoly(double t) {
+	double z = t * t;
+	return t * (FAST_A0 + z * (FAST_A1 + z * (FAST_A2 + z * (FAST_A3 + z * FAST_A4))));
+}
+
+//atan2 folded into the first octant, poly is the atan kernel
+template <double (*poly)(double)>
+static inline double octantAtan2(double y, double x) {
+	double ax = std::fabs(x);
+	double ay = std::fabs(y);
+	double big = ax > ay ? ax : ay;
+	double small = ax > ay ? ay : ax;
+	double a = small / big;
+	bool reduced = a > TAN_PI_8;
+	double t = reduced ? (a - 1) / (a + 1) : a;
+	double r = (reduced ? PI_4 : 0) + poly(t);
+	r = ay > ax ? PI_2 - r : r;
+	r = x < 0 ? PI - r : r;
+	return std::copysign(r, y);
+}
+
+//arguments the reduction does not cover go to the C library, and zeros so that -0 stays -0
+static void fixSin(const double* x, size_t n, double* out) {
+	for (size_t i = 0; i < n; i++) {
+		if (!(std::fabs(x[i]) <= REDUCE_LIMIT) || x[i] == 0) {
+			out[i] = std::sin(x[i]);
+		}
+	}
+}
+
+static void fixCos(const double* x, size_t n, double* out) {
+	for (size_t i = 0; i < n; i++) {
+		if (!(std::fabs(x[i]) <= REDUCE_LIMIT)) {
+			out[i] = std::cos(x[i]);
+		}
+	}
+}
+
+//zeros, infinities and NaN, where the signs of zero matter or the octant fold gives NaN
+static void fixAtan2(const double* y, const double* x, size_t n, double* out) {
+	bool any = false;
+	for (size_t i = 0; i < n; i++) {
+		double big = std::fabs(x[i]) > std::fabs(y[i]) ? std::fabs(x[i]) : std::fabs(y[i]);
+		any |= !(big < HUGE_VAL) | (big == 0);
+	}
+	if (!any) {
+		return;
+	}
+	for (size_t i = 0; i < n; i++) {
+		double big = std::fabs(x[i]) > std::fabs(y[i]) ? std::fabs(x[i]) : std::fabs(y[i]);
+		if (!(big < HUGE_VAL) || big == 0) {
+			out[i] = std::atan2(y[i], x[i]);
+		}
+	}
+}
+
+//keeps the arguments that need fixing when out aliases in
+static const size_t BLOCK = 256;
+
+void AngleBatch::sin(const double* radians, size_t n, double* out) {
+	double in[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		std::memcpy(in, radians + start, count * sizeof(double));
+		double* o = out + start;
+		for (size_t i = 0; i < count; i++) {
+			uint64_t q;
+			double r = reduce(in[i], q);
+			double z = r * r;
+			o[i] = quadrantSin(sinPoly(r, z), cosPoly(z), q);
+		}
+		fixSin(in, count, o);
+	}
+}
+
+void AngleBatch::cos(const double* radians, size_t n, double* out) {
+	double in[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		std::memcpy(in, radians + start, count * sizeof(double));
+		double* o = out + start;
+		for (size_t i = 0; i < count; i++) {
+			uint64_t q;
+			double r = reduce(in[i], q);
+			double z = r * r;
+			o[i] = quadrantSin(sinPoly(r, z), cosPoly(z), q + 1);
+		}
+		fixCos(in, count, o);
+	}
+}
+
+void AngleBatch::sincos(const double* radians, size_t n, double* sines, double* cosines) {
+	double in[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		std::memcpy(in, radians + start, count * sizeof(double));
+		double* s = sines + start;
+		double* c = cosines + start;
+		for (size_t i = 0; i < count; i++) {
+			uint64_t q;
+			double r = reduce(in[i], q);
+			double z = r * r;
+			double sr = sinPoly(r, z);
+			double cr = cosPoly(z);
+			s[i] = quadrantSin(sr, cr, q);
+			c[i] = quadrantSin(sr, cr, q + 1);
+		}
+		fixSin(in, count, s);
+		fixCos(in, count, c);
+	}
+}
+
+void AngleBatch::atan2(const double* y, const double* x, size_t n, double* radians) {
+	double ys[BLOCK];
+	double xs[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		std::memcpy(ys, y + start, count * sizeof(double));
+		std::memcpy(xs, x + start, count * sizeof(double));
+		double* o = radians + start;
+		for (size_t i = 0; i < count; i++) {
+			o[i] = octantAtan2<atanPoly>(ys[i], xs[i]);
+		}
+		fixAtan2(ys, xs, count, o);
+	}
+}
+
+void AngleBatch::fastSin(const double* radians, size_t n, double* out) {
+	double in[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		std::memcpy(in, radians + start, count * sizeof(double));
+		double* o = out + start;
+		for (size_t i = 0; i < count; i++) {
+			uint64_t q;
+			double r = reduce(in[i], q);
+			double z = r * r;
+			o[i] = quadrantSin(fastSinPoly(r, z), fastCosPoly(z), q);
+		}
+		fixSin(in, count, o);
+	}
+}
+
+void AngleBatch::fastCos(const double* radians, size_t n, double* out) {
+	double in[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		std::memcpy(in, radians + start, count * sizeof(double));
+		double* o = out + start;
+		for (size_t i = 0; i < count; i++) {
+			uint64_t q;
+			double r = reduce(in[i], q);
+			double z = r * r;
+			o[i] = quadrantSin(fastSinPoly(r, z), fastCosPoly(z), q + 1);
+		}
+		fixCos(in, count, o);
+	}
+}
+
+void AngleBatch::fastSincos(const double* radians, size_t n, double* sines, double* cosines) {
+	double in[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		std::memcpy(in, radians + start, count * sizeof(double));
+		double* s = sines + start;
+		double* c = cosines + start;
+		for (size_t i = 0; i < count; i++) {
+			uint64_t q;
+			double r = reduce(in[i], q);
+			double z = r * r;
+			double sr = fastSinPoly(r, z);
+			double cr = fastCosPoly(z);
+			s[i] = quadrantSin(sr, cr, q);
+			c[i] = quadrantSin(sr, cr, q + 1);
+		}
+		fixSin(in, count, s);
+		fixCos(in, count, c);
+	}
+}
+
+void AngleBatch::fastAtan2(const double* y, const double* x, size_t n, double* radians) {
+	double ys[BLOCK];
+	double xs[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		std::memcpy(ys, y + start, count * sizeof(double));
+		std::memcpy(xs, x + start, count * sizeof(double));
+		double* o = radians + start;
+		for (size_t i = 0; i < count; i++) {
+			o[i] = octantAtan2<fastAtanPoly>(ys[i], xs[i]);
+		}
+		fixAtan2(ys, xs, count, o);
+	}
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+/*
+ANGLE
+=====
+
+Angle - RADIANS, DEGREES, REVOLUTIONS, GRADIANS, ARCMINUTES
+
+Angles are stored in radians. Angle is included by Measurement.h ahead of the
+other classes, since RotationSpeed * TimeDuration gives an Angle, so it does not
+depend on any of them.
+
+Angle heading(270, DEGREES);
+Angle turned = RotationSpeed(1500, UNITS::rpm) * TimeDuration(2, UNITS::s);	//50 revolutions
+double x = heading.cos();
+Angle bearing = Angle::atan2(dy, dx);
+
+AngleBatch works on arrays of angles, or of plain radians, for code that calls
+trig in bulk:
+
+AngleBatch::sincos(angles, n, sines, cosines);
+AngleBatch::atan2(y, x, n, angles);
+AngleBatch::fastSincos(angles, n, sines, cosines);
+
+The kernels are branch-free loops the compiler vectorizes. Arguments are
+reduced to [-pi/4, pi/4] against pi/2 split in three 33 bit parts and a tail
+(Cody-Waite). Up to 8e5 rad the products with the parts are exact and the
+reduced argument is good to an ulp or so, even next to a multiple of pi/2 where
+it comes down to the tail alone. Larger or non-finite arguments are picked out in
+a second pass and sent to the C library, as are zeros so their sign is kept.
+sin and cos use the fdlibm polynomials and come within 2 ulp of the C library;
+atan2 uses the Cephes rational function for atan and comes within 3 ulp.
+
+The fast versions use the same reduction with shorter polynomials:
+fastSin, fastCos	absolute error below 5e-8
+fastAtan2		absolute error below 1e-8 rad
+That is far under a thousandth of a degree. What it saves depends on the vector
+width; atan2 still pays for the divisions that fold it into one octant.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+enum AngleUnits { RADIANS, DEGREES, REVOLUTIONS, GRADIANS, ARCMINUTES };
+
+class Angle {
+public:
+	Angle() {
+		angle_in_rad = 0;
+	}
+	//RADIANS, DEGREES, REVOLUTIONS, GRADIANS, ARCMINUTES
+	Angle(double val, AngleUnits units) {
+		set(val, units);
+	}
+	//RADIANS, DEGREES, REVOLUTIONS, GRADIANS, ARCMINUTES
+	void set(double val, AngleUnits units) {
+		switch (units) {
+		case RADIANS:
+			angle_in_rad = val;
+			break;
+		case DEGREES:
+			angle_in_rad = val * RADIANS_PER_DEGREE;
+			break;
+		case REVOLUTIONS:
+			angle_in_rad = val * RADIANS_PER_REVOLUTION;
+			break;
+		case GRADIANS:
+			angle_in_rad = val * RADIANS_PER_GRADIAN;
+			break;
+		case ARCMINUTES:
+			angle_in_rad = val * RADIANS_PER_ARCMINUTE;
+			break;
+		}
+	}
+	//RADIANS, DEGREES, REVOLUTIONS, GRADIANS, ARCMINUTES
+	double value(AngleUnits units) {
+		switch (units) {
+		case RADIANS:
+			return angle_in_rad;
+		case DEGREES:
+			return angle_in_rad / RADIANS_PER_DEGREE;
+		case REVOLUTIONS:
+			return angle_in_rad / RADIANS_PER_REVOLUTION;
+		case GRADIANS:
+			return angle_in_rad / RADIANS_PER_GRADIAN;
+		case ARCMINUTES:
+			return angle_in_rad / RADIANS_PER_ARCMINUTE;
+		}
+		return angle_in_rad;
+	}
+	Angle operator+(Angle angle) {
+		return Angle(value(RADIANS) + angle.value(RADIANS), RADIANS);
+	}
+	Angle operator-(Angle angle) {
+		return Angle(value(RADIANS) - angle.value(RADIANS), RADIANS);
+	}
+	Angle operator*(double val) {
+		return Angle(value(RADIANS) * val, RADIANS);
+	}
+	Angle operator/(double val) {
+		return Angle(value(RADIANS) / val, RADIANS);
+	}
+	double operator/(Angle angle) {
+		return value(RADIANS) / angle.value(RADIANS);
+	}
+	//the same direction in (-pi, pi]
+	Angle wrapped() {
+		double r = std::remainder(angle_in_rad, RADIANS_PER_REVOLUTION);
+		return Angle(r == -RADIANS_PER_REVOLUTION / 2 ? -r : r, RADIANS);
+	}
+	double sin() {
+		return std::sin(angle_in_rad);
+	}
+	double cos() {
+		return std::cos(angle_in_rad);
+	}
+	double tan() {
+		return std::tan(angle_in_rad);
+	}
+	static Angle atan2(double y, double x) {
+		return Angle(std::atan2(y, x), RADIANS);
+	}
+	static Angle asin(double val) {
+		return Angle(std::asin(val), RADIANS);
+	}
+	static Angle acos(double val) {
+		return Angle(std::acos(val), RADIANS);
+	}
+	bool operator>(Angle angle) {
+		return (value(RADIANS) > angle.value(RADIANS));
+	}
+	bool operator>=(Angle angle) {
+		return (value(RADIANS) >= angle.value(RADIANS));
+	}
+	bool operator<(Angle angle) {
+		return (value(RADIANS) < angle.value(RADIANS));
+	}
+	bool operator<=(Angle angle) {
+		return (value(RADIANS) <= angle.value(RADIANS));
+	}
+	bool operator==(Angle angle) {
+		return (value(RADIANS) == angle.value(RADIANS));
+	}
+	bool operator!=(Angle angle) {
+		return (value(RADIANS) != angle.value(RADIANS));
+	}
+	bool operator++() {
+		return (value(RADIANS) > 0);
+	}
+	bool operator--() {
+		return (value(RADIANS) < 0);
+	}
+
+	static constexpr double RADIANS_PER_REVOLUTION = 6.283185307179586;
+	static constexpr double RADIANS_PER_DEGREE = 0.017453292519943295;
+	static constexpr double RADIANS_PER_GRADIAN = 0.015707963267948967;
+	static constexpr double RADIANS_PER_ARCMINUTE = 2.908882086657216e-4;
+
+protected:
+	double angle_in_rad;
+};
+
+static_assert(sizeof(Angle) == sizeof(double) && std::is_standard_layout<Angle>::value, "AngleBatch reads angles as radians");
+
+//trig over arrays, out may alias in
+namespace AngleBatch {
+	void sin(const double* radians, size_t n, double* out);
+	void cos(const double* radians, size_t n, double* out);
+	void sincos(const double* radians, size_t n, double* sines, double* cosines);
+	void atan2(const double* y, const double* x, size_t n, double* radians);
+	void fastSin(const double* radians, size_t n, double* out);
+	void fastCos(const double* radians, size_t n, double* out);
+	void fastSincos(const double* radians, size_t n, double* sines, double* cosines);
+	void fastAtan2(const double* y, const double* x, size_t n, double* radians);
+
+	inline void sin(const Angle* angles, size_t n, double* out) {
+		sin(reinterpret_cast<const double*>(angles), n, out);
+	}
+	inline void cos(const Angle* angles, size_t n, double* out) {
+		cos(reinterpret_cast<const double*>(angles), n, out);
+	}
+	inline void sincos(const Angle* angles, size_t n, double* sines, double* cosines) {
+		sincos(reinterpret_cast<const double*>(angles), n, sines, cosines);
+	}
+	inline void atan2(const double* y, const double* x, size_t n, Angle* out) {
+		atan2(y, x, n, reinterpret_cast<double*>(out));
+	}
+	inline void fastSin(const Angle* angles, size_t n, double* out) {
+		fastSin(reinterpret_cast<const double*>(angles), n, out);
+	}
+	inline void fastCos(const Angle* angles, size_t n, double* out) {
+		fastCos(reinterpret_cast<const double*>(angles), n, out);
+	}
+	inline void fastSincos(const Angle* angles, size_t n, double* sines, double* cosines) {
+		fastSincos(reinterpret_cast<const double*>(angles), n, sines, cosines);
+	}
+	inline void fastAtan2(const double* y, const double* x, size_t n, Angle* out) {
+		fastAtan2(y, x, n, reinterpret_cast<double*>(out));
+	}
+}
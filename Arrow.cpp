@@ -0,0 +1,138 @@
+#include "Arrow.h"
+
+static const char* QUANTITY_KEY = "measurement.quantity";
+static const char* UNIT_KEY = "measurement.unit";
+
+//owned by an exported schema, freed by its release callback
+struct SchemaData {
+	std::string name;
+	std::vector<char> metadata;
+};
+
+//owned by an exported array
+struct ArrayData {
+	const void* buffers[2];
+	void* owner;
+	void (*freeOwner)(void*);
+};
+
+static void releaseSchema(ArrowSchema* schema) {
+	delete static_cast<SchemaData*>(schema->private_data);
+	schema->release = 0;
+}
+
+static void releaseArray(ArrowArray* array) {
+	ArrayData* data = static_cast<ArrayData*>(array->private_data);
+	if (data->freeOwner) {
+		data->freeOwner(data->owner);
+	}
+	delete data;
+	array->release = 0;
+}
+
+//metadata is an int32 pair count, then for each pair an int32 length and the bytes of the key, then the same for the value
+static void putInt32(std::vector<char>& out, int32_t val) {
+	char bytes[4];
+	std::memcpy(bytes, &val, 4);
+	out.insert(out.end(), bytes, bytes + 4);
+}
+
+static void putString(std::vector<char>& out, const char* str) {
+	int32_t length = (int32_t)std::strlen(str);
+	putInt32(out, length);
+	out.insert(out.end(), str, str + length);
+}
+
+static int32_t getInt32(const char*& p) {
+	int32_t val;
+	std::memcpy(&val, p, 4);
+	p += 4;
+	return val;
+}
+
+void arrowExportSchema(const char* name, const char* quantity, const char* unit, ArrowSchema* schema) {
+	SchemaData* data = new SchemaData;
+	data->name = name ? name : "";
+	putInt32(data->metadata, 2);
+	putString(data->metadata, QUANTITY_KEY);
+	putString(data->metadata, quantity);
+	putString(data->metadata, UNIT_KEY);
+	putString(data->metadata, unit);
+
+	schema->format = "g";
+	schema->name = data->name.c_str();
+	schema->metadata = data->metadata.data();
+	schema->flags = ARROW_FLAG_NULLABLE;
+	schema->n_children = 0;
+	schema->children = 0;
+	schema->dictionary = 0;
+	schema->release = releaseSchema;
+	schema->private_data = data;
+}
+
+void arrowExportArray(const double* values, size_t n, void* owner, void (*freeOwner)(void*), ArrowArray* array) {
+	ArrayData* data = new ArrayData;
+	//no validity bitmap, measurements have no nulls
+	data->buffers[0] = 0;
+	data->buffers[1] = values;
+	data->owner = owner;
+	data->freeOwner = freeOwner;
+
+	array->length = (int64_t)n;
+	array->null_count = 0;
+	array->offset = 0;
+	array->n_buffers = 2;
+	array->n_children = 0;
+	array->buffers = data->buffers;
+	array->children = 0;
+	array->dictionary = 0;
+	array->release = releaseArray;
+	array->private_data = data;
+}
+
+bool arrowReadField(const ArrowSchema* schema, std::string& quantity, std::string& unit) {
+	if (!schema || !schema->release || !schema->format || std::strcmp(schema->format, "g") != 0 || !schema->metadata) {
+		return false;
+	}
+	const char* p = schema->metadata;
+	int32_t pairs = getInt32(p);
+	bool haveQuantity = false;
+	bool haveUnit = false;
+	for (int32_t i = 0; i < pairs; i++) {
+		int32_t keyLength = getInt32(p);
+		std::string key(p, keyLength);
+		p += keyLength;
+		int32_t valueLength = getInt32(p);
+		if (key == QUANTITY_KEY) {
+			quantity.assign(p, valueLength);
+			haveQuantity = true;
+		}
+		else if (key == UNIT_KEY) {
+			unit.assign(p, valueLength);
+			haveUnit = true;
+		}
+		p += valueLength;
+	}
+	return haveQuantity && haveUnit;
+}
+
+int arrowUnitIndex(msr_quantity quantity, const std::string& unit) {
+	msr_unit id = msr_unit_from_name(unit.c_str());
+	if (id == MSR_INVALID_UNIT || MSR_UNIT_QUANTITY(id) != quantity) {
+		return -1;
+	}
+	return (int)(id & 0xff);
+}
+
+const char* arrowUnitName(msr_quantity quantity, int index) {
+	return msr_unit_name(MSR_UNIT_ID(quantity, index));
+}
+
+void arrowRelease(ArrowArray* array, ArrowSchema* schema) {
+	if (array && array->release) {
+		array->release(array);
+	}
+	if (schema && schema->release) {
+		schema->release(schema);
+	}
+}
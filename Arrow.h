@@ -0,0 +1,148 @@
+#pragma once
+
+/*
+ARROW
+=====
+
+Hands measurement arrays to and from Apache Arrow through the Arrow C Data
+Interface, the small ABI Arrow libraries in every language agree on. Only the
+two C structs from the spec are needed, so nothing here depends on Arrow.
+
+std::vector<Energy> readings = ...;
+ArrowArray array;
+ArrowSchema schema;
+exportArrow(readings.data(), readings.size(), "energy", &array, &schema);	//zero-copy, readings must outlive array
+pyarrow.Array._import_from_c(array_ptr, schema_ptr)
+
+std::vector<Pressure> pressures;
+if (!importArrow(&array, &schema, pressures)) { ... }	//wrong quantity, unknown unit or not float64
+
+A column is float64 ("g") with two metadata entries on its field:
+measurement.quantity	the class name, e.g. Pressure
+measurement.unit		the unit the values are in, named as in UNITS, e.g. psi
+
+Export never copies: every measurement class holds exactly one double, so an
+array of them is already an Arrow float64 buffer. The unit written out is the
+one the class keeps its value in (SIUnit<T>::stored), which is the SI unit
+except for Volume (L), Density (g_cm3) and RotationSpeed (rpm). Exporting a
+std::vector by rvalue moves it into the array, and the array's release
+callback frees it.
+
+Import takes ownership of both structs and releases them, whether or not it
+succeeds. It checks the quantity against T and converts from any unit of T with
+one multiply-add per value, or a plain copy when the unit is already the stored
+one. Nulls come back as NaN.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "MeasurementC.h"
+#include "MeasurementTraits.h"
+#include "Quantities.h"
+
+//from the Arrow C Data Interface specification
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+	const char* format;
+	const char* name;
+	const char* metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema** children;
+	struct ArrowSchema* dictionary;
+	void (*release)(struct ArrowSchema*);
+	void* private_data;
+};
+
+struct ArrowArray {
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void** buffers;
+	struct ArrowArray** children;
+	struct ArrowArray* dictionary;
+	void (*release)(struct ArrowArray*);
+	void* private_data;
+};
+
+#endif
+
+//field with the unit metadata of a quantity, name is copied
+void arrowExportSchema(const char* name, const char* quantity, const char* unit, ArrowSchema* schema);
+//float64 array over n values, owner is passed to freeOwner when the array is released (both may be null)
+void arrowExportArray(const double* values, size_t n, void* owner, void (*freeOwner)(void*), ArrowArray* array);
+//reads the unit metadata, false if the schema is not float64 or has none
+bool arrowReadField(const ArrowSchema* schema, std::string& quantity, std::string& unit);
+//position of the named unit in the UNITS enum of quantity, -1 if it is not one of its units
+int arrowUnitIndex(msr_quantity quantity, const std::string& unit);
+//name of the unit at index in the UNITS enum of quantity, null if there is none
+const char* arrowUnitName(msr_quantity quantity, int index);
+void arrowRelease(ArrowArray* array, ArrowSchema* schema);
+
+template <class T>
+void exportArrow(const T* values, size_t n, const char* name, ArrowArray* array, ArrowSchema* schema) {
+	static_assert(sizeof(T) == sizeof(double) && std::is_standard_layout<T>::value, "measurements must be a single double");
+	arrowExportSchema(name, QuantityOf<T>::name(), arrowUnitName(QuantityOf<T>::value, SIUnit<T>::stored), schema);
+	arrowExportArray(reinterpret_cast<const double*>(values), n, 0, 0, array);
+}
+
+template <class T>
+void exportArrow(std::vector<T>&& values, const char* name, ArrowArray* array, ArrowSchema* schema) {
+	static_assert(sizeof(T) == sizeof(double) && std::is_standard_layout<T>::value, "measurements must be a single double");
+	std::vector<T>* owned = new std::vector<T>(std::move(values));
+	arrowExportSchema(name, QuantityOf<T>::name(), arrowUnitName(QuantityOf<T>::value, SIUnit<T>::stored), schema);
+	arrowExportArray(reinterpret_cast<const double*>(owned->data()), owned->size(), owned,
+		[](void* owner) { delete static_cast<std::vector<T>*>(owner); }, array);
+}
+
+template <class T>
+bool importArrow(ArrowArray* array, ArrowSchema* schema, std::vector<T>& out) {
+	static_assert(sizeof(T) == sizeof(double) && std::is_standard_layout<T>::value, "measurements must be a single double");
+	std::string quantity;
+	std::string unitName;
+	int unit = -1;
+	if (arrowReadField(schema, quantity, unitName) && quantity == QuantityOf<T>::name()) {
+		unit = arrowUnitIndex(QuantityOf<T>::value, unitName);
+	}
+	if (unit < 0 || array->n_buffers != 2 || array->length < 0) {
+		arrowRelease(array, schema);
+		return false;
+	}
+	size_t n = (size_t)array->length;
+	const uint8_t* valid = static_cast<const uint8_t*>(array->buffers[0]);
+	const double* in = static_cast<const double*>(array->buffers[1]) + array->offset;
+	out.resize(n);
+	if (unit == (int)SIUnit<T>::stored && (!valid || array->null_count == 0)) {
+		std::memcpy(static_cast<void*>(out.data()), in, n * sizeof(double));
+	}
+	else {
+		//value -> SI -> the class's own unit, all inline
+		UnitConversion conv = conversionToSI<T>((typename SIUnit<T>::Units)unit);
+		for (size_t i = 0; i < n; i++) {
+			out[i] = fromSI<T>(conv.apply(in[i]));
+		}
+		if (valid && array->null_count != 0) {
+			for (size_t i = 0; i < n; i++) {
+				size_t bit = i + (size_t)array->offset;
+				if (!(valid[bit / 8] >> (bit % 8) & 1)) {
+					out[i] = fromSI<T>(NAN);
+				}
+			}
+		}
+	}
+	arrowRelease(array, schema);
+	return true;
+}
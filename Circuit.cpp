@@ -0,0 +1,381 @@
+#include "Circuit.h"
+#include <cmath>
+#include "Parallel.h"
+
+//below this many rows a solve stays on the calling thread
+static const size_t PARALLEL_ROWS = 20000;
+
+Circuit::Circuit() {
+	nodeVolts.push_back(0);
+	tolerance = 1e-10;
+	maxIterations = 10000;
+	iterations = 0;
+	threads = 0;
+}
+
+int Circuit::addNode() {
+	nodeVolts.push_back(0);
+	return (int)nodeVolts.size() - 1;
+}
+
+size_t Circuit::nodeCount() {
+	return nodeVolts.size();
+}
+
+int Circuit::addResistor(int a, int b, Resistance r) {
+	Element e = { a, b, RESISTOR, r.value(UNITS::Ohm), 0 };
+	elements.push_back(e);
+	elementAmps.push_back(0);
+	return (int)elements.size() - 1;
+}
+
+int Circuit::addCapacitor(int a, int b, Capacitance c) {
+	Element e = { a, b, CAPACITOR, c.value(UNITS::Farad), 0 };
+	elements.push_back(e);
+	elementAmps.push_back(0);
+	return (int)elements.size() - 1;
+}
+
+int Circuit::addVoltageSource(int node, Voltage v) {
+	sourceNodes.push_back(node);
+	sourceVolts.push_back(v.value(UNITS::V));
+	sourceAmps.push_back(0);
+	return (int)sourceNodes.size() - 1;
+}
+
+int Circuit::addVoltageSource(int plus, int minus, Voltage v, Resistance internal) {
+	Element e = { plus, minus, NORTON, internal.value(UNITS::Ohm), v.value(UNITS::V) };
+	elements.push_back(e);
+	elementAmps.push_back(0);
+	return (int)elements.size() - 1;
+}
+
+int Circuit::addCurrentSource(int from, int to, Current i) {
+	CurrentSource source = { from, to, i.value(UNITS::A) };
+	currentSources.push_back(source);
+	return (int)currentSources.size() - 1;
+}
+
+void Circuit::setVoltageSource(int source, Voltage v) {
+	sourceVolts[source] = v.value(UNITS::V);
+}
+
+void Circuit::setCurrentSource(int source, Current i) {
+	currentSources[source].amps = i.value(UNITS::A);
+}
+
+bool Circuit::solve() {
+	return run(0);
+}
+
+bool Circuit::step(TimeDuration dt) {
+	return run(dt.value(UNITS::s));
+}
+
+Voltage Circuit::voltage(int node) {
+	return Voltage(nodeVolts[node], UNITS::V);
+}
+
+Current Circuit::current(int element) {
+	return Current(elementAmps[element], UNITS::A);
+}
+
+Current Circuit::sourceCurrent(int source) {
+	return Current(sourceAmps[source], UNITS::A);
+}
+
+void Circuit::setTolerance(double relative) {
+	tolerance = relative;
+}
+
+void Circuit::setMaxIterations(int count) {
+	maxIterations = count;
+}
+
+void Circuit::setThreads(unsigned count) {
+	threads = count;
+}
+
+int Circuit::lastIterations() {
+	return iterations;
+}
+
+unsigned Circuit::threadsFor(size_t rows) {
+	return threadCount(rows, PARALLEL_ROWS, threads);
+}
+
+//dt of 0 means DC, where capacitors carry no current
+double Circuit::conductance(const Element& e, double dt) {
+	switch (e.type) {
+	case RESISTOR:
+	case NORTON:
+		return 1 / e.value;
+	case CAPACITOR:
+		return dt > 0 ? e.value / dt : 0;
+	}
+	return 0;
+}
+
+bool Circuit::run(double dt) {
+	std::vector<double> previous = nodeVolts;
+	assemble(dt);
+	if (!conjugateGradient()) {
+		return false;
+	}
+
+	for (size_t r = 0; r < unknownNode.size(); r++) {
+		nodeVolts[unknownNode[r]] = x[r];
+	}
+	nodeVolts[GROUND] = 0;
+	for (size_t s = 0; s < sourceNodes.size(); s++) {
+		nodeVolts[sourceNodes[s]] = sourceVolts[s];
+	}
+
+	//element currents, and what each node sends out so sources can be balanced
+	std::vector<double> leaving(nodeVolts.size(), 0.0);
+	for (size_t i = 0; i < elements.size(); i++) {
+		Element& e = elements[i];
+		double g = conductance(e, dt);
+		double v = nodeVolts[e.a] - nodeVolts[e.b];
+		double amps = 0;
+		switch (e.type) {
+		case RESISTOR:
+			amps = g * v;
+			break;
+		case NORTON:
+			amps = g * (v - e.source);
+			break;
+		case CAPACITOR:
+			amps = g * (v - (previous[e.a] - previous[e.b]));
+			break;
+		}
+		elementAmps[i] = amps;
+		leaving[e.a] += amps;
+		leaving[e.b] -= amps;
+	}
+	for (size_t i = 0; i < currentSources.size(); i++) {
+		leaving[currentSources[i].from] += currentSources[i].amps;
+		leaving[currentSources[i].to] -= currentSources[i].amps;
+	}
+	for (size_t s = 0; s < sourceNodes.size(); s++) {
+		sourceAmps[s] = leaving[sourceNodes[s]];
+	}
+	return true;
+}
+
+void Circuit::assemble(double dt) {
+	size_t nodes = nodeVolts.size();
+
+	//ground and source nodes are known, everything else is solved for
+	std::vector<char> fixed(nodes, 0);
+	std::vector<double> fixedVolts(nodes, 0.0);
+	fixed[GROUND] = 1;
+	for (size_t s = 0; s < sourceNodes.size(); s++) {
+		fixed[sourceNodes[s]] = 1;
+		fixedVolts[sourceNodes[s]] = sourceVolts[s];
+	}
+	unknown.assign(nodes, -1);
+	unknownNode.clear();
+	for (size_t n = 0; n < nodes; n++) {
+		if (!fixed[n]) {
+			unknown[n] = (int)unknownNode.size();
+			unknownNode.push_back((int)n);
+		}
+	}
+	size_t rows = unknownNode.size();
+
+	//elements touching each row, bucketed by a counting sort
+	rowStart.assign(rows + 1, 0);
+	for (size_t i = 0; i < elements.size(); i++) {
+		const Element& e = elements[i];
+		if (e.a == e.b) {
+			continue;
+		}
+		if (unknown[e.a] >= 0) {
+			rowStart[unknown[e.a] + 1]++;
+		}
+		if (unknown[e.b] >= 0) {
+			rowStart[unknown[e.b] + 1]++;
+		}
+	}
+	for (size_t r = 0; r < rows; r++) {
+		rowStart[r + 1] += rowStart[r];
+	}
+	std::vector<int> incident(rowStart[rows]);
+	std::vector<size_t> cursor(rowStart.begin(), rowStart.end() - 1);
+	for (size_t i = 0; i < elements.size(); i++) {
+		const Element& e = elements[i];
+		if (e.a == e.b) {
+			continue;
+		}
+		if (unknown[e.a] >= 0) {
+			incident[cursor[unknown[e.a]]++] = (int)i;
+		}
+		if (unknown[e.b] >= 0) {
+			incident[cursor[unknown[e.b]]++] = (int)i;
+		}
+	}
+
+	//every row is built from its own elements, so rows can be filled on separate threads
+	rowLength.assign(rows, 0);
+	columns.assign(rowStart[rows], 0);
+	entries.assign(rowStart[rows], 0.0);
+	diagonal.assign(rows, 0.0);
+	rhs.assign(rows, 0.0);
+	parallelFor(rows, threadsFor(rows), [&](size_t begin, size_t end) {
+		for (size_t r = begin; r < end; r++) {
+			int node = unknownNode[r];
+			size_t start = rowStart[r];
+			size_t length = 0;
+			for (size_t k = rowStart[r]; k < rowStart[r + 1]; k++) {
+				const Element& e = elements[incident[k]];
+				double g = conductance(e, dt);
+				int other = (e.a == node) ? e.b : e.a;
+				double sign = (e.a == node) ? 1 : -1;
+				diagonal[r] += g;
+				if (e.type == NORTON) {
+					rhs[r] += sign * g * e.source;
+				}
+				else if (e.type == CAPACITOR && dt > 0) {
+					rhs[r] += sign * g * (nodeVolts[e.a] - nodeVolts[e.b]);
+				}
+				if (unknown[other] < 0) {
+					rhs[r] += g * fixedVolts[other];
+					continue;
+				}
+				//insert keeping the row sorted by column, merging parallel elements
+				int col = unknown[other];
+				size_t pos = length;
+				while (pos > 0 && columns[start + pos - 1] > col) {
+					pos--;
+				}
+				if (pos > 0 && columns[start + pos - 1] == col) {
+					entries[start + pos - 1] -= g;
+					continue;
+				}
+				for (size_t m = length; m > pos; m--) {
+					columns[start + m] = columns[start + m - 1];
+					entries[start + m] = entries[start + m - 1];
+				}
+				columns[start + pos] = col;
+				entries[start + pos] = -g;
+				length++;
+			}
+			rowLength[r] = length;
+			//an unconnected node just stays where it is
+			if (diagonal[r] == 0) {
+				diagonal[r] = 1;
+				rhs[r] = nodeVolts[node];
+			}
+		}
+	});
+
+	for (size_t i = 0; i < currentSources.size(); i++) {
+		CurrentSource& source = currentSources[i];
+		if (unknown[source.from] >= 0) {
+			rhs[unknown[source.from]] -= source.amps;
+		}
+		if (unknown[source.to] >= 0) {
+			rhs[unknown[source.to]] += source.amps;
+		}
+	}
+
+	//start from the last solution
+	x.resize(rows);
+	for (size_t r = 0; r < rows; r++) {
+		x[r] = nodeVolts[unknownNode[r]];
+	}
+}
+
+void Circuit::multiply(const double* in, double* out) {
+	size_t rows = diagonal.size();
+	parallelFor(rows, threadsFor(rows), [&](size_t begin, size_t end) {
+		for (size_t r = begin; r < end; r++) {
+			double sum = diagonal[r] * in[r];
+			size_t start = rowStart[r];
+			for (size_t k = 0; k < rowLength[r]; k++) {
+				sum += entries[start + k] * in[columns[start + k]];
+			}
+			out[r] = sum;
+		}
+	});
+}
+
+bool Circuit::conjugateGradient() {
+	size_t n = diagonal.size();
+	unsigned count = threadsFor(n);
+	iterations = 0;
+	if (n == 0) {
+		return true;
+	}
+	std::vector<double> r(n), z(n), p(n), q(n);
+
+	multiply(x.data(), q.data());
+	double rz = parallelSum(n, count, [&](size_t begin, size_t end) {
+		double sum = 0;
+		for (size_t i = begin; i < end; i++) {
+			r[i] = rhs[i] - q[i];
+			z[i] = r[i] / diagonal[i];
+			p[i] = z[i];
+			sum += r[i] * z[i];
+		}
+		return sum;
+	});
+	double bb = parallelSum(n, count, [&](size_t begin, size_t end) {
+		double sum = 0;
+		for (size_t i = begin; i < end; i++) {
+			sum += rhs[i] * rhs[i];
+		}
+		return sum;
+	});
+	double limit = tolerance * tolerance * (bb > 0 ? bb : 1);
+
+	while (iterations < maxIterations) {
+		multiply(p.data(), q.data());
+		double pq = parallelSum(n, count, [&](size_t begin, size_t end) {
+			double sum = 0;
+			for (size_t i = begin; i < end; i++) {
+				sum += p[i] * q[i];
+			}
+			return sum;
+		});
+		if (pq == 0) {
+			break;
+		}
+		double alpha = rz / pq;
+		double rr = parallelSum(n, count, [&](size_t begin, size_t end) {
+			double sum = 0;
+			for (size_t i = begin; i < end; i++) {
+				x[i] += alpha * p[i];
+				r[i] -= alpha * q[i];
+				sum += r[i] * r[i];
+			}
+			return sum;
+		});
+		iterations++;
+		if (rr <= limit) {
+			return true;
+		}
+		double rzNext = parallelSum(n, count, [&](size_t begin, size_t end) {
+			double sum = 0;
+			for (size_t i = begin; i < end; i++) {
+				z[i] = r[i] / diagonal[i];
+				sum += r[i] * z[i];
+			}
+			return sum;
+		});
+		double beta = rzNext / rz;
+		rz = rzNext;
+		parallelFor(n, count, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				p[i] = z[i] + beta * p[i];
+			}
+		});
+	}
+	//a residual that is already zero has converged too
+	double rr = 0;
+	for (size_t i = 0; i < n; i++) {
+		rr += r[i] * r[i];
+	}
+	return rr <= limit;
+}
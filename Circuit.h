@@ -0,0 +1,129 @@
+#pragma once
+
+/*
+CIRCUIT
+=======
+
+Nodal analysis of large resistive networks, with capacitors for transient runs.
+
+Circuit grid;
+int a = grid.addNode();
+int b = grid.addNode();
+grid.addVoltageSource(a, Voltage(12, UNITS::V));
+int r1 = grid.addResistor(a, b, Resistance(10, UNITS::Ohm));
+grid.addResistor(b, Circuit::GROUND, Resistance(20, UNITS::Ohm));
+grid.solve();
+Voltage vb = grid.voltage(b);					//8 V
+Current i1 = grid.current(r1);					//0.4 A from a to b
+
+Node 0 is ground. Ideal voltage sources hold a node at a voltage relative to
+ground; a source between two other nodes needs an internal resistance and is
+modelled as its Norton equivalent. Keeping every source tied down this way
+leaves a symmetric positive definite conductance matrix, which is stored in
+compressed rows and solved with Jacobi-preconditioned conjugate gradients.
+Rows are assembled and the solver's matrix-vector products run across
+threads once the network is big enough to pay for them.
+
+step() advances a transient run by one backward Euler step. Each capacitor
+becomes a conductance C/dt in parallel with a current source carrying its
+previous voltage, so every step solves the same kind of system as solve().
+
+solve() and step() return false if the solver did not converge, and the
+previous node voltages are kept.
+*/
+
+#include <cstddef>
+#include <vector>
+#include "Measurement.h"
+
+class Circuit {
+public:
+	static const int GROUND = 0;
+
+	Circuit();
+	//returns the new node's index
+	int addNode();
+	size_t nodeCount();
+
+	//elements return an index for current()
+	int addResistor(int a, int b, Resistance r);
+	int addCapacitor(int a, int b, Capacitance c);
+	//holds node at v relative to ground, returns an index for sourceCurrent()
+	int addVoltageSource(int node, Voltage v);
+	//source with its + side at plus, driving through an internal resistance, returns an element index
+	int addVoltageSource(int plus, int minus, Voltage v, Resistance internal);
+	//drives i out of from and into to, returns an index for setCurrentSource()
+	int addCurrentSource(int from, int to, Current i);
+	void setVoltageSource(int source, Voltage v);
+	void setCurrentSource(int source, Current i);
+
+	//DC operating point, capacitors are open
+	bool solve();
+	//one backward Euler step of length dt from the present state
+	bool step(TimeDuration dt);
+
+	Voltage voltage(int node);
+	//current through element from its first node to its second
+	Current current(int element);
+	//current delivered by an ideal voltage source into its node
+	Current sourceCurrent(int source);
+
+	void setTolerance(double relative);
+	void setMaxIterations(int iterations);
+	//0 uses every hardware thread
+	void setThreads(unsigned count);
+	int lastIterations();
+
+protected:
+	enum ElementType { RESISTOR, CAPACITOR, NORTON };
+	struct Element {
+		int a;
+		int b;
+		ElementType type;
+		//R in Ohm, C in Farad
+		double value;
+		//Norton source voltage in V
+		double source;
+	};
+	struct CurrentSource {
+		int from;
+		int to;
+		double amps;
+	};
+
+	bool run(double dt);
+	void assemble(double dt);
+	bool conjugateGradient();
+	void multiply(const double* x, double* y);
+	double conductance(const Element& e, double dt);
+	unsigned threadsFor(size_t rows);
+
+	std::vector<Element> elements;
+	std::vector<CurrentSource> currentSources;
+	//node held by each ideal source, and its voltage
+	std::vector<int> sourceNodes;
+	std::vector<double> sourceVolts;
+	std::vector<double> sourceAmps;
+
+	//node voltages in V, and each element's current after the last solve
+	std::vector<double> nodeVolts;
+	std::vector<double> elementAmps;
+
+	//unknown index of each node, -1 for ground and source nodes
+	std::vector<int> unknown;
+	std::vector<int> unknownNode;
+
+	//conductance matrix of the unknowns in compressed rows
+	std::vector<size_t> rowStart;
+	std::vector<size_t> rowLength;
+	std::vector<int> columns;
+	std::vector<double> entries;
+	std::vector<double> diagonal;
+	std::vector<double> rhs;
+	std::vector<double> x;
+
+	double tolerance;
+	int maxIterations;
+	int iterations;
+	unsigned threads;
+};
@@ -0,0 +1,119 @@
+#include "CompactStorage.h"
+#include <cmath>
+#include <cstring>
+
+static inline uint32_t floatBits(float val) {
+	uint32_t bits;
+	std::memcpy(&bits, &val, sizeof(bits));
+	return bits;
+}
+
+static inline float bitsFloat(uint32_t bits) {
+	float val;
+	std::memcpy(&val, &bits, sizeof(val));
+	return val;
+}
+
+void Float32Storage::encode(const double* in, size_t n, Code* out, Block&) {
+	for (size_t i = 0; i < n; i++) {
+		out[i] = static_cast<float>(in[i]);
+	}
+}
+
+void Float32Storage::decode(const Code* in, size_t n, const Block&, double* out) {
+	for (size_t i = 0; i < n; i++) {
+		out[i] = in[i];
+	}
+}
+
+uint16_t Float16Storage::fromFloat(float val) {
+	uint32_t x = floatBits(val);
+	uint32_t sign = x & 0x80000000u;
+	x ^= sign;
+	uint16_t half;
+	if (x >= 0x47800000u) {
+		//too big for a half, or already inf / nan
+		half = (x > 0x7f800000u) ? 0x7e00 : 0x7c00;
+	}
+	else if (x < 0x38800000u) {
+		//subnormal half: let the float adder line the mantissa up and round it
+		float f = bitsFloat(x) + bitsFloat(126u << 23);
+		half = static_cast<uint16_t>(floatBits(f) - (126u << 23));
+	}
+	else {
+		//rebias the exponent and round the mantissa to nearest even
+		uint32_t odd = (x >> 13) & 1;
+		x += 0xc8000fffu + odd;
+		half = static_cast<uint16_t>(x >> 13);
+	}
+	return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+float Float16Storage::toFloat(uint16_t half) {
+	uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+	uint32_t bits = static_cast<uint32_t>(half & 0x7fff) << 13;
+	//scaling by 2^112 moves the exponent bias from 15 to 127 and also handles subnormals
+	uint32_t scaled = floatBits(bitsFloat(bits) * 0x1p112f);
+	uint32_t special = bits | 0x7f800000u;
+	uint32_t out = ((half & 0x7c00) == 0x7c00) ? special : scaled;
+	return bitsFloat(out | sign);
+}
+
+//a power of two scale puts the block's largest magnitude in [2^14, 2^15), well inside the half range, and divides exactly
+void Float16Storage::encode(const double* in, size_t n, Code* out, Block& block) {
+	double largest = 0;
+	for (size_t i = 0; i < n; i++) {
+		double magnitude = std::fabs(in[i]);
+		largest = std::isfinite(magnitude) && magnitude > largest ? magnitude : largest;
+	}
+	block.scale = largest > 0 ? std::ldexp(1.0, std::ilogb(largest) - 14) : 1;
+	double inverse = 1 / block.scale;
+	for (size_t i = 0; i < n; i++) {
+		out[i] = fromFloat(static_cast<float>(in[i] * inverse));
+	}
+}
+
+void Float16Storage::decode(const Code* in, size_t n, const Block& block, double* out) {
+	for (size_t i = 0; i < n; i++) {
+		out[i] = toFloat(in[i]) * block.scale;
+	}
+}
+
+void ScaledInt16Storage::encode(const double* in, size_t n, Code* out, Block& block) {
+	//range of the finite values only, a block with none gets an empty range at 0
+	double low = HUGE_VAL;
+	double high = -HUGE_VAL;
+	for (size_t i = 0; i < n; i++) {
+		bool finite = std::isfinite(in[i]);
+		low = finite && in[i] < low ? in[i] : low;
+		high = finite && in[i] > high ? in[i] : high;
+	}
+	if (low > high) {
+		low = 0;
+		high = 0;
+	}
+	//codes run from -MAX_CODE to MAX_CODE around the middle of the block
+	block.offset = low + (high - low) / 2;
+	block.scale = (high - low) / (2 * MAX_CODE);
+	if (block.scale == 0) {
+		block.scale = 1;
+	}
+	double inverse = 1 / block.scale;
+	for (size_t i = 0; i < n; i++) {
+		bool finite = std::isfinite(in[i]);
+		double code = std::nearbyint(((finite ? in[i] : block.offset) - block.offset) * inverse);
+		code = code < -MAX_CODE ? -MAX_CODE : code;
+		code = code > MAX_CODE ? MAX_CODE : code;
+		Code special = std::isnan(in[i]) ? NAN_CODE : (in[i] > 0 ? INFINITY_CODE : -INFINITY_CODE);
+		out[i] = finite ? static_cast<Code>(code) : special;
+	}
+}
+
+void ScaledInt16Storage::decode(const Code* in, size_t n, const Block& block, double* out) {
+	for (size_t i = 0; i < n; i++) {
+		double val = in[i] * block.scale + block.offset;
+		val = in[i] == INFINITY_CODE ? HUGE_VAL : val;
+		val = in[i] == -INFINITY_CODE ? -HUGE_VAL : val;
+		out[i] = in[i] == NAN_CODE ? NAN : val;
+	}
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+/*
+COMPACT STORAGE
+===============
+
+CompactArray<T, Storage> holds a long run of one measurement type in less than
+the 8 bytes per value a plain array of measurements takes. The storage policy
+picks the format:
+
+Float32Storage		4 bytes, about 7 significant digits
+Float16Storage		2 bytes, about 3 significant digits (IEEE half precision, scaled per block)
+ScaledInt16Storage	2 bytes, 65533 steps between the min and max of each block
+
+CompactArray<Temperature, ScaledInt16Storage> history;
+history.push_back(Temperature(21.5, UNITS::C));
+Temperature t = history[0];
+
+Values are encoded in blocks of BlockSize. A block of ScaledInt16Storage carries
+its own scale and offset, so 1024 temperatures spanning 600 K keep about 0.01 K
+resolution. Its range is taken from the finite values, and NaN, inf and -inf
+keep codes of their own, so one bad sample neither spoils the block nor turns
+into an arbitrary number. A block of Float16Storage carries a power of two
+scale that brings its largest value into the half range, so SI values far
+outside it, like 101325 Pa, keep their 3 digits instead of overflowing to inf.
+The newest, not yet full block is kept as doubles until it fills.
+
+decode() widens a range back to SI doubles. The decode loops are plain
+multiply-adds (or bit shuffles for halves) so the compiler vectorizes them, and
+they are meant to run inside whatever kernel consumes the data rather than to
+expand the whole array up front. Reading back gives the usual measurement
+classes, so the Measurement.h operator rules still apply.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MeasurementTraits.h"
+
+struct Float32Storage {
+	typedef float Code;
+	struct Block {};
+	static void encode(const double* in, size_t n, Code* out, Block& block);
+	static void decode(const Code* in, size_t n, const Block& block, double* out);
+};
+
+struct Float16Storage {
+	typedef uint16_t Code;
+	//value = half * scale, scale a power of two
+	struct Block {
+		double scale;
+	};
+	static void encode(const double* in, size_t n, Code* out, Block& block);
+	static void decode(const Code* in, size_t n, const Block& block, double* out);
+	//IEEE 754 binary16 conversions, rounding to nearest even
+	static uint16_t fromFloat(float val);
+	static float toFloat(uint16_t half);
+};
+
+struct ScaledInt16Storage {
+	typedef int16_t Code;
+	//codes past MAX_CODE stand for values that have no place on the scale
+	static const Code MAX_CODE = 32766;
+	static const Code INFINITY_CODE = 32767;	//-INFINITY_CODE for -inf
+	static const Code NAN_CODE = -32768;
+	//value = code * scale + offset
+	struct Block {
+		double scale;
+		double offset;
+	};
+	static void encode(const double* in, size_t n, Code* out, Block& block);
+	static void decode(const Code* in, size_t n, const Block& block, double* out);
+};
+
+template <class T, class Storage, size_t BlockSize = 1024>
+class CompactArray {
+public:
+	typedef typename Storage::Code Code;
+	typedef typename Storage::Block Block;
+
+	size_t size() {
+		return blocks.size() * BlockSize + tail.size();
+	}
+	void push_back(T val) {
+		tail.push_back(toSI(val));
+		if (tail.size() == BlockSize) {
+			flush();
+		}
+	}
+	//appends n values already in SI units
+	void append(const double* si, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			tail.push_back(si[i]);
+			if (tail.size() == BlockSize) {
+				flush();
+			}
+		}
+	}
+	T operator[] (size_t i) {
+		double val;
+		decode(i, 1, &val);
+		return fromSI<T>(val);
+	}
+	//widens count values starting at first into SI doubles
+	void decode(size_t first, size_t count, double* out) {
+		size_t encoded = blocks.size() * BlockSize;
+		while (count > 0 && first < encoded) {
+			size_t block = first / BlockSize;
+			size_t offset = first % BlockSize;
+			size_t n = BlockSize - offset;
+			if (n > count) {
+				n = count;
+			}
+			Storage::decode(&codes[first], n, blocks[block], out);
+			first += n;
+			out += n;
+			count -= n;
+		}
+		for (size_t i = 0; i < count; i++) {
+			out[i] = tail[first - encoded + i];
+		}
+	}
+	//memory used by the values, in bytes
+	size_t bytes() {
+		return codes.size() * sizeof(Code) + blocks.size() * sizeof(Block) + tail.size() * sizeof(double);
+	}
+	void clear() {
+		codes.clear();
+		blocks.clear();
+		tail.clear();
+	}
+
+protected:
+	void flush() {
+		Block block = Block();
+		size_t start = codes.size();
+		codes.resize(start + BlockSize);
+		Storage::encode(tail.data(), BlockSize, &codes[start], block);
+		blocks.push_back(block);
+		tail.clear();
+	}
+
+	std::vector<Code> codes;
+	std::vector<Block> blocks;
+	std::vector<double> tail;
+};
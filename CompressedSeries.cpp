@@ -0,0 +1,295 @@
+#include "CompressedSeries.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+//the widest sample: 6 bit time prefix, 64 bit time, 2 bit value prefix, 11 bit window, 64 bit value
+static const size_t MAX_SAMPLE_BITS = 6 + 64 + 2 + 11 + 64;
+//time prefixes are runs of ones ended by a zero, RAW_TIME has no zero
+static const unsigned RAW_TIME = 6;
+static const unsigned DELTA_WIDTHS[] = { 0, 7, 9, 12, 32, 64 };
+
+static inline uint64_t doubleBits(double val) {
+	uint64_t bits;
+	std::memcpy(&bits, &val, sizeof(bits));
+	return bits;
+}
+
+static inline double bitsDouble(uint64_t bits) {
+	double val;
+	std::memcpy(&val, &bits, sizeof(val));
+	return val;
+}
+
+static inline unsigned leadingZeros(uint64_t x) {
+	unsigned n = 0;
+	for (uint64_t bit = uint64_t(1) << 63; bit && !(x & bit); bit >>= 1) {
+		n++;
+	}
+	return n;
+}
+
+static inline unsigned trailingZeros(uint64_t x) {
+	unsigned n = 0;
+	for (; n < 64 && !(x & 1); x >>= 1) {
+		n++;
+	}
+	return n;
+}
+
+//ticks shorter than a second divide by ticks per second, as set() does for ms, us and ns
+double XorSeries::fromTicks(int64_t ticks) {
+	return perSecond ? (double)ticks / perSecond : (double)ticks * tickSize;
+}
+
+//time as a whole number of ticks, false when it is not one exactly
+bool XorSeries::toTicks(double t, int64_t& ticks) {
+	double count = std::nearbyint(perSecond ? t * perSecond : t / tickSize);
+	if (!(std::fabs(count) < 4.0e18)) {
+		return false;
+	}
+	ticks = (int64_t)count;
+	return fromTicks(ticks) == t;
+}
+
+static inline bool fits(int64_t val, unsigned width) {
+	//the one bit code for a repeat of the last delta has no payload
+	if (width == 0) {
+		return val == 0;
+	}
+	if (width >= 64) {
+		return true;
+	}
+	int64_t limit = int64_t(1) << (width - 1);
+	return val >= -limit && val < limit;
+}
+
+XorSeries::XorSeries(double tick, size_t blockBytes) {
+	tickSize = tick;
+	perSecond = tick < 1 ? std::nearbyint(1 / tick) : 0;
+	blockBytes = blockBytes < 1024 ? 1024 : blockBytes > 4096 ? 4096 : blockBytes;
+	blockBits = blockBytes * 8;
+	count = 0;
+	bits = 0;
+	decodedBlock = NO_BLOCK;
+}
+
+void XorSeries::clear() {
+	count = 0;
+	bits = 0;
+	headers.clear();
+	words.clear();
+	decodedBlock = NO_BLOCK;
+}
+
+//appends the low width bits, least significant first
+void XorSeries::put(uint64_t val, unsigned width) {
+	if (width < 64) {
+		val &= (uint64_t(1) << width) - 1;
+	}
+	unsigned used = bits & 63;
+	if (used == 0) {
+		words.push_back(val);
+	}
+	else {
+		words.back() |= val << used;
+		if (used + width > 64) {
+			words.push_back(val >> (64 - used));
+		}
+	}
+	bits += width;
+}
+
+void XorSeries::push_back(double t, double v) {
+	uint64_t valueBits = doubleBits(v);
+	int64_t ticks = 0;
+	bool tickTime = toTicks(t, ticks);
+	//a new block starts on raw values
+	if (headers.empty() || bits + MAX_SAMPLE_BITS > blockBits) {
+		Header h;
+		h.word = words.size();
+		h.first = count;
+		h.count = 0;
+		h.words = 0;
+		h.minTime = t;
+		h.maxTime = t;
+		h.minValue = std::numeric_limits<double>::infinity();
+		h.maxValue = -std::numeric_limits<double>::infinity();
+		headers.push_back(h);
+		bits = 0;
+		put(doubleBits(t), 64);
+		put(valueBits, 64);
+		lastDelta = 0;
+		lastLeading = -1;
+		lastTrailing = 0;
+	}
+	else {
+		if (tickTime && onGrid) {
+			int64_t delta = ticks - lastTick;
+			int64_t dod = delta - lastDelta;
+			unsigned prefix = dod == 0 ? 0 : 1;
+			while (!fits(dod, DELTA_WIDTHS[prefix])) {
+				prefix++;
+			}
+			put((uint64_t(1) << prefix) - 1, prefix + 1);
+			if (prefix) {
+				put((uint64_t)dod, DELTA_WIDTHS[prefix]);
+			}
+			lastDelta = delta;
+		}
+		else {
+			put((uint64_t(1) << RAW_TIME) - 1, RAW_TIME);
+			put(doubleBits(t), 64);
+			lastDelta = 0;
+		}
+
+		uint64_t x = valueBits ^ lastValue;
+		if (x == 0) {
+			put(0, 1);
+		}
+		else {
+			int leading = (int)leadingZeros(x);
+			int trailing = (int)trailingZeros(x);
+			if (leading > 31) {
+				leading = 31;
+			}
+			if (lastLeading >= 0 && leading >= lastLeading && trailing >= lastTrailing) {
+				//fits in the window of the last value
+				put(1, 2);
+				put(x >> lastTrailing, 64 - lastLeading - lastTrailing);
+			}
+			else {
+				unsigned width = 64 - leading - trailing;
+				put(3, 2);
+				put((uint64_t)leading, 5);
+				put(width - 1, 6);
+				put(x >> trailing, width);
+				lastLeading = leading;
+				lastTrailing = trailing;
+			}
+		}
+	}
+	onGrid = tickTime;
+	lastTick = ticks;
+	lastValue = valueBits;
+
+	Header& h = headers.back();
+	h.count++;
+	h.words = (uint32_t)(words.size() - h.word);
+	h.minTime = t < h.minTime ? t : h.minTime;
+	h.maxTime = t > h.maxTime ? t : h.maxTime;
+	if (v == v) {
+		h.minValue = v < h.minValue ? v : h.minValue;
+		h.maxValue = v > h.maxValue ? v : h.maxValue;
+	}
+	count++;
+	//the open block has grown, an older one is unchanged
+	if (decodedBlock == headers.size() - 1) {
+		decodedBlock = NO_BLOCK;
+	}
+}
+
+namespace {
+	//reads the bit stream of one block, a 64 bit window at a time
+	struct BitReader {
+		const uint64_t* words;
+		size_t size;
+		size_t position;
+
+		uint64_t peek() {
+			size_t word = position >> 6;
+			unsigned used = position & 63;
+			uint64_t val = word < size ? words[word] >> used : 0;
+			if (used && word + 1 < size) {
+				val |= words[word + 1] << (64 - used);
+			}
+			return val;
+		}
+		uint64_t get(unsigned width) {
+			uint64_t val = peek();
+			position += width;
+			return width < 64 ? val & ((uint64_t(1) << width) - 1) : val;
+		}
+	};
+}
+
+size_t XorSeries::decode(size_t block, double* t, double* v) {
+	Header& h = headers[block];
+	BitReader in = { &words[h.word], h.words, 0 };
+	double time = bitsDouble(in.get(64));
+	uint64_t value = in.get(64);
+	t[0] = time;
+	v[0] = bitsDouble(value);
+	int64_t ticks = 0;
+	toTicks(time, ticks);
+	int64_t delta = 0;
+	unsigned leading = 0;
+	unsigned width = 0;
+	for (size_t i = 1; i < h.count; i++) {
+		uint64_t window = in.peek();
+		unsigned prefix = trailingZeros(~window);
+		if (prefix >= RAW_TIME) {
+			in.position += RAW_TIME;
+			time = bitsDouble(in.get(64));
+			toTicks(time, ticks);
+			delta = 0;
+		}
+		else {
+			in.position += prefix + 1;
+			if (prefix) {
+				unsigned w = DELTA_WIDTHS[prefix];
+				int64_t dod = (int64_t)in.get(w);
+				//sign extend
+				if (w < 64) {
+					dod = (int64_t)((uint64_t)dod << (64 - w)) >> (64 - w);
+				}
+				delta += dod;
+			}
+			ticks += delta;
+			time = fromTicks(ticks);
+		}
+
+		uint64_t control = in.get(1);
+		if (control) {
+			if (in.get(1)) {
+				leading = (unsigned)in.get(5);
+				width = (unsigned)in.get(6) + 1;
+			}
+			value ^= in.get(width) << (64 - leading - width);
+		}
+		t[i] = time;
+		v[i] = bitsDouble(value);
+	}
+	return h.count;
+}
+
+size_t XorSeries::decoded(size_t block, const double*& t, const double*& v) {
+	if (block != decodedBlock) {
+		//only ever grows, to the most samples a block has had
+		if (decodedTimes.size() < headers[block].count) {
+			decodedTimes.resize(headers[block].count);
+			decodedValues.resize(headers[block].count);
+		}
+		decode(block, decodedTimes.data(), decodedValues.data());
+		decodedBlock = block;
+	}
+	t = decodedTimes.data();
+	v = decodedValues.data();
+	return headers[block].count;
+}
+
+size_t XorSeries::blockOf(size_t i) {
+	//last block starting at or before i
+	size_t low = 0;
+	size_t high = headers.size();
+	while (high - low > 1) {
+		size_t middle = (low + high) / 2;
+		if (headers[middle].first <= i) {
+			low = middle;
+		}
+		else {
+			high = middle;
+		}
+	}
+	return low;
+}
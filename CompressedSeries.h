@@ -0,0 +1,199 @@
+#pragma once
+
+/*
+COMPRESSED SERIES
+=================
+
+CompressedSeries<T> keeps (TimeDuration, T) samples in a few bits each, for
+caches of recent readings that barely change from one sample to the next. It is
+the Gorilla scheme: timestamps as delta-of-delta, values as the XOR with the
+previous value.
+
+CompressedSeries<Temperature> history(TimeDuration(1, UNITS::ms));	//timestamp tick
+history.push_back(TimeDuration(12.5, UNITS::s), Temperature(21.5, UNITS::C));
+double ratio = history.ratio();	//16 bytes a sample over compressed bytes
+
+Samples go into blocks of about 2 KB (any size from 1 to 4 KB can be picked).
+Each block starts on raw values, so it decodes on its own, and its header keeps
+the min and max of its times and values:
+
+TimeDuration t[CompressedSeries<Temperature>::MAX_BLOCK_SAMPLES];
+Temperature v[CompressedSeries<Temperature>::MAX_BLOCK_SAMPLES];
+for (size_t b = 0; b < history.blocks(); b++) {
+	if (history.header(b).maxValue < 300)
+		continue;	//the whole block is below 300 K
+	size_t n = history.decode(b, t, v);
+	...
+}
+history.between(Temperature(80, UNITS::C), Temperature(90, UNITS::C), times, values);	//skips blocks out of range
+history.during(from, to, times, values);
+
+Values keep their bits exactly, so they read back as the very same
+measurements, NaN included. Timestamps that are a whole number of ticks take a
+bit when the sampling is regular and a few bits of jitter otherwise; any other
+timestamp is kept as its raw 64 bits, so it still reads back exactly, just
+without the saving.
+
+The bit stream is sequential by nature, so decoding is a tight loop that reads a
+64 bit word at a time and unpacks a whole block into flat arrays, which the
+kernels working on them can then vectorize over. The header min and max take
+NaN values out, and the last block is encoded as it fills, so it is searchable
+like the rest. at(), between() and during() unpack into one buffer kept by the
+series, so reading samples in order decodes each block once and nothing is
+allocated per call.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MeasurementTraits.h"
+
+//times and values as stored doubles, e.g. seconds and the stored unit of the quantity
+class XorSeries {
+public:
+	struct Header {
+		size_t word;	//first word of the block
+		size_t first;	//index of the block's first sample
+		uint32_t count;
+		uint32_t words;
+		double minTime;
+		double maxTime;
+		double minValue;	//+inf and -inf when every value in the block is NaN
+		double maxValue;
+	};
+	//the most samples a block of 4 KB can hold
+	static const size_t MAX_BLOCK_SAMPLES = 4096 * 8 / 2;
+
+	XorSeries(double tick, size_t blockBytes);
+	void push_back(double t, double v);
+	size_t size() {
+		return count;
+	}
+	size_t blocks() {
+		return headers.size();
+	}
+	Header& header(size_t block) {
+		return headers[block];
+	}
+	//unpacks a block, returns how many samples it had
+	size_t decode(size_t block, double* t, double* v);
+	//unpacks a block into a buffer kept for the next call, which then costs nothing for the same block
+	//the arrays stay valid until the next call, push_back() or clear()
+	size_t decoded(size_t block, const double*& t, const double*& v);
+	//block holding sample i, which must be less than size()
+	size_t blockOf(size_t i);
+	//compressed bytes, headers included
+	size_t bytes() {
+		return words.size() * sizeof(uint64_t) + headers.size() * sizeof(Header);
+	}
+	void clear();
+
+protected:
+	void put(uint64_t bits, unsigned width);
+	double fromTicks(int64_t ticks);
+	bool toTicks(double t, int64_t& ticks);
+
+	double tickSize;
+	double perSecond;
+	size_t blockBits;
+	size_t count;
+	std::vector<Header> headers;
+	std::vector<uint64_t> words;
+	//bits written to the open block
+	size_t bits;
+	//state of the open block, the decoder keeps the same
+	bool onGrid;
+	int64_t lastTick;
+	int64_t lastDelta;
+	uint64_t lastValue;
+	int lastLeading;
+	int lastTrailing;
+	//the block last unpacked by decoded(), NO_BLOCK when there is none
+	static const size_t NO_BLOCK = ~size_t(0);
+	size_t decodedBlock;
+	std::vector<double> decodedTimes;
+	std::vector<double> decodedValues;
+};
+
+template <class T>
+class CompressedSeries {
+public:
+	static const size_t MAX_BLOCK_SAMPLES = XorSeries::MAX_BLOCK_SAMPLES;
+
+	//timestamps are delta coded in whole ticks, blockBytes is clamped to 1 to 4 KB
+	CompressedSeries(TimeDuration tick = TimeDuration(1, UNITS::ms), size_t blockBytes = 2048)
+		: series(storedValue(tick), blockBytes) {}
+	void push_back(TimeDuration t, T v) {
+		series.push_back(storedValue(t), storedValue(v));
+	}
+	size_t size() {
+		return series.size();
+	}
+	size_t blocks() {
+		return series.blocks();
+	}
+	//min and max in stored units: seconds, and the stored unit of T
+	XorSeries::Header& header(size_t block) {
+		return series.header(block);
+	}
+	//t and v need room for MAX_BLOCK_SAMPLES
+	size_t decode(size_t block, TimeDuration* t, T* v) {
+		return series.decode(block, reinterpret_cast<double*>(t), reinterpret_cast<double*>(v));
+	}
+	//sample i, which must be less than size(), decoding only the block it is in and only
+	//when the last call was for another block
+	void at(size_t i, TimeDuration& t, T& v) {
+		size_t block = series.blockOf(i);
+		const double* times;
+		const double* values;
+		series.decoded(block, times, values);
+		i -= series.header(block).first;
+		t = fromStored<TimeDuration>(times[i]);
+		v = fromStored<T>(values[i]);
+	}
+	//appends the samples with low <= value <= high
+	void between(T low, T high, std::vector<TimeDuration>& t, std::vector<T>& v) {
+		double lo = storedValue(low);
+		double hi = storedValue(high);
+		scan(lo, hi, true, t, v);
+	}
+	//appends the samples with from <= time <= to
+	void during(TimeDuration from, TimeDuration to, std::vector<TimeDuration>& t, std::vector<T>& v) {
+		double lo = storedValue(from);
+		double hi = storedValue(to);
+		scan(lo, hi, false, t, v);
+	}
+	size_t bytes() {
+		return series.bytes();
+	}
+	//bytes of plain samples over compressed bytes
+	double ratio() {
+		return series.bytes() ? (double)(series.size() * 2 * sizeof(double)) / series.bytes() : 0;
+	}
+	void clear() {
+		series.clear();
+	}
+
+protected:
+	void scan(double lo, double hi, bool byValue, std::vector<TimeDuration>& t, std::vector<T>& v) {
+		for (size_t b = 0; b < series.blocks(); b++) {
+			XorSeries::Header& h = series.header(b);
+			double min = byValue ? h.minValue : h.minTime;
+			double max = byValue ? h.maxValue : h.maxTime;
+			if (max < lo || min > hi) {
+				continue;
+			}
+			const double* times;
+			const double* values;
+			size_t n = series.decoded(b, times, values);
+			const double* key = byValue ? values : times;
+			for (size_t i = 0; i < n; i++) {
+				if (key[i] >= lo && key[i] <= hi) {
+					t.push_back(fromStored<TimeDuration>(times[i]));
+					v.push_back(fromStored<T>(values[i]));
+				}
+			}
+		}
+	}
+	XorSeries series;
+};
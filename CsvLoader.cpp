@@ -0,0 +1,305 @@
+#include "CsvLoader.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include "Parallel.h"
+#ifdef _WIN32
+#include <cstdio>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//rows parsed between in-place conversions, small enough to still be in cache
+static const size_t BLOCK_ROWS = 4096;
+//files smaller than this are parsed on the calling thread
+static const size_t PARALLEL_BYTES = 1 << 20;
+
+//end of the line starting at p, where its newline is or end
+static const char* lineEnd(const char* p, const char* end) {
+	const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+	return newline ? newline : end;
+}
+
+static bool blankLine(const char* p, const char* end) {
+	for (; p < end; p++) {
+		if (*p != ' ' && *p != '\t' && *p != '\r') {
+			return false;
+		}
+	}
+	return true;
+}
+
+//spellings headers often use that are not UNITS names
+struct UnitAlias {
+	const char* name;
+	msr_unit unit;
+};
+static const UnitAlias UNIT_ALIASES[] = {
+	{ "sec", MSR_s }, { "h", MSR_hr }, { "l", MSR_L }, { "ml", MSR_mL }, { "gal", MSR_gallon }, { "qt", MSR_quart },
+	{ "g", MSR_gram }, { "lbs", MSR_lb }, { "m/s", MSR_m_s }, { "km/h", MSR_kph }, { "ft/s", MSR_ft_s }, { "m/s2", MSR_m_s2 },
+	{ "kg/m3", MSR_kg_m3 }, { "g/cm3", MSR_g_cm3 }, { "degC", MSR_C }, { "degF", MSR_F }, { "ohm", MSR_Ohm }, { "rad/s", MSR_rad_s },
+	{ "N.m", MSR_Nm }, { "ft.lb", MSR_ftlb }
+};
+
+//a UNITS name, or one of the aliases
+static msr_unit headerUnit(const std::string& name) {
+	msr_unit unit = msr_unit_from_name(name.c_str());
+	for (size_t i = 0; unit == MSR_INVALID_UNIT && i < sizeof(UNIT_ALIASES) / sizeof(UNIT_ALIASES[0]); i++) {
+		if (name == UNIT_ALIASES[i].name) {
+			unit = UNIT_ALIASES[i].unit;
+		}
+	}
+	return unit;
+}
+
+static size_t countRows(const char* p, const char* end) {
+	size_t count = 0;
+	while (p < end) {
+		const char* e = lineEnd(p, end);
+		if (!blankLine(p, e)) {
+			count++;
+		}
+		p = e + 1;
+	}
+	return count;
+}
+
+static std::string trim(const char* begin, const char* end) {
+	while (begin < end && (*begin == ' ' || *begin == '\t')) {
+		begin++;
+	}
+	while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+		end--;
+	}
+	return std::string(begin, end);
+}
+
+CsvTable::CsvTable() {
+	rowCount = 0;
+}
+
+size_t CsvTable::rows() {
+	return rowCount;
+}
+
+size_t CsvTable::columns() {
+	return names.size();
+}
+
+int CsvTable::find(const char* name) {
+	for (size_t c = 0; c < names.size(); c++) {
+		if (names[c] == name) {
+			return (int)c;
+		}
+	}
+	return -1;
+}
+
+const std::string& CsvTable::name(size_t column) {
+	return names[column];
+}
+
+msr_unit CsvTable::unit(size_t column) {
+	return units[column];
+}
+
+const double* CsvTable::values(size_t column) {
+	return data[column].data();
+}
+
+const std::string& CsvTable::error() {
+	return message;
+}
+
+bool CsvTable::load(const char* path, unsigned threads) {
+#ifdef _WIN32
+	FILE* file = fopen(path, "rb");
+	if (!file) {
+		message = std::string("cannot open ") + path;
+		return false;
+	}
+	std::vector<char> text;
+	char buffer[65536];
+	size_t got;
+	while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		text.insert(text.end(), buffer, buffer + got);
+	}
+	fclose(file);
+	return parse(text.data(), text.size(), threads);
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		message = std::string("cannot open ") + path;
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		close(fd);
+		message = std::string("cannot read ") + path;
+		return false;
+	}
+	size_t length = (size_t)info.st_size;
+	if (length == 0) {
+		close(fd);
+		return parse("", 0, threads);
+	}
+	void* mapped = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		message = std::string("cannot map ") + path;
+		return false;
+	}
+	madvise(mapped, length, MADV_SEQUENTIAL);
+	bool ok = parse(static_cast<const char*>(mapped), length, threads);
+	munmap(mapped, length);
+	return ok;
+#endif
+}
+
+bool CsvTable::parse(const char* text, size_t length, unsigned threads) {
+	names.clear();
+	units.clear();
+	targets.clear();
+	data.clear();
+	rowCount = 0;
+	message.clear();
+
+	const char* p = text;
+	const char* end = text + length;
+	//UTF-8 byte order mark
+	if (length >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) {
+		p += 3;
+	}
+	if (!readHeader(p, end)) {
+		return false;
+	}
+
+	//one newline-aligned chunk per thread
+	unsigned chunks = threadCount(end - p, PARALLEL_BYTES, threads);
+	std::vector<const char*> bounds(chunks + 1);
+	bounds[0] = p;
+	bounds[chunks] = end;
+	for (unsigned k = 1; k < chunks; k++) {
+		const char* b = p + (end - p) / chunks * k;
+		b = b < bounds[k - 1] ? bounds[k - 1] : b;
+		b = lineEnd(b, end);
+		bounds[k] = b < end ? b + 1 : end;
+	}
+
+	//rows in each chunk, then where each chunk's rows start
+	std::vector<size_t> firstRows(chunks + 1, 0);
+	parallelFor(chunks, chunks, [&](size_t begin, size_t stop) {
+		for (size_t k = begin; k < stop; k++) {
+			firstRows[k + 1] = countRows(bounds[k], bounds[k + 1]);
+		}
+	});
+	for (unsigned k = 0; k < chunks; k++) {
+		firstRows[k + 1] += firstRows[k];
+	}
+	rowCount = firstRows[chunks];
+	for (size_t c = 0; c < data.size(); c++) {
+		data[c].resize(rowCount);
+	}
+
+	parallelFor(chunks, chunks, [&](size_t begin, size_t stop) {
+		for (size_t k = begin; k < stop; k++) {
+			parseChunk(bounds[k], bounds[k + 1], firstRows[k]);
+		}
+	});
+	return true;
+}
+
+//first non-blank line, name[unit] or name per column
+bool CsvTable::readHeader(const char*& p, const char* end) {
+	while (p < end) {
+		const char* e = lineEnd(p, end);
+		if (!blankLine(p, e)) {
+			break;
+		}
+		p = e + 1;
+	}
+	if (p >= end) {
+		message = "no header line";
+		return false;
+	}
+	const char* e = lineEnd(p, end);
+	while (true) {
+		const char* comma = static_cast<const char*>(std::memchr(p, ',', e - p));
+		const char* fieldEnd = comma ? comma : e;
+		std::string field = trim(p, fieldEnd);
+		size_t open = field.find('[');
+		size_t close = field.rfind(']');
+		msr_unit unit = MSR_INVALID_UNIT;
+		if (open != std::string::npos && close != std::string::npos && close > open) {
+			std::string unitName = trim(field.data() + open + 1, field.data() + close);
+			unit = headerUnit(unitName);
+			if (unit == MSR_INVALID_UNIT) {
+				message = "unknown unit '" + unitName + "' in column '" + field + "'";
+				return false;
+			}
+			field = trim(field.data(), field.data() + open);
+		}
+		names.push_back(field);
+		units.push_back(unit);
+		targets.push_back(unit == MSR_INVALID_UNIT ? unit : storedUnit(msr_unit_quantity(unit)));
+		if (!comma) {
+			break;
+		}
+		p = comma + 1;
+	}
+	data.resize(names.size());
+	p = e < end ? e + 1 : end;
+	return true;
+}
+
+void CsvTable::parseChunk(const char* p, const char* end, size_t firstRow) {
+	size_t columnCount = names.size();
+	size_t row = firstRow;
+	size_t blockStart = row;
+	//converts the rows parsed since the last block, in place
+	auto convertBlock = [&]() {
+		for (size_t c = 0; c < columnCount; c++) {
+			if (units[c] != targets[c]) {
+				double* block = data[c].data() + blockStart;
+				msr_convert_f64(block, block, row - blockStart, units[c], targets[c]);
+			}
+		}
+		blockStart = row;
+	};
+
+	while (p < end) {
+		const char* e = lineEnd(p, end);
+		if (!blankLine(p, e)) {
+			const char* cell = p;
+			for (size_t c = 0; c < columnCount; c++) {
+				while (cell < e && (*cell == ' ' || *cell == '\t')) {
+					cell++;
+				}
+				//from_chars takes no leading +
+				if (cell < e && *cell == '+') {
+					cell++;
+				}
+				double val = NAN;
+				std::from_chars_result result = std::from_chars(cell, e, val);
+				if (result.ec == std::errc()) {
+					cell = result.ptr;
+				}
+				else {
+					val = NAN;
+				}
+				data[c][row] = val;
+				const char* comma = static_cast<const char*>(std::memchr(cell, ',', e - cell));
+				cell = comma ? comma + 1 : e;
+			}
+			row++;
+			if (row - blockStart == BLOCK_ROWS) {
+				convertBlock();
+			}
+		}
+		p = e + 1;
+	}
+	convertBlock();
+}
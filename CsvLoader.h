@@ -0,0 +1,86 @@
+#pragma once
+
+/*
+CSV LOADER
+==========
+
+Loads numeric CSV files whose headers name the unit of each column, straight
+into columns of measurements:
+
+pressure[psi],temp[F],flow[gal]
+14.7,68,1200
+...
+
+CsvTable table;
+if (!table.load("daily.csv")) {
+	fprintf(stderr, "%s\n", table.error().c_str());
+}
+const Pressure* pressure = table.column<Pressure>("pressure");
+const Temperature* temp = table.column<Temperature>("temp");
+
+Each unit is looked up once from its header by its UNITS name, which also gives
+the quantity since unit names are unique. A few common spellings that are not
+UNITS names are taken too, such as gal, l, h, lbs, degC, m/s and km/h. Columns
+without a [unit] are loaded as plain numbers and read with values().
+
+The file is memory mapped and cut into one newline-aligned chunk per thread.
+Each thread counts its rows first so every chunk knows where its rows land,
+then parses cells with std::from_chars into blocks of rows and converts each
+block in place with msr_convert_f64 while it is still in cache. Values end up
+in the unit the class keeps them in, so column<T>() hands back the column
+itself without a copy.
+
+Empty or unparsable cells load as NaN, and short rows are padded with NaN.
+Blank lines are skipped and CRLF line ends are fine. Quoted fields are not
+supported, these are numeric files.
+*/
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "MeasurementC.h"
+#include "MeasurementTraits.h"
+#include "Quantities.h"
+
+class CsvTable {
+public:
+	CsvTable();
+	//threads 0 uses every hardware thread
+	bool load(const char* path, unsigned threads = 0);
+	//same as load() for text already in memory, which must stay valid only for the call
+	bool parse(const char* text, size_t length, unsigned threads = 0);
+
+	size_t rows();
+	size_t columns();
+	//column index for a header name (without its [unit]), -1 if there is none
+	int find(const char* name);
+	const std::string& name(size_t column);
+	//unit the file gave, MSR_INVALID_UNIT for plain numbers
+	msr_unit unit(size_t column);
+	//values of a column in the unit its class keeps them in, or as written for plain numbers
+	const double* values(size_t column);
+	//null if there is no such column or it is another quantity
+	template <class T>
+	const T* column(const char* name) {
+		static_assert(sizeof(T) == sizeof(double), "measurements must be a single double");
+		static_assert(QuantityOf<T>::value != MSR_QUANTITY_COUNT, "not a measurement class");
+		int index = find(name);
+		if (index < 0 || msr_unit_quantity(units[index]) != QuantityOf<T>::value) {
+			return 0;
+		}
+		return reinterpret_cast<const T*>(data[index].data());
+	}
+	//why the last load() or parse() failed
+	const std::string& error();
+
+protected:
+	bool readHeader(const char*& p, const char* end);
+	void parseChunk(const char* begin, const char* end, size_t firstRow);
+
+	std::vector<std::string> names;
+	std::vector<msr_unit> units;
+	std::vector<msr_unit> targets;
+	std::vector<std::vector<double> > data;
+	size_t rowCount;
+	std::string message;
+};
@@ -0,0 +1,88 @@
+#include "Downsample.h"
+
+size_t Downsample::lttbIndices(const double* x, const double* y, size_t n, size_t threshold, size_t* out) {
+	if (threshold >= n || threshold < 3) {
+		size_t count = threshold < n ? threshold : n;
+		//too few points asked for to form triangles, spread them evenly
+		for (size_t i = 0; i < count; i++) {
+			out[i] = count > 1 ? i * (n - 1) / (count - 1) : 0;
+		}
+		return count;
+	}
+	//buckets between the first and last point
+	double every = (double)(n - 2) / (threshold - 2);
+	size_t kept = 0;
+	size_t a = 0;
+	out[kept++] = 0;
+	for (size_t i = 0; i < threshold - 2; i++) {
+		size_t nextStart = (size_t)((i + 1) * every) + 1;
+		size_t nextEnd = (size_t)((i + 2) * every) + 1;
+		nextEnd = nextEnd < n ? nextEnd : n;
+		double averageX = 0;
+		double averageY = 0;
+		for (size_t j = nextStart; j < nextEnd; j++) {
+			averageX += x[j];
+			averageY += y[j];
+		}
+		size_t nextCount = nextEnd - nextStart;
+		averageX /= nextCount;
+		averageY /= nextCount;
+
+		size_t start = (size_t)(i * every) + 1;
+		size_t end = (size_t)((i + 1) * every) + 1;
+		double ax = x[a];
+		double ay = y[a];
+		size_t best = start;
+		double bestArea = -1;
+		for (size_t j = start; j < end; j++) {
+			//twice the triangle area, the factor does not change which is largest
+			double area = std::fabs((ax - averageX) * (y[j] - ay) - (ax - x[j]) * (averageY - ay));
+			if (area > bestArea) {
+				bestArea = area;
+				best = j;
+			}
+		}
+		out[kept++] = best;
+		a = best;
+	}
+	out[kept++] = n - 1;
+	return kept;
+}
+
+size_t Downsample::minMaxIndices(const double* x, const double* y, size_t n, size_t buckets, size_t* out) {
+	if (n == 0 || buckets == 0) {
+		return 0;
+	}
+	double first = x[0];
+	double span = x[n - 1] - first;
+	double perBucket = span > 0 ? buckets / span : 0;
+	size_t kept = 0;
+	size_t i = 0;
+	while (i < n) {
+		size_t bucket = (size_t)((x[i] - first) * perBucket);
+		bucket = bucket < buckets ? bucket : buckets - 1;
+		//NaN values are gaps, not extremes
+		size_t low = n;
+		size_t high = n;
+		for (; i < n; i++) {
+			size_t b = (size_t)((x[i] - first) * perBucket);
+			b = b < buckets ? b : buckets - 1;
+			if (b != bucket) {
+				break;
+			}
+			if (y[i] != y[i]) {
+				continue;
+			}
+			low = low == n || y[i] < y[low] ? i : low;
+			high = high == n || y[i] > y[high] ? i : high;
+		}
+		if (low == n) {
+			continue;
+		}
+		out[kept++] = low < high ? low : high;
+		if (low != high) {
+			out[kept++] = low < high ? high : low;
+		}
+	}
+	return kept;
+}
@@ -0,0 +1,336 @@
+#pragma once
+
+/*
+DOWNSAMPLE
+==========
+
+Reduces long (TimeDuration, quantity) series to a few points for plotting, and
+hands back measurements so the renderer still picks the display unit through
+value().
+
+TimeDuration outT[1000];
+Voltage outV[1000];
+size_t kept = Downsample::lttb(t.data(), v.data(), t.size(), 1000, outT, outV);
+size_t kept = Downsample::minMax(t.data(), v.data(), t.size(), 500, outT, outV);	//up to 2 points per pixel
+
+lttb() is largest-triangle-three-buckets: the first and last points are kept
+and each bucket in between keeps the point that makes the largest triangle
+with the point kept before it and the average of the next bucket. It follows
+the shape of the data with exactly the number of points asked for.
+
+minMax() splits the time span into equal buckets, one per pixel column, and
+keeps the lowest and highest point of each in time order, so no spike is ever
+lost.
+
+Both expect times in ascending order, and work on the stored doubles, so there
+is no value() call per point. The overloads taking arrays of SeriesView run
+many series in parallel, one series per task. LttbStream and MinMaxStream do
+the same with buckets of a fixed time width, for data arriving a point at a
+time; they keep at most two buckets of points. A point within rounding of a
+bucket's start is in that bucket, so 300 ms starts the fourth 100 ms bucket.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "MeasurementTraits.h"
+#include "Parallel.h"
+
+namespace Downsample {
+	//indexes of the points lttb keeps, returns how many (threshold, or n if that is smaller)
+	size_t lttbIndices(const double* x, const double* y, size_t n, size_t threshold, size_t* out);
+	//indexes of the min and max of each of buckets equal time spans, in order, returns how many (at most 2 * buckets)
+	size_t minMaxIndices(const double* x, const double* y, size_t n, size_t buckets, size_t* out);
+
+	//stream points within this fraction of a bucket width of a bucket's start count as in it
+	const double EDGE_FRACTION = 1e-9;
+
+	//bucket of a stream point, origin + k * width is rarely exact, so 300 ms would fall below
+	//the 100 ms bucket starting there without the snap
+	inline double bucketIndex(double x, double start, double width) {
+		double position = (x - start) / width;
+		double nearest = std::nearbyint(position);
+		return std::fabs(position - nearest) < EDGE_FRACTION * std::fmax(1, std::fabs(nearest)) ? nearest : std::floor(position);
+	}
+
+	template <class T>
+	const double* storedValues(const T* values) {
+		static_assert(sizeof(T) == sizeof(double) && std::is_standard_layout<T>::value, "measurements must be a single double");
+		return reinterpret_cast<const double*>(values);
+	}
+
+	template <class T>
+	size_t lttb(const TimeDuration* t, const T* v, size_t n, size_t threshold, TimeDuration* outT, T* outV) {
+		std::vector<size_t> keep(threshold < n ? threshold : n);
+		size_t kept = lttbIndices(storedValues(t), storedValues(v), n, threshold, keep.data());
+		for (size_t i = 0; i < kept; i++) {
+			outT[i] = t[keep[i]];
+			outV[i] = v[keep[i]];
+		}
+		return kept;
+	}
+
+	template <class T>
+	size_t minMax(const TimeDuration* t, const T* v, size_t n, size_t buckets, TimeDuration* outT, T* outV) {
+		std::vector<size_t> keep(2 * buckets);
+		size_t kept = minMaxIndices(storedValues(t), storedValues(v), n, buckets, keep.data());
+		for (size_t i = 0; i < kept; i++) {
+			outT[i] = t[keep[i]];
+			outV[i] = v[keep[i]];
+		}
+		return kept;
+	}
+
+	template <class T>
+	struct SeriesView {
+		const TimeDuration* times;
+		const T* values;
+		size_t n;
+	};
+
+	template <class T>
+	struct SeriesPoints {
+		std::vector<TimeDuration> times;
+		std::vector<T> values;
+	};
+
+	//count series at once, threads 0 uses every hardware thread
+	template <class T>
+	void lttb(const SeriesView<T>* series, size_t count, size_t threshold, SeriesPoints<T>* out, unsigned threads = 0) {
+		parallelFor(count, threadCount(count, 2, threads), [&](size_t begin, size_t end) {
+			for (size_t s = begin; s < end; s++) {
+				size_t size = threshold < series[s].n ? threshold : series[s].n;
+				out[s].times.resize(size);
+				out[s].values.resize(size);
+				lttb(series[s].times, series[s].values, series[s].n, threshold, out[s].times.data(), out[s].values.data());
+			}
+		});
+	}
+
+	template <class T>
+	void minMax(const SeriesView<T>* series, size_t count, size_t buckets, SeriesPoints<T>* out, unsigned threads = 0) {
+		parallelFor(count, threadCount(count, 2, threads), [&](size_t begin, size_t end) {
+			for (size_t s = begin; s < end; s++) {
+				out[s].times.resize(2 * buckets);
+				out[s].values.resize(2 * buckets);
+				size_t kept = minMax(series[s].times, series[s].values, series[s].n, buckets, out[s].times.data(), out[s].values.data());
+				out[s].times.resize(kept);
+				out[s].values.resize(kept);
+			}
+		});
+	}
+
+	//min and max of each bucket of a fixed time width, emitted when a point lands in a later bucket
+	template <class T>
+	class MinMaxStream {
+	public:
+		//buckets start at origin and every width after it
+		MinMaxStream(TimeDuration origin, TimeDuration width) {
+			start = storedValue(origin);
+			bucketWidth = storedValue(width);
+			bucket = 0;
+			empty = true;
+		}
+		void push(TimeDuration t, T v) {
+			double x = storedValue(t);
+			double y = storedValue(v);
+			if (std::isnan(y)) {
+				return;
+			}
+			double index = bucketIndex(x, start, bucketWidth);
+			if (!empty && index != bucket) {
+				emit();
+			}
+			if (empty) {
+				bucket = index;
+				lowT = t;
+				lowV = v;
+				highT = t;
+				highV = v;
+				empty = false;
+			}
+			if (y < storedValue(lowV)) {
+				lowT = t;
+				lowV = v;
+			}
+			if (y > storedValue(highV)) {
+				highT = t;
+				highV = v;
+			}
+		}
+		//emits the bucket still open
+		void flush() {
+			if (!empty) {
+				emit();
+			}
+		}
+		std::vector<TimeDuration>& times() {
+			return outT;
+		}
+		std::vector<T>& values() {
+			return outV;
+		}
+		//drops the points emitted so far
+		void clear() {
+			outT.clear();
+			outV.clear();
+		}
+
+	protected:
+		void emit() {
+			bool lowFirst = storedValue(lowT) <= storedValue(highT);
+			outT.push_back(lowFirst ? lowT : highT);
+			outV.push_back(lowFirst ? lowV : highV);
+			if (storedValue(lowT) != storedValue(highT)) {
+				outT.push_back(lowFirst ? highT : lowT);
+				outV.push_back(lowFirst ? highV : lowV);
+			}
+			empty = true;
+		}
+
+		double start;
+		double bucketWidth;
+		double bucket;
+		bool empty;
+		TimeDuration lowT;
+		TimeDuration highT;
+		T lowV;
+		T highV;
+		std::vector<TimeDuration> outT;
+		std::vector<T> outV;
+	};
+
+	//lttb over buckets of a fixed time width, a bucket is decided once a point lands two buckets on
+	template <class T>
+	class LttbStream {
+	public:
+		LttbStream(TimeDuration origin, TimeDuration width) {
+			start = storedValue(origin);
+			bucketWidth = storedValue(width);
+			started = false;
+			currentBucket = 0;
+			nextBucket = 0;
+		}
+		void push(TimeDuration t, T v) {
+			double x = storedValue(t);
+			double y = storedValue(v);
+			if (std::isnan(y)) {
+				return;
+			}
+			//the first point is always kept
+			if (!started) {
+				emit(t, v);
+				started = true;
+				return;
+			}
+			double index = bucketIndex(x, start, bucketWidth);
+			if (currentX.empty() || index == currentBucket) {
+				currentBucket = index;
+				add(currentT, currentX, currentY, currentV, t, x, y, v);
+				return;
+			}
+			if (nextX.empty() || index == nextBucket) {
+				nextBucket = index;
+				add(nextT, nextX, nextY, nextV, t, x, y, v);
+				return;
+			}
+			//the current bucket has both neighbours now
+			decide();
+			currentT.swap(nextT);
+			currentX.swap(nextX);
+			currentY.swap(nextY);
+			currentV.swap(nextV);
+			currentBucket = nextBucket;
+			nextT.clear();
+			nextX.clear();
+			nextY.clear();
+			nextV.clear();
+			nextBucket = index;
+			add(nextT, nextX, nextY, nextV, t, x, y, v);
+		}
+		//decides the buckets still open and keeps the last point
+		void flush() {
+			if (!nextX.empty()) {
+				decide();
+				emit(nextT.back(), nextV.back());
+			}
+			else if (!currentX.empty()) {
+				emit(currentT.back(), currentV.back());
+			}
+			currentT.clear();
+			currentX.clear();
+			currentY.clear();
+			currentV.clear();
+			nextT.clear();
+			nextX.clear();
+			nextY.clear();
+			nextV.clear();
+			started = false;
+		}
+		std::vector<TimeDuration>& times() {
+			return outT;
+		}
+		std::vector<T>& values() {
+			return outV;
+		}
+		void clear() {
+			outT.clear();
+			outV.clear();
+		}
+
+	protected:
+		static void add(std::vector<TimeDuration>& ts, std::vector<double>& xs, std::vector<double>& ys, std::vector<T>& vs,
+			TimeDuration t, double x, double y, T v) {
+			ts.push_back(t);
+			xs.push_back(x);
+			ys.push_back(y);
+			vs.push_back(v);
+		}
+		void emit(TimeDuration t, T v) {
+			outT.push_back(t);
+			outV.push_back(v);
+			lastX = storedValue(t);
+			lastY = storedValue(v);
+		}
+		//keeps the point of the current bucket with the largest triangle
+		void decide() {
+			double averageX = 0;
+			double averageY = 0;
+			for (size_t i = 0; i < nextX.size(); i++) {
+				averageX += nextX[i];
+				averageY += nextY[i];
+			}
+			averageX /= nextX.size();
+			averageY /= nextX.size();
+			size_t best = 0;
+			double bestArea = -1;
+			for (size_t i = 0; i < currentX.size(); i++) {
+				double area = std::fabs((lastX - averageX) * (currentY[i] - lastY) - (lastX - currentX[i]) * (averageY - lastY));
+				if (area > bestArea) {
+					bestArea = area;
+					best = i;
+				}
+			}
+			emit(currentT[best], currentV[best]);
+		}
+
+		double start;
+		double bucketWidth;
+		bool started;
+		double lastX;
+		double lastY;
+		double currentBucket;
+		double nextBucket;
+		std::vector<TimeDuration> currentT;
+		std::vector<double> currentX;
+		std::vector<double> currentY;
+		std::vector<T> currentV;
+		std::vector<TimeDuration> nextT;
+		std::vector<double> nextX;
+		std::vector<double> nextY;
+		std::vector<T> nextV;
+		std::vector<TimeDuration> outT;
+		std::vector<T> outV;
+	};
+}
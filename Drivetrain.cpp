@@ -0,0 +1,126 @@
+#include "Drivetrain.h"
+#include <cmath>
+
+//rad/s in one rpm, 2 pi / 60
+static const double RAD_S_PER_RPM = 1 / factor::revsPerMinute::rad_s.hi;
+//values looked up per pass of electricalPower()
+static const size_t BLOCK = 256;
+
+void Drivetrain::shaftPower(const double* torque, const double* speed, size_t n, double* power) {
+	for (size_t i = 0; i < n; i++) {
+		power[i] = torque[i] * (speed[i] * RAD_S_PER_RPM);
+	}
+}
+
+bool Drivetrain::unwrapCounts(const uint32_t* raw, size_t frames, size_t axes, unsigned bits, int64_t* counts, const int64_t* previous) {
+	//a shift of 64 is undefined, and raw holds no more than 32 bits
+	if (bits == 0 || bits > 32) {
+		return false;
+	}
+	uint64_t mask = (uint64_t(1) << bits) - 1;
+	unsigned shift = 64 - bits;
+	if (!frames) {
+		return true;
+	}
+	for (size_t a = 0; a < axes; a++) {
+		if (previous) {
+			uint64_t delta = ((uint64_t)raw[a] - (uint64_t)previous[a]) & mask;
+			counts[a] = previous[a] + ((int64_t)(delta << shift) >> shift);
+		}
+		else {
+			counts[a] = (int64_t)(raw[a] & mask);
+		}
+	}
+	//steps between frames are taken as the shortest way round the counter
+	for (size_t i = axes; i < frames * axes; i++) {
+		uint64_t delta = ((uint64_t)raw[i] - (uint64_t)raw[i - axes]) & mask;
+		counts[i] = counts[i - axes] + ((int64_t)(delta << shift) >> shift);
+	}
+	return true;
+}
+
+void Drivetrain::encoderAngles(const int64_t* counts, size_t n, double countsPerRevolution, double* radians) {
+	double step = Angle::RADIANS_PER_REVOLUTION / countsPerRevolution;
+	for (size_t i = 0; i < n; i++) {
+		radians[i] = (double)counts[i] * step;
+	}
+}
+
+void Drivetrain::encoderSpeeds(const double* radians, size_t frames, size_t axes, double period, double* speeds, const double* previous) {
+	if (!frames) {
+		return;
+	}
+	double rpmPerStep = 1 / (period * RAD_S_PER_RPM);
+	for (size_t a = 0; a < axes; a++) {
+		speeds[a] = previous ? (radians[a] - previous[a]) * rpmPerStep : 0;
+	}
+	for (size_t i = axes; i < frames * axes; i++) {
+		speeds[i] = (radians[i] - radians[i - axes]) * rpmPerStep;
+	}
+}
+
+EfficiencyMap::EfficiencyMap(RotationSpeed maxSpeed, size_t speeds, Torque maxTorque, size_t torques, const double* efficiency) {
+	speedCount = speeds < 2 ? 2 : speeds;
+	torqueCount = torques < 2 ? 2 : torques;
+	speedsPerRpm = (speedCount - 1) / std::fabs(maxSpeed.value(UNITS::rpm));
+	torquesPerNm = (torqueCount - 1) / std::fabs(maxTorque.value(UNITS::Nm));
+	//an empty table is rejected, every lookup gives NaN
+	valid = speeds > 0 && torques > 0 && efficiency;
+	table.assign(speedCount * torqueCount, NAN);
+	for (size_t s = 0; valid && s < speedCount; s++) {
+		for (size_t t = 0; t < torqueCount; t++) {
+			//a single row or column is stretched over the whole range
+			table[s * torqueCount + t] = efficiency[(s < speeds ? s : speeds - 1) * torques + (t < torques ? t : torques - 1)];
+		}
+	}
+}
+
+//bilinear interpolation, mirrored into every quadrant and clamped at the edges
+void EfficiencyMap::lookup(const double* speed, const double* torque, size_t n, double* out) {
+	const double* e = table.data();
+	double lastSpeed = (double)(speedCount - 1);
+	double lastTorque = (double)(torqueCount - 1);
+	for (size_t i = 0; i < n; i++) {
+		double fs = std::fabs(speed[i]) * speedsPerRpm;
+		double ft = std::fabs(torque[i]) * torquesPerNm;
+		fs = fs < lastSpeed ? fs : lastSpeed;
+		ft = ft < lastTorque ? ft : lastTorque;
+		//the last cell takes the points on the far edges
+		size_t s = (size_t)fs;
+		size_t t = (size_t)ft;
+		s = s < speedCount - 2 ? s : speedCount - 2;
+		t = t < torqueCount - 2 ? t : torqueCount - 2;
+		double ws = fs - s;
+		double wt = ft - t;
+		const double* cell = e + s * torqueCount + t;
+		double low = cell[0] + (cell[1] - cell[0]) * wt;
+		double high = cell[torqueCount] + (cell[torqueCount + 1] - cell[torqueCount]) * wt;
+		out[i] = low + (high - low) * ws;
+	}
+}
+
+double EfficiencyMap::efficiency(RotationSpeed speed, Torque torque) {
+	double out;
+	efficiency(&speed, &torque, 1, &out);
+	return out;
+}
+
+void EfficiencyMap::efficiency(const RotationSpeed* speed, const Torque* torque, size_t n, double* out) {
+	lookup(reinterpret_cast<const double*>(speed), reinterpret_cast<const double*>(torque), n, out);
+}
+
+void EfficiencyMap::electricalPower(const RotationSpeed* speed, const Torque* torque, size_t n, Power* out) {
+	const double* rpm = reinterpret_cast<const double*>(speed);
+	const double* Nm = reinterpret_cast<const double*>(torque);
+	double* W = reinterpret_cast<double*>(out);
+	double eta[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		lookup(rpm + start, Nm + start, count, eta);
+		for (size_t i = 0; i < count; i++) {
+			double shaft = Nm[start + i] * (rpm[start + i] * RAD_S_PER_RPM);
+			double e = eta[i] < MIN_EFFICIENCY ? MIN_EFFICIENCY : eta[i];
+			W[start + i] = shaft >= 0 ? shaft / e : shaft * e;
+		}
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+DRIVETRAIN
+==========
+
+Batch kernels for motor drive telemetry: shaft power, efficiency maps, and
+encoder counts to angles and speeds.
+
+Drivetrain::shaftPower(torque, speed, n, power);
+
+Telemetry of several axes is taken frame by frame, every axis of one sample
+next to each other (counts[frame * axes + axis]). The encoder kernels step a
+whole frame at a time, so each loop runs across the axes and vectorizes however
+many there are:
+
+Drivetrain::unwrapCounts(raw, frames, axes, 16, counts, lastCounts);	//16 bit hardware counters
+Drivetrain::encoderAngles(counts, frames * axes, 4096, angles);	//4096 counts a revolution
+Drivetrain::encoderSpeeds(angles, frames, axes, TimeDuration(50, UNITS::us), speeds, lastAngles);
+
+Speeds are backward differences, (angle[f] - angle[f - 1]) / period. lastCounts
+and lastAngles are the final frame of the previous batch, so a stream can be
+processed in pieces; without them the first frame is taken as it is and its
+speed as zero.
+
+EfficiencyMap interpolates a motor efficiency table over speed and torque, and
+turns shaft power into electrical power:
+
+EfficiencyMap map(RotationSpeed(6000, UNITS::rpm), 61, Torque(300, UNITS::Nm), 31, table);
+map.electricalPower(speed, torque, n, power);
+
+The table is speeds rows of torques efficiencies (0 to 1], for evenly spaced
+speeds from 0 to the max speed and torques from 0 to the max torque. It covers
+one quadrant and is mirrored into the other three, and points past the edges
+take the edge values. Motoring draws shaft power / efficiency, generating
+returns shaft power * efficiency. Efficiencies below MIN_EFFICIENCY are taken as
+that, so a table with zeros at standstill gives zero power there and finite
+power next to it. A map built with zero speeds or torques, or no table, is not
+valid and gives NaN efficiency and power.
+
+All kernels work in rad/s and Nm, with RotationSpeed converted from its stored
+rpm by the exact 2 pi / 60.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "MeasurementTraits.h"
+
+namespace Drivetrain {
+	//stored values: Nm, rpm and W
+	void shaftPower(const double* torque, const double* speed, size_t n, double* power);
+	//extends hardware counters of 1 to 32 bits to 64 bits, previous is the last frame before, or null
+	//false, with counts untouched, for any other bits
+	bool unwrapCounts(const uint32_t* raw, size_t frames, size_t axes, unsigned bits, int64_t* counts, const int64_t* previous = 0);
+	void encoderAngles(const int64_t* counts, size_t n, double countsPerRevolution, double* radians);
+	//angles in radians, speeds in rpm
+	void encoderSpeeds(const double* radians, size_t frames, size_t axes, double period, double* speeds, const double* previous = 0);
+
+	inline void shaftPower(const Torque* torque, const RotationSpeed* speed, size_t n, Power* power) {
+		shaftPower(reinterpret_cast<const double*>(torque), reinterpret_cast<const double*>(speed), n, reinterpret_cast<double*>(power));
+	}
+	inline void encoderAngles(const int64_t* counts, size_t n, double countsPerRevolution, Angle* angles) {
+		encoderAngles(counts, n, countsPerRevolution, reinterpret_cast<double*>(angles));
+	}
+	inline void encoderSpeeds(const Angle* angles, size_t frames, size_t axes, TimeDuration period, RotationSpeed* speeds, const Angle* previous = 0) {
+		encoderSpeeds(reinterpret_cast<const double*>(angles), frames, axes, period.value(UNITS::s), reinterpret_cast<double*>(speeds),
+			reinterpret_cast<const double*>(previous));
+	}
+}
+
+class EfficiencyMap {
+public:
+	EfficiencyMap(RotationSpeed maxSpeed, size_t speeds, Torque maxTorque, size_t torques, const double* efficiency);
+	double efficiency(RotationSpeed speed, Torque torque);
+	void efficiency(const RotationSpeed* speed, const Torque* torque, size_t n, double* out);
+	//electrical power in (motoring) or out (generating, negative)
+	void electricalPower(const RotationSpeed* speed, const Torque* torque, size_t n, Power* out);
+	//false for zero speeds or torques or no table
+	bool ok() {
+		return valid;
+	}
+
+	static constexpr double MIN_EFFICIENCY = 1e-3;
+
+protected:
+	//stored values, rpm and Nm
+	void lookup(const double* speed, const double* torque, size_t n, double* out);
+
+	size_t speedCount;
+	size_t torqueCount;
+	double speedsPerRpm;
+	double torquesPerNm;
+	std::vector<double> table;
+	bool valid;
+};
+
+static_assert(sizeof(RotationSpeed) == sizeof(double) && std::is_standard_layout<RotationSpeed>::value, "RotationSpeed must be a single double");
+static_assert(sizeof(Torque) == sizeof(double) && std::is_standard_layout<Torque>::value, "Torque must be a single double");
+static_assert(sizeof(Power) == sizeof(double) && std::is_standard_layout<Power>::value, "Power must be a single double");
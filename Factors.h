@@ -0,0 +1,282 @@
+#pragma once
+
+/*
+FACTORS
+=======
+
+Exact conversion factors. Every unit is defined as a std::ratio of its SI unit
+from the unit definitions (1 in = 254/10000 m, 1 lb = 45359237/100000000 kg,
+1 lbf = 1 lb * 9.80665 m/s2, ...) in namespace exact, with derived units built
+by std::ratio_multiply and std::ratio_divide so nothing is rounded on the way.
+Units involving pi (rpm, deg_s) carry the power of pi separately.
+
+Each ratio is folded at compile time into a DoubleDouble, an unevaluated sum
+hi + lo that holds about 32 significant digits:
+
+double inches = length_in_m / factor::in.hi;		//hi is the closest double to the exact factor
+DoubleDouble psi = factor::psi;						//the full factor, for extended precision work
+
+Factors for the classes that do not store SI values are in factor::liters
+(Volume), factor::water (Density) and factor::revsPerMinute (RotationSpeed).
+
+DoubleDouble arithmetic uses the usual error-free transformations (two-sum and
+Dekker's two-product), so it only holds up under strict IEEE double evaluation:
+do not build it with -ffast-math.
+*/
+
+#include <cstdint>
+#include <ratio>
+
+//unevaluated sum hi + lo, with lo no bigger than half an ulp of hi
+struct DoubleDouble {
+	double hi;
+	double lo;
+
+	//a + b exactly, for any a and b
+	static constexpr DoubleDouble twoSum(double a, double b) {
+		double s = a + b;
+		double bb = s - a;
+		return DoubleDouble{ s, (a - (s - bb)) + (b - bb) };
+	}
+	//a + b exactly, when |a| >= |b|
+	static constexpr DoubleDouble quickTwoSum(double a, double b) {
+		double s = a + b;
+		return DoubleDouble{ s, b - (s - a) };
+	}
+	//a split into two halves of 26 bits each, so their products are exact
+	static constexpr DoubleDouble split(double a) {
+		double t = 134217729.0 * a;
+		double hi = t - (t - a);
+		return DoubleDouble{ hi, a - hi };
+	}
+	//a * b exactly
+	static constexpr DoubleDouble twoProduct(double a, double b) {
+		double p = a * b;
+		DoubleDouble x = split(a);
+		DoubleDouble y = split(b);
+		return DoubleDouble{ p, ((x.hi * y.hi - p) + x.hi * y.lo + x.lo * y.hi) + x.lo * y.lo };
+	}
+	static constexpr DoubleDouble fromInteger(intmax_t n) {
+		double hi = (double)n;
+		//hi can round up to 2^63, which does not convert back
+		double lo = hi >= 9223372036854775807.0 ? (double)(n - (intmax_t)(hi / 2) - (intmax_t)(hi / 2)) : (double)(n - (intmax_t)hi);
+		return quickTwoSum(hi, lo);
+	}
+};
+
+constexpr DoubleDouble operator+(DoubleDouble a, DoubleDouble b) {
+	DoubleDouble s = DoubleDouble::twoSum(a.hi, b.hi);
+	DoubleDouble t = DoubleDouble::twoSum(a.lo, b.lo);
+	s = DoubleDouble::quickTwoSum(s.hi, s.lo + t.hi);
+	return DoubleDouble::quickTwoSum(s.hi, s.lo + t.lo);
+}
+constexpr DoubleDouble operator-(DoubleDouble a) {
+	return DoubleDouble{ -a.hi, -a.lo };
+}
+constexpr DoubleDouble operator-(DoubleDouble a, DoubleDouble b) {
+	return a + (-b);
+}
+constexpr DoubleDouble operator*(DoubleDouble a, DoubleDouble b) {
+	DoubleDouble p = DoubleDouble::twoProduct(a.hi, b.hi);
+	return DoubleDouble::quickTwoSum(p.hi, p.lo + (a.hi * b.lo + a.lo * b.hi));
+}
+constexpr DoubleDouble operator*(DoubleDouble a, double b) {
+	DoubleDouble p = DoubleDouble::twoProduct(a.hi, b);
+	return DoubleDouble::quickTwoSum(p.hi, p.lo + a.lo * b);
+}
+//long division, one double of quotient at a time
+constexpr DoubleDouble operator/(DoubleDouble a, DoubleDouble b) {
+	double q1 = a.hi / b.hi;
+	DoubleDouble r = a - b * q1;
+	double q2 = r.hi / b.hi;
+	r = r - b * q2;
+	double q3 = r.hi / b.hi;
+	return DoubleDouble::quickTwoSum(q1, q2) + DoubleDouble{ q3, 0 };
+}
+
+//pi to double-double precision
+constexpr DoubleDouble PI_DD = { 3.141592653589793116, 1.2246467991473532072e-16 };
+
+//num / den * pi^piPower
+constexpr DoubleDouble exactFactor(intmax_t num, intmax_t den, int piPower = 0) {
+	DoubleDouble f = DoubleDouble::fromInteger(num) / DoubleDouble::fromInteger(den);
+	for (int i = 0; i < piPower; i++) {
+		f = f * PI_DD;
+	}
+	for (int i = 0; i > piPower; i--) {
+		f = f / PI_DD;
+	}
+	return f;
+}
+template <class Ratio, int PiPower = 0>
+constexpr DoubleDouble exactFactor() {
+	return exactFactor(Ratio::num, Ratio::den, PiPower);
+}
+
+//each unit as an exact ratio of its SI unit
+namespace exact {
+	//s, min, hr, day, week, yr, ms, us, ns
+	typedef std::ratio<60> min;
+	typedef std::ratio<3600> hr;
+	typedef std::ratio<86400> day;
+	typedef std::ratio<604800> week;
+	typedef std::ratio<31557600> yr;		//Julian year of 365.25 days
+
+	//m, cm, mm, um, km, in, ft, yd, mi
+	typedef std::ratio<254, 10000> in;
+	typedef std::ratio_multiply<in, std::ratio<12> > ft;
+	typedef std::ratio_multiply<ft, std::ratio<3> > yd;
+	typedef std::ratio_multiply<ft, std::ratio<5280> > mi;
+
+	//m2, cm2, mm2, um2, km2, in2, ft2, yd2, mi2, acre, hectare
+	typedef std::ratio_multiply<in, in> in2;
+	typedef std::ratio_multiply<ft, ft> ft2;
+	typedef std::ratio_multiply<yd, yd> yd2;
+	typedef std::ratio_multiply<mi, mi> mi2;
+	typedef std::ratio_multiply<ft2, std::ratio<43560> > acre;
+
+	//m3, cm3, mm3, km3, L, mL, in3, ft3, yd3, mi3, tsp, tbsp, cup, pint, quart, gallon, barrel
+	typedef std::milli L;
+	typedef std::ratio_multiply<in2, in> in3;
+	typedef std::ratio_multiply<ft2, ft> ft3;
+	typedef std::ratio_multiply<yd2, yd> yd3;
+	typedef std::ratio_multiply<mi2, mi> mi3;
+	typedef std::ratio_multiply<in3, std::ratio<231> > gallon;
+	typedef std::ratio_divide<gallon, std::ratio<4> > quart;
+	typedef std::ratio_divide<gallon, std::ratio<8> > pint;
+	typedef std::ratio_divide<gallon, std::ratio<16> > cup;
+	typedef std::ratio_divide<gallon, std::ratio<256> > tbsp;
+	typedef std::ratio_divide<gallon, std::ratio<768> > tsp;
+	typedef std::ratio_multiply<gallon, std::ratio<63, 2> > barrel;
+
+	//m_s, kph, mph, ft_s
+	typedef std::ratio<1000, 3600> kph;
+	typedef std::ratio_divide<mi, std::ratio<3600> > mph;
+
+	//m_s2, kph_s, mph_s, ft_s2, G
+	typedef std::ratio<980665, 100000> G;
+
+	//gram, kg, lb, oz, tonne, ton
+	typedef std::ratio<45359237, 100000000> lb;
+	typedef std::ratio_divide<lb, std::ratio<16> > oz;
+	typedef std::ratio_multiply<lb, std::ratio<2000> > ton;
+
+	//N, lbf
+	typedef std::ratio_multiply<lb, G> lbf;
+
+	//Pa, kPa, MPa, psi, mmHg, inH2O, bar, atm
+	typedef std::ratio_divide<lbf, in2> psi;
+	typedef std::ratio<133322387415, 1000000000> mmHg;		//conventional, 13.5951 g/cm3 mercury under standard gravity
+	typedef std::ratio<24908891, 100000> inH2O;				//conventional, 1 g/cm3 water under standard gravity
+	typedef std::ratio<101325> atm;
+
+	//J, kJ, MJ, kWh, hph, BTU, cal, kCal
+	typedef std::ratio_multiply<std::ratio_multiply<ft, lbf>, std::ratio<550> > hp;
+	typedef std::ratio_multiply<hp, std::ratio<3600> > hph;
+	typedef std::ratio<105505585262, 100000000> BTU;		//International Table BTU
+	typedef std::ratio<4184, 1000> cal;						//thermochemical calorie
+
+	//W, kW, MW, mW, hp, BTU_h
+	typedef std::ratio_divide<BTU, std::ratio<3600> > BTU_h;
+
+	//kg_m3, g_cm3, lb_gal
+	typedef std::ratio_divide<lb, gallon> lb_gal;
+
+	//Nm, inlb, ftlb
+	typedef std::ratio_multiply<lbf, in> inlb;
+	typedef std::ratio_multiply<lbf, ft> ftlb;
+}
+
+//closest DoubleDouble to each exact factor, SI value of one of the unit
+namespace factor {
+	constexpr DoubleDouble min = exactFactor<exact::min>();
+	constexpr DoubleDouble hr = exactFactor<exact::hr>();
+	constexpr DoubleDouble day = exactFactor<exact::day>();
+	constexpr DoubleDouble week = exactFactor<exact::week>();
+	constexpr DoubleDouble yr = exactFactor<exact::yr>();
+
+	constexpr DoubleDouble in = exactFactor<exact::in>();
+	constexpr DoubleDouble ft = exactFactor<exact::ft>();
+	constexpr DoubleDouble yd = exactFactor<exact::yd>();
+	constexpr DoubleDouble mi = exactFactor<exact::mi>();
+
+	constexpr DoubleDouble in2 = exactFactor<exact::in2>();
+	constexpr DoubleDouble ft2 = exactFactor<exact::ft2>();
+	constexpr DoubleDouble yd2 = exactFactor<exact::yd2>();
+	constexpr DoubleDouble mi2 = exactFactor<exact::mi2>();
+	constexpr DoubleDouble acre = exactFactor<exact::acre>();
+
+	constexpr DoubleDouble L = exactFactor<exact::L>();
+	constexpr DoubleDouble in3 = exactFactor<exact::in3>();
+	constexpr DoubleDouble ft3 = exactFactor<exact::ft3>();
+	constexpr DoubleDouble yd3 = exactFactor<exact::yd3>();
+	constexpr DoubleDouble mi3 = exactFactor<exact::mi3>();
+	constexpr DoubleDouble tsp = exactFactor<exact::tsp>();
+	constexpr DoubleDouble tbsp = exactFactor<exact::tbsp>();
+	constexpr DoubleDouble cup = exactFactor<exact::cup>();
+	constexpr DoubleDouble pint = exactFactor<exact::pint>();
+	constexpr DoubleDouble quart = exactFactor<exact::quart>();
+	constexpr DoubleDouble gallon = exactFactor<exact::gallon>();
+	constexpr DoubleDouble barrel = exactFactor<exact::barrel>();
+
+	constexpr DoubleDouble kph = exactFactor<exact::kph>();
+	constexpr DoubleDouble mph = exactFactor<exact::mph>();
+
+	constexpr DoubleDouble G = exactFactor<exact::G>();
+
+	constexpr DoubleDouble lb = exactFactor<exact::lb>();
+	constexpr DoubleDouble oz = exactFactor<exact::oz>();
+	constexpr DoubleDouble ton = exactFactor<exact::ton>();
+
+	constexpr DoubleDouble lbf = exactFactor<exact::lbf>();
+
+	constexpr DoubleDouble psi = exactFactor<exact::psi>();
+	constexpr DoubleDouble mmHg = exactFactor<exact::mmHg>();
+	constexpr DoubleDouble inH2O = exactFactor<exact::inH2O>();
+
+	constexpr DoubleDouble hph = exactFactor<exact::hph>();
+	constexpr DoubleDouble BTU = exactFactor<exact::BTU>();
+	constexpr DoubleDouble cal = exactFactor<exact::cal>();
+
+	constexpr DoubleDouble hp = exactFactor<exact::hp>();
+	constexpr DoubleDouble BTU_h = exactFactor<exact::BTU_h>();
+
+	constexpr DoubleDouble lb_gal = exactFactor<exact::lb_gal>();
+
+	//Fahrenheit and Rankine degrees are 5/9 K, and 0 F is 459.67 * 5/9 K
+	constexpr DoubleDouble degreeF = exactFactor<std::ratio<5, 9> >();
+	constexpr DoubleDouble zeroF = exactFactor<std::ratio<45967, 180> >();
+
+	//rad_s per unit of rotation speed
+	constexpr DoubleDouble rpm = exactFactor<std::ratio<1, 30>, 1>();
+	constexpr DoubleDouble rev_s = exactFactor<std::ratio<2>, 1>();
+	constexpr DoubleDouble deg_s = exactFactor<std::ratio<1, 180>, 1>();
+
+	constexpr DoubleDouble inlb = exactFactor<exact::inlb>();
+	constexpr DoubleDouble ftlb = exactFactor<exact::ftlb>();
+
+	//liters per unit, for Volume
+	namespace liters {
+		constexpr DoubleDouble in3 = exactFactor<std::ratio_divide<exact::in3, exact::L> >();
+		constexpr DoubleDouble ft3 = exactFactor<std::ratio_divide<exact::ft3, exact::L> >();
+		constexpr DoubleDouble yd3 = exactFactor<std::ratio_divide<exact::yd3, exact::L> >();
+		constexpr DoubleDouble mi3 = exactFactor<std::ratio_divide<exact::mi3, exact::L> >();
+		constexpr DoubleDouble tsp = exactFactor<std::ratio_divide<exact::tsp, exact::L> >();
+		constexpr DoubleDouble tbsp = exactFactor<std::ratio_divide<exact::tbsp, exact::L> >();
+		constexpr DoubleDouble cup = exactFactor<std::ratio_divide<exact::cup, exact::L> >();
+		constexpr DoubleDouble pint = exactFactor<std::ratio_divide<exact::pint, exact::L> >();
+		constexpr DoubleDouble quart = exactFactor<std::ratio_divide<exact::quart, exact::L> >();
+		constexpr DoubleDouble gallon = exactFactor<std::ratio_divide<exact::gallon, exact::L> >();
+		constexpr DoubleDouble barrel = exactFactor<std::ratio_divide<exact::barrel, exact::L> >();
+	}
+	//g/cm3 per unit, for Density
+	namespace water {
+		constexpr DoubleDouble lb_gal = exactFactor<std::ratio_divide<exact::lb_gal, std::kilo> >();
+	}
+	//rpm per unit, for RotationSpeed
+	namespace revsPerMinute {
+		constexpr DoubleDouble rev_s = exactFactor<std::ratio<60> >();
+		constexpr DoubleDouble rad_s = exactFactor<std::ratio<30>, -1>();
+		constexpr DoubleDouble deg_s = exactFactor<std::ratio<1, 6> >();
+	}
+}
@@ -0,0 +1,692 @@
+#include "Formula.h"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include "Parallel.h"
+#include "Precise.h"
+
+static const int SCALAR = MSR_QUANTITY_COUNT;
+static const int KINDS = MSR_QUANTITY_COUNT + 1;
+//no operator, or a result that is not one of the kinds
+static const int NONE = 0xff;
+//rows per thread below which run() stays on the calling thread
+static const size_t PARALLEL_MINIMUM = 1 << 16;
+
+//the classes in msr_quantity order, then plain numbers
+template <size_t I> struct KindType {
+	typedef typename QuantityClass<I>::type type;
+};
+template <> struct KindType<SCALAR> {
+	typedef double type;
+};
+
+static const char* kindName(int kind) {
+	return kind == SCALAR ? "number" : quantityName((msr_quantity)kind);
+}
+
+template <class T>
+struct KindIndex {
+	static const int value = std::is_same<T, double>::value ? SCALAR : QuantityOf<T>::value == MSR_QUANTITY_COUNT ? NONE : (int)QuantityOf<T>::value;
+};
+
+template <class A, class B, class = void>
+struct SumKind {
+	static const int value = NONE;
+};
+
+template <class A, class B>
+struct SumKind<A, B, std::void_t<decltype(std::declval<A&>() + std::declval<B&>())> > {
+	static const int value = KindIndex<typename std::decay<decltype(std::declval<A&>() + std::declval<B&>())>::type>::value;
+};
+
+template <class A, class B, class = void>
+struct ProductKind {
+	static const int value = NONE;
+};
+
+template <class A, class B>
+struct ProductKind<A, B, std::void_t<typename ProductType<A, B>::type> > {
+	static const int value = KindIndex<typename std::decay<typename ProductType<A, B>::type>::type>::value;
+};
+
+template <class A, class B, class = void>
+struct QuotientKind {
+	static const int value = NONE;
+};
+
+template <class A, class B>
+struct QuotientKind<A, B, std::void_t<typename QuotientType<A, B>::type> > {
+	static const int value = KindIndex<typename std::decay<typename QuotientType<A, B>::type>::type>::value;
+};
+
+//result kinds of + * and / on every pair of kinds, read off the classes
+struct KindTables {
+	unsigned char sum[KINDS][KINDS];
+	unsigned char product[KINDS][KINDS];
+	unsigned char quotient[KINDS][KINDS];
+};
+
+template <size_t A, size_t... B>
+static void fillKindRow(KindTables& tables, std::index_sequence<B...>) {
+	typedef typename KindType<A>::type TA;
+	((tables.sum[A][B] = SumKind<TA, typename KindType<B>::type>::value), ...);
+	((tables.product[A][B] = ProductKind<TA, typename KindType<B>::type>::value), ...);
+	((tables.quotient[A][B] = QuotientKind<TA, typename KindType<B>::type>::value), ...);
+}
+
+template <size_t... A>
+static void fillKindTables(KindTables& tables, std::index_sequence<A...>) {
+	(fillKindRow<A>(tables, std::make_index_sequence<KINDS>()), ...);
+}
+
+static const KindTables& kindTables() {
+	static const KindTables tables = [] {
+		KindTables t;
+		fillKindTables(t, std::make_index_sequence<KINDS>());
+		for (int a = 0; a < KINDS; a++) {
+			for (int b = 0; b < KINDS; b++) {
+				//products defined one way round, and scalars on the left, which the classes leave out
+				if (t.product[a][b] == NONE) {
+					t.product[a][b] = t.product[b][a];
+				}
+			}
+		}
+		return t;
+	}();
+	return tables;
+}
+
+typedef double (*KindFunction)(double val, int unit);
+
+//SI value of val in a unit, by its index in the UNITS enum
+template <class T>
+static double unitToSI(double val, int unit) {
+	return (UnitFactors<T>::scale((typename SIUnit<T>::Units)unit) * val + UnitFactors<T>::offset((typename SIUnit<T>::Units)unit)).hi;
+}
+
+template <size_t... Q>
+static void fillConversions(KindFunction* toSI, double* scales, std::index_sequence<Q...>) {
+	((toSI[Q] = unitToSI<typename KindType<Q>::type>), ...);
+	((scales[Q] = storedScale<typename KindType<Q>::type>()), ...);
+}
+
+struct Conversions {
+	KindFunction toSI[MSR_QUANTITY_COUNT];
+	double stored[MSR_QUANTITY_COUNT];
+};
+
+static const Conversions& conversions() {
+	static const Conversions table = [] {
+		Conversions c;
+		fillConversions(c.toSI, c.stored, std::make_index_sequence<MSR_QUANTITY_COUNT>());
+		return c;
+	}();
+	return table;
+}
+
+static double storedToSI(int kind) {
+	return kind == SCALAR ? 1 : conversions().stored[kind];
+}
+
+namespace {
+	//an operand while compiling, a register or a folded constant
+	struct Value {
+		bool constant;
+		double number;
+		unsigned slot;	//register or column
+		int kind;
+	};
+
+	//recursive descent over one line, emitting code as it goes
+	class Compiler {
+	public:
+		Compiler(std::vector<Formulas::Column>& formulaColumns, std::vector<Formulas::Instruction>& formulaCode, size_t& registerCount)
+			: columns(formulaColumns), code(formulaCode), registers(registerCount) {
+		}
+
+		bool line(const std::string& source, std::string& error) {
+			text = source;
+			position = 0;
+			failed = false;
+			inUse.assign(registers, false);
+			lineStart = code.size();
+			std::string target = identifier();
+			if (target.empty() || !skip('=')) {
+				return fail("expected target = expression", error);
+			}
+			for (size_t c = 0; c < columns.size(); c++) {
+				if (columns[c].name == target) {
+					return fail(target + " is already defined", error);
+				}
+			}
+			Value v = expression();
+			if (!failed && position < text.size()) {
+				fail("unexpected " + text.substr(position, 1));
+			}
+			if (failed) {
+				error = message;
+				return false;
+			}
+			if (v.constant) {
+				v = materialize(v);
+			}
+			double scale = 1 / storedToSI(v.kind);
+			Formulas::Column column;
+			column.name = target;
+			column.quantity = (msr_quantity)v.kind;
+			column.derived = true;
+			column.readOnly = false;
+			column.values = 0;
+			column.scratch = 0;
+			columns.push_back(column);
+			unsigned slot = Formulas::COLUMN | (unsigned)(columns.size() - 1);
+			if (owned(v) && scale == 1 && !code.empty() && code.back().target == v.slot && lineStart < code.size()) {
+				//the last instruction writes the target straight away
+				code.back().target = slot;
+			}
+			else {
+				emit(Formulas::MULTIPLY_CONSTANT, slot, v.slot, 0, scale);
+			}
+			return true;
+		}
+
+	protected:
+		bool fail(const std::string& why, std::string& error) {
+			error = why;
+			return false;
+		}
+		Value fail(const std::string& why) {
+			if (!failed) {
+				message = why;
+				failed = true;
+			}
+			Value v = { true, 0, 0, SCALAR };
+			return v;
+		}
+
+		void spaces() {
+			while (position < text.size() && (text[position] == ' ' || text[position] == '\t' || text[position] == '\r')) {
+				position++;
+			}
+		}
+		bool skip(char c) {
+			spaces();
+			if (position < text.size() && text[position] == c) {
+				position++;
+				return true;
+			}
+			return false;
+		}
+		std::string identifier() {
+			spaces();
+			size_t start = position;
+			while (position < text.size() && (std::isalnum((unsigned char)text[position]) || text[position] == '_')) {
+				if (position == start && std::isdigit((unsigned char)text[position])) {
+					break;
+				}
+				position++;
+			}
+			return text.substr(start, position - start);
+		}
+
+		unsigned allocate() {
+			for (unsigned r = 0; r < inUse.size(); r++) {
+				if (!inUse[r]) {
+					inUse[r] = true;
+					return r;
+				}
+			}
+			inUse.push_back(true);
+			registers = inUse.size() > registers ? inUse.size() : registers;
+			return (unsigned)(inUse.size() - 1);
+		}
+		//registers can be written over, columns are read in place
+		static bool owned(Value v) {
+			return !v.constant && !(v.slot & Formulas::COLUMN);
+		}
+		void release(Value v) {
+			if (owned(v)) {
+				inUse[v.slot] = false;
+			}
+		}
+		//register for the result of an operation on v
+		unsigned result(Value v) {
+			return owned(v) ? v.slot : allocate();
+		}
+		void emit(Formulas::Op op, unsigned target, unsigned a, unsigned b, double constant) {
+			Formulas::Instruction ins = { op, target, a, b, constant };
+			code.push_back(ins);
+		}
+		Value materialize(Value v) {
+			Value r = { false, 0, allocate(), v.kind };
+			emit(Formulas::CONSTANT, r.slot, 0, 0, v.number);
+			return r;
+		}
+
+		//result kind of an operator, checked against the classes
+		//min and max take the rule of +
+		int check(char op, int a, int b) {
+			const KindTables& t = kindTables();
+			int kind = op == '*' ? t.product[a][b] : op == '/' ? t.quotient[a][b] : t.sum[a][b];
+			if (kind == NONE) {
+				std::string what = op == 'm' || op == 'M' ? std::string(op == 'm' ? "min(" : "max(") + kindName(a) + ", " + kindName(b) + ")"
+					: std::string(kindName(a)) + " " + op + " " + kindName(b);
+				fail(what + (op == 'm' || op == 'M' ? " needs one quantity" : " has no operator in Measurement.h"));
+			}
+			return kind == NONE ? SCALAR : kind;
+		}
+
+		Value binary(char op, Value a, Value b) {
+			int kind = check(op, a.kind, b.kind);
+			if (failed) {
+				return a;
+			}
+			if (a.constant && b.constant) {
+				double x = a.number;
+				double y = b.number;
+				double r = op == '+' ? x + y : op == '-' ? x - y : op == '*' ? x * y : op == '/' ? x / y : op == 'm' ? (x < y ? x : y) : (x > y ? x : y);
+				Value v = { true, r, 0, kind };
+				return v;
+			}
+			Value v = { false, 0, 0, kind };
+			if (a.constant || b.constant) {
+				bool left = a.constant;
+				Value reg = left ? b : a;
+				double k = left ? a.number : b.number;
+				Formulas::Op ins;
+				switch (op) {
+				case '+':
+					ins = Formulas::ADD_CONSTANT;
+					break;
+				case '-':
+					ins = left ? Formulas::SUBTRACT_FROM_CONSTANT : Formulas::ADD_CONSTANT;
+					k = left ? k : -k;
+					break;
+				case '*':
+					ins = Formulas::MULTIPLY_CONSTANT;
+					break;
+				case '/':
+					ins = left ? Formulas::DIVIDE_INTO_CONSTANT : Formulas::DIVIDE_CONSTANT;
+					break;
+				case 'm':
+					ins = Formulas::MIN_CONSTANT;
+					break;
+				default:
+					ins = Formulas::MAX_CONSTANT;
+					break;
+				}
+				v.slot = result(reg);
+				emit(ins, v.slot, reg.slot, 0, k);
+				return v;
+			}
+			Formulas::Op ins = op == '+' ? Formulas::ADD : op == '-' ? Formulas::SUBTRACT : op == '*' ? Formulas::MULTIPLY
+				: op == '/' ? Formulas::DIVIDE : op == 'm' ? Formulas::MIN : Formulas::MAX;
+			v.slot = owned(a) ? a.slot : result(b);
+			emit(ins, v.slot, a.slot, b.slot, 0);
+			if (v.slot != b.slot) {
+				release(b);
+			}
+			return v;
+		}
+
+		Value expression() {
+			Value v = term();
+			while (!failed) {
+				if (skip('+')) {
+					v = binary('+', v, term());
+				}
+				else if (skip('-')) {
+					v = binary('-', v, term());
+				}
+				else {
+					break;
+				}
+			}
+			return v;
+		}
+		Value term() {
+			Value v = unary();
+			while (!failed) {
+				if (skip('*')) {
+					v = binary('*', v, unary());
+				}
+				else if (skip('/')) {
+					v = binary('/', v, unary());
+				}
+				else {
+					break;
+				}
+			}
+			return v;
+		}
+		Value unary() {
+			if (skip('-')) {
+				Value v = unary();
+				if (v.constant) {
+					v.number = -v.number;
+				}
+				else if (!failed) {
+					unsigned slot = result(v);
+					emit(Formulas::NEGATE, slot, v.slot, 0, 0);
+					v.slot = slot;
+				}
+				return v;
+			}
+			return primary();
+		}
+		Value primary() {
+			if (failed) {
+				return fail("");
+			}
+			if (skip('(')) {
+				Value v = expression();
+				if (!skip(')')) {
+					return fail("expected )");
+				}
+				return v;
+			}
+			spaces();
+			if (position < text.size() && (std::isdigit((unsigned char)text[position]) || text[position] == '.')) {
+				const char* start = text.c_str() + position;
+				char* end;
+				double number = std::strtod(start, &end);
+				position += end - start;
+				Value v = { true, number, 0, SCALAR };
+				size_t before = position;
+				std::string unit = identifier();
+				if (unit.empty()) {
+					return v;
+				}
+				msr_unit id = msr_unit_from_name(unit.c_str());
+				if (id == MSR_INVALID_UNIT) {
+					position = before;
+					return fail("unknown unit " + unit);
+				}
+				v.kind = MSR_UNIT_QUANTITY(id);
+				v.number = conversions().toSI[v.kind](number, id & 0xff);
+				return v;
+			}
+			std::string name = identifier();
+			if (name.empty()) {
+				return fail(position < text.size() ? "unexpected " + text.substr(position, 1) : "expression ends early");
+			}
+			if (skip('(')) {
+				return call(name);
+			}
+			for (size_t c = 0; c < columns.size(); c++) {
+				if (columns[c].name == name) {
+					Value v = { false, 0, Formulas::COLUMN | (unsigned)c, columns[c].quantity };
+					double scale = storedToSI(v.kind);
+					if (scale != 1) {
+						unsigned slot = allocate();
+						emit(Formulas::MULTIPLY_CONSTANT, slot, v.slot, 0, scale);
+						v.slot = slot;
+					}
+					return v;
+				}
+			}
+			return fail("unknown column " + name);
+		}
+		Value call(const std::string& name) {
+			Value a = expression();
+			if (name == "abs") {
+				if (!skip(')')) {
+					return fail("expected )");
+				}
+				if (a.constant) {
+					a.number = std::fabs(a.number);
+				}
+				else if (!failed) {
+					unsigned slot = result(a);
+					emit(Formulas::ABS, slot, a.slot, 0, 0);
+					a.slot = slot;
+				}
+				return a;
+			}
+			if (name == "min" || name == "max") {
+				if (!skip(',')) {
+					return fail("expected , in " + name);
+				}
+				Value b = expression();
+				if (!skip(')')) {
+					return fail("expected )");
+				}
+				return binary(name == "min" ? 'm' : 'M', a, b);
+			}
+			return fail("unknown function " + name);
+		}
+
+		std::vector<Formulas::Column>& columns;
+		std::vector<Formulas::Instruction>& code;
+		size_t& registers;
+		std::vector<bool> inUse;
+		std::string text;
+		size_t position;
+		size_t lineStart;
+		bool failed;
+		std::string message;
+	};
+}
+
+Formulas::Formulas() {
+	registerCount = 0;
+	scratchCount = 0;
+}
+
+int Formulas::find(const std::string& name) {
+	for (size_t c = 0; c < columns.size(); c++) {
+		if (columns[c].name == name) {
+			return (int)c;
+		}
+	}
+	return -1;
+}
+
+bool Formulas::input(const char* name, msr_quantity quantity) {
+	if (find(name) >= 0 || quantity > MSR_QUANTITY_COUNT) {
+		message = std::string(name) + (find(name) >= 0 ? " is already defined" : " has an unknown quantity");
+		return false;
+	}
+	Column column;
+	column.name = name;
+	column.quantity = quantity;
+	column.derived = false;
+	column.readOnly = true;
+	column.values = 0;
+	column.scratch = 0;
+	columns.push_back(column);
+	return true;
+}
+
+bool Formulas::compile(const char* text) {
+	std::vector<Column> newColumns = columns;
+	std::vector<Instruction> newCode = code;
+	size_t newRegisters = registerCount;
+	Compiler compiler(newColumns, newCode, newRegisters);
+	std::string source = text;
+	size_t start = 0;
+	int number = 0;
+	while (start <= source.size()) {
+		size_t end = source.find_first_of("\n;", start);
+		end = end == std::string::npos ? source.size() : end;
+		std::string line = source.substr(start, end - start);
+		number++;
+		if (line.find_first_not_of(" \t\r") != std::string::npos) {
+			std::string why;
+			if (!compiler.line(line, why)) {
+				message = "line " + std::to_string(number) + ": " + why;
+				return false;
+			}
+		}
+		start = end + 1;
+	}
+	columns.swap(newColumns);
+	code.swap(newCode);
+	registerCount = newRegisters;
+	message.clear();
+	return true;
+}
+
+bool Formulas::quantity(const char* name, msr_quantity& quantity) {
+	int c = find(name);
+	if (c < 0) {
+		return false;
+	}
+	quantity = columns[c].quantity;
+	return true;
+}
+
+bool Formulas::bind(const char* name, double* values) {
+	int c = find(name);
+	if (c < 0) {
+		message = std::string("unknown column ") + name;
+		return false;
+	}
+	columns[c].values = values;
+	columns[c].readOnly = false;
+	return true;
+}
+
+bool Formulas::bind(const char* name, const double* values) {
+	int c = find(name);
+	if (c < 0 || columns[c].derived) {
+		message = std::string(c < 0 ? "unknown column " : "a target needs a writable array: ") + name;
+		return false;
+	}
+	columns[c].values = const_cast<double*>(values);
+	columns[c].readOnly = true;
+	return true;
+}
+
+bool Formulas::bindTyped(const char* name, msr_quantity quantity, double* values, bool readOnly) {
+	int c = find(name);
+	if (c >= 0 && columns[c].quantity != quantity) {
+		message = std::string(name) + " is " + kindName(columns[c].quantity) + ", not " + kindName(quantity);
+		return false;
+	}
+	return readOnly ? bind(name, (const double*)values) : bind(name, values);
+}
+
+//runs the code over one block of count rows, columns holds where each column's rows start
+static void runBlock(const std::vector<Formulas::Instruction>& code, double* const* columns, size_t count, double* registers) {
+	const size_t B = Formulas::BLOCK;
+	for (size_t k = 0; k < code.size(); k++) {
+		const Formulas::Instruction& ins = code[k];
+		double* t = ins.target & Formulas::COLUMN ? columns[ins.target & ~Formulas::COLUMN] : registers + ins.target * B;
+		const double* a = ins.a & Formulas::COLUMN ? columns[ins.a & ~Formulas::COLUMN] : registers + ins.a * B;
+		const double* b = ins.b & Formulas::COLUMN ? columns[ins.b & ~Formulas::COLUMN] : registers + ins.b * B;
+		double c = ins.constant;
+		switch (ins.op) {
+		case Formulas::CONSTANT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = c;
+			}
+			break;
+		case Formulas::ADD:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = a[i] + b[i];
+			}
+			break;
+		case Formulas::SUBTRACT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = a[i] - b[i];
+			}
+			break;
+		case Formulas::MULTIPLY:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = a[i] * b[i];
+			}
+			break;
+		case Formulas::DIVIDE:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = a[i] / b[i];
+			}
+			break;
+		case Formulas::NEGATE:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = -a[i];
+			}
+			break;
+		case Formulas::ABS:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = std::fabs(a[i]);
+			}
+			break;
+		case Formulas::MIN:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = b[i] < a[i] ? b[i] : a[i];
+			}
+			break;
+		case Formulas::MAX:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = b[i] > a[i] ? b[i] : a[i];
+			}
+			break;
+		case Formulas::ADD_CONSTANT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = a[i] + c;
+			}
+			break;
+		case Formulas::SUBTRACT_FROM_CONSTANT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = c - a[i];
+			}
+			break;
+		case Formulas::MULTIPLY_CONSTANT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = a[i] * c;
+			}
+			break;
+		case Formulas::DIVIDE_CONSTANT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = a[i] / c;
+			}
+			break;
+		case Formulas::DIVIDE_INTO_CONSTANT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = c / a[i];
+			}
+			break;
+		case Formulas::MIN_CONSTANT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = c < a[i] ? c : a[i];
+			}
+			break;
+		case Formulas::MAX_CONSTANT:
+			for (size_t i = 0; i < count; i++) {
+				t[i] = c > a[i] ? c : a[i];
+			}
+			break;
+		}
+	}
+}
+
+bool Formulas::run(size_t rows, unsigned threads) {
+	scratchCount = 0;
+	for (size_t c = 0; c < columns.size(); c++) {
+		if (!columns[c].values && !columns[c].derived) {
+			message = "no array bound for " + columns[c].name;
+			return false;
+		}
+		if (!columns[c].values) {
+			columns[c].scratch = scratchCount++;
+		}
+	}
+	size_t blocks = (rows + BLOCK - 1) / BLOCK;
+	parallelFor(blocks, threadCount(rows, PARALLEL_MINIMUM, threads), [&](size_t begin, size_t end) {
+		std::vector<double> registers((registerCount ? registerCount : 1) * BLOCK);
+		std::vector<double> scratch((scratchCount ? scratchCount : 1) * BLOCK);
+		std::vector<double*> starts(columns.size());
+		for (size_t block = begin; block < end; block++) {
+			size_t start = block * BLOCK;
+			size_t count = rows - start < BLOCK ? rows - start : BLOCK;
+			for (size_t c = 0; c < columns.size(); c++) {
+				starts[c] = columns[c].values ? columns[c].values + start : scratch.data() + columns[c].scratch * BLOCK;
+			}
+			runBlock(code, starts.data(), count, registers.data());
+		}
+	});
+	return true;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+/*
+FORMULA
+=======
+
+Derived signals configured as text, compiled once and then run over whole
+columns.
+
+Formulas formulas;
+formulas.input<Voltage>("voltage");
+formulas.input<Current>("current");
+formulas.input<Force>("force");
+formulas.input<Area>("area");
+if (!formulas.compile("power = voltage * current\n"
+		"pressure = force / area + 1 atm\n"
+		"headroom = 1.5 kW - power")) {
+	log(formulas.error());	//e.g. "line 2: Force * Area has no operator in Measurement.h"
+}
+formulas.bind("voltage", volts);	//const Voltage*, in the stored unit
+formulas.bind("current", amps);
+formulas.bind("power", watts);		//Power*, outputs are written
+formulas.run(rows);
+
+Every name is a column of one quantity, and each line adds its target as a new
+column that later lines can use. Expressions take + - * /, parentheses, unary
+minus, abs(x), min(a, b) and max(a, b). Numbers are plain scalars unless a unit
+name follows, as in 1 atm or 1.5 kW.
+
+Dimensions are checked when compiling, with the rules of the operators in
+Measurement.h, read off the classes the same way MeasurementC.cpp builds its
+product tables: a product or quotient is allowed when the classes define it,
+and gives the quantity they return. + - min and max need the same quantity on
+both sides. Scalars multiply and divide anything, and one quantity over itself
+is a plain number, as the classes have it. Lines that do not check come back
+false with a message, so a bad configuration fails before any data is touched.
+
+The formulas compile to a bytecode over a small set of registers, each a block
+of BLOCK rows held in SI units. run() steps through the rows a block at a time
+and runs every instruction over the whole block, so the interpreter costs one
+dispatch per instruction per block and each instruction is a plain loop the
+compiler vectorizes. Constant subexpressions are folded while compiling, and
+constants go into instructions rather than registers. Instructions read
+columns in place and the last instruction of a line writes its target directly,
+except for the few quantities whose stored unit is not SI (Volume, Density,
+RotationSpeed), which are scaled through a register. Targets that are not bound
+to an array stay in a scratch block, for the lines that use them. Large frames
+are split between threads.
+*/
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "MeasurementC.h"
+#include "MeasurementTraits.h"
+#include "Quantities.h"
+
+class Formulas {
+public:
+	//rows in a register
+	static const size_t BLOCK = 256;
+
+	Formulas();
+	//declares an input column, false if the name is taken
+	bool input(const char* name, msr_quantity quantity);
+	template <class T>
+	bool input(const char* name) {
+		static_assert(QuantityOf<T>::value != MSR_QUANTITY_COUNT || std::is_same<T, double>::value, "not a measurement class");
+		return input(name, QuantityOf<T>::value);
+	}
+	//compiles "target = expression" lines, separated by newlines or ;
+	//nothing is added when any line fails
+	bool compile(const char* text);
+	const char* error() {
+		return message.c_str();
+	}
+	//false for unknown names
+	bool quantity(const char* name, msr_quantity& quantity);
+	//values of a column in its stored unit, read for inputs and written for targets
+	bool bind(const char* name, double* values);
+	bool bind(const char* name, const double* values);
+	template <class T>
+	bool bind(const char* name, T* values) {
+		static_assert(QuantityOf<T>::value != MSR_QUANTITY_COUNT || std::is_same<T, double>::value, "not a measurement class");
+		return bindTyped(name, QuantityOf<T>::value, reinterpret_cast<double*>(values), false);
+	}
+	template <class T>
+	bool bind(const char* name, const T* values) {
+		static_assert(QuantityOf<T>::value != MSR_QUANTITY_COUNT || std::is_same<T, double>::value, "not a measurement class");
+		return bindTyped(name, QuantityOf<T>::value, const_cast<double*>(reinterpret_cast<const double*>(values)), true);
+	}
+	//evaluates every formula over rows rows, threads 0 uses every hardware thread
+	//false if an input has no array bound
+	bool run(size_t rows, unsigned threads = 0);
+	size_t instructions() {
+		return code.size();
+	}
+	size_t registers() {
+		return registerCount;
+	}
+
+	enum Op { CONSTANT, ADD, SUBTRACT, MULTIPLY, DIVIDE, NEGATE, ABS, MIN, MAX,
+		ADD_CONSTANT, SUBTRACT_FROM_CONSTANT, MULTIPLY_CONSTANT, DIVIDE_CONSTANT, DIVIDE_INTO_CONSTANT, MIN_CONSTANT, MAX_CONSTANT };
+	//operands are registers, or columns with the COLUMN bit set
+	static const unsigned COLUMN = 0x80000000u;
+	struct Instruction {
+		Op op;
+		unsigned target;
+		unsigned a;
+		unsigned b;
+		double constant;	//in SI units
+	};
+	struct Column {
+		std::string name;
+		msr_quantity quantity;
+		bool derived;
+		bool readOnly;
+		double* values;
+		size_t scratch;		//scratch block of unbound targets, or SIZE_MAX
+	};
+
+protected:
+	bool bindTyped(const char* name, msr_quantity quantity, double* values, bool readOnly);
+	int find(const std::string& name);
+
+	std::vector<Column> columns;
+	std::vector<Instruction> code;
+	size_t registerCount;
+	size_t scratchCount;
+	std::string message;
+};
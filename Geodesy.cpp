@@ -0,0 +1,139 @@
+#include "Geodesy.h"
+#include <cmath>
+
+//fixes per pass through the AngleBatch kernels
+static const size_t BLOCK = 256;
+//the largest bearing below a whole turn, for those that round up to 2 pi
+static const double LAST_BEARING = std::nextafter(Angle::RADIANS_PER_REVOLUTION, 0.0);
+
+void Geodesy::haversine(const double* lat1, const double* lon1, const double* lat2, const double* lon2, size_t n, double* meters,
+	double radius) {
+	double halfLat[BLOCK];
+	double halfLon[BLOCK];
+	double cos1[BLOCK];
+	double cos2[BLOCK];
+	double y[BLOCK];
+	double x[BLOCK];
+	for (size_t start = 0; start < n; start += BLOCK) {
+		size_t count = n - start < BLOCK ? n - start : BLOCK;
+		for (size_t i = 0; i < count; i++) {
+			halfLat[i] = (lat2[start + i] - lat1[start + i]) * 0.5;
+			halfLon[i] = (lon2[start + i] - lon1[start + i]) * 0.5;
+		}
+		AngleBatch::sin(halfLat, count, halfLat);
+		AngleBatch::sin(halfLon, count, halfLon);
+		AngleBatch::cos(lat1 + start, count, cos1);
+		AngleBatch::cos(lat2 + start, count, cos2);
+		for (size_t i = 0; i < count; i++) {
+			double a = halfLat[i] * halfLat[i] + cos1[i] * cos2[i] * halfLon[i] * halfLon[i];
+			a = a < 1 ? a : 1;
+			y[i] = std::sqrt(a);
+			x[i] = std::sqrt(1 - a);
+		}
+		//2 atan2(sqrt(a), sqrt(1 - a)) keeps its accuracy at both ends, unlike asin
+		AngleBatch::atan2(y, x, count, meters + start);
+		for (size_t i = 0; i < count; i++) {
+			meters[start + i] *= 2 * radius;
+		}
+	}
+}
+
+//inverse problem on the WGS84 ellipsoid
+static double vincentyDistance(double lat1, double lon1, double lat2, double lon2, int maxIterations) {
+	const double a = Geodesy::WGS84_A;
+	const double f = Geodesy::WGS84_F;
+	const double b = a * (1 - f);
+	double L = lon2 - lon1;
+	double U1 = std::atan((1 - f) * std::tan(lat1));
+	double U2 = std::atan((1 - f) * std::tan(lat2));
+	double sinU1 = std::sin(U1);
+	double cosU1 = std::cos(U1);
+	double sinU2 = std::sin(U2);
+	double cosU2 = std::cos(U2);
+	double lambda = L;
+	double sinSigma = 0;
+	double cosSigma = 1;
+	double sigma = 0;
+	double cosSqAlpha = 1;
+	double cos2SigmaM = 0;
+	for (int i = 0; i < maxIterations; i++) {
+		double sinLambda = std::sin(lambda);
+		double cosLambda = std::cos(lambda);
+		double p = cosU2 * sinLambda;
+		double q = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+		sinSigma = std::sqrt(p * p + q * q);
+		if (sinSigma == 0) {
+			//the same point
+			return 0;
+		}
+		cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+		sigma = std::atan2(sinSigma, cosSigma);
+		double sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+		cosSqAlpha = 1 - sinAlpha * sinAlpha;
+		//on the equator cos2SigmaM is undefined, and its term drops out
+		cos2SigmaM = cosSqAlpha != 0 ? cosSigma - 2 * sinU1 * sinU2 / cosSqAlpha : 0;
+		double C = f / 16 * cosSqAlpha * (4 + f * (4 - 3 * cosSqAlpha));
+		double previous = lambda;
+		lambda = L + (1 - C) * f * sinAlpha * (sigma + C * sinSigma * (cos2SigmaM + C * cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+		if (std::fabs(lambda - previous) < 1e-12) {
+			break;
+		}
+	}
+	double uSq = cosSqAlpha * (a * a - b * b) / (b * b);
+	double A = 1 + uSq / 16384 * (4096 + uSq * (-768 + uSq * (320 - 175 * uSq)));
+	double B = uSq / 1024 * (256 + uSq * (-128 + uSq * (74 - 47 * uSq)));
+	double deltaSigma = B * sinSigma * (cos2SigmaM + B / 4 * (cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)
+		- B / 6 * cos2SigmaM * (-3 + 4 * sinSigma * sinSigma) * (-3 + 4 * cos2SigmaM * cos2SigmaM)));
+	return b * A * (sigma - deltaSigma);
+}
+
+void Geodesy::vincenty(const double* lat1, const double* lon1, const double* lat2, const double* lon2, size_t n, double* meters,
+	int maxIterations) {
+	for (size_t i = 0; i < n; i++) {
+		meters[i] = vincentyDistance(lat1[i], lon1[i], lat2[i], lon2[i], maxIterations);
+	}
+}
+
+void Geodesy::bearings(const double* lat, const double* lon, size_t n, double* radians) {
+	if (n < 2) {
+		return;
+	}
+	double sinLat[BLOCK + 1];
+	double cosLat[BLOCK + 1];
+	double dLon[BLOCK];
+	double sinDLon[BLOCK];
+	double cosDLon[BLOCK];
+	double y[BLOCK];
+	double x[BLOCK];
+	size_t legCount = n - 1;
+	for (size_t start = 0; start < legCount; start += BLOCK) {
+		size_t count = legCount - start < BLOCK ? legCount - start : BLOCK;
+		//count legs need count + 1 fixes
+		AngleBatch::sincos(lat + start, count + 1, sinLat, cosLat);
+		for (size_t i = 0; i < count; i++) {
+			dLon[i] = lon[start + i + 1] - lon[start + i];
+		}
+		AngleBatch::sincos(dLon, count, sinDLon, cosDLon);
+		for (size_t i = 0; i < count; i++) {
+			y[i] = sinDLon[i] * cosLat[i + 1];
+			x[i] = cosLat[i] * sinLat[i + 1] - sinLat[i] * cosLat[i + 1] * cosDLon[i];
+		}
+		double* out = radians + start;
+		AngleBatch::atan2(y, x, count, out);
+		//into [0, 2 pi), a bearing a hair west of north rounds to 2 pi when the turn is added, and -0 is 0
+		for (size_t i = 0; i < count; i++) {
+			double b = out[i] < 0 ? out[i] + Angle::RADIANS_PER_REVOLUTION : std::fabs(out[i]);
+			out[i] = b >= Angle::RADIANS_PER_REVOLUTION ? LAST_BEARING : b;
+		}
+	}
+}
+
+void Geodesy::legs(const double* lat, const double* lon, const double* times, size_t n, double* meters, double* metersPerSecond) {
+	if (n < 2) {
+		return;
+	}
+	haversine(lat, lon, lat + 1, lon + 1, n - 1, meters);
+	for (size_t i = 0; i + 1 < n; i++) {
+		metersPerSecond[i] = meters[i] / (times[i + 1] - times[i]);
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+/*
+GEODESY
+=======
+
+Distances, bearings and speeds between GPS fixes, over whole arrays of them.
+Latitudes and longitudes come in as Angle arrays, results go out as Length,
+Angle and Speed arrays.
+
+Geodesy::haversine(lat1, lon1, lat2, lon2, n, distances);	//sphere of mean radius
+Geodesy::vincenty(lat1, lon1, lat2, lon2, n, distances);	//WGS84 ellipsoid
+
+Geodesy::bearings(lat, lon, n, headings);			//n - 1 initial bearings, fix i to fix i + 1
+Geodesy::legs(lat, lon, times, n, distances, speeds);	//n - 1 legs, speed = Length / TimeDuration
+
+haversine() runs blocks of fixes through the AngleBatch kernels, so the trig
+vectorizes the same way, and is within 0.6% of the ellipsoid distance.
+vincenty() is the iterative inverse solution, within a millimeter or so. It
+stops after maxIterations (20 by default), which only matters for nearly
+antipodal points, where it keeps the last iterate rather than diverge.
+
+Bearings are clockwise from north in [0, 2 pi). Speeds between fixes with the
+same time are infinite or NaN, as a division by zero would give.
+*/
+
+#include <cstddef>
+#include <type_traits>
+#include "MeasurementTraits.h"
+
+namespace Geodesy {
+	//mean Earth radius (IUGG), in m
+	const double EARTH_RADIUS = 6371008.8;
+	//WGS84 semi-major axis in m, and flattening
+	const double WGS84_A = 6378137.0;
+	const double WGS84_F = 1 / 298.257223563;
+
+	//radians in, meters out
+	void haversine(const double* lat1, const double* lon1, const double* lat2, const double* lon2, size_t n, double* meters,
+		double radius = EARTH_RADIUS);
+	void vincenty(const double* lat1, const double* lon1, const double* lat2, const double* lon2, size_t n, double* meters,
+		int maxIterations = 20);
+	void bearings(const double* lat, const double* lon, size_t n, double* radians);
+	//distances and speeds of the n - 1 legs, times in s
+	void legs(const double* lat, const double* lon, const double* times, size_t n, double* meters, double* metersPerSecond);
+
+	inline const double* radians(const Angle* angles) {
+		return reinterpret_cast<const double*>(angles);
+	}
+
+	inline void haversine(const Angle* lat1, const Angle* lon1, const Angle* lat2, const Angle* lon2, size_t n, Length* out,
+		Length radius = Length(EARTH_RADIUS, UNITS::m)) {
+		static_assert(sizeof(Length) == sizeof(double) && std::is_standard_layout<Length>::value, "Length must be a single double");
+		haversine(radians(lat1), radians(lon1), radians(lat2), radians(lon2), n, reinterpret_cast<double*>(out), radius.value(UNITS::m));
+	}
+	inline void vincenty(const Angle* lat1, const Angle* lon1, const Angle* lat2, const Angle* lon2, size_t n, Length* out,
+		int maxIterations = 20) {
+		vincenty(radians(lat1), radians(lon1), radians(lat2), radians(lon2), n, reinterpret_cast<double*>(out), maxIterations);
+	}
+	inline void bearings(const Angle* lat, const Angle* lon, size_t n, Angle* out) {
+		bearings(radians(lat), radians(lon), n, reinterpret_cast<double*>(out));
+	}
+	inline void legs(const Angle* lat, const Angle* lon, const TimeDuration* times, size_t n, Length* distances, Speed* speeds) {
+		static_assert(sizeof(TimeDuration) == sizeof(double) && std::is_standard_layout<TimeDuration>::value, "TimeDuration must be a single double");
+		static_assert(sizeof(Speed) == sizeof(double) && std::is_standard_layout<Speed>::value, "Speed must be a single double");
+		legs(radians(lat), radians(lon), reinterpret_cast<const double*>(times), n, reinterpret_cast<double*>(distances),
+			reinterpret_cast<double*>(speeds));
+	}
+}
@@ -0,0 +1,166 @@
+#include "Histogram.h"
+#include "Parallel.h"
+
+//samples whose slots are worked out together before counting
+static const size_t BLOCK = 256;
+//within this fraction of a bin width of an edge, uniform bins check the edge itself
+static const double EDGE_FRACTION = 1e-9;
+//below this many samples everything stays on the calling thread
+static const size_t PARALLEL_MINIMUM = 1 << 16;
+
+HistogramAxis::HistogramAxis() {
+	edgeList.assign(2, 0.0);
+	isUniform = true;
+	low = 0;
+	high = 0;
+	inverseWidth = 0;
+}
+
+HistogramAxis HistogramAxis::uniform(double low, double high, size_t bins) {
+	HistogramAxis axis;
+	bins = bins ? bins : 1;
+	axis.edgeList.resize(bins + 1);
+	for (size_t i = 0; i <= bins; i++) {
+		axis.edgeList[i] = low + (high - low) * i / bins;
+	}
+	axis.isUniform = true;
+	axis.low = low;
+	axis.high = high;
+	axis.inverseWidth = bins / (high - low);
+	return axis;
+}
+
+HistogramAxis HistogramAxis::edges(const double* edges, size_t count) {
+	HistogramAxis axis;
+	if (count >= 2) {
+		axis.edgeList.assign(edges, edges + count);
+	}
+	axis.isUniform = false;
+	axis.low = axis.edgeList.front();
+	axis.high = axis.edgeList.back();
+	axis.inverseWidth = 0;
+	return axis;
+}
+
+HistogramAxis HistogramAxis::converted(const double* edges) const {
+	HistogramAxis axis = *this;
+	axis.edgeList.assign(edges, edges + edgeList.size());
+	axis.low = axis.edgeList.front();
+	axis.high = axis.edgeList.back();
+	axis.inverseWidth = isUniform ? bins() / (axis.high - axis.low) : 0;
+	return axis;
+}
+
+void HistogramAxis::slots(const double* values, size_t n, uint32_t* out) const {
+	uint32_t binCount = (uint32_t)bins();
+	const double* edges = edgeList.data();
+	if (isUniform) {
+		//only max and min, which compile to maxpd and minpd, so this loop vectorizes; NaN fails the first compare
+		//and lands in slot 0 like anything below, and the pass after this one sends it to its own slot
+		double top = (double)binCount;
+		for (size_t i = 0; i < n; i++) {
+			double position = (values[i] - low) * inverseWidth;
+			double clamped = position > -1 ? position : -1;
+			clamped = clamped < top ? clamped : top;
+			out[i] = (uint32_t)(int32_t)(clamped + 1);
+		}
+		//right at an edge the multiply can round into the neighbouring bin, so there the edges decide,
+		//and NaN and the last edge itself are put right in the same pass
+		int fixUp = 0;
+		for (size_t i = 0; i < n; i++) {
+			double x = values[i];
+			double fraction = (x - low) * inverseWidth - (double)((int32_t)out[i] - 1);
+			//bitwise, not logical, operators keep this loop branch free
+			fixUp |= (int)(out[i] - 1 < binCount) & ((int)(fraction < EDGE_FRACTION) | (int)(fraction > 1 - EDGE_FRACTION));
+			fixUp |= (int)(x != x) | (int)(x == high);
+		}
+		if (fixUp) {
+			for (size_t i = 0; i < n; i++) {
+				double x = values[i];
+				uint32_t slot = out[i];
+				if (x != x) {
+					slot = binCount + 2;
+				} else if (x == high) {
+					slot = binCount;
+				} else if (slot - 1 < binCount) {
+					slot -= x < edges[slot - 1] ? 1 : 0;
+					slot += slot < binCount && x >= edges[slot] ? 1 : 0;
+				}
+				out[i] = slot;
+			}
+		}
+		return;
+	}
+	size_t count = edgeList.size();
+	for (size_t i = 0; i < n; i++) {
+		double x = values[i];
+		//number of edges at or below x, the halving compiles to conditional moves
+		const double* base = edges;
+		size_t length = count;
+		while (length > 1) {
+			size_t half = length / 2;
+			base = base[half] <= x ? base + half : base;
+			length -= half;
+		}
+		uint32_t slot = (uint32_t)(base - edges) + (*base <= x ? 1 : 0);
+		slot = x == high ? binCount : slot;
+		out[i] = x != x ? binCount + 2 : slot;
+	}
+}
+
+void histogramCounts(const HistogramAxis& axis, const double* values, size_t n, uint64_t* counts, unsigned threads) {
+	size_t slotCount = axis.slots();
+	unsigned chunks = threadCount(n, PARALLEL_MINIMUM, threads);
+	size_t chunk = (n + chunks - 1) / chunks;
+	std::vector<std::vector<uint64_t> > partials(chunks);
+	parallelFor(n, chunks, [&](size_t begin, size_t end) {
+		//four interleaved copies, so runs of one bin do not wait on the same counter
+		std::vector<uint64_t> local(slotCount * 4, 0);
+		uint32_t slot[BLOCK];
+		for (size_t i = begin; i < end; i += BLOCK) {
+			size_t count = end - i < BLOCK ? end - i : BLOCK;
+			axis.slots(values + i, count, slot);
+			for (size_t j = 0; j < count; j++) {
+				local[(j & 3) * slotCount + slot[j]]++;
+			}
+		}
+		std::vector<uint64_t>& partial = partials[begin / chunk];
+		partial.assign(slotCount, 0);
+		for (size_t s = 0; s < slotCount; s++) {
+			partial[s] = local[s] + local[slotCount + s] + local[2 * slotCount + s] + local[3 * slotCount + s];
+		}
+	});
+	for (size_t t = 0; t < partials.size(); t++) {
+		for (size_t s = 0; s < partials[t].size(); s++) {
+			counts[s] += partials[t][s];
+		}
+	}
+}
+
+void histogramCounts2D(const HistogramAxis& xAxis, const double* x, const HistogramAxis& yAxis, const double* y, size_t n,
+	uint64_t* counts, unsigned threads) {
+	size_t ySlots = yAxis.slots();
+	size_t slotCount = xAxis.slots() * ySlots;
+	unsigned chunks = threadCount(n, PARALLEL_MINIMUM, threads);
+	size_t chunk = (n + chunks - 1) / chunks;
+	std::vector<std::vector<uint64_t> > partials(chunks);
+	parallelFor(n, chunks, [&](size_t begin, size_t end) {
+		std::vector<uint64_t>& local = partials[begin / chunk];
+		local.assign(slotCount, 0);
+		uint32_t xSlot[BLOCK];
+		uint32_t ySlot[BLOCK];
+		for (size_t i = begin; i < end; i += BLOCK) {
+			size_t count = end - i < BLOCK ? end - i : BLOCK;
+			xAxis.slots(x + i, count, xSlot);
+			yAxis.slots(y + i, count, ySlot);
+			for (size_t j = 0; j < count; j++) {
+				local[xSlot[j] * ySlots + ySlot[j]]++;
+			}
+		}
+	});
+	for (size_t t = 0; t < partials.size(); t++) {
+		for (size_t s = 0; s < partials[t].size(); s++) {
+			counts[s] += partials[t][s];
+		}
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+/*
+HISTOGRAM
+=========
+
+Histograms of measurement arrays with bin edges given in any unit.
+
+Histogram<Speed> speeds(0, 100, 20, UNITS::mph);				//20 uniform bins from 0 to 100 mph
+speeds.add(samples.data(), samples.size());
+uint64_t inBin3 = speeds.count(3);
+double from = speeds.edge(3).value(UNITS::kph);
+
+double edges[] = { 32, 50, 68, 86, 104 };
+Histogram<Temperature> temps(edges, 5, UNITS::F);				//4 bins between uneven edges
+
+//x uniform in kPa, y between the uneven edges above in F
+Histogram2D<Pressure, Temperature> map(HistogramAxis::uniform(90, 110, 40), UNITS::kPa, HistogramAxis::edges(edges, 5), UNITS::F);
+map.add(pressures.data(), temperatures.data(), pressures.size());
+
+Edges are converted once, up front, into the unit each class keeps its value in,
+each through the class's own constructor, so a sample made as T(edge, units) is
+exactly on its edge and -40 F is not below a histogram starting at -40 F.
+Samples are then binned straight from the arrays without any conversion.
+Uniform bins take one multiply per sample to find the bin, computed a block at
+a time so the compiler vectorizes it; the rare block with a sample within
+rounding of an edge is checked against the edges, so 15 mph always lands in the
+bin that starts at 15 mph. Uneven bins use a branch-free binary search over the
+edges. Every thread bins its share of the samples into its own partial counts,
+and the partials are added up at the end; merge() does the same for histograms
+filled separately, which must have the same edges.
+
+Each axis keeps three counters beside its bins: below the first edge, above the
+last edge, and NaN. A value equal to the last edge goes in the last bin.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MeasurementTraits.h"
+
+//bin edges as plain doubles, in the unit the binned values are in
+class HistogramAxis {
+public:
+	HistogramAxis();
+	//bins of equal width from low to high
+	static HistogramAxis uniform(double low, double high, size_t bins);
+	//count ascending edges, count - 1 bins
+	static HistogramAxis edges(const double* edges, size_t count);
+
+	size_t bins() const {
+		return edgeList.size() - 1;
+	}
+	//bins plus below, above and NaN
+	size_t slots() const {
+		return edgeList.size() + 2;
+	}
+	double edge(size_t i) const {
+		return edgeList[i];
+	}
+	//0 below, 1 to bins() for the bins, bins() + 1 above, bins() + 2 NaN
+	void slots(const double* values, size_t n, uint32_t* out) const;
+	//same bins with every edge replaced, edges holds bins() + 1 ascending values
+	HistogramAxis converted(const double* edges) const;
+
+protected:
+	std::vector<double> edgeList;
+	bool isUniform;
+	double low;
+	double high;
+	double inverseWidth;
+};
+
+//fills counts (slots() of them) from n values, per thread partials added together at the end
+void histogramCounts(const HistogramAxis& axis, const double* values, size_t n, uint64_t* counts, unsigned threads);
+//counts is x slots by y slots, x major
+void histogramCounts2D(const HistogramAxis& xAxis, const double* x, const HistogramAxis& yAxis, const double* y, size_t n,
+	uint64_t* counts, unsigned threads);
+
+//edges in units, each set into a T so that a sample made from an edge value is exactly on it
+template <class T>
+HistogramAxis storedAxis(HistogramAxis edgesInUnits, typename SIUnit<T>::Units units) {
+	std::vector<double> stored(edgesInUnits.bins() + 1);
+	for (size_t i = 0; i < stored.size(); i++) {
+		stored[i] = storedValue(T(edgesInUnits.edge(i), units));
+	}
+	return edgesInUnits.converted(stored.data());
+}
+
+template <class T>
+class Histogram {
+public:
+	typedef typename SIUnit<T>::Units Units;
+
+	Histogram(double low, double high, size_t bins, Units units) : axis(storedAxis<T>(HistogramAxis::uniform(low, high, bins), units)) {
+		counts.assign(axis.slots(), 0);
+	}
+	Histogram(const double* edges, size_t count, Units units) : axis(storedAxis<T>(HistogramAxis::edges(edges, count), units)) {
+		counts.assign(axis.slots(), 0);
+	}
+	//threads 0 uses every hardware thread
+	void add(const T* values, size_t n, unsigned threads = 0) {
+		histogramCounts(axis, reinterpret_cast<const double*>(values), n, counts.data(), threads);
+	}
+	//adds the counts of a histogram with the same edges
+	void merge(const Histogram& other) {
+		for (size_t i = 0; i < counts.size(); i++) {
+			counts[i] += other.counts[i];
+		}
+	}
+	void clear() {
+		counts.assign(counts.size(), 0);
+	}
+	size_t bins() {
+		return axis.bins();
+	}
+	uint64_t count(size_t bin) {
+		return counts[bin + 1];
+	}
+	uint64_t below() {
+		return counts[0];
+	}
+	uint64_t above() {
+		return counts[axis.bins() + 1];
+	}
+	uint64_t nan() {
+		return counts[axis.bins() + 2];
+	}
+	//lower edge of bin, edge(bins()) is the upper edge of the last bin
+	T edge(size_t i) {
+		return fromStored<T>(axis.edge(i));
+	}
+
+protected:
+	HistogramAxis axis;
+	std::vector<uint64_t> counts;
+};
+
+template <class X, class Y>
+class Histogram2D {
+public:
+	//axes with edges in xUnits and yUnits
+	Histogram2D(HistogramAxis xEdges, typename SIUnit<X>::Units xUnits, HistogramAxis yEdges, typename SIUnit<Y>::Units yUnits)
+		: xAxis(storedAxis<X>(xEdges, xUnits)), yAxis(storedAxis<Y>(yEdges, yUnits)) {
+		counts.assign(xAxis.slots() * yAxis.slots(), 0);
+	}
+	void add(const X* x, const Y* y, size_t n, unsigned threads = 0) {
+		histogramCounts2D(xAxis, reinterpret_cast<const double*>(x), yAxis, reinterpret_cast<const double*>(y), n, counts.data(), threads);
+	}
+	void merge(const Histogram2D& other) {
+		for (size_t i = 0; i < counts.size(); i++) {
+			counts[i] += other.counts[i];
+		}
+	}
+	void clear() {
+		counts.assign(counts.size(), 0);
+	}
+	size_t xBins() {
+		return xAxis.bins();
+	}
+	size_t yBins() {
+		return yAxis.bins();
+	}
+	//samples in bin (i, j), both in range
+	uint64_t count(size_t i, size_t j) {
+		return counts[(i + 1) * yAxis.slots() + j + 1];
+	}
+	//every slot, x major, with the below, above and NaN slots of HistogramAxis::slots() on each axis
+	const uint64_t* slotCounts() {
+		return counts.data();
+	}
+
+protected:
+	HistogramAxis xAxis;
+	HistogramAxis yAxis;
+	std::vector<uint64_t> counts;
+};
@@ -0,0 +1,161 @@
+#include "Instrumentation.h"
+
+#ifdef MEASUREMENT_INSTRUMENT
+
+#include "MeasurementC.h"
+#include "Quantities.h"
+
+using namespace Instrumentation;
+
+static std::atomic<uint64_t> setCounts[QUANTITY_COUNT][MAX_UNITS];
+static std::atomic<uint64_t> valueCounts[QUANTITY_COUNT][MAX_UNITS];
+static std::atomic<uint64_t> roundTripCounts[QUANTITY_COUNT][MAX_UNITS];
+static std::atomic<Site*> sites(0);
+
+//last hook run on this thread for each quantity, for spotting round trips
+//kept per quantity so that work on other quantities in between does not hide one
+struct LastEvent {
+	const void* object;
+	int unit;
+	Event event;
+};
+static thread_local LastEvent lastEvents[QUANTITY_COUNT];
+static thread_local Site* currentSite = 0;
+
+static_assert((int)QUANTITY_COUNT == (int)MSR_QUANTITY_COUNT, "Quantity follows msr_quantity");
+
+struct UnitName {
+	int quantity;
+	int unit;
+	const char* name;
+};
+
+//every unit, from the list the C API checks against UNITS at compile time
+#define INSTRUMENT_UNIT_NAME(QUANTITY, UNIT) { QUANTITY, MSR_##UNIT & 0xff, #UNIT },
+static const UnitName UNIT_NAMES[] = { MSR_UNIT_LIST(INSTRUMENT_UNIT_NAME) };
+
+void Instrumentation::record(Quantity quantity, int unit, Event event, const void* object) {
+	if (unit < 0 || unit >= MAX_UNITS) {
+		return;
+	}
+	LastEvent& last = lastEvents[quantity];
+	bool roundTrip = false;
+	if (last.object && last.unit == unit) {
+		roundTrip = (last.event == SET && event == VALUE && last.object == object)
+			|| (last.event == VALUE && event == SET && last.object != object);
+	}
+	last.object = object;
+	last.unit = unit;
+	last.event = event;
+
+	if (event == SET) {
+		setCounts[quantity][unit].fetch_add(1, std::memory_order_relaxed);
+	}
+	else {
+		valueCounts[quantity][unit].fetch_add(1, std::memory_order_relaxed);
+	}
+	if (roundTrip) {
+		roundTripCounts[quantity][unit].fetch_add(1, std::memory_order_relaxed);
+	}
+	if (currentSite) {
+		(event == SET ? currentSite->sets : currentSite->values).fetch_add(1, std::memory_order_relaxed);
+		if (roundTrip) {
+			currentSite->roundTrips.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+Site::Site(const char* siteName) : name(siteName), sets(0), values(0), roundTrips(0) {
+	next = sites.load();
+	while (!sites.compare_exchange_weak(next, this)) {
+	}
+}
+
+SiteScope::SiteScope(Site& site) {
+	previous = currentSite;
+	currentSite = &site;
+}
+
+SiteScope::~SiteScope() {
+	currentSite = previous;
+}
+
+Snapshot Instrumentation::snapshot() {
+	Snapshot snap;
+	for (int q = 0; q < QUANTITY_COUNT; q++) {
+		for (int u = 0; u < MAX_UNITS; u++) {
+			snap.sets[q][u] = setCounts[q][u].load(std::memory_order_relaxed);
+			snap.values[q][u] = valueCounts[q][u].load(std::memory_order_relaxed);
+			snap.roundTrips[q][u] = roundTripCounts[q][u].load(std::memory_order_relaxed);
+		}
+	}
+	for (Site* site = sites.load(); site; site = site->next) {
+		SiteCounts counts = { site->name, site->sets.load(), site->values.load(), site->roundTrips.load() };
+		snap.sites.push_back(counts);
+	}
+	return snap;
+}
+
+void Instrumentation::reset() {
+	for (int q = 0; q < QUANTITY_COUNT; q++) {
+		for (int u = 0; u < MAX_UNITS; u++) {
+			setCounts[q][u].store(0);
+			valueCounts[q][u].store(0);
+			roundTripCounts[q][u].store(0);
+		}
+	}
+	for (Site* site = sites.load(); site; site = site->next) {
+		site->sets.store(0);
+		site->values.store(0);
+		site->roundTrips.store(0);
+	}
+}
+
+const char* Instrumentation::quantityName(Quantity quantity) {
+	return quantity >= 0 && quantity < QUANTITY_COUNT ? ::quantityName((msr_quantity)quantity) : "?";
+}
+
+const char* Instrumentation::unitName(Quantity quantity, int unit) {
+	for (size_t i = 0; i < sizeof(UNIT_NAMES) / sizeof(UNIT_NAMES[0]); i++) {
+		if (UNIT_NAMES[i].quantity == quantity && UNIT_NAMES[i].unit == unit) {
+			return UNIT_NAMES[i].name;
+		}
+	}
+	return "?";
+}
+
+void Instrumentation::dump(FILE* out) {
+	Snapshot snap = snapshot();
+	fprintf(out, "%-16s %-8s %12s %12s %12s\n", "quantity", "unit", "set", "value", "round trips");
+	for (int q = 0; q < QUANTITY_COUNT; q++) {
+		for (int u = 0; u < MAX_UNITS; u++) {
+			if (snap.sets[q][u] || snap.values[q][u]) {
+				fprintf(out, "%-16s %-8s %12llu %12llu %12llu\n", quantityName((Quantity)q), unitName((Quantity)q, u),
+					(unsigned long long)snap.sets[q][u], (unsigned long long)snap.values[q][u],
+					(unsigned long long)snap.roundTrips[q][u]);
+			}
+		}
+	}
+	for (size_t i = 0; i < snap.sites.size(); i++) {
+		SiteCounts& site = snap.sites[i];
+		fprintf(out, "site %s: %llu set, %llu value, %llu round trips\n", site.name,
+			(unsigned long long)site.sets, (unsigned long long)site.values, (unsigned long long)site.roundTrips);
+	}
+}
+
+//prints the summary when the program exits
+static struct DumpAtExit {
+	~DumpAtExit() {
+		Snapshot snap = snapshot();
+		for (int q = 0; q < QUANTITY_COUNT; q++) {
+			for (int u = 0; u < MAX_UNITS; u++) {
+				if (snap.sets[q][u] || snap.values[q][u]) {
+					dump(stderr);
+					return;
+				}
+			}
+		}
+	}
+} dumpAtExit;
+
+#endif
@@ -0,0 +1,113 @@
+#pragma once
+
+/*
+INSTRUMENTATION
+===============
+
+Optional counting of unit conversions, for finding code that converts the same
+values back and forth. It is compiled in only when MEASUREMENT_INSTRUMENT is
+defined for every file that includes Measurement.h, e.g. -DMEASUREMENT_INSTRUMENT.
+Without it the hooks in set() and value() are empty macros, so there is nothing
+left to cost anything.
+
+With it, every set() and value() call is counted by quantity and unit, and two
+patterns are counted as round trips:
+set then value	a measurement is set in a unit and read straight back in the same unit
+value then set	a value read out in a unit goes straight into a new measurement of the same kind in that unit
+Both usually mean a measurement could have been passed along instead.
+
+Counts can also be split by call site. A site covers everything run on the
+thread while its scope is open, including calls into other functions:
+
+void Pump::update() {
+	MEASUREMENT_SITE("Pump::update");
+	...
+}
+
+Only code inside a MEASUREMENT_SITE scope is attributed to a site. Hooks run
+outside every scope, or on another thread than the one that opened it, such as
+a parallelFor worker, still count towards the totals per quantity and unit but
+towards no site. The hooks live in set() and value() themselves, so they cannot
+see their caller's file and line; a site is where the attribution comes from.
+
+Instrumentation::Snapshot counts = Instrumentation::snapshot();
+Instrumentation::dump(stderr);
+
+A summary is printed to stderr at exit if anything was counted.
+*/
+
+#ifdef MEASUREMENT_INSTRUMENT
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace Instrumentation {
+	enum Quantity {
+		TIME_DURATION, LENGTH, AREA, VOLUME, SPEED, ACCELERATION, MASS, FORCE, PRESSURE, ENERGY,
+		POWER, DENSITY, TEMPERATURE, VOLTAGE, CURRENT, CAPACITANCE, RESISTANCE, ROTATION_SPEED, TORQUE,
+		QUANTITY_COUNT
+	};
+	//more than the number of units in any enum in UNITS
+	const int MAX_UNITS = 32;
+	enum Event { SET, VALUE };
+
+	//called by the hooks in set() and value()
+	void record(Quantity quantity, int unit, Event event, const void* object);
+
+	//named call site, declared static so it is registered once
+	class Site {
+	public:
+		Site(const char* siteName);
+		const char* name;
+		std::atomic<uint64_t> sets;
+		std::atomic<uint64_t> values;
+		std::atomic<uint64_t> roundTrips;
+		Site* next;
+	};
+	//makes site the current site of this thread until the scope closes
+	class SiteScope {
+	public:
+		SiteScope(Site& site);
+		~SiteScope();
+	private:
+		Site* previous;
+	};
+
+	struct SiteCounts {
+		const char* name;
+		uint64_t sets;
+		uint64_t values;
+		uint64_t roundTrips;
+	};
+	struct Snapshot {
+		uint64_t sets[QUANTITY_COUNT][MAX_UNITS];
+		uint64_t values[QUANTITY_COUNT][MAX_UNITS];
+		uint64_t roundTrips[QUANTITY_COUNT][MAX_UNITS];
+		std::vector<SiteCounts> sites;
+	};
+	Snapshot snapshot();
+	//zeroes every count, sites stay registered
+	void reset();
+	//non-zero counts as text, one line per quantity and unit, then one per site
+	void dump(FILE* out);
+	const char* quantityName(Quantity quantity);
+	const char* unitName(Quantity quantity, int unit);
+}
+
+#define MEASUREMENT_COUNT_SET(QUANTITY, UNITS) Instrumentation::record(Instrumentation::QUANTITY, (int)(UNITS), Instrumentation::SET, this)
+#define MEASUREMENT_COUNT_VALUE(QUANTITY, UNITS) Instrumentation::record(Instrumentation::QUANTITY, (int)(UNITS), Instrumentation::VALUE, this)
+#define MEASUREMENT_SITE_JOIN(A, B) A##B
+#define MEASUREMENT_SITE_NAME(A, B) MEASUREMENT_SITE_JOIN(A, B)
+#define MEASUREMENT_SITE(NAME) \
+	static Instrumentation::Site MEASUREMENT_SITE_NAME(measurementSite, __LINE__)(NAME); \
+	Instrumentation::SiteScope MEASUREMENT_SITE_NAME(measurementScope, __LINE__)(MEASUREMENT_SITE_NAME(measurementSite, __LINE__))
+
+#else
+
+#define MEASUREMENT_COUNT_SET(QUANTITY, UNITS) ((void)0)
+#define MEASUREMENT_COUNT_VALUE(QUANTITY, UNITS) ((void)0)
+#define MEASUREMENT_SITE(NAME) ((void)0)
+
+#endif
@@ -0,0 +1,524 @@
+#pragma once
+
+/*
+INTEGRATORS
+===========
+
+Fixed step RK4 and adaptive Dormand-Prince 5(4) integrators whose state is a
+tuple of measurements.
+
+typedef std::tuple<Length, Speed> State;
+auto fall = [](TimeDuration t, State y) {
+	return std::make_tuple(std::get<1>(y), Acceleration(-1, UNITS::G));
+};
+State y = RK4<Length, Speed>::integrate(fall, TimeDuration(0, UNITS::s), State(Length(100, UNITS::m), Speed()), TimeDuration(1, UNITS::ms), 1000);
+
+The derivative of each state component is its rate over TimeDuration by the
+operators in Measurement.h, so the derivative of (Length, Speed) must be
+returned as (Speed, Acceleration). Returning anything else, or using a state
+component that has no rate, fails to compile.
+
+StateBatch keeps many independent systems with one array per component.
+integrateRK4() and integrateDormandPrince() advance a whole batch, splitting
+the systems between threads. The RK4 inner loop runs over systems with the
+state in registers, so it vectorizes when the derivative inlines.
+integrateDormandPrince() steps BATCH_LANES systems side by side, each with its
+own time and step size, so the stage sums and error norms run across systems
+and only the derivative is called one system at a time. Every system takes
+the same steps and gets the same result as DormandPrince::integrate() alone.
+
+States are handed to the derivative straight from their stored doubles, with
+no call into value(), so a derivative that inlines costs only its arithmetic.
+*/
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MeasurementTraits.h"
+#include "Parallel.h"
+
+//rate of change of a measurement, e.g. Speed for Length
+template <class S>
+struct RateOf {
+	typedef typename QuotientType<S, TimeDuration>::type type;
+	static_assert(std::is_same<typename ProductType<type, TimeDuration>::type, S>::value,
+		"a state component's rate times TimeDuration must give the component back");
+};
+
+//moves between typed state tuples and arrays of SI values
+template <class... S>
+struct OdeState {
+	typedef std::tuple<S...> State;
+	typedef std::tuple<typename RateOf<S>::type...> Rate;
+	typedef std::array<double, sizeof...(S)> Values;
+
+	static Values values(State y) {
+		return valuesOf(y, std::index_sequence_for<S...>());
+	}
+	static Values rateValues(Rate r) {
+		return valuesOf(r, std::index_sequence_for<S...>());
+	}
+	static State state(const Values& v) {
+		return stateOf(v, std::index_sequence_for<S...>());
+	}
+	//evaluates f(t, y) for SI values
+	template <class F>
+	static Values derivative(F& f, double t, const Values& y) {
+		typedef decltype(f(TimeDuration(), State())) Result;
+		static_assert(std::is_same<typename std::decay<Result>::type, Rate>::value,
+			"the derivative must return the rate of each state component, e.g. (Speed, Acceleration) for (Length, Speed)");
+		return rateValues(f(fromSIValue<TimeDuration>(t), state(y)));
+	}
+
+private:
+	template <class Tuple, size_t... I>
+	static Values valuesOf(Tuple& tuple, std::index_sequence<I...>) {
+		Values v = { siValue(std::get<I>(tuple))... };
+		return v;
+	}
+	template <size_t... I>
+	static State stateOf(const Values& v, std::index_sequence<I...>) {
+		return State(fromSIValue<S>(v[I])...);
+	}
+	//SI value from the stored double, storedScale() folds to a constant and is 1 for most types
+	template <class T>
+	static double siValue(T val) {
+		return storedValue(val) * storedScale<T>();
+	}
+	template <class T>
+	static T fromSIValue(double val) {
+		return fromStored<T>(val / storedScale<T>());
+	}
+};
+
+template <class... S>
+class RK4 {
+public:
+	typedef OdeState<S...> Traits;
+	typedef typename Traits::State State;
+	typedef typename Traits::Values Values;
+	static const size_t N = sizeof...(S);
+
+	//one step of length dt from time t
+	template <class F>
+	static State step(F f, TimeDuration t, State y, TimeDuration dt) {
+		Values v = Traits::values(y);
+		stepValues(f, toSI(t), v, toSI(dt));
+		return Traits::state(v);
+	}
+	//steps fixed steps of length dt from time t0
+	template <class F>
+	static State integrate(F f, TimeDuration t0, State y, TimeDuration dt, size_t steps) {
+		Values v = Traits::values(y);
+		double t = toSI(t0);
+		double h = toSI(dt);
+		for (size_t i = 0; i < steps; i++) {
+			stepValues(f, t + i * h, v, h);
+		}
+		return Traits::state(v);
+	}
+	template <class F>
+	static void stepValues(F& f, double t, Values& y, double h) {
+		Values k1 = Traits::derivative(f, t, y);
+		Values k2 = Traits::derivative(f, t + h / 2, add(y, k1, h / 2));
+		Values k3 = Traits::derivative(f, t + h / 2, add(y, k2, h / 2));
+		Values k4 = Traits::derivative(f, t + h, add(y, k3, h));
+		for (size_t j = 0; j < N; j++) {
+			y[j] += h / 6 * (k1[j] + 2 * k2[j] + 2 * k3[j] + k4[j]);
+		}
+	}
+
+private:
+	static Values add(const Values& y, const Values& k, double h) {
+		Values result;
+		for (size_t j = 0; j < N; j++) {
+			result[j] = y[j] + h * k[j];
+		}
+		return result;
+	}
+};
+
+//systems integrateDormandPrince() steps side by side
+static const size_t BATCH_LANES = 8;
+
+template <class... S>
+class DormandPrince {
+public:
+	typedef OdeState<S...> Traits;
+	typedef typename Traits::State State;
+	typedef typename Traits::Values Values;
+	static const size_t N = sizeof...(S);
+
+	//error per step is kept below absolute + relative * |y|, absolute in SI units
+	DormandPrince(double relative = 1e-6, double absolute = 1e-9) {
+		rtol = relative;
+		atol = absolute;
+		firstStep = 0;
+		maxSteps = 1000000;
+		accepted = 0;
+		rejected = 0;
+		succeeded = true;
+	}
+	void setInitialStep(TimeDuration dt) {
+		firstStep = toSI(dt);
+	}
+	void setMaxSteps(int count) {
+		maxSteps = count;
+	}
+	int acceptedSteps() {
+		return accepted;
+	}
+	int rejectedSteps() {
+		return rejected;
+	}
+	//false if the last integrate() ran out of steps or the step size collapsed
+	bool ok() {
+		return succeeded;
+	}
+	template <class F>
+	State integrate(F f, TimeDuration t0, State y, TimeDuration t1) {
+		Values v = Traits::values(y);
+		integrateValues(f, toSI(t0), v, toSI(t1));
+		return Traits::state(v);
+	}
+	template <class F>
+	bool integrateValues(F& f, double t, Values& y, double end) {
+		accepted = 0;
+		rejected = 0;
+		double span = end - t;
+		double h = firstStep > 0 ? firstStep : span / 100;
+		Values k1 = Traits::derivative(f, t, y);
+		succeeded = true;
+		while (t < end) {
+			if (accepted + rejected >= maxSteps || h <= std::fabs(t) * 1e-15) {
+				succeeded = false;
+				return false;
+			}
+			if (t + h > end) {
+				h = end - t;
+			}
+			Values k2 = Traits::derivative(f, t + h * (1.0 / 5), combine(y, h, k1, 1.0 / 5));
+			Values k3 = Traits::derivative(f, t + h * (3.0 / 10), combine(y, h, k1, 3.0 / 40, k2, 9.0 / 40));
+			Values k4 = Traits::derivative(f, t + h * (4.0 / 5), combine(y, h, k1, 44.0 / 45, k2, -56.0 / 15, k3, 32.0 / 9));
+			Values k5 = Traits::derivative(f, t + h * (8.0 / 9), combine(y, h, k1, 19372.0 / 6561, k2, -25360.0 / 2187, k3, 64448.0 / 6561, k4, -212.0 / 729));
+			Values k6 = Traits::derivative(f, t + h, combine(y, h, k1, 9017.0 / 3168, k2, -355.0 / 33, k3, 46732.0 / 5247, k4, 49.0 / 176, k5, -5103.0 / 18656));
+			Values next = combine(y, h, k1, 35.0 / 384, k3, 500.0 / 1113, k4, 125.0 / 192, k5, -2187.0 / 6784, k6, 11.0 / 84);
+			Values k7 = Traits::derivative(f, t + h, next);
+
+			//difference between the fifth and embedded fourth order solutions
+			double err = 0;
+			for (size_t j = 0; j < N; j++) {
+				double e = h * (71.0 / 57600 * k1[j] - 71.0 / 16695 * k3[j] + 71.0 / 1920 * k4[j]
+					- 17253.0 / 339200 * k5[j] + 22.0 / 525 * k6[j] - 1.0 / 40 * k7[j]);
+				double scale = atol + rtol * std::fmax(std::fabs(y[j]), std::fabs(next[j]));
+				err += (e / scale) * (e / scale);
+			}
+			err = std::sqrt(err / N);
+
+			if (err <= 1) {
+				t += h;
+				y = next;
+				k1 = k7;
+				accepted++;
+			}
+			else {
+				rejected++;
+			}
+			h *= stepFactor(err);
+		}
+		return true;
+	}
+	//integrates the first width of BATCH_LANES systems side by side from t to end, y[j][w] is component j of lane w
+	//returns how many failed, ok() and the step counts are not updated
+	template <class F>
+	size_t integrateLanes(F& f, double t0, double end, double (&y)[N][BATCH_LANES], size_t width) {
+		const size_t W = BATCH_LANES;
+		double k[7][N][W];
+		double next[N][W];
+		double stage[N][W];
+		double t[W];
+		double h[W];
+		double err[W];
+		int steps[W];
+		bool active[W];
+		size_t failures = 0;
+		size_t running = width;
+		//unused lanes start finished, with h = 0 so their sums stay finite
+		for (size_t w = 0; w < W; w++) {
+			active[w] = w < width;
+			t[w] = t0;
+			h[w] = w < width ? (firstStep > 0 ? firstStep : (end - t0) / 100) : 0;
+			steps[w] = 0;
+			for (size_t j = 0; j < N; j++) {
+				if (w >= width) {
+					y[j][w] = 0;
+				}
+				for (size_t s = 0; s < 7; s++) {
+					k[s][j][w] = 0;
+				}
+			}
+		}
+		derivatives(f, t, h, 0, y, k[0], active);
+		while (running) {
+			for (size_t w = 0; w < W; w++) {
+				if (!active[w]) {
+					continue;
+				}
+				if (!(t[w] < end)) {
+					active[w] = false;
+				}
+				else if (steps[w] >= maxSteps || h[w] <= std::fabs(t[w]) * 1e-15) {
+					active[w] = false;
+					failures++;
+				}
+				else if (t[w] + h[w] > end) {
+					h[w] = end - t[w];
+				}
+				if (!active[w]) {
+					h[w] = 0;
+					running--;
+				}
+			}
+			if (!running) {
+				break;
+			}
+			combineLanes(stage, y, h, k, { 1.0 / 5 });
+			derivatives(f, t, h, 1.0 / 5, stage, k[1], active);
+			combineLanes(stage, y, h, k, { 3.0 / 40, 9.0 / 40 });
+			derivatives(f, t, h, 3.0 / 10, stage, k[2], active);
+			combineLanes(stage, y, h, k, { 44.0 / 45, -56.0 / 15, 32.0 / 9 });
+			derivatives(f, t, h, 4.0 / 5, stage, k[3], active);
+			combineLanes(stage, y, h, k, { 19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729 });
+			derivatives(f, t, h, 8.0 / 9, stage, k[4], active);
+			combineLanes(stage, y, h, k, { 9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176, -5103.0 / 18656 });
+			derivatives(f, t, h, 1, stage, k[5], active);
+			combineLanes(next, y, h, k, { 35.0 / 384, 0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784, 11.0 / 84 });
+			derivatives(f, t, h, 1, next, k[6], active);
+
+			//same sums in the same order as integrateValues(), one lane per system
+			for (size_t w = 0; w < W; w++) {
+				err[w] = 0;
+			}
+			for (size_t j = 0; j < N; j++) {
+				for (size_t w = 0; w < W; w++) {
+					double e = h[w] * (71.0 / 57600 * k[0][j][w] - 71.0 / 16695 * k[2][j][w] + 71.0 / 1920 * k[3][j][w]
+						- 17253.0 / 339200 * k[4][j][w] + 22.0 / 525 * k[5][j][w] - 1.0 / 40 * k[6][j][w]);
+					double scale = atol + rtol * std::fmax(std::fabs(y[j][w]), std::fabs(next[j][w]));
+					err[w] += (e / scale) * (e / scale);
+				}
+			}
+			for (size_t w = 0; w < W; w++) {
+				if (!active[w]) {
+					continue;
+				}
+				err[w] = std::sqrt(err[w] / N);
+				steps[w]++;
+				if (err[w] <= 1) {
+					t[w] += h[w];
+					for (size_t j = 0; j < N; j++) {
+						y[j][w] = next[j][w];
+						k[0][j][w] = k[6][j][w];
+					}
+				}
+				h[w] *= stepFactor(err[w]);
+			}
+		}
+		return failures;
+	}
+
+private:
+	static double stepFactor(double err) {
+		double factor = err > 0 ? 0.9 * std::pow(err, -0.2) : 5;
+		return factor < 0.2 ? 0.2 : (factor > 5 ? 5 : factor);
+	}
+	//y + h * (sum of k * a)
+	template <class... Terms>
+	static Values combine(const Values& y, double h, Terms... terms) {
+		Values result = y;
+		addTerms(result, h, terms...);
+		return result;
+	}
+	static void addTerms(Values&, double) {}
+	template <class... Terms>
+	static void addTerms(Values& result, double h, const Values& k, double a, Terms... terms) {
+		for (size_t j = 0; j < N; j++) {
+			result[j] += h * a * k[j];
+		}
+		addTerms(result, h, terms...);
+	}
+	//out = y + h * (sum of k[s] * a[s]) for every lane, a zero a skips its k as combine() does
+	static void combineLanes(double (&out)[N][BATCH_LANES], const double (&y)[N][BATCH_LANES], const double* h,
+		const double (*k)[N][BATCH_LANES], std::initializer_list<double> a) {
+		for (size_t j = 0; j < N; j++) {
+			for (size_t w = 0; w < BATCH_LANES; w++) {
+				out[j][w] = y[j][w];
+			}
+		}
+		size_t s = 0;
+		for (double coefficient : a) {
+			if (coefficient != 0) {
+				for (size_t j = 0; j < N; j++) {
+					for (size_t w = 0; w < BATCH_LANES; w++) {
+						out[j][w] += h[w] * coefficient * k[s][j][w];
+					}
+				}
+			}
+			s++;
+		}
+	}
+	//k = f(t + c * h, y) for each running lane
+	template <class F>
+	static void derivatives(F& f, const double* t, const double* h, double c, const double (&y)[N][BATCH_LANES],
+		double (&k)[N][BATCH_LANES], const bool* active) {
+		for (size_t w = 0; w < BATCH_LANES; w++) {
+			if (!active[w]) {
+				continue;
+			}
+			Values v;
+			for (size_t j = 0; j < N; j++) {
+				v[j] = y[j][w];
+			}
+			Values rate = Traits::derivative(f, t[w] + h[w] * c, v);
+			for (size_t j = 0; j < N; j++) {
+				k[j][w] = rate[j];
+			}
+		}
+	}
+
+	double rtol;
+	double atol;
+	double firstStep;
+	int maxSteps;
+	int accepted;
+	int rejected;
+	bool succeeded;
+};
+
+//many independent systems, one SI array per state component
+template <class... S>
+class StateBatch {
+public:
+	typedef OdeState<S...> Traits;
+	typedef typename Traits::State State;
+	typedef typename Traits::Values Values;
+	static const size_t N = sizeof...(S);
+
+	StateBatch() {
+		count = 0;
+	}
+	StateBatch(size_t systems) {
+		count = 0;
+		resize(systems);
+	}
+	size_t size() {
+		return count;
+	}
+	void resize(size_t systems) {
+		for (size_t j = 0; j < N; j++) {
+			components[j].resize(systems);
+		}
+		count = systems;
+	}
+	State get(size_t i) {
+		return Traits::state(values(i));
+	}
+	void set(size_t i, State y) {
+		setValues(i, Traits::values(y));
+	}
+	void push_back(State y) {
+		resize(count + 1);
+		set(count - 1, y);
+	}
+	Values values(size_t i) {
+		Values v;
+		for (size_t j = 0; j < N; j++) {
+			v[j] = components[j][i];
+		}
+		return v;
+	}
+	void setValues(size_t i, const Values& v) {
+		for (size_t j = 0; j < N; j++) {
+			components[j][i] = v[j];
+		}
+	}
+	//SI values of component j for every system
+	double* component(size_t j) {
+		return components[j].data();
+	}
+
+protected:
+	std::array<std::vector<double>, sizeof...(S)> components;
+	size_t count;
+};
+
+//below this many systems a batch runs on the calling thread
+static const size_t BATCH_PARALLEL_SYSTEMS = 4096;
+
+//advances every system by steps fixed steps of dt, f is called as f(t, state) for each system
+template <class F, class... S>
+void integrateRK4(F f, StateBatch<S...>& batch, TimeDuration t0, TimeDuration dt, size_t steps, unsigned threads = 0) {
+	typedef typename StateBatch<S...>::Values Values;
+	const size_t N = sizeof...(S);
+	double start = toSI(t0);
+	double h = toSI(dt);
+	double* columns[sizeof...(S)];
+	for (size_t j = 0; j < N; j++) {
+		columns[j] = batch.component(j);
+	}
+	parallelFor(batch.size(), threadCount(batch.size(), BATCH_PARALLEL_SYSTEMS, threads), [&](size_t begin, size_t end) {
+		F local = f;
+		for (size_t i = begin; i < end; i++) {
+			Values y;
+			for (size_t j = 0; j < N; j++) {
+				y[j] = columns[j][i];
+			}
+			for (size_t s = 0; s < steps; s++) {
+				RK4<S...>::stepValues(local, start + s * h, y, h);
+			}
+			for (size_t j = 0; j < N; j++) {
+				columns[j][i] = y[j];
+			}
+		}
+	});
+}
+
+//integrates every system from t0 to t1 with its own adaptive steps, false if any system failed
+template <class F, class... S>
+bool integrateDormandPrince(F f, StateBatch<S...>& batch, TimeDuration t0, TimeDuration t1,
+	double relative = 1e-6, double absolute = 1e-9, unsigned threads = 0) {
+	const size_t N = sizeof...(S);
+	double start = toSI(t0);
+	double end = toSI(t1);
+	double* columns[sizeof...(S)];
+	for (size_t j = 0; j < N; j++) {
+		columns[j] = batch.component(j);
+	}
+	unsigned count = threadCount(batch.size(), BATCH_PARALLEL_SYSTEMS, threads);
+	double failed = parallelSum(batch.size(), count, [&](size_t begin, size_t last) {
+		F local = f;
+		DormandPrince<S...> solver(relative, absolute);
+		double lanes[sizeof...(S)][BATCH_LANES];
+		double failures = 0;
+		for (size_t i = begin; i < last; i += BATCH_LANES) {
+			size_t width = last - i < BATCH_LANES ? last - i : BATCH_LANES;
+			for (size_t j = 0; j < N; j++) {
+				for (size_t w = 0; w < width; w++) {
+					lanes[j][w] = columns[j][i + w];
+				}
+			}
+			failures += solver.integrateLanes(local, start, end, lanes, width);
+			for (size_t j = 0; j < N; j++) {
+				for (size_t w = 0; w < width; w++) {
+					columns[j][i + w] = lanes[j][w];
+				}
+			}
+		}
+		return failures;
+	});
+	return failed == 0;
+}
@@ -0,0 +1,66 @@
+#include "Interval.h"
+
+//the loops below avoid branches so they vectorize; bounds are pushed outward after each operation
+
+static inline double min2(double a, double b) {
+	return a < b ? a : b;
+}
+
+static inline double max2(double a, double b) {
+	return a > b ? a : b;
+}
+
+void IntervalBatch::add(const double* aLo, const double* aHi, const double* bLo, const double* bHi, double* lo, double* hi, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		lo[i] = roundDown(aLo[i] + bLo[i]);
+		hi[i] = roundUp(aHi[i] + bHi[i]);
+	}
+}
+
+void IntervalBatch::subtract(const double* aLo, const double* aHi, const double* bLo, const double* bHi, double* lo, double* hi, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		double low = aLo[i] - bHi[i];
+		double high = aHi[i] - bLo[i];
+		lo[i] = roundDown(low);
+		hi[i] = roundUp(high);
+	}
+}
+
+void IntervalBatch::multiply(const double* aLo, const double* aHi, const double* bLo, const double* bHi, double* lo, double* hi, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		//the extremes are always at one of the four corners
+		double p1 = aLo[i] * bLo[i];
+		double p2 = aLo[i] * bHi[i];
+		double p3 = aHi[i] * bLo[i];
+		double p4 = aHi[i] * bHi[i];
+		double low = min2(min2(p1, p2), min2(p3, p4));
+		double high = max2(max2(p1, p2), max2(p3, p4));
+		lo[i] = roundDown(low);
+		hi[i] = roundUp(high);
+	}
+}
+
+void IntervalBatch::divide(const double* aLo, const double* aHi, const double* bLo, const double* bHi, double* lo, double* hi, size_t n) {
+	const double inf = std::numeric_limits<double>::infinity();
+	for (size_t i = 0; i < n; i++) {
+		double q1 = aLo[i] / bLo[i];
+		double q2 = aLo[i] / bHi[i];
+		double q3 = aHi[i] / bLo[i];
+		double q4 = aHi[i] / bHi[i];
+		double low = min2(min2(q1, q2), min2(q3, q4));
+		double high = max2(max2(q1, q2), max2(q3, q4));
+		//a divisor that spans zero can give anything
+		bool spansZero = (bLo[i] <= 0) & (bHi[i] >= 0);
+		lo[i] = spansZero ? -inf : roundDown(low);
+		hi[i] = spansZero ? inf : roundUp(high);
+	}
+}
+
+void IntervalBatch::scale(const double* aLo, const double* aHi, double factor, double* lo, double* hi, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		double p1 = aLo[i] * factor;
+		double p2 = aHi[i] * factor;
+		lo[i] = roundDown(min2(p1, p2));
+		hi[i] = roundUp(max2(p1, p2));
+	}
+}
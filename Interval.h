@@ -0,0 +1,240 @@
+#pragma once
+
+/*
+INTERVALS
+=========
+
+Interval<T> holds a guaranteed enclosure [lower, upper] of a measurement, for
+example a sensor reading and its tolerance:
+
+Interval<Force> f = Interval<Force>::tolerance(Force(500, UNITS::N), Force(5, UNITS::N));
+Interval<Area> a(Area(0.0100, UNITS::m2), Area(0.0102, UNITS::m2));
+Interval<Pressure> p = f / a;
+if (p.below(Pressure(60, UNITS::kPa))) { ... }
+
+Mixed-type operators follow Measurement.h: Interval<A> * Interval<B> only compiles
+when A * B does, and gives an Interval of the same result type. The bounds
+themselves are worked out in SI units, so they do not pick up the per-class
+conversion shortcuts.
+
+Every operation rounds outward: each bound is pushed away from the interval by
+two ulps after it is computed, which covers the round-to-nearest error of the
+operation without having to change the FPU rounding mode. The constructors
+round outward too for Volume, Density and RotationSpeed, whose stored units are
+not SI, so the conversion does not drop the value out of the interval. Division
+by an interval containing zero gives [-inf, inf]. A bound that overflows keeps its
+infinity on the outer side and the largest double on the inner side, so a sum
+too large for a double still gives [DBL_MAX, inf] rather than NaN.
+
+IntervalArray<T> stores many intervals as separate lower/upper arrays, and the
+IntervalBatch functions work over them in one pass with no branches in the loop
+body so the compiler can vectorize them.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "MeasurementTraits.h"
+
+namespace IntervalBatch {
+	//lower and upper bounds are SI values, n elements each
+	void add(const double* aLo, const double* aHi, const double* bLo, const double* bHi, double* lo, double* hi, size_t n);
+	void subtract(const double* aLo, const double* aHi, const double* bLo, const double* bHi, double* lo, double* hi, size_t n);
+	void multiply(const double* aLo, const double* aHi, const double* bLo, const double* bHi, double* lo, double* hi, size_t n);
+	void divide(const double* aLo, const double* aHi, const double* bLo, const double* bHi, double* lo, double* hi, size_t n);
+	void scale(const double* aLo, const double* aHi, double factor, double* lo, double* hi, size_t n);
+
+	//pushes a bound outward by two ulps
+	//a sum or product that overflowed is at least the largest double, so a lower bound of +inf comes back as that
+	inline double roundDown(double val) {
+		double down = val - std::fabs(val) * (2 * std::numeric_limits<double>::epsilon()) - std::numeric_limits<double>::denorm_min();
+		return val == std::numeric_limits<double>::infinity() ? std::numeric_limits<double>::max() : down;
+	}
+	inline double roundUp(double val) {
+		double up = val + std::fabs(val) * (2 * std::numeric_limits<double>::epsilon()) + std::numeric_limits<double>::denorm_min();
+		return val == -std::numeric_limits<double>::infinity() ? -std::numeric_limits<double>::max() : up;
+	}
+}
+
+template <class T>
+class Interval {
+public:
+	Interval() {
+		lo = 0;
+		hi = 0;
+	}
+	//a single exactly known value
+	Interval(T val) {
+		lo = toSI(val);
+		hi = lo;
+		roundStored();
+	}
+	//low and high are swapped if given in the wrong order
+	Interval(T low, T high) {
+		lo = toSI(low);
+		hi = toSI(high);
+		if (lo > hi) {
+			std::swap(lo, hi);
+		}
+		roundStored();
+	}
+	//nominal +/- tol
+	static Interval tolerance(T nominal, T tol) {
+		double n = toSI(nominal);
+		double t = std::fabs(toSI(tol));
+		return fromBounds(IntervalBatch::roundDown(n - t), IntervalBatch::roundUp(n + t));
+	}
+	//bounds given directly in SI units
+	static Interval fromBounds(double lower, double upper) {
+		Interval result;
+		result.lo = lower;
+		result.hi = upper;
+		return result;
+	}
+	T lower() {
+		return fromSI<T>(lo);
+	}
+	T upper() {
+		return fromSI<T>(hi);
+	}
+	T midpoint() {
+		return fromSI<T>(lo + (hi - lo) / 2);
+	}
+	T width() {
+		return fromSI<T>(hi - lo);
+	}
+	double lowerSI() {
+		return lo;
+	}
+	double upperSI() {
+		return hi;
+	}
+	bool contains(T val) {
+		double v = toSI(val);
+		return (lo <= v && v <= hi);
+	}
+	//every value in the interval is below the limit
+	bool below(T limit) {
+		return (hi < toSI(limit));
+	}
+	//every value in the interval is above the limit
+	bool above(T limit) {
+		return (lo > toSI(limit));
+	}
+	//some value in the interval could be above the limit
+	bool mayExceed(T limit) {
+		return (hi > toSI(limit));
+	}
+	Interval operator+ (Interval other) {
+		return fromBounds(IntervalBatch::roundDown(lo + other.lo), IntervalBatch::roundUp(hi + other.hi));
+	}
+	Interval operator- (Interval other) {
+		return fromBounds(IntervalBatch::roundDown(lo - other.hi), IntervalBatch::roundUp(hi - other.lo));
+	}
+	Interval operator* (double val) {
+		Interval result;
+		IntervalBatch::scale(&lo, &hi, val, &result.lo, &result.hi, 1);
+		return result;
+	}
+	Interval operator/ (double val) {
+		Interval result;
+		IntervalBatch::divide(&lo, &hi, &val, &val, &result.lo, &result.hi, 1);
+		return result;
+	}
+	template <class U>
+	Interval<typename ProductType<T, U>::type> operator* (Interval<U> other) {
+		double resultLo, resultHi;
+		IntervalBatch::multiply(&lo, &hi, &other.lo, &other.hi, &resultLo, &resultHi, 1);
+		return Interval<typename ProductType<T, U>::type>::fromBounds(resultLo, resultHi);
+	}
+	template <class U>
+	Interval<typename QuotientType<T, U>::type> operator/ (Interval<U> other) {
+		double resultLo, resultHi;
+		IntervalBatch::divide(&lo, &hi, &other.lo, &other.hi, &resultLo, &resultHi, 1);
+		return Interval<typename QuotientType<T, U>::type>::fromBounds(resultLo, resultHi);
+	}
+	//smallest interval holding both
+	Interval hull(Interval other) {
+		return fromBounds(lo < other.lo ? lo : other.lo, hi > other.hi ? hi : other.hi);
+	}
+	bool operator== (Interval other) {
+		return (lo == other.lo && hi == other.hi);
+	}
+	bool operator!= (Interval other) {
+		return !(*this == other);
+	}
+
+protected:
+	template <class U> friend class Interval;
+	double lo;
+	double hi;
+
+	//classes not stored in SI units round when converted, so the bounds are pushed past that rounding
+	void roundStored() {
+		if (storedScale<T>() != 1) {
+			lo = IntervalBatch::roundDown(lo);
+			hi = IntervalBatch::roundUp(hi);
+		}
+	}
+};
+
+//many intervals of the same measurement, stored as separate lower/upper SI arrays
+template <class T>
+class IntervalArray {
+public:
+	IntervalArray() {}
+	IntervalArray(size_t count) : lo(count), hi(count) {}
+	size_t size() {
+		return lo.size();
+	}
+	void resize(size_t count) {
+		lo.resize(count);
+		hi.resize(count);
+	}
+	void push_back(Interval<T> val) {
+		lo.push_back(val.lowerSI());
+		hi.push_back(val.upperSI());
+	}
+	Interval<T> operator[] (size_t i) {
+		return Interval<T>::fromBounds(lo[i], hi[i]);
+	}
+	double* lower() {
+		return lo.data();
+	}
+	double* upper() {
+		return hi.data();
+	}
+	IntervalArray operator+ (IntervalArray& other) {
+		IntervalArray result(size());
+		IntervalBatch::add(lower(), upper(), other.lower(), other.upper(), result.lower(), result.upper(), size());
+		return result;
+	}
+	IntervalArray operator- (IntervalArray& other) {
+		IntervalArray result(size());
+		IntervalBatch::subtract(lower(), upper(), other.lower(), other.upper(), result.lower(), result.upper(), size());
+		return result;
+	}
+	IntervalArray operator* (double factor) {
+		IntervalArray result(size());
+		IntervalBatch::scale(lower(), upper(), factor, result.lower(), result.upper(), size());
+		return result;
+	}
+	template <class U>
+	IntervalArray<typename ProductType<T, U>::type> operator* (IntervalArray<U>& other) {
+		IntervalArray<typename ProductType<T, U>::type> result(size());
+		IntervalBatch::multiply(lower(), upper(), other.lower(), other.upper(), result.lower(), result.upper(), size());
+		return result;
+	}
+	template <class U>
+	IntervalArray<typename QuotientType<T, U>::type> operator/ (IntervalArray<U>& other) {
+		IntervalArray<typename QuotientType<T, U>::type> result(size());
+		IntervalBatch::divide(lower(), upper(), other.lower(), other.upper(), result.lower(), result.upper(), size());
+		return result;
+	}
+
+protected:
+	std::vector<double> lo;
+	std::vector<double> hi;
+};
@@ -0,0 +1,237 @@
+#pragma once
+
+/*
+LITERALS
+========
+
+User-defined literals for every unit in the UNITS namespace. The suffix is the
+unit's enum name with a leading underscore:
+
+using namespace measurement::literals;
+Length board = 12.5_ft;
+Energy battery = 3_kWh;
+Speed limit = 60_mph;
+
+Literals are constexpr and work out the stored value from the same factors
+in UnitFactors that set() uses, the same way, so 12.5_ft is bit for bit
+Length(12.5, UNITS::ft) but costs nothing at runtime.
+Temperatures are absolute (20_C is 293.15 K).
+*/
+
+#include <type_traits>
+#include "Measurement.h"
+#include "MeasurementTraits.h"
+
+namespace measurement {
+
+	//the stored value set() gives, from the unit's factor in UnitFactors: set() divides out a
+	//power of ten below the stored unit and multiplies by the rounded factor otherwise
+	template <class T>
+	constexpr double storedLiteral(double val, typename SIUnit<T>::Units units) {
+		DoubleDouble ratio = UnitFactors<T>::scale(units) / UnitFactors<T>::scale(SIUnit<T>::stored);
+		double inverse = (DoubleDouble{ 1, 0 } / ratio).hi;
+		double power = 10;
+		while (power < inverse) {
+			power *= 10;
+		}
+		return ratio.hi < 1 && power == inverse ? val / power : val * ratio.hi;
+	}
+
+	template <class T>
+	constexpr T literal(double val, typename SIUnit<T>::Units units) {
+		if constexpr (std::is_constructible<T, StoredValue, double>::value) {
+			return T(StoredValue(), storedLiteral<T>(val, units));
+		} else {
+			return T(SIValue(), storedLiteral<T>(val, units));
+		}
+	}
+
+//defines integer and floating point literals for one unit
+#define MEASUREMENT_LITERAL(TYPE, UNIT) \
+	constexpr TYPE operator""_##UNIT(long double val) { \
+		return literal<TYPE>(static_cast<double>(val), UNITS::UNIT); \
+	} \
+	constexpr TYPE operator""_##UNIT(unsigned long long val) { \
+		return literal<TYPE>(static_cast<double>(val), UNITS::UNIT); \
+	}
+
+	namespace literals {
+
+		MEASUREMENT_LITERAL(TimeDuration, s)
+		MEASUREMENT_LITERAL(TimeDuration, min)
+		MEASUREMENT_LITERAL(TimeDuration, hr)
+		MEASUREMENT_LITERAL(TimeDuration, day)
+		MEASUREMENT_LITERAL(TimeDuration, week)
+		MEASUREMENT_LITERAL(TimeDuration, yr)
+		MEASUREMENT_LITERAL(TimeDuration, ms)
+		MEASUREMENT_LITERAL(TimeDuration, us)
+		MEASUREMENT_LITERAL(TimeDuration, ns)
+
+		MEASUREMENT_LITERAL(Length, m)
+		MEASUREMENT_LITERAL(Length, cm)
+		MEASUREMENT_LITERAL(Length, mm)
+		MEASUREMENT_LITERAL(Length, um)
+		MEASUREMENT_LITERAL(Length, km)
+		MEASUREMENT_LITERAL(Length, in)
+		MEASUREMENT_LITERAL(Length, ft)
+		MEASUREMENT_LITERAL(Length, yd)
+		MEASUREMENT_LITERAL(Length, mi)
+
+		MEASUREMENT_LITERAL(Area, m2)
+		MEASUREMENT_LITERAL(Area, cm2)
+		MEASUREMENT_LITERAL(Area, mm2)
+		MEASUREMENT_LITERAL(Area, um2)
+		MEASUREMENT_LITERAL(Area, km2)
+		MEASUREMENT_LITERAL(Area, in2)
+		MEASUREMENT_LITERAL(Area, ft2)
+		MEASUREMENT_LITERAL(Area, yd2)
+		MEASUREMENT_LITERAL(Area, mi2)
+		MEASUREMENT_LITERAL(Area, acre)
+		MEASUREMENT_LITERAL(Area, hectare)
+
+		MEASUREMENT_LITERAL(Volume, m3)
+		MEASUREMENT_LITERAL(Volume, cm3)
+		MEASUREMENT_LITERAL(Volume, mm3)
+		MEASUREMENT_LITERAL(Volume, km3)
+		MEASUREMENT_LITERAL(Volume, L)
+		MEASUREMENT_LITERAL(Volume, mL)
+		MEASUREMENT_LITERAL(Volume, in3)
+		MEASUREMENT_LITERAL(Volume, ft3)
+		MEASUREMENT_LITERAL(Volume, yd3)
+		MEASUREMENT_LITERAL(Volume, mi3)
+		MEASUREMENT_LITERAL(Volume, tsp)
+		MEASUREMENT_LITERAL(Volume, tbsp)
+		MEASUREMENT_LITERAL(Volume, cup)
+		MEASUREMENT_LITERAL(Volume, pint)
+		MEASUREMENT_LITERAL(Volume, quart)
+		MEASUREMENT_LITERAL(Volume, gallon)
+		MEASUREMENT_LITERAL(Volume, barrel)
+
+		MEASUREMENT_LITERAL(Speed, m_s)
+		MEASUREMENT_LITERAL(Speed, kph)
+		MEASUREMENT_LITERAL(Speed, mph)
+		MEASUREMENT_LITERAL(Speed, ft_s)
+
+		MEASUREMENT_LITERAL(Acceleration, m_s2)
+		MEASUREMENT_LITERAL(Acceleration, kph_s)
+		MEASUREMENT_LITERAL(Acceleration, mph_s)
+		MEASUREMENT_LITERAL(Acceleration, ft_s2)
+		MEASUREMENT_LITERAL(Acceleration, G)
+
+		MEASUREMENT_LITERAL(Mass, gram)
+		MEASUREMENT_LITERAL(Mass, kg)
+		MEASUREMENT_LITERAL(Mass, lb)
+		MEASUREMENT_LITERAL(Mass, oz)
+		MEASUREMENT_LITERAL(Mass, tonne)
+		MEASUREMENT_LITERAL(Mass, ton)
+
+		MEASUREMENT_LITERAL(Force, N)
+		MEASUREMENT_LITERAL(Force, lbf)
+
+		MEASUREMENT_LITERAL(Pressure, Pa)
+		MEASUREMENT_LITERAL(Pressure, kPa)
+		MEASUREMENT_LITERAL(Pressure, MPa)
+		MEASUREMENT_LITERAL(Pressure, psi)
+		MEASUREMENT_LITERAL(Pressure, mmHg)
+		MEASUREMENT_LITERAL(Pressure, inH2O)
+		MEASUREMENT_LITERAL(Pressure, bar)
+		MEASUREMENT_LITERAL(Pressure, atm)
+
+		MEASUREMENT_LITERAL(Energy, J)
+		MEASUREMENT_LITERAL(Energy, kJ)
+		MEASUREMENT_LITERAL(Energy, MJ)
+		MEASUREMENT_LITERAL(Energy, kWh)
+		MEASUREMENT_LITERAL(Energy, hph)
+		MEASUREMENT_LITERAL(Energy, BTU)
+		MEASUREMENT_LITERAL(Energy, cal)
+		MEASUREMENT_LITERAL(Energy, kCal)
+
+		MEASUREMENT_LITERAL(Power, W)
+		MEASUREMENT_LITERAL(Power, kW)
+		MEASUREMENT_LITERAL(Power, MW)
+		MEASUREMENT_LITERAL(Power, mW)
+		MEASUREMENT_LITERAL(Power, hp)
+		MEASUREMENT_LITERAL(Power, BTU_h)
+
+		MEASUREMENT_LITERAL(Density, kg_m3)
+		MEASUREMENT_LITERAL(Density, g_cm3)
+		MEASUREMENT_LITERAL(Density, lb_gal)
+
+		MEASUREMENT_LITERAL(Voltage, V)
+		MEASUREMENT_LITERAL(Voltage, mV)
+		MEASUREMENT_LITERAL(Voltage, kV)
+		MEASUREMENT_LITERAL(Voltage, MV)
+
+		MEASUREMENT_LITERAL(Current, A)
+		MEASUREMENT_LITERAL(Current, mA)
+		MEASUREMENT_LITERAL(Current, kA)
+		MEASUREMENT_LITERAL(Current, MA)
+
+		MEASUREMENT_LITERAL(Capacitance, Farad)
+		MEASUREMENT_LITERAL(Capacitance, uF)
+		MEASUREMENT_LITERAL(Capacitance, mF)
+		MEASUREMENT_LITERAL(Capacitance, nF)
+		MEASUREMENT_LITERAL(Capacitance, pF)
+
+		MEASUREMENT_LITERAL(Resistance, Ohm)
+		MEASUREMENT_LITERAL(Resistance, mOhm)
+		MEASUREMENT_LITERAL(Resistance, kOhm)
+		MEASUREMENT_LITERAL(Resistance, MOhm)
+
+		MEASUREMENT_LITERAL(RotationSpeed, rpm)
+		MEASUREMENT_LITERAL(RotationSpeed, rev_s)
+		MEASUREMENT_LITERAL(RotationSpeed, rad_s)
+		MEASUREMENT_LITERAL(RotationSpeed, deg_s)
+
+		MEASUREMENT_LITERAL(Torque, Nm)
+		MEASUREMENT_LITERAL(Torque, inlb)
+		MEASUREMENT_LITERAL(Torque, ftlb)
+
+		//temperatures have an offset, so they are written out
+		//C, K, F, R
+		constexpr Temperature operator""_C(long double val) {
+			return Temperature(SIValue(), static_cast<double>(val) + 273.15);
+		}
+		constexpr Temperature operator""_C(unsigned long long val) {
+			return Temperature(SIValue(), static_cast<double>(val) + 273.15);
+		}
+		constexpr Temperature operator""_K(long double val) {
+			return Temperature(SIValue(), static_cast<double>(val));
+		}
+		constexpr Temperature operator""_K(unsigned long long val) {
+			return Temperature(SIValue(), static_cast<double>(val));
+		}
+		//same factors and order of operations as Temperature(val, UNITS::F), so both give the same double
+		constexpr Temperature operator""_F(long double val) {
+			return Temperature(SIValue(), static_cast<double>(val) * factor::degreeF.hi + factor::zeroF.hi);
+		}
+		constexpr Temperature operator""_F(unsigned long long val) {
+			return Temperature(SIValue(), static_cast<double>(val) * factor::degreeF.hi + factor::zeroF.hi);
+		}
+		constexpr Temperature operator""_R(long double val) {
+			return Temperature(SIValue(), static_cast<double>(val) * factor::degreeF.hi);
+		}
+		constexpr Temperature operator""_R(unsigned long long val) {
+			return Temperature(SIValue(), static_cast<double>(val) * factor::degreeF.hi);
+		}
+	}
+
+#undef MEASUREMENT_LITERAL
+
+	//compile-time checks: these only build if the literals fold to constants
+	namespace literals_check {
+		using namespace literals;
+
+		template <class T>
+		constexpr bool isConstant(T) {
+			return true;
+		}
+
+		static_assert(isConstant(12.5_ft) && isConstant(3_kWh) && isConstant(60_mph), "literals must be constant expressions");
+		static_assert(isConstant(72_F) && isConstant(1_gallon) && isConstant(100_psi), "literals must be constant expressions");
+		static_assert(storedLiteral<Length>(1, UNITS::ft) == 0.3048 && storedLiteral<Length>(1, UNITS::mi) == 1609.344, "length scales");
+		static_assert(storedLiteral<Volume>(1, UNITS::gallon) > 3.785411 && storedLiteral<Volume>(1, UNITS::gallon) < 3.785412, "US gallon is 231 in3");
+		static_assert(storedLiteral<Force>(1, UNITS::lbf) > 4.448221615 && storedLiteral<Force>(1, UNITS::lbf) < 4.448221616, "pound-force");
+		static_assert(storedLiteral<Length>(7, UNITS::cm) == 7 / 100.0, "powers of ten are divided out as set() does");
+	}
+}
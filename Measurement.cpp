@@ -1,6 +1,7 @@
 #include "Measurement.h"
 
-inline void TimeDuration::set(double value, UNITS::TimeUnits units) {
+void TimeDuration::set(double value, UNITS::TimeUnits units) {
+	MEASUREMENT_COUNT_SET(TIME_DURATION, units);
 	//SECOND, MINUTE, HOUR, DAY, WEEK, YEAR, MILLISECOND, MICROSECOND, NANOSECOND
 	switch (units) {
 	case UNITS::s:
@@ -33,7 +34,8 @@ inline void TimeDuration::set(double value, UNITS::TimeUnits units) {
 	}
 }
 
-inline double TimeDuration::value(UNITS::TimeUnits units) {
+double TimeDuration::value(UNITS::TimeUnits units) {
+	MEASUREMENT_COUNT_VALUE(TIME_DURATION, units);
 	switch (units) {
 	case UNITS::s:
 		return time_in_s;
@@ -62,9 +64,11 @@ inline double TimeDuration::value(UNITS::TimeUnits units) {
 		return time_in_s * 1000000000;
 		break;
 	}
+	return NAN;
 }
 
-inline void Length::set(double value, UNITS::LengthUnits units) {
+void Length::set(double value, UNITS::LengthUnits units) {
+	MEASUREMENT_COUNT_SET(LENGTH, units);
 	switch (units) {
 	case UNITS::m:
 		length_in_m = value;
@@ -82,21 +86,22 @@ inline void Length::set(double value, UNITS::LengthUnits units) {
 		length_in_m = value * 1000;
 		break;
 	case UNITS::in:
-		set(value / 25.4, UNITS::mm);
+		length_in_m = value * factor::in.hi;
 		break;
 	case UNITS::ft:
-		set(value * 12, UNITS::in);
+		length_in_m = value * factor::ft.hi;
 		break;
 	case UNITS::mi:
-		set(value * 5280, UNITS::ft);
+		length_in_m = value * factor::mi.hi;
 		break;
 	case UNITS::yd:
-		set(value * 3, UNITS::ft);
+		length_in_m = value * factor::yd.hi;
 		break;
 	}
 }
 
-inline double Length::value(UNITS::LengthUnits units) {
+double Length::value(UNITS::LengthUnits units) {
+	MEASUREMENT_COUNT_VALUE(LENGTH, units);
 	switch (units) {
 	case UNITS::m:
 		return length_in_m;
@@ -114,22 +119,24 @@ inline double Length::value(UNITS::LengthUnits units) {
 		return (length_in_m / 1000);
 		break;
 	case UNITS::in:
-		return value(UNITS::mm) / 25.4;
+		return length_in_m / factor::in.hi;
 		break;
 	case UNITS::ft:
-		return value(UNITS::in) / 12;
+		return length_in_m / factor::ft.hi;
 		break;
 	case UNITS::mi:
-		return value(UNITS::ft) / 5280;
+		return length_in_m / factor::mi.hi;
 		break;
 	case UNITS::yd:
-		return value(UNITS::ft) / 3;
+		return length_in_m / factor::yd.hi;
 		break;
 	}
+	return NAN;
 
 }
 
-inline void Area::set(double value, UNITS::AreaUnits units) {
+void Area::set(double value, UNITS::AreaUnits units) {
+	MEASUREMENT_COUNT_SET(AREA, units);
 	//m2, cm2, mm2, um2, km2, in2, ft2, yd2, mi2, acre, hectare
 	//store as m^2
 	switch (units) {
@@ -143,25 +150,25 @@ inline void Area::set(double value, UNITS::AreaUnits units) {
 		area_in_m2 = value / 1000000.0;
 		break;
 	case UNITS::um2:
-		area_in_m2 = value / 1000000000.0;
+		area_in_m2 = value / 1000000000000.0;
 		break;
 	case UNITS::km2:
 		area_in_m2 = value * 1000000.0;
 		break;
 	case UNITS::in2:
-		area_in_m2 = value * .00064516;
+		area_in_m2 = value * factor::in2.hi;
 		break;
 	case UNITS::ft2:
-		area_in_m2 = value * .00064516 * 144;
+		area_in_m2 = value * factor::ft2.hi;
 		break;
 	case UNITS::yd2:
-		area_in_m2 = value * .00064516 * 144 * 9;
+		area_in_m2 = value * factor::yd2.hi;
 		break;
 	case UNITS::mi2:
-		area_in_m2 = value * .00064516 * 144 * 5280 * 5280;
+		area_in_m2 = value * factor::mi2.hi;
 		break;
 	case UNITS::acre:
-		area_in_m2 = value * .00064516 * 144 * 43560.0;
+		area_in_m2 = value * factor::acre.hi;
 		break;
 	case UNITS::hectare:
 		area_in_m2 = 10000.0 * value;
@@ -169,7 +176,8 @@ inline void Area::set(double value, UNITS::AreaUnits units) {
 	}
 }
 
-inline double Area::value(UNITS::AreaUnits units) {
+double Area::value(UNITS::AreaUnits units) {
+	MEASUREMENT_COUNT_VALUE(AREA, units);
 	//m2, cm2, mm2, um2, km2, in2, ft2, yd2, mi2, acre, hectare
 	//convert from m2
 	switch (units) {
@@ -183,33 +191,35 @@ inline double Area::value(UNITS::AreaUnits units) {
 		return area_in_m2 * 1000000.0;
 		break;
 	case UNITS::um2:
-		return area_in_m2 * 1000000000.0;
+		return area_in_m2 * 1000000000000.0;
 		break;
 	case UNITS::km2:
 		return area_in_m2 / 1000000.0;
 		break;
 	case UNITS::in2:
-		return area_in_m2 / .00064516;
+		return area_in_m2 / factor::in2.hi;
 		break;
 	case UNITS::ft2:
-		return area_in_m2 / (.00064516 * 144);
+		return area_in_m2 / factor::ft2.hi;
 		break;
 	case UNITS::yd2:
-		return area_in_m2 / (.00064516 * 144 * 9);
+		return area_in_m2 / factor::yd2.hi;
 		break;
 	case UNITS::mi2:
-		return area_in_m2 / (.00064516 * 144 * 5280 * 5280);
+		return area_in_m2 / factor::mi2.hi;
 		break;
 	case UNITS::acre:
-		return area_in_m2 / (.00064516 * 144 * 43560.0);
+		return area_in_m2 / factor::acre.hi;
 		break;
 	case UNITS::hectare:
 		return area_in_m2 / 10000.0;
 		break;
 	}
+	return NAN;
 }
 
-inline void Volume::set(double value, UNITS::VolumeUnits units) {
+void Volume::set(double value, UNITS::VolumeUnits units) {
+	MEASUREMENT_COUNT_SET(VOLUME, units);
 	switch (units) {
 	case UNITS::m3:
 		volume_in_L = value * 1000.0;
@@ -221,7 +231,7 @@ inline void Volume::set(double value, UNITS::VolumeUnits units) {
 		volume_in_L = value / 1000000.0;
 		break;
 	case UNITS::km3:
-		volume_in_L = value * 1000000.0;
+		volume_in_L = value * 1000000000000.0;
 		break;
 	case UNITS::L:
 		volume_in_L = value;
@@ -230,42 +240,43 @@ inline void Volume::set(double value, UNITS::VolumeUnits units) {
 		volume_in_L = value / 1000.0;
 		break;
 	case UNITS::in3:
-		volume_in_L = value / 61.023744;
+		volume_in_L = value * factor::liters::in3.hi;
 		break;
 	case UNITS::ft3:
-		set(value * 1728, UNITS::in3);
+		volume_in_L = value * factor::liters::ft3.hi;
 		break;
 	case UNITS::yd3:
-		set(value * 15552, UNITS::in3);
+		volume_in_L = value * factor::liters::yd3.hi;
 		break;
 	case UNITS::mi3:
-		set(value * 254358061056000, UNITS::in3);
+		volume_in_L = value * factor::liters::mi3.hi;
 		break;
 	case UNITS::tsp:
-		set(value / 96, UNITS::pint);
+		volume_in_L = value * factor::liters::tsp.hi;
 		break;
 	case UNITS::tbsp:
-		set(value / 32, UNITS::pint);
+		volume_in_L = value * factor::liters::tbsp.hi;
 		break;
 	case UNITS::cup:
-		set(value / 2, UNITS::pint);
+		volume_in_L = value * factor::liters::cup.hi;
 		break;
 	case UNITS::pint:
-		volume_in_L = value * .473176473;
+		volume_in_L = value * factor::liters::pint.hi;
 		break;
 	case UNITS::quart:
-		set(value * 2, UNITS::pint);
+		volume_in_L = value * factor::liters::quart.hi;
 		break;
 	case UNITS::gallon:
-		set(value * 8, UNITS::pint);
+		volume_in_L = value * factor::liters::gallon.hi;
 		break;
 	case UNITS::barrel:
-		set(value * 31.5, UNITS::gallon);
+		volume_in_L = value * factor::liters::barrel.hi;
 		break;
 	}
 }
 
-inline double Volume::value(UNITS::VolumeUnits units) {
+double Volume::value(UNITS::VolumeUnits units) {
+	MEASUREMENT_COUNT_VALUE(VOLUME, units);
 	switch (units) {
 	case UNITS::m3:
 		return volume_in_L / 1000.0;
@@ -277,7 +288,7 @@ inline double Volume::value(UNITS::VolumeUnits units) {
 		return volume_in_L * 1000000.0;
 		break;
 	case UNITS::km3:
-		return volume_in_L / 1000000.0;
+		return volume_in_L / 1000000000000.0;
 		break;
 	case UNITS::L:
 		return volume_in_L;
@@ -286,142 +297,124 @@ inline double Volume::value(UNITS::VolumeUnits units) {
 		return volume_in_L * 1000.0;
 		break;
 	case UNITS::in3:
-		return volume_in_L * 61.023744;
+		return volume_in_L / factor::liters::in3.hi;
 		break;
 	case UNITS::ft3:
-		return value(UNITS::in3) / 1728;
+		return volume_in_L / factor::liters::ft3.hi;
 		break;
 	case UNITS::yd3:
-		return value(UNITS::in3) / 15552;
+		return volume_in_L / factor::liters::yd3.hi;
 		break;
 	case UNITS::mi3:
-		return value(UNITS::in3) / 254358061056000.0;
+		return volume_in_L / factor::liters::mi3.hi;
 		break;
 	case UNITS::tsp:
-		return value(UNITS::pint) * 96;
+		return volume_in_L / factor::liters::tsp.hi;
 		break;
 	case UNITS::tbsp:
-		return value(UNITS::pint) * 32;
+		return volume_in_L / factor::liters::tbsp.hi;
 		break;
 	case UNITS::cup:
-		return value(UNITS::pint) * 2;
+		return volume_in_L / factor::liters::cup.hi;
 		break;
 	case UNITS::pint:
-		return volume_in_L / .473176473;
+		return volume_in_L / factor::liters::pint.hi;
 		break;
 	case UNITS::quart:
-		return value(UNITS::pint) / 2;
+		return volume_in_L / factor::liters::quart.hi;
 		break;
 	case UNITS::gallon:
-		return value(UNITS::pint) / 8;
+		return volume_in_L / factor::liters::gallon.hi;
 		break;
 	case UNITS::barrel:
-		return value(UNITS::pint) / 31.5;
+		return volume_in_L / factor::liters::barrel.hi;
 		break;
 	}
+	return NAN;
 }
 
-inline void Speed::set(double value, UNITS::SpeedUnits units) {
+void Speed::set(double value, UNITS::SpeedUnits units) {
+	MEASUREMENT_COUNT_SET(SPEED, units);
 	switch (units) {
 	case UNITS::m_s:
 		speed_in_m_s = value;
 		break;
 	case UNITS::kph: 
-		{
-			double metersPerHour = value * 1000;
-			double metersPerSecond = metersPerHour / 3600;
-			speed_in_m_s = metersPerSecond;
-		}
+		speed_in_m_s = value * factor::kph.hi;
 		break;
 	case UNITS::mph: 
-		{
-			Length distanceInHr(value, UNITS::mi);
-			double MetersPerHour = distanceInHr.value(UNITS::m);
-			double MetersPerSecond = MetersPerHour / 3600;
-			speed_in_m_s = MetersPerSecond;
-		}	
+		speed_in_m_s = value * factor::mph.hi;
 		break;
 	case UNITS::ft_s: 
-		{
-			Length distanceInSecond(value, UNITS::ft);
-			speed_in_m_s = distanceInSecond.value(UNITS::m);
-		}
+		speed_in_m_s = value * factor::ft.hi;
 		break;
 	}
 }
 
-inline double Speed::value(UNITS::SpeedUnits units) {
+double Speed::value(UNITS::SpeedUnits units) {
+	MEASUREMENT_COUNT_VALUE(SPEED, units);
 	switch (units) {
 	case UNITS::m_s:
 		return speed_in_m_s;
 		break;
 	case UNITS::kph:
-		return speed_in_m_s * 3600 / 1000;
+		return speed_in_m_s / factor::kph.hi;
 		break;
 	case UNITS::mph:
-		{
-			Length distanceInHr(speed_in_m_s * 3600, UNITS::m);
-			return distanceInHr.value(UNITS::mi);
-		}
+		return speed_in_m_s / factor::mph.hi;
 		break;
 	case UNITS::ft_s:
-		{
-			Length distanceInSecond(speed_in_m_s, UNITS::m);
-			return distanceInSecond.value(UNITS::ft);
-		}
-	break;
+		return speed_in_m_s / factor::ft.hi;
+		break;
 	}
+	return NAN;
 }
 
-inline void Acceleration::set(double value, UNITS::AccelerationUnits units) {
+void Acceleration::set(double value, UNITS::AccelerationUnits units) {
+	MEASUREMENT_COUNT_SET(ACCELERATION, units);
 	switch (units) {
 	case UNITS::m_s2:
 		acceleration_in_m_s2 = value;
 		break;
 	case UNITS::kph_s:
-	{
-		Speed increasePerSecond(value, UNITS::kph);
-		acceleration_in_m_s2 = increasePerSecond.value(UNITS::m_s);
-	}	break;
+		acceleration_in_m_s2 = value * factor::kph.hi;
+		break;
 	case UNITS::mph_s:
-	{
-		Speed increasePerSecond(value, UNITS::mph);
-		acceleration_in_m_s2 = increasePerSecond.value(UNITS::m_s);
-	}	break;
+		acceleration_in_m_s2 = value * factor::mph.hi;
+		break;
 	case UNITS::ft_s2:
-		acceleration_in_m_s2 = value * .3048;
+		acceleration_in_m_s2 = value * factor::ft.hi;
 		break;
 	case UNITS::G:
-		acceleration_in_m_s2 = value * 9.80665;
+		acceleration_in_m_s2 = value * factor::G.hi;
 		break;
 	}
 }
 
-inline double Acceleration::value(UNITS::AccelerationUnits units) {
+double Acceleration::value(UNITS::AccelerationUnits units) {
+	MEASUREMENT_COUNT_VALUE(ACCELERATION, units);
 	switch (units) {
 	case UNITS::m_s2:
 		return acceleration_in_m_s2;
 		break;
 	case UNITS::kph_s:
-	{
-		Speed increasePerSecond(acceleration_in_m_s2, UNITS::m_s);
-		return increasePerSecond.value(UNITS::kph);
-	}	break;
+		return acceleration_in_m_s2 / factor::kph.hi;
+		break;
 	case UNITS::mph_s:
-	{	
-		Speed incPerSecond(acceleration_in_m_s2, UNITS::m_s);
-		return incPerSecond.value(UNITS::mph);
-	}	break;
+		return acceleration_in_m_s2 / factor::mph.hi;
+		break;
 	case UNITS::ft_s2:
-		return acceleration_in_m_s2 / .3048;
+		return acceleration_in_m_s2 / factor::ft.hi;
 		break;
 	case UNITS::G:
-		return acceleration_in_m_s2 / 9.80665;
+		return acceleration_in_m_s2 / factor::G.hi;
 		break;
 	}
+	return NAN;
 }
 
-inline void Mass::set(double value, UNITS::MassUnits units) {
+void Mass::set(double value, UNITS::MassUnits units) {
+	MEASUREMENT_COUNT_SET(MASS, units);
 	switch (units) {
 	case UNITS::gram:
 		mass_in_kg = value / 1000;
@@ -430,21 +423,22 @@ inline void Mass::set(double value, UNITS::MassUnits units) {
 		mass_in_kg = value;
 		break;
 	case UNITS::lb:
-		mass_in_kg = value * .45359237;
+		mass_in_kg = value * factor::lb.hi;
 		break;
 	case UNITS::oz:
-		set(value / 16, UNITS::lb);
+		mass_in_kg = value * factor::oz.hi;
 		break;
 	case UNITS::tonne:
 		mass_in_kg = value * 1000;
 		break;
 	case UNITS::ton:
-		set(2000, UNITS::lb);
+		mass_in_kg = value * factor::ton.hi;
 		break;
 	}
 }
 
-inline double Mass::value(UNITS::MassUnits units) {
+double Mass::value(UNITS::MassUnits units) {
+	MEASUREMENT_COUNT_VALUE(MASS, units);
 	switch (units) {
 	case UNITS::gram:
 		return mass_in_kg * 1000;
@@ -453,43 +447,48 @@ inline double Mass::value(UNITS::MassUnits units) {
 		return mass_in_kg;
 		break;
 	case UNITS::lb:
-		return mass_in_kg / .45359237;
+		return mass_in_kg / factor::lb.hi;
 		break;
 	case UNITS::oz:
-		return value(UNITS::lb) * 16;
+		return mass_in_kg / factor::oz.hi;
 		break;
 	case UNITS::tonne:
-		return mass_in_kg * 1000;
+		return mass_in_kg / 1000;
 		break;
 	case UNITS::ton:
-		return value(UNITS::lb) * 2000;
+		return mass_in_kg / factor::ton.hi;
 		break;
 	}
+	return NAN;
 }
 
-inline void Force::set(double value, UNITS::ForceUnits units) {
+void Force::set(double value, UNITS::ForceUnits units) {
+	MEASUREMENT_COUNT_SET(FORCE, units);
 	switch (units) {
 	case UNITS::N:
 		force_in_N = value;
 		break;
 	case UNITS::lbf:
-		force_in_N = value / .2248089431;
+		force_in_N = value * factor::lbf.hi;
 		break;
 	}
 }
 
-inline double Force::value(UNITS::ForceUnits units) {
+double Force::value(UNITS::ForceUnits units) {
+	MEASUREMENT_COUNT_VALUE(FORCE, units);
 	switch (units) {
 	case UNITS::N:
 		return force_in_N;
 		break;
 	case UNITS::lbf:
-		return force_in_N * .2248089431;
+		return force_in_N / factor::lbf.hi;
 		break;
 	}
+	return NAN;
 }
 
-inline void Pressure::set(double value, UNITS::PressureUnits units) {
+void Pressure::set(double value, UNITS::PressureUnits units) {
+	MEASUREMENT_COUNT_SET(PRESSURE, units);
 	switch (units) {
 	case UNITS::Pa:
 		pressure_in_Pa = value;
@@ -501,13 +500,13 @@ inline void Pressure::set(double value, UNITS::PressureUnits units) {
 		pressure_in_Pa = value * 1000000;
 		break;
 	case UNITS::psi:
-		pressure_in_Pa = value * 6894.75729317;
+		pressure_in_Pa = value * factor::psi.hi;
 		break;
 	case UNITS::mmHg:
-		pressure_in_Pa = value * 133.322387415;
+		pressure_in_Pa = value * factor::mmHg.hi;
 		break;
 	case UNITS::inH2O:
-		pressure_in_Pa = value * 249.08891;
+		pressure_in_Pa = value * factor::inH2O.hi;
 		break;
 	case UNITS::bar:
 		pressure_in_Pa = value * 100000;
@@ -518,7 +517,8 @@ inline void Pressure::set(double value, UNITS::PressureUnits units) {
 	}
 }
 
-inline double Pressure::value(UNITS::PressureUnits units) {
+double Pressure::value(UNITS::PressureUnits units) {
+	MEASUREMENT_COUNT_VALUE(PRESSURE, units);
 	switch (units) {
 	case UNITS::Pa:
 		return pressure_in_Pa;
@@ -530,13 +530,13 @@ inline double Pressure::value(UNITS::PressureUnits units) {
 		return pressure_in_Pa / 1000000;
 		break;
 	case UNITS::psi:
-		return pressure_in_Pa / 6894.75729317;
+		return pressure_in_Pa / factor::psi.hi;
 		break;
 	case UNITS::mmHg:
-		return pressure_in_Pa / 133.322387415;
+		return pressure_in_Pa / factor::mmHg.hi;
 		break;
 	case UNITS::inH2O:
-		return pressure_in_Pa / 249.08891;
+		return pressure_in_Pa / factor::inH2O.hi;
 		break;
 	case UNITS::bar:
 		return pressure_in_Pa / 100000;
@@ -545,6 +545,7 @@ inline double Pressure::value(UNITS::PressureUnits units) {
 		return pressure_in_Pa / 101325;
 		break;
 	}
+	return NAN;
 }
 
 
@@ -553,17 +554,18 @@ inline double Pressure::value(UNITS::PressureUnits units) {
 
 //defaults to 0C
 
-inline Temperature::Temperature() {
+Temperature::Temperature() {
 	set(0, UNITS::C);
 }
 
-inline Temperature::Temperature(double value, UNITS::TemperatureUnits units) {
+Temperature::Temperature(double value, UNITS::TemperatureUnits units) {
 	set(value, units);
 }
 
 //J, kJ, mJ, kWh, hph, BTU
 
-inline void Energy::set(double val, UNITS::EnergyUnits units) {
+void Energy::set(double val, UNITS::EnergyUnits units) {
+	MEASUREMENT_COUNT_SET(ENERGY, units);
 	switch (units) {
 	case UNITS::J:
 		energy_in_J = val;
@@ -578,13 +580,13 @@ inline void Energy::set(double val, UNITS::EnergyUnits units) {
 		energy_in_J = val * 3600000;
 		break;
 	case UNITS::hph:
-		energy_in_J = val * 2684519.5368856;
+		energy_in_J = val * factor::hph.hi;
 		break;
 	case UNITS::BTU:
-		energy_in_J = val * 1055.05585262;
+		energy_in_J = val * factor::BTU.hi;
 		break;
 	case UNITS::cal:
-		energy_in_J = val * 4.184;
+		energy_in_J = val * factor::cal.hi;
 		break;
 	case UNITS::kCal:
 		energy_in_J = val * 4184;
@@ -592,7 +594,8 @@ inline void Energy::set(double val, UNITS::EnergyUnits units) {
 	}
 }
 
-inline double Energy::value(UNITS::EnergyUnits units) {
+double Energy::value(UNITS::EnergyUnits units) {
+	MEASUREMENT_COUNT_VALUE(ENERGY, units);
 	switch (units) {
 	case UNITS::J:
 		return energy_in_J;
@@ -607,18 +610,19 @@ inline double Energy::value(UNITS::EnergyUnits units) {
 		return energy_in_J / 3600000;
 		break;
 	case UNITS::hph:
-		return energy_in_J / 2684519.5368856;
+		return energy_in_J / factor::hph.hi;
 		break;
 	case UNITS::BTU:
-		return energy_in_J / 1055.05585262;
+		return energy_in_J / factor::BTU.hi;
 		break;
 	case UNITS::cal:
-		return energy_in_J / 4.184;
+		return energy_in_J / factor::cal.hi;
 		break;
 	case UNITS::kCal:
 		return energy_in_J / 4184;
 		break;
 	}
+	return NAN;
 }
 
 //W, kW, MW, mW, hp, BTU_h
@@ -626,11 +630,12 @@ inline double Energy::value(UNITS::EnergyUnits units) {
 
 //W, kW, MW, mW, hp, BTU_h
 
-inline Power::Power(double val, UNITS::PowerUnits units) {
+Power::Power(double val, UNITS::PowerUnits units) {
 	set(val, units);
 }
 
-inline void Power::set(double val, UNITS::PowerUnits units) {
+void Power::set(double val, UNITS::PowerUnits units) {
+	MEASUREMENT_COUNT_SET(POWER, units);
 	switch (units) {
 	case UNITS::W:
 		power_in_W = val;
@@ -645,17 +650,18 @@ inline void Power::set(double val, UNITS::PowerUnits units) {
 		power_in_W = val / 1000;
 		break;
 	case UNITS::hp:
-		power_in_W = val * 745.699872;
+		power_in_W = val * factor::hp.hi;
 		break;
 	case UNITS::BTU_h:
-		power_in_W = val / 3.41;
+		power_in_W = val * factor::BTU_h.hi;
 		break;
 	}
 }
 
 //W, kW, MW, mW, cal, kCal, hp, BTU_h
 
-inline double Power::value(UNITS::PowerUnits units) {
+double Power::value(UNITS::PowerUnits units) {
+	MEASUREMENT_COUNT_VALUE(POWER, units);
 	switch (units) {
 	case UNITS::W:
 		return power_in_W;
@@ -670,18 +676,20 @@ inline double Power::value(UNITS::PowerUnits units) {
 		return power_in_W * 1000;
 		break;
 	case UNITS::hp:
-		return power_in_W / 745.699872;
+		return power_in_W / factor::hp.hi;
 		break;
 	case UNITS::BTU_h:
-		return power_in_W * 3.41;
+		return power_in_W / factor::BTU_h.hi;
 		break;
 	}
+	return NAN;
 
 }
 
 //kg_m3, g_cm3, lb_gal
 
-inline void Density::set(double val, UNITS::DensityUnits units) {
+void Density::set(double val, UNITS::DensityUnits units) {
+	MEASUREMENT_COUNT_SET(DENSITY, units);
 	switch (units) {
 	case UNITS::kg_m3:
 		density_relative_to_water = val / 1000;
@@ -690,14 +698,15 @@ inline void Density::set(double val, UNITS::DensityUnits units) {
 		density_relative_to_water = val;
 		break;
 	case UNITS::lb_gal:
-		density_relative_to_water = val * 8.34540445;
+		density_relative_to_water = val * factor::water::lb_gal.hi;
 		break;
 	}
 }
 
 //kg_m3, g_cm3, lb_gal
 
-inline double Density::value(UNITS::DensityUnits units) {
+double Density::value(UNITS::DensityUnits units) {
+	MEASUREMENT_COUNT_VALUE(DENSITY, units);
 	switch (units) {
 	case UNITS::kg_m3:
 		return density_relative_to_water * 1000;
@@ -706,13 +715,15 @@ inline double Density::value(UNITS::DensityUnits units) {
 		return density_relative_to_water;
 		break;
 	case UNITS::lb_gal:
-		return density_relative_to_water / 8.34540445;
+		return density_relative_to_water / factor::water::lb_gal.hi;
 		break;
 	}
+	return NAN;
 
 }
 
-inline void Current::set(double val, UNITS::CurrentUnits units) {
+void Current::set(double val, UNITS::CurrentUnits units) {
+	MEASUREMENT_COUNT_SET(CURRENT, units);
 	switch (units) {
 	case UNITS::A:
 		current_in_A = val;
@@ -729,7 +740,8 @@ inline void Current::set(double val, UNITS::CurrentUnits units) {
 	}
 }
 
-inline double Current::value(UNITS::CurrentUnits units) {
+double Current::value(UNITS::CurrentUnits units) {
+	MEASUREMENT_COUNT_VALUE(CURRENT, units);
 	switch (units) {
 	case UNITS::A:
 		return current_in_A;
@@ -744,9 +756,11 @@ inline double Current::value(UNITS::CurrentUnits units) {
 		return current_in_A / 1000000;
 		break;
 	}
+	return NAN;
 }
 
-inline void Voltage::set(double val, UNITS::VoltageUnits units) {
+void Voltage::set(double val, UNITS::VoltageUnits units) {
+	MEASUREMENT_COUNT_SET(VOLTAGE, units);
 	switch (units) {
 	case UNITS::V:
 		voltage_in_V = val;
@@ -763,7 +777,8 @@ inline void Voltage::set(double val, UNITS::VoltageUnits units) {
 	}
 }
 
-inline double Voltage::value(UNITS::VoltageUnits units) {
+double Voltage::value(UNITS::VoltageUnits units) {
+	MEASUREMENT_COUNT_VALUE(VOLTAGE, units);
 	switch (units) {
 	case UNITS::V:
 		return voltage_in_V;
@@ -778,95 +793,113 @@ inline double Voltage::value(UNITS::VoltageUnits units) {
 		return voltage_in_V / 1000000;
 		break;
 	}
+	return NAN;
 }
 
 //Nm, inlb, ftlb
-inline void Torque::set(double val, UNITS::TorqueUnits units) {
+void Torque::set(double val, UNITS::TorqueUnits units) {
+	MEASUREMENT_COUNT_SET(TORQUE, units);
 	switch (units) {
 	case UNITS::Nm:
 		torque_in_Nm = val;
 		break;
 	case UNITS::inlb:
-		torque_in_Nm = val / 8.85074576737892;
+		torque_in_Nm = val * factor::inlb.hi;
 		break;
 	case UNITS::ftlb:
-		torque_in_Nm = val / (12 * 8.85074576737892);
+		torque_in_Nm = val * factor::ftlb.hi;
 		break;
 	}
 }
 
 //Nm, inlb, ftlb
-inline double Torque::value(UNITS::TorqueUnits units) {
+double Torque::value(UNITS::TorqueUnits units) {
+	MEASUREMENT_COUNT_VALUE(TORQUE, units);
 	switch (units) {
 	case UNITS::Nm:
 		return torque_in_Nm;
 		break;
 	case UNITS::inlb:
-		return torque_in_Nm * 8.85074576737892;
+		return torque_in_Nm / factor::inlb.hi;
 		break;
 	case UNITS::ftlb:
-		return torque_in_Nm * (12 * 8.85074576737892);
+		return torque_in_Nm / factor::ftlb.hi;
 		break;
 	}
+	return NAN;
 }
 
 //rpm, rev_s, rad_s
-inline void RotationSpeed::set(double val, UNITS::RotationSpeedUnits units) {
+void RotationSpeed::set(double val, UNITS::RotationSpeedUnits units) {
+	MEASUREMENT_COUNT_SET(ROTATION_SPEED, units);
 	switch (units) {
 	case (UNITS::rpm):
 		rotationSpeed_in_rpm = val;
 		break;
 	case(UNITS::rev_s):
-		rotationSpeed_in_rpm = val / 60;
+		rotationSpeed_in_rpm = val * factor::revsPerMinute::rev_s.hi;
 		break;
 	case(UNITS::rad_s):
-		rotationSpeed_in_rpm = val / (6.28 * 60);
+		rotationSpeed_in_rpm = val * factor::revsPerMinute::rad_s.hi;
 		break;
 	case(UNITS::deg_s):
-		rotationSpeed_in_rpm = val / (360 * 60);
+		rotationSpeed_in_rpm = val * factor::revsPerMinute::deg_s.hi;
 		break;
 	}
 }
 
 //rpm, rev_s, rad_s
-inline double RotationSpeed::value(UNITS::RotationSpeedUnits units) {
+double RotationSpeed::value(UNITS::RotationSpeedUnits units) {
+	MEASUREMENT_COUNT_VALUE(ROTATION_SPEED, units);
 	switch (units) {
 	case (UNITS::rpm):
 		return rotationSpeed_in_rpm;
 		break;
 	case(UNITS::rev_s):
-		return rotationSpeed_in_rpm * 60;
+		return rotationSpeed_in_rpm / factor::revsPerMinute::rev_s.hi;
 		break;
 	case(UNITS::rad_s):
-		return rotationSpeed_in_rpm * (6.28 * 60);
+		return rotationSpeed_in_rpm / factor::revsPerMinute::rad_s.hi;
 		break;
 	case(UNITS::deg_s):
-		return rotationSpeed_in_rpm * (360 * 60);
+		return rotationSpeed_in_rpm / factor::revsPerMinute::deg_s.hi;
 		break;
 	}
+	return NAN;
+}
+
+//signed, so braking torque gives negative power
+Power Torque::operator* (RotationSpeed speed) {
+	return Power(value(UNITS::Nm) * speed.value(UNITS::rad_s), UNITS::W);
+}
+
+Power RotationSpeed::operator*(Torque torque) {
+	return Power(value(UNITS::rad_s) * torque.value(UNITS::Nm), UNITS::W);
 }
 
-inline void Capacitance::set(double val, UNITS::CapacitanceUnits units) {
+void Capacitance::set(double val, UNITS::CapacitanceUnits units) {
+	MEASUREMENT_COUNT_SET(CAPACITANCE, units);
 	switch (units) {
 	case(UNITS::Farad):
 		capacitance_in_Farad = val;
 		break;
 	case(UNITS::mF):
-		capacitance_in_Farad = val * 0.001;
+		capacitance_in_Farad = val / 1000;
 		break;
 	case(UNITS::uF):
-		capacitance_in_Farad = val * 0.000001;
+		capacitance_in_Farad = val / 1000000;
 		break;
 	case(UNITS::nF):
-		capacitance_in_Farad = val * 0.000000001;
+		capacitance_in_Farad = val / 1000000000;
 		break;
 	case(UNITS::pF):
-		capacitance_in_Farad = val * 0.000000000001;
+		capacitance_in_Farad = val / 1000000000000;
 		break;
 	}
 }
 
-inline double Capacitance::value(UNITS::CapacitanceUnits units) {
+double Capacitance::value(UNITS::CapacitanceUnits units) {
+	MEASUREMENT_COUNT_VALUE(CAPACITANCE, units);
 	switch (units) {
 	case(UNITS::Farad):
 		return capacitance_in_Farad;
@@ -884,16 +917,18 @@ inline double Capacitance::value(UNITS::CapacitanceUnits units) {
 		return capacitance_in_Farad * 1000000000000;
 		break;
 	}
+	return NAN;
 }
 
 // Ohm, mOhm, kOhm, MOhm
-inline void Resistance::set(double val, UNITS::ResistanceUnits units) {
+void Resistance::set(double val, UNITS::ResistanceUnits units) {
+	MEASUREMENT_COUNT_SET(RESISTANCE, units);
 	switch (units) {
 	case(UNITS::Ohm):
 		resistance_in_Ohm = val;
 		break;
 	case(UNITS::mOhm):
-		resistance_in_Ohm = val * .001;
+		resistance_in_Ohm = val / 1000;
 		break;
 	case(UNITS::kOhm):
 		resistance_in_Ohm = val * 1000;
@@ -905,7 +940,8 @@ inline void Resistance::set(double val, UNITS::ResistanceUnits units) {
 }
 
 //Ohm, mOhm, kOhm, MOhm
-inline double Resistance::value(UNITS::ResistanceUnits units) {
+double Resistance::value(UNITS::ResistanceUnits units) {
+	MEASUREMENT_COUNT_VALUE(RESISTANCE, units);
 	switch (units) {
 	case(UNITS::Ohm):
 		return resistance_in_Ohm;
@@ -914,11 +950,12 @@ inline double Resistance::value(UNITS::ResistanceUnits units) {
 		return resistance_in_Ohm * 1000;
 		break;
 	case(UNITS::kOhm):
-		return resistance_in_Ohm * .001;
+		return resistance_in_Ohm / 1000;
 		break;
 	case(UNITS::MOhm):
-		return resistance_in_Ohm * .000001;
+		return resistance_in_Ohm / 1000000;
 		break;
 	}
+	return NAN;
 
 }
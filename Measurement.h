@@ -27,6 +27,8 @@ Area - m2, cm2, mm2, um2, km2, in2, ft2, yd2, mi2, acre, hectare
 */
 
 #include "Angle.h"
+#include "Factors.h"
+#include "Instrumentation.h"
 class TimeDuration;
 class Length;
 class Area;
@@ -72,6 +74,11 @@ namespace UNITS {
 }
 
 
+//tag for the constexpr constructors that take a value already in SI units
+struct SIValue {};
+//tag for the constexpr constructors of Volume, Density and RotationSpeed that take the value they keep, which is not SI
+struct StoredValue {};
+
 struct YR_DAY_HR_MIN_SEC {
 	int years;
 	int days;
@@ -86,6 +93,8 @@ public:
 	TimeDuration() {
 		time_in_s = 0;
 	}
+	//value in s, usable in constant expressions
+	constexpr TimeDuration(SIValue, double val) : time_in_s(val) {}
 	TimeDuration(double val, UNITS::TimeUnits units) {
 		set(val, units);
 	}
@@ -164,6 +173,8 @@ public:
 	Length() {
 		length_in_m = 0;
 	}
+	//value in m, usable in constant expressions
+	constexpr Length(SIValue, double val) : length_in_m(val) {}
 	//m, cm, mm, um, km, in, ft, yd, mi
 	Length(double val, UNITS::LengthUnits units) {
 		set(val, units);
@@ -184,23 +195,13 @@ public:
 	Length operator* (double val) {
 		return Length(value(UNITS::m) * val, UNITS::m);
 	}
-	Area operator* (Length length) {
-		return Area(value(UNITS::m) * length.value(UNITS::m), UNITS::m2);
-	}
-	Volume operator* (Area area) {
-		return Volume(value(UNITS::m) * area.value(UNITS::m2), UNITS::m3);
-	}
-	Energy operator* (Force f) {
-		return Energy(value(UNITS::m) * f.value(UNITS::N), UNITS::J);
-	}
+	Area operator* (Length length);
+	Volume operator* (Area area);
+	Energy operator* (Force f);
 	double operator/ (Length length) {
 		return (value(UNITS::m) / length.value(UNITS::m));
 	}
-	Speed operator/ (TimeDuration time) {
-		double meters = value(UNITS::m);
-		double secs = time.value(UNITS::s);
-		return Speed(meters / secs, UNITS::m_s);
-	}
+	Speed operator/ (TimeDuration time);
 	bool operator> (Length length) {
 		return (value(UNITS::m) > length.value(UNITS::m));
 	}
@@ -244,6 +245,8 @@ public:
 	Area() {
 		area_in_m2 = 0;
 	}
+	//value in m2, usable in constant expressions
+	constexpr Area(SIValue, double val) : area_in_m2(val) {}
 	//m2, cm2, mm2, um2, km2, in2, ft2, yd2, mi2, acre, hectare
 	Area(double val, UNITS::AreaUnits units) {
 		set(val, units);
@@ -264,12 +267,8 @@ public:
 	Area operator/ (double val) {
 		return Area(value(UNITS::m2) / val, UNITS::m2);
 	}
-	Volume operator* (Length length) {
-		return Volume(value(UNITS::m2) * length.value(UNITS::m), UNITS::m3);
-	}
-	Length operator/ (Length length) {
-		return Length(value(UNITS::m2) / length.value(UNITS::m), UNITS::m);
-	}
+	Volume operator* (Length length);
+	Length operator/ (Length length);
 	double operator/ (Area area) {
 		return (value(UNITS::m2) / area.value(UNITS::m2));
 	}
@@ -301,6 +300,10 @@ public:
 	Volume() {
 		volume_in_L = 0;
 	}
+	//value in m3, usable in constant expressions
+	constexpr Volume(SIValue, double val) : volume_in_L(val * 1000) {}
+	//value in L, usable in constant expressions
+	constexpr Volume(StoredValue, double val) : volume_in_L(val) {}
 	//m3, cm3, mm3, km3, L, mL, in3, ft3, yd3, mi3, tsp, tbsp, cup, pint, quart, gallon, barrel
 	Volume(double val, UNITS::VolumeUnits units) {
 		set(val, units);
@@ -321,12 +324,8 @@ public:
 	Volume operator/ (double factor) {
 		return Volume(value(UNITS::L) / factor, UNITS::L);
 	}
-	Area operator/ (Length length) {
-		return Area(value(UNITS::L) / length.value(UNITS::m), UNITS::m2);
-	}
-	Length operator/ (Area area) {
-		return Length(value(UNITS::L) / area.value(UNITS::m2), UNITS::m);
-	}
+	Area operator/ (Length length);
+	Length operator/ (Area area);
 	bool operator> (Volume vol) {
 		return (value(UNITS::m3) > vol.value(UNITS::m3));
 	}
@@ -355,6 +354,8 @@ public:
 	Speed() {
 		speed_in_m_s = 0;
 	}
+	//value in m_s, usable in constant expressions
+	constexpr Speed(SIValue, double val) : speed_in_m_s(val) {}
 	//m_s, kph, mph, ft_s, G
 	Speed(double val, UNITS::SpeedUnits units) {
 		set(val, units);
@@ -369,12 +370,8 @@ public:
 	Speed operator- (Speed speed) {
 		return Speed(value(UNITS::m_s) - speed.value(UNITS::m_s), UNITS::m_s);
 	}
-	Acceleration operator/ (TimeDuration time) {
-		return Acceleration(value(UNITS::m_s) / time.value(UNITS::s), UNITS::m_s2);
-	}
-	Length operator* (TimeDuration time) {
-		return Length(value(UNITS::m_s) * time.value(UNITS::s), UNITS::m);
-	}
+	Acceleration operator/ (TimeDuration time);
+	Length operator* (TimeDuration time);
 	Speed operator* (double val) {
 		return Speed(value(UNITS::m_s) * val, UNITS::m_s);
 	}
@@ -415,6 +412,8 @@ public:
 	Acceleration() {
 		acceleration_in_m_s2 = 0;
 	}
+	//value in m_s2, usable in constant expressions
+	constexpr Acceleration(SIValue, double val) : acceleration_in_m_s2(val) {}
 	// m_s2, kph_s, mph_s, ft_s2, G
 	Acceleration(double value, UNITS::AccelerationUnits units) {
 		set(value, units);
@@ -435,12 +434,8 @@ public:
 	Acceleration operator/ (double val) {
 		return Acceleration(value(UNITS::m_s2) / val, UNITS::m_s2);
 	}
-	Speed operator* (TimeDuration time) {
-		return Speed(value(UNITS::m_s2) * time.value(UNITS::s), UNITS::m_s);
-	}
-	Force operator* (Mass mass) {
-		return Force(value(UNITS::m_s2) * mass.value(UNITS::kg), UNITS::N);
-	}
+	Speed operator* (TimeDuration time);
+	Force operator* (Mass mass);
 	bool operator> (Acceleration accel) {
 		return (value(UNITS::m_s2) > accel.value(UNITS::m_s2));
 	}
@@ -475,6 +470,8 @@ public:
 	Mass() {
 		mass_in_kg = 0;
 	}
+	//value in kg, usable in constant expressions
+	constexpr Mass(SIValue, double val) : mass_in_kg(val) {}
 	//gram, kg, lb, oz, tonne, ton
 	Mass(double value, UNITS::MassUnits units) {
 		set(value, units);
@@ -495,12 +492,8 @@ public:
 	Mass operator/ (double val) {
 		return Mass(value(UNITS::kg) / val, UNITS::kg);
 	}
-	Force operator* (Acceleration accel) {
-		return Force(value(UNITS::kg) * accel.value(UNITS::m_s2), UNITS::N);
-	}
-	Density operator/ (Volume vol) {
-		return Density(value(UNITS::kg) / vol.value(UNITS::m3), UNITS::kg_m3);
-	}
+	Force operator* (Acceleration accel);
+	Density operator/ (Volume vol);
 	bool operator> (Mass mass) {
 		return (value(UNITS::kg) > mass.value(UNITS::kg));
 	}
@@ -529,6 +522,8 @@ public:
 	Force() {
 		force_in_N = 0;
 	}
+	//value in N, usable in constant expressions
+	constexpr Force(SIValue, double val) : force_in_N(val) {}
 	//N, lbf
 	Force(double value, UNITS::ForceUnits units) {
 		set(value, units);
@@ -549,18 +544,10 @@ public:
 	Force operator/ (double val) {
 		return Force(value(UNITS::N) / val, UNITS::N);
 	}
-	Energy operator* (Length distance) {
-		return Energy(value(UNITS::N) + distance.value(UNITS::m), UNITS::J);
-	}
-	Acceleration operator/ (Mass mass) {
-		return Acceleration(value(UNITS::N) / mass.value(UNITS::kg), UNITS::m_s2);
-	}
-	Mass operator/ (Acceleration accel) {
-		return Mass(value(UNITS::N) / accel.value(UNITS::m_s2), UNITS::kg);
-	}
-	Pressure operator/ (Area area) {
-		return Pressure(value(UNITS::N) / area.value(UNITS::m2), UNITS::Pa);
-	}
+	Energy operator* (Length distance);
+	Acceleration operator/ (Mass mass);
+	Mass operator/ (Acceleration accel);
+	Pressure operator/ (Area area);
 	bool operator> (Force force) {
 		return (value(UNITS::N) > force.value(UNITS::N));
 	}
@@ -595,6 +582,8 @@ public:
 	Pressure() {
 		pressure_in_Pa = 0;
 	}
+	//value in Pa, usable in constant expressions
+	constexpr Pressure(SIValue, double val) : pressure_in_Pa(val) {}
 	//Pa, kPa, MPa, psi, mmHg, inH2O, bar, atm
 	Pressure(double value, UNITS::PressureUnits units) {
 		set(value, units);
@@ -615,9 +604,7 @@ public:
 	Pressure operator/ (double val) {
 		return Pressure(value(UNITS::Pa) / val, UNITS::Pa);
 	}
-	Force operator* (Area area) {
-		return Force(area.value(UNITS::m2) * value(UNITS::Pa), UNITS::N);
-	}
+	Force operator* (Area area);
 	bool operator> (Pressure press) {
 		return (value(UNITS::Pa) > press.value(UNITS::Pa));
 	}
@@ -652,6 +639,8 @@ public:
 	Energy() {
 		energy_in_J = 0;
 	}
+	//value in J, usable in constant expressions
+	constexpr Energy(SIValue, double val) : energy_in_J(val) {}
 	//J, kJ, mJ, kWh, hph, BTU, cal, kCal
 	Energy(double val, UNITS::EnergyUnits units) {
 		set(val, units);
@@ -671,29 +660,17 @@ public:
 	Energy operator/ (double val) {
 		return Energy(value(UNITS::J) / val, UNITS::J);
 	}
-	Power operator/ (TimeDuration time) {
-		return Power(value(UNITS::J) / time.value(UNITS::s), UNITS::W);
-	}
-	Force operator/ (Length distance) {
-		return Force(value(UNITS::J) / distance.value(UNITS::m), UNITS::N);
-	}
-	Length operator/ (Force force) {
-		return Length(value(UNITS::J) / force.value(UNITS::N), UNITS::m);
-	}
-	Pressure operator/ (Volume vol) {
-		return Pressure(value(UNITS::J) / vol.value(UNITS::m3), UNITS::Pa);
-	}
-	Volume operator/ (Pressure p) {
-		return Volume(value(UNITS::J) / p.value(UNITS::Pa), UNITS::m3);
-	}
-	void operator= (Torque torque) {
-		set(torque.value(UNITS::Nm), UNITS::J);
-	}
+	Power operator/ (TimeDuration time);
+	Force operator/ (Length distance);
+	Length operator/ (Force force);
+	Pressure operator/ (Volume vol);
+	Volume operator/ (Pressure p);
+	void operator= (Torque torque);
 	bool operator> (Energy energy) {
 		return (value(UNITS::J) > energy.value(UNITS::J));
 	}
 	bool operator>= (Energy energy) {
-		return (value(UNITS::J) > energy.value(UNITS::J));
+		return (value(UNITS::J) >= energy.value(UNITS::J));
 	}
 	bool operator< (Energy energy) {
 		return (value(UNITS::J) < energy.value(UNITS::J));
@@ -707,9 +684,7 @@ public:
 	bool operator!= (Energy energy) {
 		return (value(UNITS::J) != energy.value(UNITS::J));
 	}
-	operator Torque() {
-		return Torque(value(UNITS::J), UNITS::Nm);
-	}
+	operator Torque();
 protected:
 	double energy_in_J;
 };
@@ -720,6 +695,8 @@ public:
 	Power() {
 		power_in_W = 0;
 	}
+	//value in W, usable in constant expressions
+	constexpr Power(SIValue, double val) : power_in_W(val) {}
 	//W, kW, MW, mW, hp, BTU_h
 	Power(double val, UNITS::PowerUnits units);
 	//W, kW, MW, mW, hp, BTU_h
@@ -738,26 +715,16 @@ public:
 	Power operator/ (double val) {
 		return Power(value(UNITS::W) / val, UNITS::W);
 	}
-	Energy operator* (TimeDuration time) {
-		return Energy(value(UNITS::W) * time.value(UNITS::s), UNITS::J);
-	}
-	Voltage operator/ (Current current) {
-		return Voltage(value(UNITS::W) / current.value(UNITS::A), UNITS::V);
-	}
-	Current operator/ (Voltage volts) {
-		return Current(value(UNITS::W) / volts.value(UNITS::V), UNITS::A);
-	}
-	Speed operator/ (Force force) {
-		return Speed(value(UNITS::W) / force.value(UNITS::N), UNITS::m_s);
-	}
-	Force operator/ (Speed velocity) {
-		return Force(value(UNITS::W) / velocity.value(UNITS::m_s), UNITS::N);
-	}
+	Energy operator* (TimeDuration time);
+	Voltage operator/ (Current current);
+	Current operator/ (Voltage volts);
+	Speed operator/ (Force force);
+	Force operator/ (Speed velocity);
 	bool operator> (Power energy) {
 		return (value(UNITS::W) > energy.value(UNITS::W));
 	}
 	bool operator>= (Power energy) {
-		return (value(UNITS::W) > energy.value(UNITS::W));
+		return (value(UNITS::W) >= energy.value(UNITS::W));
 	}
 	bool operator< (Power energy) {
 		return (value(UNITS::W) < energy.value(UNITS::W));
@@ -781,6 +748,10 @@ public:
 	Density() {
 		density_relative_to_water = 0;
 	}
+	//value in kg_m3, usable in constant expressions
+	constexpr Density(SIValue, double val) : density_relative_to_water(val / 1000) {}
+	//value in g_cm3, usable in constant expressions
+	constexpr Density(StoredValue, double val) : density_relative_to_water(val) {}
 	//kg_m3, g_cm3, lb_gal
 	Density(double val, UNITS::DensityUnits units) {
 		set(val, units);
@@ -801,14 +772,12 @@ public:
 	Density operator/ (double val) {
 		return Density(value(UNITS::kg_m3) / val, UNITS::kg_m3);
 	}
-	Mass operator* (Volume vol) {
-		return Mass(value(UNITS::g_cm3) * vol.value(UNITS::cm3), UNITS::gram);
-	}
+	Mass operator* (Volume vol);
 	bool operator> (Density energy) {
 		return (value(UNITS::kg_m3) > energy.value(UNITS::kg_m3));
 	}
 	bool operator>= (Density energy) {
-		return (value(UNITS::kg_m3) > energy.value(UNITS::kg_m3));
+		return (value(UNITS::kg_m3) >= energy.value(UNITS::kg_m3));
 	}
 	bool operator< (Density energy) {
 		return (value(UNITS::kg_m3) < energy.value(UNITS::kg_m3));
@@ -831,10 +800,13 @@ class Temperature {
 public:
 	//defaults to 0C
 	Temperature();
+	//value in K, usable in constant expressions
+	constexpr Temperature(SIValue, double val) : temperature_in_K(val) {}
 	//C, K, F, R
 	Temperature(double value, UNITS::TemperatureUnits units);
 	//C, K, F, R
 	void set(double value, UNITS::TemperatureUnits units) {
+		MEASUREMENT_COUNT_SET(TEMPERATURE, units);
 		switch (units) {
 		case UNITS::C:
 			temperature_in_K = value + 273.15;
@@ -843,15 +815,16 @@ public:
 			temperature_in_K = value;
 			break;
 		case UNITS::F:
-			temperature_in_K = (value + 459.67) / 1.8;
+			temperature_in_K = value * factor::degreeF.hi + factor::zeroF.hi;
 			break;
 		case UNITS::R:
-			temperature_in_K = value / 1.8;
+			temperature_in_K = value * factor::degreeF.hi;
 			break;
 		}
 	}
 	//C, K, F, R
 	double value(UNITS::TemperatureUnits units) {
+		MEASUREMENT_COUNT_VALUE(TEMPERATURE, units);
 		switch (units) {
 		case UNITS::C:
 			return temperature_in_K - 273.15;
@@ -860,12 +833,13 @@ public:
 			return temperature_in_K;
 			break;
 		case UNITS::F:
-			return temperature_in_K * 1.8 - 459.67;
+			return (temperature_in_K - factor::zeroF.hi) / factor::degreeF.hi;
 			break;
 		case UNITS::R:
-			return temperature_in_K * 1.8;
+			return temperature_in_K / factor::degreeF.hi;
 			break;
 		}
+		return NAN;
 	}
 	Temperature operator+ (Temperature temp) {
 		return Temperature(value(UNITS::K) + temp.value(UNITS::K), UNITS::K);
@@ -900,6 +874,8 @@ public:
 	Voltage() {
 		voltage_in_V = 0;
 	}
+	//value in V, usable in constant expressions
+	constexpr Voltage(SIValue, double val) : voltage_in_V(val) {}
 	//value in Volts
 	Voltage(double val) {
 		set(val, UNITS::V);
@@ -928,12 +904,8 @@ public:
 	Voltage operator/ (double val) {
 		return Voltage(value(UNITS::V) / val, UNITS::V);
 	}
-	Power operator* (Current c) {
-		return Power(value(UNITS::V) * c.value(UNITS::A), UNITS::W);
-	}
-	Resistance operator/ (Current c) {
-		return Resistance(value(UNITS::V) / c.value(UNITS::A), UNITS::Ohm);
-	}
+	Power operator* (Current c);
+	Resistance operator/ (Current c);
 	bool operator> (Voltage v) {
 		return (value(UNITS::V) > v.value(UNITS::V));
 	}
@@ -967,6 +939,8 @@ public:
 	Current() {
 		current_in_A = 0;
 	}
+	//value in A, usable in constant expressions
+	constexpr Current(SIValue, double val) : current_in_A(val) {}
 	//current in Amps
 	Current(double val) {
 		set(val, UNITS::A);
@@ -999,9 +973,7 @@ public:
 	Current operator/(double val) {
 		return Current(value(UNITS::A) / val, UNITS::A);
 	}
-	Power operator* (Voltage v) {
-		return Power(value(UNITS::A) * v.value(UNITS::V), UNITS::W);
-	}
+	Power operator* (Voltage v);
 	bool operator> (Current c) {
 		return (value(UNITS::A) > c.value(UNITS::A));
 	}
@@ -1035,6 +1007,8 @@ public:
 	Torque() {
 		torque_in_Nm = 0;
 	}
+	//value in Nm, usable in constant expressions
+	constexpr Torque(SIValue, double val) : torque_in_Nm(val) {}
 	//Nm, inlb, ftlb
 	Torque(double val, UNITS::TorqueUnits units) {
 		set(val, units);
@@ -1055,25 +1029,18 @@ public:
 	Torque operator/ (double val) {
 		return Torque(value(UNITS::Nm) / val, UNITS::Nm);
 	}
-	Length operator/ (Force f) {
-		return Length(value(UNITS::Nm) / f.value(UNITS::N), UNITS::m);
-	}
-	Force operator/ (Length l) {
-		return Force(value(UNITS::Nm) / l.value(UNITS::m), UNITS::N);
-	}
-	/*Power operator* (RotationSpeed speed) {
-		Power myPower = Power(value(UNITS::Nm) * speed.value(UNITS::rev_s) * 6.28318530718, UNITS::W);
-		return myPower;
-			//Power(value(UNITS::Nm) * speed.value(UNITS::rev_s) * 6.28318530718, UNITS::W);
-	}*/
+	Length operator/ (Force f);
+	Force operator/ (Length l);
+	//shaft power, negative when the torque works against the rotation
+	Power operator* (RotationSpeed speed);
 	bool operator> (Torque t) {
 		return (value(UNITS::Nm) > t.value(UNITS::Nm));
 	}
 	bool operator>= (Torque t) {
-		return (value(UNITS::Nm) > t.value(UNITS::Nm));
+		return (value(UNITS::Nm) >= t.value(UNITS::Nm));
 	}
 	bool operator< (Torque t) {
-		return (value(UNITS::Nm) > t.value(UNITS::Nm));
+		return (value(UNITS::Nm) < t.value(UNITS::Nm));
 	}
 	bool operator<= (Torque t) {
 		return (value(UNITS::Nm) <= t.value(UNITS::Nm));
@@ -1090,9 +1057,7 @@ public:
 	bool operator--() {
 		return (value(UNITS::Nm) < 0);
 	}
-	operator Energy() {
-		return Energy(value(UNITS::Nm), UNITS::J);
-	}
+	operator Energy();
 protected:
 	double torque_in_Nm;
 };
@@ -1102,6 +1067,10 @@ public:
 	RotationSpeed() {
 		rotationSpeed_in_rpm = 0;
 	}
+	//value in rad_s, usable in constant expressions
+	constexpr RotationSpeed(SIValue, double val) : rotationSpeed_in_rpm(val * 60 / 6.283185307179586) {}
+	//value in rpm, usable in constant expressions
+	constexpr RotationSpeed(StoredValue, double val) : rotationSpeed_in_rpm(val) {}
 	//rpm, rev_s, rad_s
 	RotationSpeed(double val, UNITS::RotationSpeedUnits units) {
 		set(val, units);
@@ -1122,20 +1091,9 @@ public:
 	RotationSpeed operator/(double val) {
 		return RotationSpeed(value(UNITS::rpm) / val, UNITS::rpm);
 	}
-	Power operator*(Torque torque) {
-		double RPM = value(UNITS::rpm);
-		if (RPM < 0) {
-			RPM = -RPM;;
-		}
-		double t = torque.value(UNITS::Nm);
-		if (torque--) {
-			t = -t;
-		}
-		return Power(RPM * t, UNITS::W);
-	}
-	Angle operator*(TimeDuration time) {
-		return Angle(value(UNITS::rpm) * time.value(UNITS::min), REVOLUTIONS);
-	}
+	//shaft power, negative when the torque works against the rotation
+	Power operator*(Torque torque);
+	Angle operator*(TimeDuration time);
 	bool operator> (RotationSpeed speed) {
 		return (value(UNITS::rpm) > speed.value(UNITS::rpm));
 	}
@@ -1170,6 +1128,8 @@ public:
 	Resistance() {
 		resistance_in_Ohm = 0;
 	}
+	//value in Ohm, usable in constant expressions
+	constexpr Resistance(SIValue, double val) : resistance_in_Ohm(val) {}
 	//Ohm, mOhm, kOhm, MOhm
 	Resistance(double val, UNITS::ResistanceUnits units) {
 		set(val, units);
@@ -1193,9 +1153,7 @@ public:
 	Resistance operator/(double val) {
 		return Resistance(value(UNITS::Ohm) / val, UNITS::Ohm);
 	}
-	Voltage operator*(Current c) {
-		return Voltage(value(UNITS::Ohm) * c.value(UNITS::A), UNITS::V);
-	}
+	Voltage operator*(Current c);
 	bool operator>(Resistance R) {
 		return (value(UNITS::Ohm) > R.value(UNITS::Ohm));
 	}
@@ -1223,6 +1181,8 @@ public:
 	Capacitance() {
 		capacitance_in_Farad = 0;
 	}
+	//value in Farad, usable in constant expressions
+	constexpr Capacitance(SIValue, double val) : capacitance_in_Farad(val) {}
 	//Farad, uF, mF, nF, pF
 	Capacitance(double val, UNITS::CapacitanceUnits units) {
 		set(val, units);
@@ -1267,3 +1227,167 @@ public:
 protected:
 	double capacitance_in_Farad;
 };
+
+//members that use other quantities, defined here once every class is complete
+
+inline Area Length::operator* (Length length) {
+	return Area(value(UNITS::m) * length.value(UNITS::m), UNITS::m2);
+}
+
+inline Volume Length::operator* (Area area) {
+	return Volume(value(UNITS::m) * area.value(UNITS::m2), UNITS::m3);
+}
+
+inline Energy Length::operator* (Force f) {
+	return Energy(value(UNITS::m) * f.value(UNITS::N), UNITS::J);
+}
+
+inline Speed Length::operator/ (TimeDuration time) {
+	double meters = value(UNITS::m);
+	double secs = time.value(UNITS::s);
+	return Speed(meters / secs, UNITS::m_s);
+}
+
+inline Volume Area::operator* (Length length) {
+	return Volume(value(UNITS::m2) * length.value(UNITS::m), UNITS::m3);
+}
+
+inline Length Area::operator/ (Length length) {
+	return Length(value(UNITS::m2) / length.value(UNITS::m), UNITS::m);
+}
+
+inline Area Volume::operator/ (Length length) {
+	return Area(value(UNITS::m3) / length.value(UNITS::m), UNITS::m2);
+}
+
+inline Length Volume::operator/ (Area area) {
+	return Length(value(UNITS::m3) / area.value(UNITS::m2), UNITS::m);
+}
+
+inline Acceleration Speed::operator/ (TimeDuration time) {
+	return Acceleration(value(UNITS::m_s) / time.value(UNITS::s), UNITS::m_s2);
+}
+
+inline Length Speed::operator* (TimeDuration time) {
+	return Length(value(UNITS::m_s) * time.value(UNITS::s), UNITS::m);
+}
+
+inline Speed Acceleration::operator* (TimeDuration time) {
+	return Speed(value(UNITS::m_s2) * time.value(UNITS::s), UNITS::m_s);
+}
+
+inline Force Acceleration::operator* (Mass mass) {
+	return Force(value(UNITS::m_s2) * mass.value(UNITS::kg), UNITS::N);
+}
+
+inline Force Mass::operator* (Acceleration accel) {
+	return Force(value(UNITS::kg) * accel.value(UNITS::m_s2), UNITS::N);
+}
+
+inline Density Mass::operator/ (Volume vol) {
+	return Density(value(UNITS::kg) / vol.value(UNITS::m3), UNITS::kg_m3);
+}
+
+inline Energy Force::operator* (Length distance) {
+	return Energy(value(UNITS::N) * distance.value(UNITS::m), UNITS::J);
+}
+
+inline Acceleration Force::operator/ (Mass mass) {
+	return Acceleration(value(UNITS::N) / mass.value(UNITS::kg), UNITS::m_s2);
+}
+
+inline Mass Force::operator/ (Acceleration accel) {
+	return Mass(value(UNITS::N) / accel.value(UNITS::m_s2), UNITS::kg);
+}
+
+inline Pressure Force::operator/ (Area area) {
+	return Pressure(value(UNITS::N) / area.value(UNITS::m2), UNITS::Pa);
+}
+
+inline Force Pressure::operator* (Area area) {
+	return Force(area.value(UNITS::m2) * value(UNITS::Pa), UNITS::N);
+}
+
+inline Power Energy::operator/ (TimeDuration time) {
+	return Power(value(UNITS::J) / time.value(UNITS::s), UNITS::W);
+}
+
+inline Force Energy::operator/ (Length distance) {
+	return Force(value(UNITS::J) / distance.value(UNITS::m), UNITS::N);
+}
+
+inline Length Energy::operator/ (Force force) {
+	return Length(value(UNITS::J) / force.value(UNITS::N), UNITS::m);
+}
+
+inline Pressure Energy::operator/ (Volume vol) {
+	return Pressure(value(UNITS::J) / vol.value(UNITS::m3), UNITS::Pa);
+}
+
+inline Volume Energy::operator/ (Pressure p) {
+	return Volume(value(UNITS::J) / p.value(UNITS::Pa), UNITS::m3);
+}
+
+inline void Energy::operator= (Torque torque) {
+	set(torque.value(UNITS::Nm), UNITS::J);
+}
+
+inline Energy::operator Torque() {
+	return Torque(value(UNITS::J), UNITS::Nm);
+}
+
+inline Energy Power::operator* (TimeDuration time) {
+	return Energy(value(UNITS::W) * time.value(UNITS::s), UNITS::J);
+}
+
+inline Voltage Power::operator/ (Current current) {
+	return Voltage(value(UNITS::W) / current.value(UNITS::A), UNITS::V);
+}
+
+inline Current Power::operator/ (Voltage volts) {
+	return Current(value(UNITS::W) / volts.value(UNITS::V), UNITS::A);
+}
+
+inline Speed Power::operator/ (Force force) {
+	return Speed(value(UNITS::W) / force.value(UNITS::N), UNITS::m_s);
+}
+
+inline Force Power::operator/ (Speed velocity) {
+	return Force(value(UNITS::W) / velocity.value(UNITS::m_s), UNITS::N);
+}
+
+inline Mass Density::operator* (Volume vol) {
+	return Mass(value(UNITS::g_cm3) * vol.value(UNITS::cm3), UNITS::gram);
+}
+
+inline Power Voltage::operator* (Current c) {
+	return Power(value(UNITS::V) * c.value(UNITS::A), UNITS::W);
+}
+
+inline Resistance Voltage::operator/ (Current c) {
+	return Resistance(value(UNITS::V) / c.value(UNITS::A), UNITS::Ohm);
+}
+
+inline Power Current::operator* (Voltage v) {
+	return Power(value(UNITS::A) * v.value(UNITS::V), UNITS::W);
+}
+
+inline Length Torque::operator/ (Force f) {
+	return Length(value(UNITS::Nm) / f.value(UNITS::N), UNITS::m);
+}
+
+inline Force Torque::operator/ (Length l) {
+	return Force(value(UNITS::Nm) / l.value(UNITS::m), UNITS::N);
+}
+
+inline Torque::operator Energy() {
+	return Energy(value(UNITS::Nm), UNITS::J);
+}
+
+inline Angle RotationSpeed::operator*(TimeDuration time) {
+	return Angle(value(UNITS::rpm) * time.value(UNITS::min), REVOLUTIONS);
+}
+
+inline Voltage Resistance::operator*(Current c) {
+	return Voltage(value(UNITS::Ohm) * c.value(UNITS::A), UNITS::V);
+}
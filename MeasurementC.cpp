@@ -0,0 +1,326 @@
+//the shared library target defines this itself, the static library gets it here
+#ifndef MEASUREMENT_C_BUILD
+#define MEASUREMENT_C_BUILD
+#endif
+#include "MeasurementC.h"
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include "Parallel.h"
+#include "Precise.h"
+#include "Quantities.h"
+
+//every id in MeasurementC.h must still be quantity << 8 | position in its UNITS enum
+#define MSR_CHECK_UNIT(QUANTITY, UNIT) \
+	static_assert(MSR_##UNIT == MSR_UNIT_ID(QUANTITY, UNITS::UNIT), "MeasurementC.h is out of step with UNITS::" #UNIT);
+MSR_UNIT_LIST(MSR_CHECK_UNIT)
+
+//arrays shorter than this stay on the calling thread
+static const size_t PARALLEL_MINIMUM = 1 << 18;
+
+static std::atomic<unsigned> requestedThreads(0);
+
+template <class A, class B, class = void>
+struct ProductIndex {
+	static const int value = MSR_QUANTITY_COUNT;
+};
+
+template <class A, class B>
+struct ProductIndex<A, B, std::void_t<typename ProductType<A, B>::type> > {
+	static const int value = QuantityOf<typename ProductType<A, B>::type>::value;
+};
+
+template <class A, class B, class = void>
+struct QuotientIndex {
+	static const int value = MSR_QUANTITY_COUNT;
+};
+
+template <class A, class B>
+struct QuotientIndex<A, B, std::void_t<typename QuotientType<A, B>::type> > {
+	static const int value = QuantityOf<typename QuotientType<A, B>::type>::value;
+};
+
+//result quantities of the C++ operators, read off Measurement.h rather than written out by hand
+struct OperatorTables {
+	unsigned char product[MSR_QUANTITY_COUNT][MSR_QUANTITY_COUNT];
+	unsigned char quotient[MSR_QUANTITY_COUNT][MSR_QUANTITY_COUNT];
+};
+
+template <size_t A, size_t... B>
+static void fillRow(OperatorTables& tables, std::index_sequence<B...>) {
+	((tables.product[A][B] = ProductIndex<typename QuantityClass<A>::type, typename QuantityClass<B>::type>::value), ...);
+	((tables.quotient[A][B] = QuotientIndex<typename QuantityClass<A>::type, typename QuantityClass<B>::type>::value), ...);
+}
+
+template <size_t... A>
+static void fillTables(OperatorTables& tables, std::index_sequence<A...>) {
+	(fillRow<A>(tables, std::make_index_sequence<MSR_QUANTITY_COUNT>()), ...);
+}
+
+static const OperatorTables& operatorTables() {
+	static const OperatorTables tables = [] {
+		OperatorTables t;
+		fillTables(t, std::make_index_sequence<MSR_QUANTITY_COUNT>());
+		//some products are only defined one way round, e.g. Speed * TimeDuration
+		for (int a = 0; a < MSR_QUANTITY_COUNT; a++) {
+			for (int b = 0; b < MSR_QUANTITY_COUNT; b++) {
+				if (t.product[a][b] == MSR_QUANTITY_COUNT) {
+					t.product[a][b] = t.product[b][a];
+				}
+			}
+		}
+		return t;
+	}();
+	return tables;
+}
+
+struct UnitName {
+	msr_unit id;
+	const char* name;
+};
+
+#define MSR_UNIT_NAME(QUANTITY, UNIT) { MSR_##UNIT, #UNIT },
+static const UnitName UNIT_NAMES[] = { MSR_UNIT_LIST(MSR_UNIT_NAME) };
+static const size_t UNIT_COUNT = sizeof(UNIT_NAMES) / sizeof(UNIT_NAMES[0]);
+
+static bool knownUnit(msr_unit unit) {
+	for (size_t i = 0; i < UNIT_COUNT; i++) {
+		if (UNIT_NAMES[i].id == unit) {
+			return true;
+		}
+	}
+	return false;
+}
+
+typedef DoubleDouble (*FactorFunction)(int index);
+
+template <class T>
+static DoubleDouble scaleOf(int index) {
+	return UnitFactors<T>::scale((typename SIUnit<T>::Units)index);
+}
+
+template <class T>
+static DoubleDouble offsetOf(int index) {
+	return UnitFactors<T>::offset((typename SIUnit<T>::Units)index);
+}
+
+#define MSR_SCALE_OF(QUANTITY, TYPE) scaleOf<TYPE>,
+#define MSR_OFFSET_OF(QUANTITY, TYPE) offsetOf<TYPE>,
+static const FactorFunction SCALES[] = { MEASUREMENT_QUANTITY_LIST(MSR_SCALE_OF) };
+static const FactorFunction OFFSETS[] = { MEASUREMENT_QUANTITY_LIST(MSR_OFFSET_OF) };
+
+//exact scale and offset of a known unit to SI
+static DoubleDouble unitScale(msr_unit unit) {
+	return SCALES[MSR_UNIT_QUANTITY(unit)](unit & 0xff);
+}
+
+static DoubleDouble unitOffset(msr_unit unit) {
+	return OFFSETS[MSR_UNIT_QUANTITY(unit)](unit & 0xff);
+}
+
+//folded in double-double, so each conversion is rounded once
+static UnitConversion conversion(msr_unit from, msr_unit to) {
+	DoubleDouble toScale = unitScale(to);
+	UnitConversion conv;
+	conv.scale = (unitScale(from) / toScale).hi;
+	conv.offset = ((unitOffset(from) - unitOffset(to)) / toScale).hi;
+	return conv;
+}
+
+template <class F>
+static void run(size_t n, F fn) {
+	parallelFor(n, threadCount(n, PARALLEL_MINIMUM, requestedThreads.load(std::memory_order_relaxed)), fn);
+}
+
+//checks shared by the binary operations
+static msr_status checkBinary(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n) {
+	if (!knownUnit(aUnit) || !knownUnit(bUnit) || !knownUnit(outUnit)) {
+		return MSR_UNKNOWN_UNIT;
+	}
+	if (n && (!a || !b || !out)) {
+		return MSR_NULL_ARRAY;
+	}
+	return MSR_OK;
+}
+
+int msr_abi_version(void) {
+	return MSR_ABI_VERSION;
+}
+
+msr_unit msr_unit_from_name(const char* name) {
+	if (!name) {
+		return MSR_INVALID_UNIT;
+	}
+	for (size_t i = 0; i < UNIT_COUNT; i++) {
+		if (std::strcmp(UNIT_NAMES[i].name, name) == 0) {
+			return UNIT_NAMES[i].id;
+		}
+	}
+	return MSR_INVALID_UNIT;
+}
+
+const char* msr_unit_name(msr_unit unit) {
+	for (size_t i = 0; i < UNIT_COUNT; i++) {
+		if (UNIT_NAMES[i].id == unit) {
+			return UNIT_NAMES[i].name;
+		}
+	}
+	return 0;
+}
+
+msr_quantity msr_unit_quantity(msr_unit unit) {
+	return knownUnit(unit) ? MSR_UNIT_QUANTITY(unit) : MSR_QUANTITY_COUNT;
+}
+
+msr_quantity msr_product_quantity(msr_quantity a, msr_quantity b) {
+	if (a < 0 || a >= MSR_QUANTITY_COUNT || b < 0 || b >= MSR_QUANTITY_COUNT) {
+		return MSR_QUANTITY_COUNT;
+	}
+	return (msr_quantity)operatorTables().product[a][b];
+}
+
+msr_quantity msr_quotient_quantity(msr_quantity a, msr_quantity b) {
+	if (a < 0 || a >= MSR_QUANTITY_COUNT || b < 0 || b >= MSR_QUANTITY_COUNT) {
+		return MSR_QUANTITY_COUNT;
+	}
+	return (msr_quantity)operatorTables().quotient[a][b];
+}
+
+void msr_set_threads(unsigned threads) {
+	requestedThreads.store(threads, std::memory_order_relaxed);
+}
+
+msr_status msr_convert_f64(const double* in, double* out, size_t n, msr_unit from, msr_unit to) {
+	if (!knownUnit(from) || !knownUnit(to)) {
+		return MSR_UNKNOWN_UNIT;
+	}
+	if (MSR_UNIT_QUANTITY(from) != MSR_UNIT_QUANTITY(to)) {
+		return MSR_INCOMPATIBLE_UNITS;
+	}
+	if (n && (!in || !out)) {
+		return MSR_NULL_ARRAY;
+	}
+	if (from == to) {
+		if (in != out) {
+			std::memmove(out, in, n * sizeof(double));
+		}
+		return MSR_OK;
+	}
+	UnitConversion conv = conversion(from, to);
+	run(n, [=](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			out[i] = in[i] * conv.scale + conv.offset;
+		}
+	});
+	return MSR_OK;
+}
+
+msr_status msr_convert_f32(const float* in, float* out, size_t n, msr_unit from, msr_unit to) {
+	if (!knownUnit(from) || !knownUnit(to)) {
+		return MSR_UNKNOWN_UNIT;
+	}
+	if (MSR_UNIT_QUANTITY(from) != MSR_UNIT_QUANTITY(to)) {
+		return MSR_INCOMPATIBLE_UNITS;
+	}
+	if (n && (!in || !out)) {
+		return MSR_NULL_ARRAY;
+	}
+	//worked in double, rounded to float once
+	UnitConversion conv = conversion(from, to);
+	run(n, [=](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			out[i] = (float)(in[i] * conv.scale + conv.offset);
+		}
+	});
+	return MSR_OK;
+}
+
+//out = a * ka + b * kb + k, the SI sum or difference mapped straight to outUnit
+static msr_status addScaled(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n, double sign) {
+	msr_status status = checkBinary(a, aUnit, b, bUnit, out, outUnit, n);
+	if (status != MSR_OK) {
+		return status;
+	}
+	if (MSR_UNIT_QUANTITY(aUnit) != MSR_UNIT_QUANTITY(bUnit) || MSR_UNIT_QUANTITY(aUnit) != MSR_UNIT_QUANTITY(outUnit)) {
+		return MSR_INCOMPATIBLE_UNITS;
+	}
+	DoubleDouble outScale = unitScale(outUnit);
+	double ka = (unitScale(aUnit) / outScale).hi;
+	double kb = sign * (unitScale(bUnit) / outScale).hi;
+	double k = ((unitOffset(aUnit) + unitOffset(bUnit) * sign - unitOffset(outUnit)) / outScale).hi;
+	run(n, [=](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			out[i] = a[i] * ka + b[i] * kb + k;
+		}
+	});
+	return MSR_OK;
+}
+
+msr_status msr_add_f64(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n) {
+	return addScaled(a, aUnit, b, bUnit, out, outUnit, n, 1);
+}
+
+msr_status msr_subtract_f64(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n) {
+	return addScaled(a, aUnit, b, bUnit, out, outUnit, n, -1);
+}
+
+msr_status msr_multiply_f64(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n) {
+	msr_status status = checkBinary(a, aUnit, b, bUnit, out, outUnit, n);
+	if (status != MSR_OK) {
+		return status;
+	}
+	if (msr_product_quantity(MSR_UNIT_QUANTITY(aUnit), MSR_UNIT_QUANTITY(bUnit)) != MSR_UNIT_QUANTITY(outUnit)) {
+		return MSR_INCOMPATIBLE_UNITS;
+	}
+	//no quantity with an offset has a product, so the three scales fold into one
+	double k = (unitScale(aUnit) * unitScale(bUnit) / unitScale(outUnit)).hi;
+	run(n, [=](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			out[i] = a[i] * b[i] * k;
+		}
+	});
+	return MSR_OK;
+}
+
+msr_status msr_divide_f64(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n) {
+	msr_status status = checkBinary(a, aUnit, b, bUnit, out, outUnit, n);
+	if (status != MSR_OK) {
+		return status;
+	}
+	if (msr_quotient_quantity(MSR_UNIT_QUANTITY(aUnit), MSR_UNIT_QUANTITY(bUnit)) != MSR_UNIT_QUANTITY(outUnit)) {
+		return MSR_INCOMPATIBLE_UNITS;
+	}
+	double k = (unitScale(aUnit) / (unitScale(bUnit) * unitScale(outUnit))).hi;
+	run(n, [=](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			out[i] = a[i] / b[i] * k;
+		}
+	});
+	return MSR_OK;
+}
+
+msr_status msr_sum_f64(const double* in, msr_unit inUnit, size_t n, double* out, msr_unit outUnit) {
+	if (!knownUnit(inUnit) || !knownUnit(outUnit)) {
+		return MSR_UNKNOWN_UNIT;
+	}
+	if (MSR_UNIT_QUANTITY(inUnit) != MSR_UNIT_QUANTITY(outUnit)) {
+		return MSR_INCOMPATIBLE_UNITS;
+	}
+	if (!out || (n && !in)) {
+		return MSR_NULL_ARRAY;
+	}
+	double total = parallelSum(n, threadCount(n, PARALLEL_MINIMUM, requestedThreads.load(std::memory_order_relaxed)),
+		[=](size_t begin, size_t end) {
+			double sum = 0;
+			for (size_t i = begin; i < end; i++) {
+				sum += in[i];
+			}
+			return sum;
+		});
+	//the offset is added once per value, as the C++ operator+ does in SI
+	DoubleDouble outScale = unitScale(outUnit);
+	double scale = (unitScale(inUnit) / outScale).hi;
+	double offset = ((unitOffset(inUnit) * (double)n - unitOffset(outUnit)) / outScale).hi;
+	*out = total * scale + offset;
+	return MSR_OK;
+}
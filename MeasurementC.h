@@ -0,0 +1,363 @@
+#pragma once
+
+/*
+MEASUREMENT C
+=============
+
+Stable C interface for calling the library from other languages, built as the
+shared library libmeasurement_c. Everything works on whole arrays, so one call
+from Python, Rust or Go converts millions of values at C++ speed instead of
+crossing the FFI boundary once per value.
+
+double psi[4] = { 14.7, 30, 60, 120 };
+double kPa[4];
+if (msr_convert_f64(psi, kPa, 4, MSR_psi, MSR_kPa) != MSR_OK) { ... }
+
+//force in lbf times distance in ft, written out as energy in J
+msr_multiply_f64(force, MSR_lbf, distance, MSR_ft, work, MSR_J, n);
+
+A unit id is its quantity in the high byte and its position in the matching
+UNITS enum in the low byte, so MSR_psi is 0x0803 because psi is entry 3 of
+UNITS::PressureUnits. New units are only ever appended to the enums, so ids
+never change once published. MeasurementC.cpp checks every id against UNITS at
+compile time.
+
+Conversions use the exact factors from Factors.h, folded into a single scale
+and offset per call, so each element costs one multiply-add. Arrays longer than
+a few hundred thousand values are split between threads. in and out may be the
+same array, but must not otherwise overlap.
+
+Values are what the C++ classes would hold: temperatures are absolute, so
+adding 10 C to 10 C gives 293.15 C, the same as Temperature::operator+.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#ifdef MEASUREMENT_C_BUILD
+#define MSR_API __declspec(dllexport)
+#else
+#define MSR_API __declspec(dllimport)
+#endif
+#else
+#define MSR_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//bumped only if an existing function or id changes meaning
+#define MSR_ABI_VERSION 1
+
+typedef uint32_t msr_unit;
+
+//same order as the measurement classes
+typedef enum msr_quantity {
+	MSR_TIME_DURATION, MSR_LENGTH, MSR_AREA, MSR_VOLUME, MSR_SPEED, MSR_ACCELERATION, MSR_MASS, MSR_FORCE,
+	MSR_PRESSURE, MSR_ENERGY, MSR_POWER, MSR_DENSITY, MSR_TEMPERATURE, MSR_VOLTAGE, MSR_CURRENT,
+	MSR_CAPACITANCE, MSR_RESISTANCE, MSR_ROTATION_SPEED, MSR_TORQUE,
+	MSR_QUANTITY_COUNT
+} msr_quantity;
+
+typedef enum msr_status {
+	MSR_OK = 0,
+	//an id that is not in the list below
+	MSR_UNKNOWN_UNIT,
+	//units of the wrong quantities for the operation
+	MSR_INCOMPATIBLE_UNITS,
+	//a null array with n > 0
+	MSR_NULL_ARRAY
+} msr_status;
+
+#define MSR_UNIT_ID(QUANTITY, INDEX) ((msr_unit)(QUANTITY) << 8 | (msr_unit)(INDEX))
+#define MSR_UNIT_QUANTITY(UNIT) ((msr_quantity)((UNIT) >> 8))
+
+enum {
+	//TimeDuration
+	MSR_s = 0x0000,
+	MSR_min = 0x0001,
+	MSR_hr = 0x0002,
+	MSR_day = 0x0003,
+	MSR_week = 0x0004,
+	MSR_yr = 0x0005,
+	MSR_ms = 0x0006,
+	MSR_us = 0x0007,
+	MSR_ns = 0x0008,
+	//Length
+	MSR_m = 0x0100,
+	MSR_cm = 0x0101,
+	MSR_mm = 0x0102,
+	MSR_um = 0x0103,
+	MSR_km = 0x0104,
+	MSR_in = 0x0105,
+	MSR_ft = 0x0106,
+	MSR_yd = 0x0107,
+	MSR_mi = 0x0108,
+	//Area
+	MSR_m2 = 0x0200,
+	MSR_cm2 = 0x0201,
+	MSR_mm2 = 0x0202,
+	MSR_um2 = 0x0203,
+	MSR_km2 = 0x0204,
+	MSR_in2 = 0x0205,
+	MSR_ft2 = 0x0206,
+	MSR_yd2 = 0x0207,
+	MSR_mi2 = 0x0208,
+	MSR_acre = 0x0209,
+	MSR_hectare = 0x020a,
+	//Volume
+	MSR_m3 = 0x0300,
+	MSR_cm3 = 0x0301,
+	MSR_mm3 = 0x0302,
+	MSR_km3 = 0x0303,
+	MSR_L = 0x0304,
+	MSR_mL = 0x0305,
+	MSR_in3 = 0x0306,
+	MSR_ft3 = 0x0307,
+	MSR_yd3 = 0x0308,
+	MSR_mi3 = 0x0309,
+	MSR_tsp = 0x030a,
+	MSR_tbsp = 0x030b,
+	MSR_cup = 0x030c,
+	MSR_pint = 0x030d,
+	MSR_quart = 0x030e,
+	MSR_gallon = 0x030f,
+	MSR_barrel = 0x0310,
+	//Speed
+	MSR_m_s = 0x0400,
+	MSR_kph = 0x0401,
+	MSR_mph = 0x0402,
+	MSR_ft_s = 0x0403,
+	//Acceleration
+	MSR_m_s2 = 0x0500,
+	MSR_kph_s = 0x0501,
+	MSR_mph_s = 0x0502,
+	MSR_ft_s2 = 0x0503,
+	MSR_G = 0x0504,
+	//Mass
+	MSR_gram = 0x0600,
+	MSR_kg = 0x0601,
+	MSR_lb = 0x0602,
+	MSR_oz = 0x0603,
+	MSR_tonne = 0x0604,
+	MSR_ton = 0x0605,
+	//Force
+	MSR_N = 0x0700,
+	MSR_lbf = 0x0701,
+	//Pressure
+	MSR_Pa = 0x0800,
+	MSR_kPa = 0x0801,
+	MSR_MPa = 0x0802,
+	MSR_psi = 0x0803,
+	MSR_mmHg = 0x0804,
+	MSR_inH2O = 0x0805,
+	MSR_bar = 0x0806,
+	MSR_atm = 0x0807,
+	//Energy
+	MSR_J = 0x0900,
+	MSR_kJ = 0x0901,
+	MSR_MJ = 0x0902,
+	MSR_kWh = 0x0903,
+	MSR_hph = 0x0904,
+	MSR_BTU = 0x0905,
+	MSR_cal = 0x0906,
+	MSR_kCal = 0x0907,
+	//Power
+	MSR_W = 0x0a00,
+	MSR_kW = 0x0a01,
+	MSR_MW = 0x0a02,
+	MSR_mW = 0x0a03,
+	MSR_hp = 0x0a04,
+	MSR_BTU_h = 0x0a05,
+	//Density
+	MSR_kg_m3 = 0x0b00,
+	MSR_g_cm3 = 0x0b01,
+	MSR_lb_gal = 0x0b02,
+	//Temperature
+	MSR_C = 0x0c00,
+	MSR_K = 0x0c01,
+	MSR_F = 0x0c02,
+	MSR_R = 0x0c03,
+	//Voltage
+	MSR_V = 0x0d00,
+	MSR_mV = 0x0d01,
+	MSR_kV = 0x0d02,
+	MSR_MV = 0x0d03,
+	//Current
+	MSR_A = 0x0e00,
+	MSR_mA = 0x0e01,
+	MSR_kA = 0x0e02,
+	MSR_MA = 0x0e03,
+	//Capacitance
+	MSR_Farad = 0x0f00,
+	MSR_uF = 0x0f01,
+	MSR_mF = 0x0f02,
+	MSR_nF = 0x0f03,
+	MSR_pF = 0x0f04,
+	//Resistance
+	MSR_Ohm = 0x1000,
+	MSR_mOhm = 0x1001,
+	MSR_kOhm = 0x1002,
+	MSR_MOhm = 0x1003,
+	//RotationSpeed
+	MSR_rpm = 0x1100,
+	MSR_rev_s = 0x1101,
+	MSR_rad_s = 0x1102,
+	MSR_deg_s = 0x1103,
+	//Torque
+	MSR_Nm = 0x1200,
+	MSR_inlb = 0x1201,
+	MSR_ftlb = 0x1202,
+	MSR_INVALID_UNIT = 0xffff
+};
+
+//every unit as X(quantity, unit name), for building tables on either side of the interface
+#define MSR_UNIT_LIST(X) \
+	X(MSR_TIME_DURATION, s) \
+	X(MSR_TIME_DURATION, min) \
+	X(MSR_TIME_DURATION, hr) \
+	X(MSR_TIME_DURATION, day) \
+	X(MSR_TIME_DURATION, week) \
+	X(MSR_TIME_DURATION, yr) \
+	X(MSR_TIME_DURATION, ms) \
+	X(MSR_TIME_DURATION, us) \
+	X(MSR_TIME_DURATION, ns) \
+	X(MSR_LENGTH, m) \
+	X(MSR_LENGTH, cm) \
+	X(MSR_LENGTH, mm) \
+	X(MSR_LENGTH, um) \
+	X(MSR_LENGTH, km) \
+	X(MSR_LENGTH, in) \
+	X(MSR_LENGTH, ft) \
+	X(MSR_LENGTH, yd) \
+	X(MSR_LENGTH, mi) \
+	X(MSR_AREA, m2) \
+	X(MSR_AREA, cm2) \
+	X(MSR_AREA, mm2) \
+	X(MSR_AREA, um2) \
+	X(MSR_AREA, km2) \
+	X(MSR_AREA, in2) \
+	X(MSR_AREA, ft2) \
+	X(MSR_AREA, yd2) \
+	X(MSR_AREA, mi2) \
+	X(MSR_AREA, acre) \
+	X(MSR_AREA, hectare) \
+	X(MSR_VOLUME, m3) \
+	X(MSR_VOLUME, cm3) \
+	X(MSR_VOLUME, mm3) \
+	X(MSR_VOLUME, km3) \
+	X(MSR_VOLUME, L) \
+	X(MSR_VOLUME, mL) \
+	X(MSR_VOLUME, in3) \
+	X(MSR_VOLUME, ft3) \
+	X(MSR_VOLUME, yd3) \
+	X(MSR_VOLUME, mi3) \
+	X(MSR_VOLUME, tsp) \
+	X(MSR_VOLUME, tbsp) \
+	X(MSR_VOLUME, cup) \
+	X(MSR_VOLUME, pint) \
+	X(MSR_VOLUME, quart) \
+	X(MSR_VOLUME, gallon) \
+	X(MSR_VOLUME, barrel) \
+	X(MSR_SPEED, m_s) \
+	X(MSR_SPEED, kph) \
+	X(MSR_SPEED, mph) \
+	X(MSR_SPEED, ft_s) \
+	X(MSR_ACCELERATION, m_s2) \
+	X(MSR_ACCELERATION, kph_s) \
+	X(MSR_ACCELERATION, mph_s) \
+	X(MSR_ACCELERATION, ft_s2) \
+	X(MSR_ACCELERATION, G) \
+	X(MSR_MASS, gram) \
+	X(MSR_MASS, kg) \
+	X(MSR_MASS, lb) \
+	X(MSR_MASS, oz) \
+	X(MSR_MASS, tonne) \
+	X(MSR_MASS, ton) \
+	X(MSR_FORCE, N) \
+	X(MSR_FORCE, lbf) \
+	X(MSR_PRESSURE, Pa) \
+	X(MSR_PRESSURE, kPa) \
+	X(MSR_PRESSURE, MPa) \
+	X(MSR_PRESSURE, psi) \
+	X(MSR_PRESSURE, mmHg) \
+	X(MSR_PRESSURE, inH2O) \
+	X(MSR_PRESSURE, bar) \
+	X(MSR_PRESSURE, atm) \
+	X(MSR_ENERGY, J) \
+	X(MSR_ENERGY, kJ) \
+	X(MSR_ENERGY, MJ) \
+	X(MSR_ENERGY, kWh) \
+	X(MSR_ENERGY, hph) \
+	X(MSR_ENERGY, BTU) \
+	X(MSR_ENERGY, cal) \
+	X(MSR_ENERGY, kCal) \
+	X(MSR_POWER, W) \
+	X(MSR_POWER, kW) \
+	X(MSR_POWER, MW) \
+	X(MSR_POWER, mW) \
+	X(MSR_POWER, hp) \
+	X(MSR_POWER, BTU_h) \
+	X(MSR_DENSITY, kg_m3) \
+	X(MSR_DENSITY, g_cm3) \
+	X(MSR_DENSITY, lb_gal) \
+	X(MSR_TEMPERATURE, C) \
+	X(MSR_TEMPERATURE, K) \
+	X(MSR_TEMPERATURE, F) \
+	X(MSR_TEMPERATURE, R) \
+	X(MSR_VOLTAGE, V) \
+	X(MSR_VOLTAGE, mV) \
+	X(MSR_VOLTAGE, kV) \
+	X(MSR_VOLTAGE, MV) \
+	X(MSR_CURRENT, A) \
+	X(MSR_CURRENT, mA) \
+	X(MSR_CURRENT, kA) \
+	X(MSR_CURRENT, MA) \
+	X(MSR_CAPACITANCE, Farad) \
+	X(MSR_CAPACITANCE, uF) \
+	X(MSR_CAPACITANCE, mF) \
+	X(MSR_CAPACITANCE, nF) \
+	X(MSR_CAPACITANCE, pF) \
+	X(MSR_RESISTANCE, Ohm) \
+	X(MSR_RESISTANCE, mOhm) \
+	X(MSR_RESISTANCE, kOhm) \
+	X(MSR_RESISTANCE, MOhm) \
+	X(MSR_ROTATION_SPEED, rpm) \
+	X(MSR_ROTATION_SPEED, rev_s) \
+	X(MSR_ROTATION_SPEED, rad_s) \
+	X(MSR_ROTATION_SPEED, deg_s) \
+	X(MSR_TORQUE, Nm) \
+	X(MSR_TORQUE, inlb) \
+	X(MSR_TORQUE, ftlb)
+
+MSR_API int msr_abi_version(void);
+//MSR_INVALID_UNIT for a name that is not a unit, names are the UNITS enum names ("psi", "ft_s2")
+MSR_API msr_unit msr_unit_from_name(const char* name);
+//null for an unknown unit
+MSR_API const char* msr_unit_name(msr_unit unit);
+//MSR_QUANTITY_COUNT for an unknown unit
+MSR_API msr_quantity msr_unit_quantity(msr_unit unit);
+//quantity a product or quotient of the two quantities has in the C++ classes, MSR_QUANTITY_COUNT if none
+MSR_API msr_quantity msr_product_quantity(msr_quantity a, msr_quantity b);
+MSR_API msr_quantity msr_quotient_quantity(msr_quantity a, msr_quantity b);
+//threads for large arrays, 0 (the default) uses every hardware thread and 1 keeps work on the calling thread
+MSR_API void msr_set_threads(unsigned threads);
+
+//out[i] = in[i] converted from one unit to another of the same quantity
+MSR_API msr_status msr_convert_f64(const double* in, double* out, size_t n, msr_unit from, msr_unit to);
+MSR_API msr_status msr_convert_f32(const float* in, float* out, size_t n, msr_unit from, msr_unit to);
+
+//out[i] = a[i] + b[i] and a[i] - b[i], all three of one quantity
+MSR_API msr_status msr_add_f64(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n);
+MSR_API msr_status msr_subtract_f64(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n);
+//out[i] = a[i] * b[i] and a[i] / b[i], outUnit of the quantity the C++ operator returns
+MSR_API msr_status msr_multiply_f64(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n);
+MSR_API msr_status msr_divide_f64(const double* a, msr_unit aUnit, const double* b, msr_unit bUnit, double* out, msr_unit outUnit, size_t n);
+//sum of n values, written to *out in outUnit
+MSR_API msr_status msr_sum_f64(const double* in, msr_unit inUnit, size_t n, double* out, msr_unit outUnit);
+
+#ifdef __cplusplus
+}
+#endif
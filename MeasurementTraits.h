@@ -0,0 +1,384 @@
+#pragma once
+
+/*
+MEASUREMENT TRAITS
+==================
+
+Maps each measurement class to the unit it is normalized to, so that templates
+can get at the raw SI number without knowing which class they were handed.
+
+toSI(Length(1, UNITS::ft))		-> 0.3048
+fromSI<Length>(0.3048)			-> 1 ft
+
+UnitConversion turns a unit into a scale and offset once, for loops that
+convert many values to or from the same unit. The scale and offset are rounded
+once from the exact factors in UnitFactors, the same ones Precise uses, so a
+conversion of an offset unit like F matches set() and value() to rounding.
+conversionFromStored() and conversionToStored() go straight between a unit and
+the double a class keeps (storedValue()), so a loop over measurements needs no
+call to value() and vectorizes.
+
+Plain doubles are treated as dimensionless and pass straight through.
+*/
+
+#include <cstring>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+#include "Factors.h"
+#include "Measurement.h"
+
+//unit is the SI unit, stored the unit the class keeps its value in
+template <class T> struct SIUnit;
+
+template <> struct SIUnit<TimeDuration> {
+	typedef UNITS::TimeUnits Units;
+	static const UNITS::TimeUnits unit = UNITS::s;
+	static const UNITS::TimeUnits stored = UNITS::s;
+};
+template <> struct SIUnit<Length> {
+	typedef UNITS::LengthUnits Units;
+	static const UNITS::LengthUnits unit = UNITS::m;
+	static const UNITS::LengthUnits stored = UNITS::m;
+};
+template <> struct SIUnit<Area> {
+	typedef UNITS::AreaUnits Units;
+	static const UNITS::AreaUnits unit = UNITS::m2;
+	static const UNITS::AreaUnits stored = UNITS::m2;
+};
+template <> struct SIUnit<Volume> {
+	typedef UNITS::VolumeUnits Units;
+	static const UNITS::VolumeUnits unit = UNITS::m3;
+	static const UNITS::VolumeUnits stored = UNITS::L;
+};
+template <> struct SIUnit<Speed> {
+	typedef UNITS::SpeedUnits Units;
+	static const UNITS::SpeedUnits unit = UNITS::m_s;
+	static const UNITS::SpeedUnits stored = UNITS::m_s;
+};
+template <> struct SIUnit<Acceleration> {
+	typedef UNITS::AccelerationUnits Units;
+	static const UNITS::AccelerationUnits unit = UNITS::m_s2;
+	static const UNITS::AccelerationUnits stored = UNITS::m_s2;
+};
+template <> struct SIUnit<Mass> {
+	typedef UNITS::MassUnits Units;
+	static const UNITS::MassUnits unit = UNITS::kg;
+	static const UNITS::MassUnits stored = UNITS::kg;
+};
+template <> struct SIUnit<Force> {
+	typedef UNITS::ForceUnits Units;
+	static const UNITS::ForceUnits unit = UNITS::N;
+	static const UNITS::ForceUnits stored = UNITS::N;
+};
+template <> struct SIUnit<Pressure> {
+	typedef UNITS::PressureUnits Units;
+	static const UNITS::PressureUnits unit = UNITS::Pa;
+	static const UNITS::PressureUnits stored = UNITS::Pa;
+};
+template <> struct SIUnit<Energy> {
+	typedef UNITS::EnergyUnits Units;
+	static const UNITS::EnergyUnits unit = UNITS::J;
+	static const UNITS::EnergyUnits stored = UNITS::J;
+};
+template <> struct SIUnit<Power> {
+	typedef UNITS::PowerUnits Units;
+	static const UNITS::PowerUnits unit = UNITS::W;
+	static const UNITS::PowerUnits stored = UNITS::W;
+};
+template <> struct SIUnit<Density> {
+	typedef UNITS::DensityUnits Units;
+	static const UNITS::DensityUnits unit = UNITS::kg_m3;
+	static const UNITS::DensityUnits stored = UNITS::g_cm3;
+};
+template <> struct SIUnit<Temperature> {
+	typedef UNITS::TemperatureUnits Units;
+	static const UNITS::TemperatureUnits unit = UNITS::K;
+	static const UNITS::TemperatureUnits stored = UNITS::K;
+};
+template <> struct SIUnit<Voltage> {
+	typedef UNITS::VoltageUnits Units;
+	static const UNITS::VoltageUnits unit = UNITS::V;
+	static const UNITS::VoltageUnits stored = UNITS::V;
+};
+template <> struct SIUnit<Current> {
+	typedef UNITS::CurrentUnits Units;
+	static const UNITS::CurrentUnits unit = UNITS::A;
+	static const UNITS::CurrentUnits stored = UNITS::A;
+};
+template <> struct SIUnit<Capacitance> {
+	typedef UNITS::CapacitanceUnits Units;
+	static const UNITS::CapacitanceUnits unit = UNITS::Farad;
+	static const UNITS::CapacitanceUnits stored = UNITS::Farad;
+};
+template <> struct SIUnit<Resistance> {
+	typedef UNITS::ResistanceUnits Units;
+	static const UNITS::ResistanceUnits unit = UNITS::Ohm;
+	static const UNITS::ResistanceUnits stored = UNITS::Ohm;
+};
+template <> struct SIUnit<RotationSpeed> {
+	typedef UNITS::RotationSpeedUnits Units;
+	static const UNITS::RotationSpeedUnits unit = UNITS::rad_s;
+	static const UNITS::RotationSpeedUnits stored = UNITS::rpm;
+};
+template <> struct SIUnit<Torque> {
+	typedef UNITS::TorqueUnits Units;
+	static const UNITS::TorqueUnits unit = UNITS::Nm;
+	static const UNITS::TorqueUnits stored = UNITS::Nm;
+};
+template <> struct SIUnit<Angle> {
+	typedef AngleUnits Units;
+	static const AngleUnits unit = RADIANS;
+	static const AngleUnits stored = RADIANS;
+};
+
+//measurement class for a unit enum, e.g. MeasurementOf<UNITS::PressureUnits>::type is Pressure
+template <class Units> struct MeasurementOf;
+
+template <> struct MeasurementOf<UNITS::TimeUnits> {
+	typedef TimeDuration type;
+};
+template <> struct MeasurementOf<UNITS::LengthUnits> {
+	typedef Length type;
+};
+template <> struct MeasurementOf<UNITS::AreaUnits> {
+	typedef Area type;
+};
+template <> struct MeasurementOf<UNITS::VolumeUnits> {
+	typedef Volume type;
+};
+template <> struct MeasurementOf<UNITS::SpeedUnits> {
+	typedef Speed type;
+};
+template <> struct MeasurementOf<UNITS::AccelerationUnits> {
+	typedef Acceleration type;
+};
+template <> struct MeasurementOf<UNITS::MassUnits> {
+	typedef Mass type;
+};
+template <> struct MeasurementOf<UNITS::ForceUnits> {
+	typedef Force type;
+};
+template <> struct MeasurementOf<UNITS::PressureUnits> {
+	typedef Pressure type;
+};
+template <> struct MeasurementOf<UNITS::EnergyUnits> {
+	typedef Energy type;
+};
+template <> struct MeasurementOf<UNITS::PowerUnits> {
+	typedef Power type;
+};
+template <> struct MeasurementOf<UNITS::DensityUnits> {
+	typedef Density type;
+};
+template <> struct MeasurementOf<UNITS::TemperatureUnits> {
+	typedef Temperature type;
+};
+template <> struct MeasurementOf<UNITS::VoltageUnits> {
+	typedef Voltage type;
+};
+template <> struct MeasurementOf<UNITS::CurrentUnits> {
+	typedef Current type;
+};
+template <> struct MeasurementOf<UNITS::CapacitanceUnits> {
+	typedef Capacitance type;
+};
+template <> struct MeasurementOf<UNITS::ResistanceUnits> {
+	typedef Resistance type;
+};
+template <> struct MeasurementOf<UNITS::RotationSpeedUnits> {
+	typedef RotationSpeed type;
+};
+template <> struct MeasurementOf<UNITS::TorqueUnits> {
+	typedef Torque type;
+};
+template <> struct MeasurementOf<AngleUnits> {
+	typedef Angle type;
+};
+
+//scale and offset from each unit to SI as DoubleDouble, indexed by the UNITS enum
+template <class T> struct UnitFactors;
+
+#define MEASUREMENT_UNIT_FACTORS(TYPE, ...) \
+	template <> struct UnitFactors<TYPE> { \
+		static constexpr DoubleDouble SCALES[] = { __VA_ARGS__ }; \
+		static constexpr DoubleDouble scale(SIUnit<TYPE>::Units units) { \
+			return SCALES[units]; \
+		} \
+		static constexpr DoubleDouble offset(SIUnit<TYPE>::Units) { \
+			return DoubleDouble{ 0, 0 }; \
+		} \
+	};
+
+//factors of ten are exact in double, so they go straight in
+MEASUREMENT_UNIT_FACTORS(TimeDuration, { 1, 0 }, factor::min, factor::hr, factor::day, factor::week, factor::yr,
+	exactFactor<std::milli>(), exactFactor<std::micro>(), exactFactor<std::nano>())
+MEASUREMENT_UNIT_FACTORS(Length, { 1, 0 }, exactFactor<std::centi>(), exactFactor<std::milli>(), exactFactor<std::micro>(),
+	{ 1e3, 0 }, factor::in, factor::ft, factor::yd, factor::mi)
+MEASUREMENT_UNIT_FACTORS(Area, { 1, 0 }, exactFactor<std::ratio<1, 10000> >(), exactFactor<std::micro>(), exactFactor<std::pico>(),
+	{ 1e6, 0 }, factor::in2, factor::ft2, factor::yd2, factor::mi2, factor::acre, { 1e4, 0 })
+MEASUREMENT_UNIT_FACTORS(Volume, { 1, 0 }, exactFactor<std::micro>(), exactFactor<std::nano>(), { 1e9, 0 }, factor::L,
+	exactFactor<std::micro>(), factor::in3, factor::ft3, factor::yd3, factor::mi3, factor::tsp, factor::tbsp, factor::cup,
+	factor::pint, factor::quart, factor::gallon, factor::barrel)
+MEASUREMENT_UNIT_FACTORS(Speed, { 1, 0 }, factor::kph, factor::mph, factor::ft)
+MEASUREMENT_UNIT_FACTORS(Acceleration, { 1, 0 }, factor::kph, factor::mph, factor::ft, factor::G)
+MEASUREMENT_UNIT_FACTORS(Mass, exactFactor<std::milli>(), { 1, 0 }, factor::lb, factor::oz, { 1e3, 0 }, factor::ton)
+MEASUREMENT_UNIT_FACTORS(Force, { 1, 0 }, factor::lbf)
+MEASUREMENT_UNIT_FACTORS(Pressure, { 1, 0 }, { 1e3, 0 }, { 1e6, 0 }, factor::psi, factor::mmHg, factor::inH2O, { 1e5, 0 }, { 101325, 0 })
+MEASUREMENT_UNIT_FACTORS(Energy, { 1, 0 }, { 1e3, 0 }, { 1e6, 0 }, { 3.6e6, 0 }, factor::hph, factor::BTU, factor::cal, { 4184, 0 })
+MEASUREMENT_UNIT_FACTORS(Power, { 1, 0 }, { 1e3, 0 }, { 1e6, 0 }, exactFactor<std::milli>(), factor::hp, factor::BTU_h)
+MEASUREMENT_UNIT_FACTORS(Density, { 1, 0 }, { 1e3, 0 }, factor::lb_gal)
+MEASUREMENT_UNIT_FACTORS(Voltage, { 1, 0 }, exactFactor<std::milli>(), { 1e3, 0 }, { 1e6, 0 })
+MEASUREMENT_UNIT_FACTORS(Current, { 1, 0 }, exactFactor<std::milli>(), { 1e3, 0 }, { 1e6, 0 })
+MEASUREMENT_UNIT_FACTORS(Capacitance, { 1, 0 }, exactFactor<std::micro>(), exactFactor<std::milli>(), exactFactor<std::nano>(),
+	exactFactor<std::pico>())
+MEASUREMENT_UNIT_FACTORS(Resistance, { 1, 0 }, exactFactor<std::milli>(), { 1e3, 0 }, { 1e6, 0 })
+MEASUREMENT_UNIT_FACTORS(RotationSpeed, factor::rpm, factor::rev_s, { 1, 0 }, factor::deg_s)
+MEASUREMENT_UNIT_FACTORS(Torque, { 1, 0 }, factor::inlb, factor::ftlb)
+
+template <> struct UnitFactors<Temperature> {
+	//C, K, F, R
+	static constexpr DoubleDouble SCALES[] = { { 1, 0 }, { 1, 0 }, factor::degreeF, factor::degreeF };
+	static constexpr DoubleDouble OFFSETS[] = { exactFactor<std::ratio<27315, 100> >(), { 0, 0 }, factor::zeroF, { 0, 0 } };
+	static constexpr DoubleDouble scale(UNITS::TemperatureUnits units) {
+		return SCALES[units];
+	}
+	static constexpr DoubleDouble offset(UNITS::TemperatureUnits units) {
+		return OFFSETS[units];
+	}
+};
+
+template <> struct UnitFactors<Angle> {
+	static constexpr DoubleDouble SCALES[] = { { 1, 0 }, { Angle::RADIANS_PER_DEGREE, 0 }, { Angle::RADIANS_PER_REVOLUTION, 0 },
+		{ Angle::RADIANS_PER_GRADIAN, 0 }, { Angle::RADIANS_PER_ARCMINUTE, 0 } };
+	static constexpr DoubleDouble scale(AngleUnits units) {
+		return SCALES[units];
+	}
+	static constexpr DoubleDouble offset(AngleUnits) {
+		return DoubleDouble{ 0, 0 };
+	}
+};
+
+//result types of the operators in Measurement.h, e.g. ProductType<Force, Length>::type is Energy
+//they have no type member when the operator does not exist, so templates using them drop out quietly
+template <class A, class B, class = void>
+struct ProductType {};
+
+template <class A, class B>
+struct ProductType<A, B, std::void_t<decltype(std::declval<A&>() * std::declval<B&>())> > {
+	typedef decltype(std::declval<A&>() * std::declval<B&>()) type;
+};
+
+template <class A, class B, class = void>
+struct QuotientType {};
+
+template <class A, class B>
+struct QuotientType<A, B, std::void_t<decltype(std::declval<A&>() / std::declval<B&>())> > {
+	typedef decltype(std::declval<A&>() / std::declval<B&>()) type;
+};
+
+//value of a measurement in its SI unit
+template <class T>
+typename std::enable_if<!std::is_arithmetic<T>::value, double>::type toSI(T val) {
+	return val.value(SIUnit<T>::unit);
+}
+
+template <class T>
+typename std::enable_if<std::is_arithmetic<T>::value, double>::type toSI(T val) {
+	return val;
+}
+
+//builds a measurement from a value in its SI unit
+template <class T>
+T fromSI(double val) {
+	return T(SIValue(), val);
+}
+
+template <>
+inline double fromSI<double>(double val) {
+	return val;
+}
+
+//Angle comes ahead of SIValue in Measurement.h, so it is built from radians directly
+template <>
+inline Angle fromSI<Angle>(double val) {
+	return Angle(val, RADIANS);
+}
+
+//linear map between SI and another unit: out = (in + shift) * scale + offset
+//shift and offset are only non-zero for temperatures, shift when converting out of kelvin
+//so that K - 255.37 cancels exactly before the scale, as value() does it
+struct UnitConversion {
+	double shift = 0;
+	double scale = 1;
+	double offset = 0;
+	double apply(double val) const {
+		return (val + shift) * scale + offset;
+	}
+};
+
+//conversion from SI values to values in units, from the exact factors so offset units lose nothing to cancellation
+template <class T>
+UnitConversion conversionFromSI(typename SIUnit<T>::Units units) {
+	UnitConversion conv;
+	conv.shift = -UnitFactors<T>::offset(units).hi;
+	conv.scale = (DoubleDouble{ 1, 0 } / UnitFactors<T>::scale(units)).hi;
+	return conv;
+}
+
+//conversion from values in units to SI values
+template <class T>
+UnitConversion conversionToSI(typename SIUnit<T>::Units units) {
+	UnitConversion conv;
+	conv.scale = UnitFactors<T>::scale(units).hi;
+	conv.offset = UnitFactors<T>::offset(units).hi;
+	return conv;
+}
+
+//the double a measurement keeps, in SIUnit<T>::stored
+template <class T>
+double storedValue(T val) {
+	static_assert(sizeof(T) == sizeof(double) && std::is_standard_layout<T>::value, "measurements are a single double");
+	double bits;
+	std::memcpy(&bits, &val, sizeof(bits));
+	return bits;
+}
+
+template <class T>
+T fromStored(double val) {
+	static_assert(sizeof(T) == sizeof(double) && std::is_standard_layout<T>::value, "measurements are a single double");
+	T out;
+	std::memcpy(static_cast<void*>(&out), &val, sizeof(val));
+	return out;
+}
+
+//SI value of one stored unit, e.g. 0.001 for Volume which is kept in L
+template <class T>
+double storedScale() {
+	return UnitFactors<T>::scale(SIUnit<T>::stored).hi;
+}
+
+template <>
+inline double storedScale<double>() {
+	return 1;
+}
+
+//conversion from stored values to values in units, for loops that read measurements without calling value()
+template <class T>
+UnitConversion conversionFromStored(typename SIUnit<T>::Units units) {
+	DoubleDouble stored = UnitFactors<T>::scale(SIUnit<T>::stored);
+	UnitConversion conv;
+	conv.shift = -(UnitFactors<T>::offset(units) / stored).hi;
+	conv.scale = (stored / UnitFactors<T>::scale(units)).hi;
+	return conv;
+}
+
+//conversion from values in units to stored values
+template <class T>
+UnitConversion conversionToStored(typename SIUnit<T>::Units units) {
+	DoubleDouble stored = UnitFactors<T>::scale(SIUnit<T>::stored);
+	UnitConversion conv;
+	conv.scale = (UnitFactors<T>::scale(units) / stored).hi;
+	conv.offset = (UnitFactors<T>::offset(units) / stored).hi;
+	return conv;
+}
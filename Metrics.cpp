@@ -0,0 +1,136 @@
+#include "Metrics.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+//starting buffer size, grown by doubling when a scrape does not fit
+static const size_t INITIAL_BUFFER = 4096;
+
+MetricsWriter::MetricsWriter() {
+	text.resize(INITIAL_BUFFER);
+	length = 0;
+	start = 0;
+	counter = false;
+}
+
+void MetricsWriter::begin() {
+	length = 0;
+	start = 0;
+	counter = false;
+}
+
+void MetricsWriter::end() {
+	put("# EOF\n");
+}
+
+const char* MetricsWriter::data() {
+	return text.data() + start;
+}
+
+size_t MetricsWriter::size() {
+	return length - start;
+}
+
+void MetricsWriter::consume(size_t count) {
+	start += count < size() ? count : size();
+	if (start == length) {
+		start = 0;
+		length = 0;
+	}
+}
+
+void MetricsWriter::header(const char* name, const char* suffix, const char* help, MetricType type) {
+	put("# TYPE ");
+	metricName(name, suffix);
+	put(type == COUNTER ? " counter\n" : " gauge\n");
+	put("# UNIT ");
+	metricName(name, suffix);
+	putChar(' ');
+	put(suffix);
+	putChar('\n');
+	if (help && *help) {
+		put("# HELP ");
+		metricName(name, suffix);
+		putChar(' ');
+		putEscaped(help);
+		putChar('\n');
+	}
+}
+
+void MetricsWriter::line(const char* name, const char* suffix, const char* labels, const char* labelValue, double val) {
+	metricName(name, suffix);
+	if (counter) {
+		put("_total");
+	}
+	if (labels && *labels) {
+		putChar('{');
+		put(labels);
+		if (labelValue) {
+			put("=\"");
+			putEscaped(labelValue);
+			putChar('"');
+		}
+		putChar('}');
+	}
+	putChar(' ');
+	putNumber(val);
+	putChar('\n');
+}
+
+void MetricsWriter::metricName(const char* name, const char* suffix) {
+	put(name);
+	putChar('_');
+	put(suffix);
+}
+
+void MetricsWriter::put(const char* str) {
+	put(str, std::strlen(str));
+}
+
+void MetricsWriter::put(const char* str, size_t count) {
+	if (length + count > text.size()) {
+		size_t grown = text.size() * 2;
+		text.resize(grown > length + count ? grown : length + count);
+	}
+	std::memcpy(text.data() + length, str, count);
+	length += count;
+}
+
+void MetricsWriter::putChar(char c) {
+	put(&c, 1);
+}
+
+//backslash, double quote and line feed are escaped in label values and help text
+void MetricsWriter::putEscaped(const char* str) {
+	for (; *str; str++) {
+		switch (*str) {
+		case '\\':
+			put("\\\\", 2);
+			break;
+		case '"':
+			put("\\\"", 2);
+			break;
+		case '\n':
+			put("\\n", 2);
+			break;
+		default:
+			putChar(*str);
+			break;
+		}
+	}
+}
+
+void MetricsWriter::putNumber(double val) {
+	if (std::isnan(val)) {
+		put("NaN");
+		return;
+	}
+	if (std::isinf(val)) {
+		put(val > 0 ? "+Inf" : "-Inf");
+		return;
+	}
+	//shortest text that reads back as the same double
+	char digits[32];
+	std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), val);
+	put(digits, result.ptr - digits);
+}
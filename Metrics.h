@@ -0,0 +1,179 @@
+#pragma once
+
+/*
+METRICS
+=======
+
+Writes measurements in the OpenMetrics text format (what Prometheus scrapes)
+straight into a buffer that is kept between scrapes.
+
+MetricsWriter metrics;
+metrics.begin();
+metrics.family<Power>("asset_power", "Electrical power drawn by the asset");
+for (...) {
+	metrics.sample("asset_power", "asset", assetName, assetPower);
+}
+metrics.end();
+send(socket, metrics.data(), metrics.size(), 0);
+
+produces
+
+# TYPE asset_power_watts gauge
+# UNIT asset_power_watts watts
+# HELP asset_power_watts Electrical power drawn by the asset
+asset_power_watts{asset="pump7"} 1520.5
+# EOF
+
+Each metric name gets the unit suffix Prometheus expects for its measurement,
+and values are written in that base unit: seconds, meters, grams, pascals,
+joules, watts, celsius and so on. MetricUnit<T> holds the mapping.
+
+Numbers are written with std::to_chars and label values are escaped in place,
+so once the buffer has grown to the size of a scrape, later scrapes allocate
+nothing. begin() empties the buffer but keeps its capacity. Output can also be
+taken out part way through a scrape with data() and consume(), for sending it
+in pieces.
+*/
+
+#include <cstddef>
+#include <vector>
+#include "MeasurementTraits.h"
+
+//unit each measurement is exposed in, and the suffix naming it
+template <class T> struct MetricUnit;
+
+template <> struct MetricUnit<TimeDuration> {
+	static const UNITS::TimeUnits unit = UNITS::s;
+	static const char* suffix() { return "seconds"; }
+};
+template <> struct MetricUnit<Length> {
+	static const UNITS::LengthUnits unit = UNITS::m;
+	static const char* suffix() { return "meters"; }
+};
+template <> struct MetricUnit<Area> {
+	static const UNITS::AreaUnits unit = UNITS::m2;
+	static const char* suffix() { return "square_meters"; }
+};
+template <> struct MetricUnit<Volume> {
+	static const UNITS::VolumeUnits unit = UNITS::m3;
+	static const char* suffix() { return "cubic_meters"; }
+};
+template <> struct MetricUnit<Speed> {
+	static const UNITS::SpeedUnits unit = UNITS::m_s;
+	static const char* suffix() { return "meters_per_second"; }
+};
+template <> struct MetricUnit<Acceleration> {
+	static const UNITS::AccelerationUnits unit = UNITS::m_s2;
+	static const char* suffix() { return "meters_per_second_squared"; }
+};
+template <> struct MetricUnit<Mass> {
+	static const UNITS::MassUnits unit = UNITS::gram;
+	static const char* suffix() { return "grams"; }
+};
+template <> struct MetricUnit<Force> {
+	static const UNITS::ForceUnits unit = UNITS::N;
+	static const char* suffix() { return "newtons"; }
+};
+template <> struct MetricUnit<Pressure> {
+	static const UNITS::PressureUnits unit = UNITS::Pa;
+	static const char* suffix() { return "pascals"; }
+};
+template <> struct MetricUnit<Energy> {
+	static const UNITS::EnergyUnits unit = UNITS::J;
+	static const char* suffix() { return "joules"; }
+};
+template <> struct MetricUnit<Power> {
+	static const UNITS::PowerUnits unit = UNITS::W;
+	static const char* suffix() { return "watts"; }
+};
+template <> struct MetricUnit<Density> {
+	static const UNITS::DensityUnits unit = UNITS::kg_m3;
+	static const char* suffix() { return "kilograms_per_cubic_meter"; }
+};
+template <> struct MetricUnit<Temperature> {
+	static const UNITS::TemperatureUnits unit = UNITS::C;
+	static const char* suffix() { return "celsius"; }
+};
+template <> struct MetricUnit<Voltage> {
+	static const UNITS::VoltageUnits unit = UNITS::V;
+	static const char* suffix() { return "volts"; }
+};
+template <> struct MetricUnit<Current> {
+	static const UNITS::CurrentUnits unit = UNITS::A;
+	static const char* suffix() { return "amperes"; }
+};
+template <> struct MetricUnit<Capacitance> {
+	static const UNITS::CapacitanceUnits unit = UNITS::Farad;
+	static const char* suffix() { return "farads"; }
+};
+template <> struct MetricUnit<Resistance> {
+	static const UNITS::ResistanceUnits unit = UNITS::Ohm;
+	static const char* suffix() { return "ohms"; }
+};
+template <> struct MetricUnit<RotationSpeed> {
+	static const UNITS::RotationSpeedUnits unit = UNITS::rad_s;
+	static const char* suffix() { return "radians_per_second"; }
+};
+template <> struct MetricUnit<Torque> {
+	static const UNITS::TorqueUnits unit = UNITS::Nm;
+	static const char* suffix() { return "newton_meters"; }
+};
+
+class MetricsWriter {
+public:
+	enum MetricType { GAUGE, COUNTER };
+
+	MetricsWriter();
+	//starts a scrape, keeping the memory of the last one
+	void begin();
+	//writes the # EOF line that closes a scrape
+	void end();
+
+	//TYPE, UNIT and HELP lines for a metric, written once before its samples
+	template <class T>
+	void family(const char* name, const char* help, MetricType type = GAUGE) {
+		header(name, MetricUnit<T>::suffix(), help, type);
+		counter = (type == COUNTER);
+	}
+	template <class T>
+	void sample(const char* name, T val) {
+		line(name, MetricUnit<T>::suffix(), 0, 0, exposed(val));
+	}
+	//sample with one label, e.g. asset="pump7"
+	template <class T>
+	void sample(const char* name, const char* label, const char* labelValue, T val) {
+		line(name, MetricUnit<T>::suffix(), label, labelValue, exposed(val));
+	}
+	//sample whose labels are already formatted, e.g. site="north",asset="pump7"
+	template <class T>
+	void sampleLabels(const char* name, const char* labels, T val) {
+		line(name, MetricUnit<T>::suffix(), labels, 0, exposed(val));
+	}
+
+	const char* data();
+	size_t size();
+	//drops the first count bytes once they have been sent
+	void consume(size_t count);
+
+protected:
+	//value in the exposed unit, using a conversion from the stored double worked out once per type
+	template <class T>
+	static double exposed(T val) {
+		static const UnitConversion conv = conversionFromStored<T>(MetricUnit<T>::unit);
+		return conv.apply(storedValue(val));
+	}
+	void header(const char* name, const char* suffix, const char* help, MetricType type);
+	//labelValue of 0 means labels is a preformatted list
+	void line(const char* name, const char* suffix, const char* labels, const char* labelValue, double val);
+	void metricName(const char* name, const char* suffix);
+	void put(const char* text);
+	void put(const char* text, size_t length);
+	void putChar(char c);
+	void putEscaped(const char* text);
+	void putNumber(double val);
+
+	std::vector<char> text;
+	size_t length;
+	size_t start;
+	bool counter;
+};
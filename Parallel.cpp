@@ -0,0 +1,101 @@
+#include "Parallel.h"
+
+//set on pool threads, and on a caller while it works through its own job
+static thread_local bool insidePool = false;
+
+ThreadPool& ThreadPool::shared() {
+	unsigned hardware = std::thread::hardware_concurrency();
+	static ThreadPool pool(hardware > 1 ? hardware - 1 : 0);
+	return pool;
+}
+
+ThreadPool::ThreadPool(unsigned workers) : wanted(workers), task(nullptr), context(nullptr), first(0), end(0),
+	generation(0), active(0), stop(false), next(0), remaining(0) {
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stop = true;
+	}
+	wake.notify_all();
+	for (size_t t = 0; t < workers.size(); t++) {
+		workers[t].join();
+	}
+}
+
+unsigned ThreadPool::workerCount() {
+	return wanted;
+}
+
+void ThreadPool::run(size_t count, Task job, void* jobContext) {
+	std::unique_lock<std::mutex> owner(submit, std::defer_lock);
+	if (wanted == 0 || count < 2 || insidePool || !owner.try_lock()) {
+		for (size_t i = 0; i < count; i++) {
+			job(jobContext, i);
+		}
+		return;
+	}
+	uint64_t start;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		//started here rather than in the constructor so a process that never goes parallel has no threads
+		while (workers.size() < wanted) {
+			workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+		}
+		task = job;
+		context = jobContext;
+		start = next.load();
+		first = start;
+		end = start + count;
+		remaining.store(count);
+		generation++;
+	}
+	wake.notify_all();
+	insidePool = true;
+	work(job, jobContext, start, start + count);
+	insidePool = false;
+	std::unique_lock<std::mutex> waiting(lock);
+	finished.wait(waiting, [&] { return remaining.load() == 0 && active == 0; });
+}
+
+void ThreadPool::work(Task job, void* jobContext, uint64_t start, uint64_t last) {
+	uint64_t i = next.load();
+	while (i < last) {
+		//claims i only if nobody else has, and never steps past this job's range
+		if (!next.compare_exchange_weak(i, i + 1)) {
+			continue;
+		}
+		job(jobContext, size_t(i - start));
+		if (remaining.fetch_sub(1) == 1) {
+			std::lock_guard<std::mutex> guard(lock);
+			finished.notify_all();
+		}
+		i = next.load();
+	}
+}
+
+void ThreadPool::workerLoop() {
+	insidePool = true;
+	uint64_t seen = 0;
+	std::unique_lock<std::mutex> guard(lock);
+	while (true) {
+		wake.wait(guard, [&] { return stop || generation != seen; });
+		if (stop) {
+			return;
+		}
+		seen = generation;
+		Task job = task;
+		void* jobContext = context;
+		uint64_t start = first;
+		uint64_t last = end;
+		active++;
+		guard.unlock();
+		work(job, jobContext, start, last);
+		guard.lock();
+		active--;
+		if (active == 0) {
+			finished.notify_all();
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+/*
+PARALLEL
+========
+
+Small helpers for splitting a loop over [0, n) between threads.
+
+parallelFor(n, threadCount(n, 10000, 0), [&](size_t begin, size_t end) { ... });
+
+threadCount() returns 1 for jobs too small to pay for handing them out, so the
+work then runs on the calling thread with no overhead.
+
+The chunks run on one pool of worker threads shared by the whole process,
+started on first use, so a solver calling parallelFor several times per
+iteration pays a wake-up rather than a thread start each time. The calling
+thread works through chunks too. A parallelFor called from inside a chunk, or
+while another thread has the pool, runs its chunks on the calling thread.
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+	typedef void (*Task)(void* context, size_t index);
+
+	//the process-wide pool parallelFor uses
+	static ThreadPool& shared();
+
+	ThreadPool(unsigned workers);
+	~ThreadPool();
+	//runs task(context, i) for every i in [0, count) and returns once all are done
+	void run(size_t count, Task task, void* context);
+	unsigned workerCount();
+
+protected:
+	void work(Task job, void* jobContext, uint64_t start, uint64_t last);
+	void workerLoop();
+
+	std::vector<std::thread> workers;
+	unsigned wanted;
+	//held by the thread handing out a job, others fall back to running it themselves
+	std::mutex submit;
+	std::mutex lock;
+	std::condition_variable wake;
+	std::condition_variable finished;
+	//job being handed out, only changed under lock
+	Task task;
+	void* context;
+	uint64_t first;
+	uint64_t end;
+	uint64_t generation;
+	unsigned active;
+	bool stop;
+	//indexes only ever grow, so a worker holding an old job's range finds it used up
+	std::atomic<uint64_t> next;
+	std::atomic<size_t> remaining;
+};
+
+//threads to use for n items: 1 below minimum, otherwise requested (0 = every hardware thread)
+inline unsigned threadCount(size_t n, size_t minimum, unsigned requested) {
+	if (n < minimum) {
+		return 1;
+	}
+	unsigned count = requested ? requested : std::thread::hardware_concurrency();
+	return count ? count : 1;
+}
+
+//runs fn(begin, end) over [0, n) split into one contiguous chunk per thread
+template <class F>
+void parallelFor(size_t n, unsigned threads, F fn) {
+	if (threads <= 1 || n < 2) {
+		fn(size_t(0), n);
+		return;
+	}
+	struct Job {
+		F* fn;
+		size_t n;
+		size_t chunk;
+	};
+	Job job = { &fn, n, (n + threads - 1) / threads };
+	ThreadPool::shared().run((n + job.chunk - 1) / job.chunk, [](void* context, size_t index) {
+		Job* j = (Job*)context;
+		size_t begin = index * j->chunk;
+		size_t end = begin + j->chunk < j->n ? begin + j->chunk : j->n;
+		(*j->fn)(begin, end);
+	}, &job);
+}
+
+//adds up fn(begin, end) over the same chunks as parallelFor
+template <class F>
+double parallelSum(size_t n, unsigned threads, F fn) {
+	if (threads <= 1 || n < 2) {
+		return fn(size_t(0), n);
+	}
+	std::vector<double> partial(threads, 0.0);
+	size_t chunk = (n + threads - 1) / threads;
+	parallelFor(n, threads, [&](size_t begin, size_t end) {
+		partial[begin / chunk] = fn(begin, end);
+	});
+	double total = 0;
+	for (size_t t = 0; t < partial.size(); t++) {
+		total += partial[t];
+	}
+	return total;
+}
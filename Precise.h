@@ -0,0 +1,219 @@
+#pragma once
+
+/*
+PRECISE
+=======
+
+Opt-in extended precision for metrology work. Precise<T> keeps its SI value
+as a DoubleDouble (about 32 significant digits) and converts with the exact
+factors from Factors.h, so a value put in as inches and read back as
+millimeters keeps every digit a double can hold and more.
+
+Precise<Length> gauge(1.00000000000001, UNITS::in);
+Precise<Length> sum = gauge + gauge;
+DoubleDouble mm = sum.precise(UNITS::mm);
+Length plain = sum.measurement();
+
+PreciseBatch works on arrays kept as two SoA columns, hi and lo. The kernels are
+branch-free loops of double operations, so they vectorize like the plain
+kernels elsewhere in the library. A double-double add or multiply costs about
+ten to twenty double operations, but over arrays that do not fit in cache the
+loops stay close to memory speed and land within a few times of the same
+loop on plain doubles. Conversions split their constant factor once per call
+and skip the offset add for units without one, and builds with FMA enabled
+(-mfma or -march=native) take the exact product error from one fma instead of
+splitting. benchmarks/PreciseBenchmark has the numbers.
+
+Everything here needs strict IEEE double evaluation (no -ffast-math).
+*/
+
+#include <cmath>
+#include <cstddef>
+#include "Factors.h"
+#include "MeasurementTraits.h"
+
+template <class T>
+class Precise {
+public:
+	typedef typename SIUnit<T>::Units Units;
+
+	Precise() {
+		si.hi = 0;
+		si.lo = 0;
+	}
+	Precise(double val, Units units) {
+		set(val, units);
+	}
+	//an ordinary measurement, exact to the double it holds
+	Precise(T measurement) {
+		si.hi = toSI(measurement);
+		si.lo = 0;
+	}
+	static Precise fromSI(DoubleDouble val) {
+		Precise p;
+		p.si = val;
+		return p;
+	}
+	void set(double val, Units units) {
+		si = UnitFactors<T>::scale(units) * val + UnitFactors<T>::offset(units);
+	}
+	void set(DoubleDouble val, Units units) {
+		si = UnitFactors<T>::scale(units) * val + UnitFactors<T>::offset(units);
+	}
+	//rounded to the nearest double
+	double value(Units units) {
+		return precise(units).hi;
+	}
+	DoubleDouble precise(Units units) {
+		return (si - UnitFactors<T>::offset(units)) / UnitFactors<T>::scale(units);
+	}
+	DoubleDouble siValue() {
+		return si;
+	}
+	T measurement() {
+		return ::fromSI<T>(si.hi);
+	}
+	Precise operator+(Precise other) {
+		return fromSI(si + other.si);
+	}
+	Precise operator-(Precise other) {
+		return fromSI(si - other.si);
+	}
+	Precise operator*(double val) {
+		return fromSI(si * val);
+	}
+	Precise operator/(double val) {
+		return fromSI(si / DoubleDouble{ val, 0 });
+	}
+	bool operator<(Precise other) {
+		return si.hi < other.si.hi || (si.hi == other.si.hi && si.lo < other.si.lo);
+	}
+	bool operator>(Precise other) {
+		return other < *this;
+	}
+	bool operator<=(Precise other) {
+		return !(other < *this);
+	}
+	bool operator>=(Precise other) {
+		return !(*this < other);
+	}
+	bool operator==(Precise other) {
+		return si.hi == other.si.hi && si.lo == other.si.lo;
+	}
+	bool operator!=(Precise other) {
+		return !(*this == other);
+	}
+
+protected:
+	DoubleDouble si;
+};
+
+//kernels over double-double arrays held as hi and lo columns, in may alias out
+namespace PreciseBatch {
+	//a constant factor with its high part split once, for products that only need the other operand split
+	struct Factor {
+		DoubleDouble value;
+		DoubleDouble halves;
+	};
+	inline Factor factor(DoubleDouble value) {
+		return Factor{ value, DoubleDouble::split(value.hi) };
+	}
+	//error of the double product factor.hi * x, exact either way, so both paths give the same bits
+	inline double productError(const Factor& f, double x, double p) {
+#ifdef __FMA__
+		return std::fma(f.value.hi, x, -p);
+#else
+		DoubleDouble xs = DoubleDouble::split(x);
+		return ((f.halves.hi * xs.hi - p) + f.halves.hi * xs.lo + f.halves.lo * xs.hi) + f.halves.lo * xs.lo;
+#endif
+	}
+	//f * x, the same as DoubleDouble * double
+	inline DoubleDouble times(const Factor& f, double x) {
+		double p = f.value.hi * x;
+		return DoubleDouble::quickTwoSum(p, productError(f, x, p) + f.value.lo * x);
+	}
+	//f * v, the same as DoubleDouble * DoubleDouble
+	inline DoubleDouble times(const Factor& f, DoubleDouble v) {
+		double p = f.value.hi * v.hi;
+		return DoubleDouble::quickTwoSum(p, productError(f, v.hi, p) + (v.hi * f.value.lo + v.lo * f.value.hi));
+	}
+
+	//SI values of n plain values in units
+	template <class T>
+	void fromUnits(const double* in, size_t n, typename SIUnit<T>::Units units, double* hi, double* lo) {
+		Factor scale = factor(UnitFactors<T>::scale(units));
+		DoubleDouble offset = UnitFactors<T>::offset(units);
+		//only temperatures have an offset, everything else skips the double-double add
+		if (offset.hi == 0 && offset.lo == 0) {
+			for (size_t i = 0; i < n; i++) {
+				DoubleDouble v = times(scale, in[i]);
+				hi[i] = v.hi;
+				lo[i] = v.lo;
+			}
+			return;
+		}
+		for (size_t i = 0; i < n; i++) {
+			DoubleDouble v = times(scale, in[i]) + offset;
+			hi[i] = v.hi;
+			lo[i] = v.lo;
+		}
+	}
+	//values in units rounded to double
+	template <class T>
+	void toUnits(const double* hi, const double* lo, size_t n, typename SIUnit<T>::Units units, double* out) {
+		//one division up front, then a multiply per value
+		Factor inverse = factor(DoubleDouble{ 1, 0 } / UnitFactors<T>::scale(units));
+		DoubleDouble offset = UnitFactors<T>::offset(units);
+		if (offset.hi == 0 && offset.lo == 0) {
+			for (size_t i = 0; i < n; i++) {
+				out[i] = times(inverse, DoubleDouble{ hi[i], lo[i] }).hi;
+			}
+			return;
+		}
+		for (size_t i = 0; i < n; i++) {
+			out[i] = times(inverse, DoubleDouble{ hi[i], lo[i] } - offset).hi;
+		}
+	}
+	inline void add(const double* aHi, const double* aLo, const double* bHi, const double* bLo, size_t n, double* hi, double* lo) {
+		for (size_t i = 0; i < n; i++) {
+			DoubleDouble v = DoubleDouble{ aHi[i], aLo[i] } + DoubleDouble{ bHi[i], bLo[i] };
+			hi[i] = v.hi;
+			lo[i] = v.lo;
+		}
+	}
+	inline void subtract(const double* aHi, const double* aLo, const double* bHi, const double* bLo, size_t n, double* hi, double* lo) {
+		for (size_t i = 0; i < n; i++) {
+			DoubleDouble v = DoubleDouble{ aHi[i], aLo[i] } - DoubleDouble{ bHi[i], bLo[i] };
+			hi[i] = v.hi;
+			lo[i] = v.lo;
+		}
+	}
+	inline void multiply(const double* aHi, const double* aLo, const double* bHi, const double* bLo, size_t n, double* hi, double* lo) {
+		for (size_t i = 0; i < n; i++) {
+			DoubleDouble v = DoubleDouble{ aHi[i], aLo[i] } * DoubleDouble{ bHi[i], bLo[i] };
+			hi[i] = v.hi;
+			lo[i] = v.lo;
+		}
+	}
+	inline void scale(const double* inHi, const double* inLo, size_t n, DoubleDouble factor, double* hi, double* lo) {
+		for (size_t i = 0; i < n; i++) {
+			DoubleDouble v = DoubleDouble{ inHi[i], inLo[i] } * factor;
+			hi[i] = v.hi;
+			lo[i] = v.lo;
+		}
+	}
+	//sum in double-double, four independent accumulators so the adds pipeline
+	inline DoubleDouble sum(const double* hi, const double* lo, size_t n) {
+		DoubleDouble acc[4] = { { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 } };
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			for (size_t k = 0; k < 4; k++) {
+				acc[k] = acc[k] + DoubleDouble{ hi[i + k], lo[i + k] };
+			}
+		}
+		for (; i < n; i++) {
+			acc[0] = acc[0] + DoubleDouble{ hi[i], lo[i] };
+		}
+		return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+	}
+}
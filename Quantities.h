@@ -0,0 +1,92 @@
+#pragma once
+
+/*
+QUANTITIES
+==========
+
+The one table of which measurement class goes with which msr_quantity, for code
+that dispatches on quantities at run time: the C interface, the formula
+compiler, the CSV loader and Arrow export all read it rather than keep lists
+of their own.
+
+MEASUREMENT_QUANTITY_LIST(X) calls X(quantity, class) for every class, in
+msr_quantity order, so tables indexed by quantity can be built from it:
+
+#define SCALE_OF(QUANTITY, TYPE) storedScale<TYPE>(),
+static const double SCALES[] = { MEASUREMENT_QUANTITY_LIST(SCALE_OF) };
+
+QuantityOf<Pressure>::value		-> MSR_PRESSURE, MSR_QUANTITY_COUNT for double, Angle or anything else
+QuantityOf<Pressure>::name()	-> "Pressure"
+QuantityClass<MSR_PRESSURE>::type	-> Pressure
+storedUnit(MSR_VOLUME)			-> MSR_L, the unit the class keeps its value in
+quantityName(MSR_VOLUME)		-> "Volume"
+*/
+
+#include "MeasurementC.h"
+#include "MeasurementTraits.h"
+
+#define MEASUREMENT_QUANTITY_LIST(X) \
+	X(MSR_TIME_DURATION, TimeDuration) \
+	X(MSR_LENGTH, Length) \
+	X(MSR_AREA, Area) \
+	X(MSR_VOLUME, Volume) \
+	X(MSR_SPEED, Speed) \
+	X(MSR_ACCELERATION, Acceleration) \
+	X(MSR_MASS, Mass) \
+	X(MSR_FORCE, Force) \
+	X(MSR_PRESSURE, Pressure) \
+	X(MSR_ENERGY, Energy) \
+	X(MSR_POWER, Power) \
+	X(MSR_DENSITY, Density) \
+	X(MSR_TEMPERATURE, Temperature) \
+	X(MSR_VOLTAGE, Voltage) \
+	X(MSR_CURRENT, Current) \
+	X(MSR_CAPACITANCE, Capacitance) \
+	X(MSR_RESISTANCE, Resistance) \
+	X(MSR_ROTATION_SPEED, RotationSpeed) \
+	X(MSR_TORQUE, Torque)
+
+//types that are not one of the classes, such as the double or Angle an operator may return
+template <class T> struct QuantityOf {
+	static const msr_quantity value = MSR_QUANTITY_COUNT;
+};
+
+template <int Q> struct QuantityClass;
+
+#define MEASUREMENT_QUANTITY(QUANTITY, TYPE) \
+	template <> struct QuantityOf<TYPE> { \
+		static const msr_quantity value = QUANTITY; \
+		static const char* name() { return #TYPE; } \
+	}; \
+	template <> struct QuantityClass<QUANTITY> { \
+		typedef TYPE type; \
+	};
+MEASUREMENT_QUANTITY_LIST(MEASUREMENT_QUANTITY)
+
+//every quantity once, in order, so arrays built from the list can be indexed by msr_quantity
+#define MEASUREMENT_QUANTITY_ID(QUANTITY, TYPE) QUANTITY,
+constexpr bool quantityListInOrder() {
+	const msr_quantity ids[] = { MEASUREMENT_QUANTITY_LIST(MEASUREMENT_QUANTITY_ID) };
+	for (int i = 0; i < (int)(sizeof(ids) / sizeof(ids[0])); i++) {
+		if (ids[i] != i) {
+			return false;
+		}
+	}
+	return sizeof(ids) / sizeof(ids[0]) == MSR_QUANTITY_COUNT;
+}
+static_assert(quantityListInOrder(), "MEASUREMENT_QUANTITY_LIST is out of step with msr_quantity");
+
+#define MEASUREMENT_STORED_UNIT(QUANTITY, TYPE) MSR_UNIT_ID(QUANTITY, SIUnit<TYPE>::stored),
+#define MEASUREMENT_QUANTITY_NAME(QUANTITY, TYPE) #TYPE,
+
+//MSR_INVALID_UNIT for MSR_QUANTITY_COUNT
+inline msr_unit storedUnit(msr_quantity quantity) {
+	static const msr_unit units[] = { MEASUREMENT_QUANTITY_LIST(MEASUREMENT_STORED_UNIT) };
+	return (unsigned)quantity < MSR_QUANTITY_COUNT ? units[quantity] : (msr_unit)MSR_INVALID_UNIT;
+}
+
+//the class name, null for MSR_QUANTITY_COUNT
+inline const char* quantityName(msr_quantity quantity) {
+	static const char* const names[] = { MEASUREMENT_QUANTITY_LIST(MEASUREMENT_QUANTITY_NAME) };
+	return (unsigned)quantity < MSR_QUANTITY_COUNT ? names[quantity] : 0;
+}
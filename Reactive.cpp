@@ -0,0 +1,179 @@
+#include "Reactive.h"
+#include <algorithm>
+#include "Parallel.h"
+
+ReactiveGraph::ReactiveGraph() : revision(1), recomputeCount(0) {
+	inputStart.push_back(0);
+}
+
+unsigned ReactiveGraph::addInput(double si) {
+	unsigned node = (unsigned)values.size();
+	values.push_back(si);
+	changed.push_back(revision);
+	verified.push_back(revision);
+	stale.push_back(0);
+	inputStart.push_back((unsigned)inputs.size());
+	dependents.push_back(std::vector<unsigned>());
+	computes.push_back(Compute());
+	return node;
+}
+
+//starts stale and never verified, so the first read computes it whatever its inputs
+unsigned ReactiveGraph::addDerived(const unsigned* nodeInputs, size_t count, Compute compute) {
+	unsigned node = (unsigned)values.size();
+	values.push_back(0);
+	changed.push_back(0);
+	verified.push_back(0);
+	stale.push_back(1);
+	inputs.insert(inputs.end(), nodeInputs, nodeInputs + count);
+	inputStart.push_back((unsigned)inputs.size());
+	for (size_t i = 0; i < count; i++) {
+		dependents[nodeInputs[i]].push_back(node);
+	}
+	dependents.push_back(std::vector<unsigned>());
+	computes.push_back(compute);
+	staleList.push_back(node);
+	return node;
+}
+
+bool ReactiveGraph::setValue(unsigned node, double si) {
+	if (node >= values.size() || computes[node]) {
+		return false;
+	}
+	if (values[node] == si) {
+		return true;
+	}
+	values[node] = si;
+	revision++;
+	changed[node] = revision;
+	markStale(node);
+	return true;
+}
+
+//a stale node's dependents are all stale already, so the walk stops there
+void ReactiveGraph::markStale(unsigned node) {
+	pending.assign(dependents[node].begin(), dependents[node].end());
+	while (!pending.empty()) {
+		unsigned n = pending.back();
+		pending.pop_back();
+		if (stale[n]) {
+			continue;
+		}
+		stale[n] = 1;
+		staleList.push_back(n);
+		pending.insert(pending.end(), dependents[n].begin(), dependents[n].end());
+	}
+	//get() freshens nodes without taking them off the list, drop those once they pile up
+	if (staleList.size() > 2 * values.size()) {
+		size_t kept = 0;
+		for (size_t i = 0; i < staleList.size(); i++) {
+			if (stale[staleList[i]]) {
+				staleList[kept++] = staleList[i];
+			}
+		}
+		staleList.resize(kept);
+		std::sort(staleList.begin(), staleList.end());
+		staleList.erase(std::unique(staleList.begin(), staleList.end()), staleList.end());
+	}
+}
+
+bool ReactiveGraph::recompute(unsigned node) {
+	unsigned begin = inputStart[node];
+	unsigned end = inputStart[node + 1];
+	bool run = verified[node] == 0;
+	for (unsigned k = begin; k < end && !run; k++) {
+		run = changed[inputs[k]] > verified[node];
+	}
+	if (run) {
+		double v = computes[node](values.data(), inputs.data() + begin);
+		//equal values stop the change here, dependents will find nothing new
+		if (verified[node] == 0 || !(v == values[node])) {
+			values[node] = v;
+			changed[node] = revision;
+		}
+	}
+	verified[node] = revision;
+	stale[node] = 0;
+	return run;
+}
+
+double ReactiveGraph::value(unsigned node) {
+	if (!stale[node]) {
+		return values[node];
+	}
+	//depth first through stale inputs, a node is computed once all its inputs are fresh
+	stack.clear();
+	Frame first = { node, inputStart[node] };
+	stack.push_back(first);
+	while (!stack.empty()) {
+		Frame& top = stack.back();
+		unsigned end = inputStart[top.node + 1];
+		while (top.next < end && !stale[inputs[top.next]]) {
+			top.next++;
+		}
+		if (top.next < end) {
+			unsigned in = inputs[top.next];
+			Frame next = { in, inputStart[in] };
+			stack.push_back(next);
+			continue;
+		}
+		recomputeCount += recompute(top.node);
+		stack.pop_back();
+	}
+	return values[node];
+}
+
+void ReactiveGraph::refresh(unsigned threads) {
+	//ids follow creation order, so sorted ids have every input ahead of the nodes using it
+	std::vector<unsigned> order;
+	for (size_t i = 0; i < staleList.size(); i++) {
+		if (stale[staleList[i]]) {
+			order.push_back(staleList[i]);
+		}
+	}
+	staleList.clear();
+	if (order.empty()) {
+		return;
+	}
+	std::sort(order.begin(), order.end());
+	order.erase(std::unique(order.begin(), order.end()), order.end());
+
+	//level is the longest path back to a fresh node, nodes in a level only read lower levels
+	level.resize(values.size());
+	unsigned depth = 0;
+	for (size_t i = 0; i < order.size(); i++) {
+		unsigned n = order[i];
+		unsigned l = 0;
+		for (unsigned k = inputStart[n]; k < inputStart[n + 1]; k++) {
+			if (stale[inputs[k]] && level[inputs[k]] + 1 > l) {
+				l = level[inputs[k]] + 1;
+			}
+		}
+		level[n] = l;
+		depth = std::max(depth, l);
+	}
+	std::vector<size_t> start(depth + 2, 0);
+	for (size_t i = 0; i < order.size(); i++) {
+		start[level[order[i]] + 1]++;
+	}
+	for (unsigned l = 0; l <= depth; l++) {
+		start[l + 1] += start[l];
+	}
+	std::vector<unsigned> byLevel(order.size());
+	std::vector<size_t> fill(start.begin(), start.end() - 1);
+	for (size_t i = 0; i < order.size(); i++) {
+		byLevel[fill[level[order[i]]]++] = order[i];
+	}
+
+	for (unsigned l = 0; l <= depth; l++) {
+		const unsigned* nodes = byLevel.data() + start[l];
+		size_t count = start[l + 1] - start[l];
+		recomputeCount += (uint64_t)parallelSum(count, threadCount(count, PARALLEL_LEVEL, threads), [&](size_t begin, size_t end) {
+			double ran = 0;
+			for (size_t i = begin; i < end; i++) {
+				ran += recompute(nodes[i]);
+			}
+			return ran;
+		});
+	}
+}
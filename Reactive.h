@@ -0,0 +1,183 @@
+#pragma once
+
+/*
+REACTIVE
+========
+
+A graph of derived quantities that recomputes only what an input change
+reaches, and only when something reads it.
+
+ReactiveGraph graph;
+Reactive<Mass> mass = graph.input(Mass(1200, UNITS::kg));
+Reactive<Acceleration> accel = graph.input(Acceleration(0.3, UNITS::G));
+Reactive<Area> piston = graph.input(Area(50, UNITS::cm2));
+Reactive<Force> force = graph.product(mass, accel);
+Reactive<Pressure> pressure = graph.quotient(force, piston);
+Reactive<Pressure> margin = graph.derive([](Pressure p) { return Pressure(10, UNITS::bar) - p; }, pressure);
+graph.set(mass, Mass(1500, UNITS::kg));		//marks force, pressure and margin stale
+Pressure m = graph.get(margin);				//recomputes those three, nothing else
+
+Every node holds one typed value. Inputs are set from outside, derived nodes
+are built by derive() from a function of their inputs' values, and product(),
+quotient(), sum(), difference() and total() cover the operators of
+Measurement.h, so a node of the wrong quantity fails to compile like the
+expression would. Nodes are only ever added, and a node's inputs must exist
+before it, so the graph cannot have cycles and node order is a topological
+order.
+
+set() marks the cone of nodes downstream of the input stale, stopping at nodes
+that are already stale, so it costs the number of nodes newly invalidated and
+nothing if the value did not change. get() brings a stale node up to date by
+walking back through its stale inputs with an explicit stack, so long chains do
+not run out of call stack. A node whose inputs all came out with the values it
+last saw is not recomputed, so a change that is absorbed part way down, e.g. by
+a min() or a clamp, stops there. Work is proportional to the affected cone, not
+to the size of the graph.
+
+refresh() brings every stale node up to date at once. The stale nodes are put
+into levels by their longest path from a fresh node, and each level is split
+between threads, so independent parts of the graph run side by side. Levels
+too small to pay for threads run on the calling thread. Functions given to
+derive() must then be safe to call at the same time for different nodes.
+Otherwise the graph is used from one thread at a time.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MeasurementTraits.h"
+
+template <class T>
+class Reactive {
+public:
+	Reactive() : id(UINT32_MAX) {}
+	explicit Reactive(unsigned node) : id(node) {}
+	unsigned id;
+};
+
+class ReactiveGraph {
+public:
+	//stale nodes a level needs before it is split between threads, handing a level to the pool
+	//costs about what recomputing 40 nodes does
+	static const size_t PARALLEL_LEVEL = 512;
+
+	ReactiveGraph();
+
+	template <class T>
+	Reactive<T> input(T value) {
+		return Reactive<T>(addInput(toSI(value)));
+	}
+	//node of f(inputs...), f takes the inputs' types and returns a measurement or a double
+	template <class F, class... A>
+	Reactive<typename std::decay<decltype(std::declval<F&>()(std::declval<A>()...))>::type> derive(F f, Reactive<A>... args) {
+		typedef typename std::decay<decltype(std::declval<F&>()(std::declval<A>()...))>::type R;
+		static_assert(sizeof...(A) > 0, "a derived node needs at least one input");
+		unsigned ids[] = { args.id... };
+		return Reactive<R>(addDerived(ids, sizeof...(A), [f](const double* values, const unsigned* in) mutable {
+			return Call<A...>::apply(f, values, in, std::index_sequence_for<A...>());
+		}));
+	}
+	template <class A, class B>
+	Reactive<typename ProductType<A, B>::type> product(Reactive<A> a, Reactive<B> b) {
+		return derive([](A x, B y) { return x * y; }, a, b);
+	}
+	template <class A, class B>
+	Reactive<typename QuotientType<A, B>::type> quotient(Reactive<A> a, Reactive<B> b) {
+		return derive([](A x, B y) { return x / y; }, a, b);
+	}
+	template <class T>
+	Reactive<T> sum(Reactive<T> a, Reactive<T> b) {
+		return derive([](T x, T y) { return x + y; }, a, b);
+	}
+	template <class T>
+	Reactive<T> difference(Reactive<T> a, Reactive<T> b) {
+		return derive([](T x, T y) { return x - y; }, a, b);
+	}
+	//sum of any number of nodes of one quantity, added in SI
+	template <class T>
+	Reactive<T> total(const std::vector<Reactive<T> >& nodes) {
+		static_assert(std::is_same<decltype(std::declval<T&>() + std::declval<T&>()), T>::value, "total() needs T + T to give T");
+		std::vector<unsigned> ids(nodes.size());
+		for (size_t i = 0; i < nodes.size(); i++) {
+			ids[i] = nodes[i].id;
+		}
+		size_t count = ids.size();
+		return Reactive<T>(addDerived(ids.data(), count, [count](const double* values, const unsigned* in) {
+			double s = 0;
+			for (size_t i = 0; i < count; i++) {
+				s += values[in[i]];
+			}
+			return s;
+		}));
+	}
+
+	//false for derived nodes
+	template <class T>
+	bool set(Reactive<T> node, T value) {
+		return setValue(node.id, toSI(value));
+	}
+	//brings node up to date first
+	template <class T>
+	T get(Reactive<T> node) {
+		return fromSI<T>(value(node.id));
+	}
+	template <class T>
+	bool isStale(Reactive<T> node) {
+		return isStale(node.id);
+	}
+	//brings every stale node up to date, threads 0 uses every hardware thread
+	void refresh(unsigned threads = 0);
+
+	//untyped interface, values in SI
+	typedef std::function<double(const double* values, const unsigned* inputs)> Compute;
+	unsigned addInput(double si);
+	//inputs must already be in the graph
+	unsigned addDerived(const unsigned* nodeInputs, size_t count, Compute compute);
+	bool setValue(unsigned node, double si);
+	double value(unsigned node);
+	bool isStale(unsigned node) {
+		return stale[node] != 0;
+	}
+	size_t nodeCount() {
+		return values.size();
+	}
+	//derived values computed since the graph was made, for checking how much an update cost
+	uint64_t recomputations() {
+		return recomputeCount;
+	}
+
+protected:
+	template <class... A>
+	struct Call {
+		template <class F, size_t... I>
+		static double apply(F& f, const double* values, const unsigned* in, std::index_sequence<I...>) {
+			return toSI(f(fromSI<A>(values[in[I]])...));
+		}
+	};
+	struct Frame {
+		unsigned node;
+		unsigned next;	//next input to look at
+	};
+
+	void markStale(unsigned node);
+	//computes node from fresh inputs if any of them changed since it was last verified, true if it ran
+	bool recompute(unsigned node);
+
+	std::vector<double> values;
+	std::vector<uint64_t> changed;		//revision the value last changed
+	std::vector<uint64_t> verified;		//revision the node was last brought up to date, 0 before its first computation
+	std::vector<uint8_t> stale;
+	std::vector<unsigned> inputStart;	//node's inputs are inputs[inputStart[node], inputStart[node + 1])
+	std::vector<unsigned> inputs;
+	std::vector<std::vector<unsigned> > dependents;
+	std::vector<Compute> computes;		//empty for inputs
+	std::vector<unsigned> staleList;	//every stale node, along with some that have since been brought up to date
+	std::vector<Frame> stack;
+	std::vector<unsigned> pending;
+	std::vector<unsigned> level;
+	uint64_t revision;
+	uint64_t recomputeCount;
+};
@@ -0,0 +1,291 @@
+#pragma once
+
+/*
+SAMPLE RINGS
+============
+
+Bounded lock-free queues that carry raw readings from acquisition threads to a
+processing thread. A sample is the raw double the device reported plus a tag
+for its unit, so pushing is a store and an atomic index update, with no
+measurement built on the producer side.
+
+SpscRing<Pressure> ring(4096);				//one producer, one consumer
+ring.push(752.1, UNITS::mmHg);				//false when the ring is full
+
+Pressure batch[256];
+size_t count = ring.drain(batch, 256);		//consumer side
+
+MpscRing<T> has the same interface and takes any number of producer threads
+with one consumer.
+
+drain() converts everything it takes out in one pass over the batch. The scale
+and offset of each unit are looked up from a small table, filled the first
+time the consumer sees the unit, so the loop is a gather and a multiply-add per
+sample that the compiler vectorizes. drainSI() writes the SI doubles directly
+for kernels that work on raw arrays.
+
+Capacity is rounded up to a power of two. The producer and consumer indices sit
+on separate cache lines, and each side keeps a cached copy of the other's index
+so a push or pop only touches the shared line when the ring looks full or empty.
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "MeasurementTraits.h"
+
+//assumed size of a cache line, used to keep producer and consumer data apart
+static const size_t CACHE_LINE = 64;
+//more than the number of units in any enum in UNITS
+static const int MAX_UNIT_TAGS = 32;
+//samples converted per pass of drain()
+static const size_t DRAIN_BATCH = 256;
+
+//consumer side table of conversions to SI, indexed by unit tag
+template <class T>
+class SampleConverter {
+public:
+	typedef typename SIUnit<T>::Units Units;
+
+	SampleConverter() {
+		for (int u = 0; u < MAX_UNIT_TAGS; u++) {
+			known[u] = false;
+			scale[u] = 0;
+			offset[u] = 0;
+		}
+	}
+	//SI values of n raw samples
+	void convert(const double* values, const uint8_t* units, size_t n, double* out) {
+		for (size_t i = 0; i < n; i++) {
+			if (!known[units[i]]) {
+				learn(units[i]);
+			}
+		}
+		for (size_t i = 0; i < n; i++) {
+			out[i] = values[i] * scale[units[i]] + offset[units[i]];
+		}
+	}
+
+private:
+	void learn(uint8_t unit) {
+		UnitConversion conv = conversionToSI<T>((Units)unit);
+		scale[unit] = conv.scale;
+		offset[unit] = conv.offset;
+		known[unit] = true;
+	}
+
+	double scale[MAX_UNIT_TAGS];
+	double offset[MAX_UNIT_TAGS];
+	bool known[MAX_UNIT_TAGS];
+};
+
+//smallest power of two holding at least n
+inline size_t ringCapacity(size_t n) {
+	size_t capacity = 2;
+	while (capacity < n) {
+		capacity *= 2;
+	}
+	return capacity;
+}
+
+//drain() and drainSI() on top of a ring's popRaw()
+template <class Ring, class T>
+class SampleDrain {
+public:
+	//takes up to max samples out as SI values
+	size_t drainSI(double* out, size_t max) {
+		double vals[DRAIN_BATCH];
+		uint8_t tags[DRAIN_BATCH];
+		size_t done = 0;
+		while (done < max) {
+			size_t want = max - done < DRAIN_BATCH ? max - done : DRAIN_BATCH;
+			size_t count = static_cast<Ring*>(this)->popRaw(vals, tags, want);
+			converter.convert(vals, tags, count, out + done);
+			done += count;
+			if (count < want) {
+				break;
+			}
+		}
+		return done;
+	}
+	//takes up to max samples out as measurements
+	size_t drain(T* out, size_t max) {
+		double si[DRAIN_BATCH];
+		size_t done = 0;
+		while (done < max) {
+			size_t want = max - done < DRAIN_BATCH ? max - done : DRAIN_BATCH;
+			size_t count = drainSI(si, want);
+			for (size_t i = 0; i < count; i++) {
+				out[done + i] = fromSI<T>(si[i]);
+			}
+			done += count;
+			if (count < want) {
+				break;
+			}
+		}
+		return done;
+	}
+
+private:
+	SampleConverter<T> converter;
+};
+
+//single producer, single consumer
+template <class T>
+class SpscRing : public SampleDrain<SpscRing<T>, T> {
+public:
+	typedef typename SIUnit<T>::Units Units;
+
+	SpscRing(size_t capacity) {
+		size_t size = ringCapacity(capacity);
+		values.resize(size);
+		units.resize(size);
+		mask = size - 1;
+		head.store(0);
+		tail.store(0);
+		cachedHead = 0;
+		cachedTail = 0;
+	}
+	size_t capacity() {
+		return mask + 1;
+	}
+
+	//producer side, false when the ring is full
+	bool push(double val, Units unit) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t - cachedHead > mask) {
+			cachedHead = head.load(std::memory_order_acquire);
+			if (t - cachedHead > mask) {
+				return false;
+			}
+		}
+		values[t & mask] = val;
+		units[t & mask] = (uint8_t)unit;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+	//pushes as many of n readings in one unit as fit, returns how many
+	size_t push(const double* vals, size_t n, Units unit) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		size_t room = mask + 1 - (t - cachedHead);
+		if (room < n) {
+			cachedHead = head.load(std::memory_order_acquire);
+			room = mask + 1 - (t - cachedHead);
+		}
+		size_t count = n < room ? n : room;
+		for (size_t i = 0; i < count; i++) {
+			values[(t + i) & mask] = vals[i];
+			units[(t + i) & mask] = (uint8_t)unit;
+		}
+		tail.store(t + count, std::memory_order_release);
+		return count;
+	}
+
+	//consumer side, takes up to max samples out as raw values and unit tags
+	size_t popRaw(double* vals, uint8_t* tags, size_t max) {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (cachedTail - h < max) {
+			cachedTail = tail.load(std::memory_order_acquire);
+		}
+		size_t available = cachedTail - h;
+		size_t count = max < available ? max : available;
+		for (size_t i = 0; i < count; i++) {
+			vals[i] = values[(h + i) & mask];
+			tags[i] = units[(h + i) & mask];
+		}
+		head.store(h + count, std::memory_order_release);
+		return count;
+	}
+
+protected:
+	std::vector<double> values;
+	std::vector<uint8_t> units;
+	size_t mask;
+	//written by the consumer
+	alignas(CACHE_LINE) std::atomic<size_t> head;
+	size_t cachedTail;
+	//written by the producer
+	alignas(CACHE_LINE) std::atomic<size_t> tail;
+	size_t cachedHead;
+};
+
+//any number of producers, single consumer
+//each slot carries a sequence number, so producers claim slots with one compare and swap and never wait on each other
+template <class T>
+class MpscRing : public SampleDrain<MpscRing<T>, T> {
+public:
+	typedef typename SIUnit<T>::Units Units;
+
+	MpscRing(size_t capacity) {
+		size_t size = ringCapacity(capacity);
+		slots.reset(new Slot[size]);
+		for (size_t i = 0; i < size; i++) {
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		mask = size - 1;
+		head = 0;
+		tail.store(0);
+	}
+	size_t capacity() {
+		return mask + 1;
+	}
+
+	//producer side, safe from any thread, false when the ring is full
+	bool push(double val, Units unit) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		Slot* slot;
+		while (true) {
+			slot = &slots[t & mask];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			//the slot is free for position t when its sequence is t, and still unread when it is t + 1 - capacity
+			if (sequence == t) {
+				if (tail.compare_exchange_weak(t, t + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+			else if ((ptrdiff_t)(sequence - t) < 0) {
+				return false;
+			}
+			else {
+				t = tail.load(std::memory_order_relaxed);
+			}
+		}
+		slot->value = val;
+		slot->unit = (uint8_t)unit;
+		slot->sequence.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	//consumer side, takes up to max samples out as raw values and unit tags
+	size_t popRaw(double* vals, uint8_t* tags, size_t max) {
+		size_t count = 0;
+		while (count < max) {
+			Slot& slot = slots[head & mask];
+			if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+				break;
+			}
+			vals[count] = slot.value;
+			tags[count] = slot.unit;
+			slot.sequence.store(head + mask + 1, std::memory_order_release);
+			head++;
+			count++;
+		}
+		return count;
+	}
+
+protected:
+	struct Slot {
+		std::atomic<size_t> sequence;
+		double value;
+		uint8_t unit;
+	};
+
+	std::unique_ptr<Slot[]> slots;
+	size_t mask;
+	//written by the consumer
+	alignas(CACHE_LINE) size_t head;
+	//claimed by producers
+	alignas(CACHE_LINE) std::atomic<size_t> tail;
+};
@@ -0,0 +1,149 @@
+#include "Sort.h"
+#include <algorithm>
+#include "Parallel.h"
+
+//11 bits per pass, six passes over 64 bit keys
+static const int DIGIT_BITS = 11;
+static const size_t RADIX = 1 << DIGIT_BITS;
+static const int PASSES = (64 + DIGIT_BITS - 1) / DIGIT_BITS;
+//arrays shorter than this are sorted on the calling thread
+static const size_t PARALLEL_MINIMUM = 1 << 16;
+
+using namespace QuantitySort;
+
+void QuantitySort::radixSort(uint64_t* keys, uint64_t* payload, size_t n, unsigned threads) {
+	if (n < 2) {
+		return;
+	}
+	unsigned chunks = threadCount(n, PARALLEL_MINIMUM, threads);
+	//same split as parallelFor, so begin / chunk is the chunk number
+	size_t chunk = (n + chunks - 1) / chunks;
+
+	//every digit of every pass counted in one read, to find passes that would not move anything
+	std::vector<size_t> totals(chunks * PASSES * RADIX, 0);
+	parallelFor(n, chunks, [&](size_t begin, size_t end) {
+		size_t* counts = &totals[(begin / chunk) * PASSES * RADIX];
+		for (size_t i = begin; i < end; i++) {
+			uint64_t key = keys[i];
+			for (int pass = 0; pass < PASSES; pass++) {
+				counts[pass * RADIX + ((key >> (pass * DIGIT_BITS)) & (RADIX - 1))]++;
+			}
+		}
+	});
+	bool skip[PASSES];
+	for (int pass = 0; pass < PASSES; pass++) {
+		skip[pass] = false;
+		for (size_t digit = 0; digit < RADIX; digit++) {
+			size_t total = 0;
+			for (unsigned t = 0; t < chunks; t++) {
+				total += totals[(t * PASSES + pass) * RADIX + digit];
+			}
+			if (total == n) {
+				skip[pass] = true;
+			}
+		}
+	}
+
+	std::vector<uint64_t> keyScratch(n);
+	std::vector<uint64_t> payloadScratch(payload ? n : 0);
+	uint64_t* src = keys;
+	uint64_t* dst = keyScratch.data();
+	uint64_t* payloadSrc = payload;
+	uint64_t* payloadDst = payload ? payloadScratch.data() : 0;
+	std::vector<size_t> offsets(chunks * RADIX);
+
+	for (int pass = 0; pass < PASSES; pass++) {
+		if (skip[pass]) {
+			continue;
+		}
+		int shift = pass * DIGIT_BITS;
+		//counts per chunk of the keys in their current order
+		parallelFor(n, chunks, [&](size_t begin, size_t end) {
+			size_t* counts = &offsets[(begin / chunk) * RADIX];
+			std::fill(counts, counts + RADIX, 0);
+			for (size_t i = begin; i < end; i++) {
+				counts[(src[i] >> shift) & (RADIX - 1)]++;
+			}
+		});
+		//each chunk's first slot for each digit, digits in order and chunks in order within a digit
+		size_t sum = 0;
+		for (size_t digit = 0; digit < RADIX; digit++) {
+			for (unsigned t = 0; t < chunks; t++) {
+				size_t count = offsets[t * RADIX + digit];
+				offsets[t * RADIX + digit] = sum;
+				sum += count;
+			}
+		}
+		parallelFor(n, chunks, [&](size_t begin, size_t end) {
+			size_t* next = &offsets[(begin / chunk) * RADIX];
+			for (size_t i = begin; i < end; i++) {
+				size_t slot = next[(src[i] >> shift) & (RADIX - 1)]++;
+				dst[slot] = src[i];
+				if (payloadSrc) {
+					payloadDst[slot] = payloadSrc[i];
+				}
+			}
+		});
+		std::swap(src, dst);
+		std::swap(payloadSrc, payloadDst);
+	}
+
+	if (src != keys) {
+		parallelFor(n, chunks, [&](size_t begin, size_t end) {
+			std::memcpy(keys + begin, src + begin, (end - begin) * sizeof(uint64_t));
+			if (payload) {
+				std::memcpy(payload + begin, payloadSrc + begin, (end - begin) * sizeof(uint64_t));
+			}
+		});
+	}
+}
+
+//larger key first, then lower index, so results do not depend on the thread split
+static bool rankedBefore(const Ranked& a, const Ranked& b) {
+	return a.key > b.key || (a.key == b.key && a.index < b.index);
+}
+
+std::vector<Ranked> QuantitySort::selectLargest(const uint64_t* keys, size_t n, size_t k, unsigned threads) {
+	k = k < n ? k : n;
+	std::vector<Ranked> result;
+	if (k == 0) {
+		return result;
+	}
+	unsigned chunks = threadCount(n, PARALLEL_MINIMUM, threads);
+	size_t chunk = (n + chunks - 1) / chunks;
+	//each chunk keeps its own top k, then the candidates are narrowed down once more
+	std::vector<std::vector<Ranked> > candidates(chunks);
+	parallelFor(n, chunks, [&](size_t begin, size_t end) {
+		std::vector<Ranked>& local = candidates[begin / chunk];
+		local.resize(end - begin);
+		for (size_t i = begin; i < end; i++) {
+			local[i - begin].key = keys[i];
+			local[i - begin].index = i;
+		}
+		if (local.size() > k) {
+			std::nth_element(local.begin(), local.begin() + (k - 1), local.end(), rankedBefore);
+			local.resize(k);
+		}
+	});
+	for (unsigned t = 0; t < chunks; t++) {
+		result.insert(result.end(), candidates[t].begin(), candidates[t].end());
+	}
+	if (result.size() > k) {
+		std::nth_element(result.begin(), result.begin() + (k - 1), result.end(), rankedBefore);
+		result.resize(k);
+	}
+	std::sort(result.begin(), result.end(), rankedBefore);
+	return result;
+}
+
+void QuantitySort::selectRanks(uint64_t* keys, size_t n, const size_t* ranks, size_t count) {
+	//each selection only has to look at the part above the previous rank
+	size_t first = 0;
+	for (size_t j = 0; j < count; j++) {
+		if (ranks[j] < first || ranks[j] >= n) {
+			continue;
+		}
+		std::nth_element(keys + first, keys + ranks[j], keys + n);
+		first = ranks[j] + 1;
+	}
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+/*
+SORT
+====
+
+Sorting and selection for arrays of measurements (or plain doubles) that never
+call value() or the comparison operators.
+
+std::vector<Pressure> readings = ...;
+QuantitySort::sort(readings.data(), readings.size());
+QuantitySort::sortByKey(readings.data(), timestamps.data(), readings.size());	//timestamps follow their readings
+Pressure p99 = QuantitySort::quantile(readings.data(), readings.size(), 0.99);
+QuantitySort::largest(readings.data(), readings.size(), 10, top10);
+
+Every measurement class keeps one double in a unit that is a positive multiple
+of its SI unit (K for Temperature), so ordering the stored doubles orders the
+quantities. Each double is mapped to an unsigned integer with the same order
+(flip every bit of negatives, only the sign bit of positives) and sorted with
+an LSD radix sort, 11 bits per pass. Passes where every key has the same digit,
+such as the exponent bits of data in a narrow range, are skipped. Each pass
+counts digits per thread and scatters per thread, so large arrays use every
+core.
+
+The sort is stable, -0 sorts before +0, and NaNs go to the end (or the start,
+for NaNs with the sign bit set). Selection is nth_element on the same keys,
+O(n) for top-k and single quantiles. Quantiles interpolate linearly between
+the two nearest ranks.
+
+Like Arrow.h this relies on each measurement being a single double, read and
+written through storedValue() and fromStored() from MeasurementTraits.h.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "MeasurementTraits.h"
+
+namespace QuantitySort {
+	const uint64_t SIGN_BIT = uint64_t(1) << 63;
+
+	//unsigned integer that orders like the double
+	inline uint64_t orderedBits(double val) {
+		uint64_t bits;
+		std::memcpy(&bits, &val, sizeof(bits));
+		return (bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT;
+	}
+
+	inline double fromOrderedBits(uint64_t bits) {
+		bits = (bits & SIGN_BIT) ? bits & ~SIGN_BIT : ~bits;
+		double val;
+		std::memcpy(&val, &bits, sizeof(val));
+		return val;
+	}
+
+	template <class T>
+	uint64_t keyOf(const T& val) {
+		return orderedBits(storedValue(val));
+	}
+
+	template <class T>
+	void setFromKey(T& val, uint64_t key) {
+		val = fromStored<T>(fromOrderedBits(key));
+	}
+
+	//key with the index it came from, for selection and key-value sorts
+	struct Ranked {
+		uint64_t key;
+		size_t index;
+	};
+
+	//sorts keys ascending in place, with payload (if not null) moved alongside, threads 0 uses every hardware thread
+	void radixSort(uint64_t* keys, uint64_t* payload, size_t n, unsigned threads);
+	//the k largest keys, largest first, ties in index order
+	std::vector<Ranked> selectLargest(const uint64_t* keys, size_t n, size_t k, unsigned threads);
+	//key at each rank, nth_element style, ranks ascending
+	void selectRanks(uint64_t* keys, size_t n, const size_t* ranks, size_t count);
+
+	template <class T>
+	void sort(T* values, size_t n, unsigned threads = 0) {
+		std::vector<uint64_t> keys(n);
+		for (size_t i = 0; i < n; i++) {
+			keys[i] = keyOf(values[i]);
+		}
+		radixSort(keys.data(), 0, n, threads);
+		for (size_t i = 0; i < n; i++) {
+			setFromKey(values[i], keys[i]);
+		}
+	}
+
+	//sorts keys and applies the same reordering to payload, which can be any copyable type
+	template <class T, class V>
+	void sortByKey(T* keys, V* payload, size_t n, unsigned threads = 0) {
+		std::vector<uint64_t> bits(n);
+		std::vector<uint64_t> order(n);
+		for (size_t i = 0; i < n; i++) {
+			bits[i] = keyOf(keys[i]);
+			order[i] = i;
+		}
+		radixSort(bits.data(), order.data(), n, threads);
+		std::vector<V> moved(payload, payload + n);
+		for (size_t i = 0; i < n; i++) {
+			setFromKey(keys[i], bits[i]);
+			payload[i] = moved[order[i]];
+		}
+	}
+
+	//k largest values, largest first, into out
+	template <class T>
+	void largest(const T* values, size_t n, size_t k, T* out, unsigned threads = 0) {
+		std::vector<uint64_t> keys(n);
+		for (size_t i = 0; i < n; i++) {
+			keys[i] = keyOf(values[i]);
+		}
+		std::vector<Ranked> top = selectLargest(keys.data(), n, k, threads);
+		for (size_t i = 0; i < top.size(); i++) {
+			setFromKey(out[i], top[i].key);
+		}
+	}
+
+	//k smallest values, smallest first, selected as the largest complements
+	template <class T>
+	void smallest(const T* values, size_t n, size_t k, T* out, unsigned threads = 0) {
+		std::vector<uint64_t> keys(n);
+		for (size_t i = 0; i < n; i++) {
+			keys[i] = ~keyOf(values[i]);
+		}
+		std::vector<Ranked> top = selectLargest(keys.data(), n, k, threads);
+		for (size_t i = 0; i < top.size(); i++) {
+			setFromKey(out[i], ~top[i].key);
+		}
+	}
+
+	//k largest keys, largest first, with the payload of each
+	template <class T, class V>
+	void largest(const T* keys, const V* payload, size_t n, size_t k, T* outKeys, V* outPayload, unsigned threads = 0) {
+		std::vector<uint64_t> bits(n);
+		for (size_t i = 0; i < n; i++) {
+			bits[i] = keyOf(keys[i]);
+		}
+		std::vector<Ranked> top = selectLargest(bits.data(), n, k, threads);
+		for (size_t i = 0; i < top.size(); i++) {
+			setFromKey(outKeys[i], top[i].key);
+			outPayload[i] = payload[top[i].index];
+		}
+	}
+
+	template <class T, class V>
+	void smallest(const T* keys, const V* payload, size_t n, size_t k, T* outKeys, V* outPayload, unsigned threads = 0) {
+		std::vector<uint64_t> bits(n);
+		for (size_t i = 0; i < n; i++) {
+			bits[i] = ~keyOf(keys[i]);
+		}
+		std::vector<Ranked> top = selectLargest(bits.data(), n, k, threads);
+		for (size_t i = 0; i < top.size(); i++) {
+			setFromKey(outKeys[i], ~top[i].key);
+			outPayload[i] = payload[top[i].index];
+		}
+	}
+
+	//q from 0 to 1 for each of count quantiles, written to out, n must be at least 1
+	template <class T>
+	void quantiles(const T* values, size_t n, const double* q, size_t count, T* out) {
+		std::vector<uint64_t> keys(n);
+		for (size_t i = 0; i < n; i++) {
+			keys[i] = keyOf(values[i]);
+		}
+		//the two ranks each quantile sits between
+		std::vector<size_t> ranks;
+		for (size_t j = 0; j < count; j++) {
+			double position = (q[j] < 0 ? 0 : q[j] > 1 ? 1 : q[j]) * (n - 1);
+			size_t below = (size_t)position;
+			ranks.push_back(below);
+			ranks.push_back(below + 1 < n ? below + 1 : below);
+		}
+		std::vector<size_t> sorted(ranks);
+		std::sort(sorted.begin(), sorted.end());
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+		selectRanks(keys.data(), n, sorted.data(), sorted.size());
+		for (size_t j = 0; j < count; j++) {
+			double position = (q[j] < 0 ? 0 : q[j] > 1 ? 1 : q[j]) * (n - 1);
+			double low = fromOrderedBits(keys[ranks[2 * j]]);
+			double high = fromOrderedBits(keys[ranks[2 * j + 1]]);
+			double fraction = position - (double)ranks[2 * j];
+			double stored = fraction > 0 ? low + (high - low) * fraction : low;
+			setFromKey(out[j], orderedBits(stored));
+		}
+	}
+
+	template <class T>
+	T quantile(const T* values, size_t n, double q) {
+		T result;
+		quantiles(values, n, &q, 1, &result);
+		return result;
+	}
+
+	template <class T>
+	T median(const T* values, size_t n) {
+		return quantile(values, n, 0.5);
+	}
+}
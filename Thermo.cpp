@@ -0,0 +1,335 @@
+#include "Thermo.h"
+#include <cmath>
+#include <limits>
+#include "MeasurementTraits.h"
+
+//IAPWS-IF97 specific gas constant of water, J / (kg K)
+static const double R_WATER = 461.526;
+
+//region 1 Gibbs free energy: gamma = sum n (7.1 - pi)^I (tau - 1.222)^J, p* = 16.53 MPa, T* = 1386 K
+static const int REGION1_TERMS = 34;
+static const int REGION1_I[REGION1_TERMS] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5, 8, 8, 21, 23, 29, 30, 31, 32
+};
+static const int REGION1_J[REGION1_TERMS] = {
+	-2, -1, 0, 1, 2, 3, 4, 5, -9, -7, -1, 0, 1, 3, -3, 0, 1, 3, 17, -4, 0, 6, -5, -2, 10, -8, -11, -6, -29, -31, -38, -39, -40, -41
+};
+static const double REGION1_N[REGION1_TERMS] = {
+	0.14632971213167, -0.84548187169114, -0.37563603672040e1, 0.33855169168385e1,
+	-0.95791963387872, 0.15772038513228, -0.16616417199501e-1, 0.81214629983568e-3,
+	0.28319080123804e-3, -0.60706301565874e-3, -0.18990068218419e-1, -0.32529748770505e-1,
+	-0.21841717175414e-1, -0.52838357969930e-4, -0.47184321073267e-3, -0.30001780793026e-3,
+	0.47661393906987e-4, -0.44141845330846e-5, -0.72694996297594e-15, -0.31679644845054e-4,
+	-0.28270797985312e-5, -0.85205128120103e-9, -0.22425281908000e-5, -0.65171222895601e-6,
+	-0.14341729937924e-12, -0.40516996860117e-6, -0.12734301741641e-8, -0.17424871230634e-9,
+	-0.68762131295531e-18, 0.14478307828521e-19, 0.26335781662795e-22, -0.11947622640071e-22,
+	0.18228094581404e-23, -0.93537087292458e-25
+};
+
+//region 2 ideal gas part: gamma0 = ln(pi) + sum n0 tau^J0, p* = 1 MPa, T* = 540 K
+static const int REGION2_IDEAL_TERMS = 9;
+static const int REGION2_J0[REGION2_IDEAL_TERMS] = { 0, 1, -5, -4, -3, -2, -1, 2, 3 };
+static const double REGION2_N0[REGION2_IDEAL_TERMS] = {
+	-0.96927686500217e1, 0.10086655968018e2, -0.56087911283020e-2, 0.71452738081455e-1,
+	-0.40710498223928, 0.14240819171444e1, -0.43839511319450e1, -0.28408632460772,
+	0.21268463753307e-1
+};
+
+//region 2 residual part: gammaR = sum n pi^I (tau - 0.5)^J
+static const int REGION2_TERMS = 43;
+static const int REGION2_I[REGION2_TERMS] = {
+	1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 4, 4, 4, 5, 6, 6, 6, 7, 7, 7, 8, 8, 9, 10, 10, 10, 16, 16, 18, 20, 20, 20, 21, 22, 23, 24, 24, 24
+};
+static const int REGION2_J[REGION2_TERMS] = {
+	0, 1, 2, 3, 6, 1, 2, 4, 7, 36, 0, 1, 3, 6, 35, 1, 2, 3, 7, 3, 16, 35, 0, 11, 25, 8, 36, 13, 4, 10, 14, 29, 50, 57, 20, 35, 48, 21, 53, 39, 26, 40, 58
+};
+static const double REGION2_N[REGION2_TERMS] = {
+	-0.17731742473213e-2, -0.17834862292358e-1, -0.45996013696365e-1, -0.57581259083432e-1,
+	-0.50325278727930e-1, -0.33032641670203e-4, -0.18948987516315e-3, -0.39392777243355e-2,
+	-0.43797295650573e-1, -0.26674547914087e-4, 0.20481737692309e-7, 0.43870667284435e-6,
+	-0.32277677238570e-4, -0.15033924542148e-2, -0.40668253562649e-1, -0.78847309559367e-9,
+	0.12790717852285e-7, 0.48225372718507e-6, 0.22922076337661e-5, -0.16714766451061e-10,
+	-0.21171472321355e-2, -0.23895741934104e2, -0.59059564324270e-17, -0.12621808899101e-5,
+	-0.38946842435739e-1, 0.11256211360459e-10, -0.82311340897998e1, 0.19809712802088e-7,
+	0.10468965886579e-18, -0.10234747095929e-12, -0.10018179379511e-8, -0.80882908646985e-10,
+	0.10693031879409, -0.33662250574171, 0.89185845355421e-24, 0.30629316876232e-12,
+	-0.42002467698208e-5, -0.59056029685639e-25, 0.37826947613457e-5, -0.12768608934681e-14,
+	0.73087610595061e-28, 0.55414715350778e-16, -0.94369707241210e-6
+};
+
+//region 4 saturation line
+static const double REGION4_N[10] = {
+	0.11670521452767e4, -0.72421316703206e6, -0.17073846940092e2, 0.12020824702470e5,
+	-0.32325550322333e7, 0.14915108613530e2, -0.48232657361591e4, 0.40511340542057e6,
+	-0.23855557567849, 0.65017534844798e3
+};
+
+//boundary between regions 2 and 3
+static const double B23_N[3] = { 0.34805185628969e3, -0.11671859879975e1, 0.10192970039326e-2 };
+
+//IAPWS 2011 sublimation pressure of ice Ih: ln(p / pt) = sum a theta^(b - 1), theta = T / Tt, 50 K to the triple point
+static const double TRIPLE_K = 273.16;
+static const double TRIPLE_PA = 611.657;
+static const double SUBLIMATION_A[3] = { -0.212144006e2, 0.273203819e2, -0.610598130e1 };
+static const double SUBLIMATION_B[3] = { 0.333333333e-2, 0.120666667e1, 0.170333333e1 };
+
+static const double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+
+//reads SI values straight from the stored doubles, set up once per call so the loops make no value() calls
+template <class T>
+struct SIReader {
+	UnitConversion conv = conversionFromStored<T>(SIUnit<T>::unit);
+	double operator()(T val) const {
+		return conv.apply(storedValue(val));
+	}
+};
+
+//x^k for k from low to high, written into powers[k - low]
+static void powerTable(double x, int low, int high, double* powers) {
+	powers[-low] = 1;
+	for (int k = 1; k <= high; k++) {
+		powers[k - low] = powers[k - 1 - low] * x;
+	}
+	double inverse = 1 / x;
+	for (int k = -1; k >= low; k--) {
+		powers[k - low] = powers[k + 1 - low] * inverse;
+	}
+}
+
+//derivatives of the region 1 Gibbs free energy
+static void region1(double pi, double tau, double& gammaPi, double& gammaTau) {
+	double a[34];		//(7.1 - pi)^k, k from -1 to 32
+	double b[60];		//(tau - 1.222)^k, k from -42 to 17
+	powerTable(7.1 - pi, -1, 32, a);
+	powerTable(tau - 1.222, -42, 17, b);
+	gammaPi = 0;
+	gammaTau = 0;
+	for (int i = 0; i < REGION1_TERMS; i++) {
+		int I = REGION1_I[i];
+		int J = REGION1_J[i];
+		gammaPi -= REGION1_N[i] * I * a[I - 1 + 1] * b[J + 42];
+		gammaTau += REGION1_N[i] * J * a[I + 1] * b[J - 1 + 42];
+	}
+}
+
+//derivatives of the region 2 Gibbs free energy
+static void region2(double pi, double tau, double& gammaPi, double& gammaTau) {
+	double a[25];		//pi^k, k from 0 to 24
+	double b[60];		//(tau - 0.5)^k, k from -1 to 58
+	double c[10];		//tau^k, k from -6 to 3
+	powerTable(pi, 0, 24, a);
+	powerTable(tau - 0.5, -1, 58, b);
+	powerTable(tau, -6, 3, c);
+	gammaPi = 1 / pi;
+	gammaTau = 0;
+	for (int i = 0; i < REGION2_IDEAL_TERMS; i++) {
+		gammaTau += REGION2_N0[i] * REGION2_J0[i] * c[REGION2_J0[i] - 1 + 6];
+	}
+	for (int i = 0; i < REGION2_TERMS; i++) {
+		int I = REGION2_I[i];
+		int J = REGION2_J[i];
+		gammaPi += REGION2_N[i] * I * a[I - 1] * b[J + 1];
+		gammaTau += REGION2_N[i] * a[I] * J * b[J - 1 + 1];
+	}
+}
+
+//saturation pressure in Pa
+static double saturationPa(double T) {
+	if (!(T >= 273.15 && T <= 647.096)) {
+		return NOT_A_NUMBER;
+	}
+	const double* n = REGION4_N;
+	double theta = T + n[8] / (T - n[9]);
+	double A = theta * theta + n[0] * theta + n[1];
+	double B = n[2] * theta * theta + n[3] * theta + n[4];
+	double C = n[5] * theta * theta + n[6] * theta + n[7];
+	double root = 2 * C / (-B + std::sqrt(B * B - 4 * A * C));
+	return root * root * root * root * 1e6;
+}
+
+//saturation temperature in K
+static double saturationK(double p) {
+	if (!(p >= 611.213 && p <= 22.064e6)) {
+		return NOT_A_NUMBER;
+	}
+	const double* n = REGION4_N;
+	double beta = std::sqrt(std::sqrt(p / 1e6));
+	double E = beta * beta + n[2] * beta + n[5];
+	double F = n[0] * beta * beta + n[3] * beta + n[6];
+	double G = n[1] * beta * beta + n[4] * beta + n[7];
+	double D = 2 * G / (-F - std::sqrt(F * F - 4 * E * G));
+	return (n[9] + D - std::sqrt((n[9] + D) * (n[9] + D) - 4 * (n[8] + n[9] * D))) / 2;
+}
+
+//sublimation pressure over ice in Pa
+static double sublimationPa(double T) {
+	if (!(T >= 50 && T <= TRIPLE_K)) {
+		return NOT_A_NUMBER;
+	}
+	double theta = T / TRIPLE_K;
+	double sum = 0;
+	for (int i = 0; i < 3; i++) {
+		sum += SUBLIMATION_A[i] * std::pow(theta, SUBLIMATION_B[i] - 1);
+	}
+	return TRIPLE_PA * std::exp(sum);
+}
+
+//frost point in K, Newton's method on ln p, which is close to linear in 1 / T
+static double sublimationK(double p) {
+	if (!(p >= sublimationPa(50) && p <= TRIPLE_PA)) {
+		return NOT_A_NUMBER;
+	}
+	double target = std::log(p / TRIPLE_PA);
+	double theta = 1;
+	for (int iteration = 0; iteration < 100; iteration++) {
+		double sum = 0;
+		double slope = 0;
+		for (int i = 0; i < 3; i++) {
+			double term = SUBLIMATION_A[i] * std::pow(theta, SUBLIMATION_B[i] - 1);
+			sum += term;
+			slope += term * (SUBLIMATION_B[i] - 1) / theta;
+		}
+		double step = (sum - target) / slope;
+		theta -= step;
+		if (std::fabs(step) < 1e-15) {
+			break;
+		}
+	}
+	return theta * TRIPLE_K;
+}
+
+//partial pressure of water vapour in Pa at relative humidity rh, saturated over liquid water
+//from 273.15 K and over ice below it, and 0 for dry air at any temperature
+static double vapourPa(double T, double rh) {
+	if (rh == 0) {
+		return 0;
+	}
+	return rh * (T >= 273.15 ? saturationPa(T) : sublimationPa(T));
+}
+
+//temperature in K at which a vapour pressure saturates, the frost point below the lowest IF97 pressure
+static double condensationK(double p) {
+	return p >= 611.213 ? saturationK(p) : sublimationK(p);
+}
+
+//1 or 2 for the supported regions, 0 otherwise
+static int region(double p, double T) {
+	if (!(T >= 273.15 && T <= 1073.15 && p > 0 && p <= 100e6)) {
+		return 0;
+	}
+	if (T <= 623.15) {
+		return p > saturationPa(T) ? 1 : 2;
+	}
+	double boundary = (B23_N[0] + B23_N[1] * T + B23_N[2] * T * T) * 1e6;
+	return p <= boundary ? 2 : 0;
+}
+
+//specific volume in m3/kg and specific enthalpy in J/kg
+static void waterState(double p, double T, double& volume, double& enthalpy) {
+	double gammaPi, gammaTau;
+	switch (region(p, T)) {
+	case 1:
+		region1(p / 16.53e6, 1386 / T, gammaPi, gammaTau);
+		volume = R_WATER * T / 16.53e6 * gammaPi;
+		enthalpy = R_WATER * 1386 * gammaTau;
+		break;
+	case 2:
+		region2(p / 1e6, 540 / T, gammaPi, gammaTau);
+		volume = R_WATER * T / 1e6 * gammaPi;
+		enthalpy = R_WATER * 540 * gammaTau;
+		break;
+	default:
+		volume = NOT_A_NUMBER;
+		enthalpy = NOT_A_NUMBER;
+		break;
+	}
+}
+
+void Thermo::idealGasDensity(const Pressure* p, const Temperature* T, size_t n, double molarMass, Density* out) {
+	SIReader<Pressure> pa;
+	SIReader<Temperature> kelvin;
+	double factor = molarMass / GAS_CONSTANT;
+	for (size_t i = 0; i < n; i++) {
+		out[i] = fromSI<Density>(factor * pa(p[i]) / kelvin(T[i]));
+	}
+}
+
+void Thermo::idealGasVolume(const Pressure* p, const Temperature* T, size_t n, Mass mass, double molarMass, Volume* out) {
+	SIReader<Pressure> pa;
+	SIReader<Temperature> kelvin;
+	double factor = toSI(mass) / molarMass * GAS_CONSTANT;
+	for (size_t i = 0; i < n; i++) {
+		out[i] = fromSI<Volume>(factor * kelvin(T[i]) / pa(p[i]));
+	}
+}
+
+void Thermo::idealGasEnergy(const Temperature* T, size_t n, Mass mass, double molarMass, double cv, Energy* out) {
+	SIReader<Temperature> kelvin;
+	double factor = toSI(mass) / molarMass * cv;
+	for (size_t i = 0; i < n; i++) {
+		out[i] = fromSI<Energy>(factor * kelvin(T[i]));
+	}
+}
+
+void Thermo::waterDensity(const Pressure* p, const Temperature* T, size_t n, Density* out) {
+	SIReader<Pressure> pa;
+	SIReader<Temperature> kelvin;
+	for (size_t i = 0; i < n; i++) {
+		double volume, enthalpy;
+		waterState(pa(p[i]), kelvin(T[i]), volume, enthalpy);
+		out[i] = fromSI<Density>(1 / volume);
+	}
+}
+
+void Thermo::waterEnthalpy(const Pressure* p, const Temperature* T, size_t n, Mass mass, Energy* out) {
+	SIReader<Pressure> pa;
+	SIReader<Temperature> kelvin;
+	double kg = toSI(mass);
+	for (size_t i = 0; i < n; i++) {
+		double volume, enthalpy;
+		waterState(pa(p[i]), kelvin(T[i]), volume, enthalpy);
+		out[i] = fromSI<Energy>(kg * enthalpy);
+	}
+}
+
+void Thermo::saturationPressure(const Temperature* T, size_t n, Pressure* out) {
+	SIReader<Temperature> kelvin;
+	for (size_t i = 0; i < n; i++) {
+		out[i] = fromSI<Pressure>(saturationPa(kelvin(T[i])));
+	}
+}
+
+void Thermo::saturationTemperature(const Pressure* p, size_t n, Temperature* out) {
+	SIReader<Pressure> pa;
+	for (size_t i = 0; i < n; i++) {
+		out[i] = fromSI<Temperature>(saturationK(pa(p[i])));
+	}
+}
+
+void Thermo::humidityRatio(const Pressure* p, const Temperature* T, const double* rh, size_t n, double* out) {
+	SIReader<Pressure> pa;
+	SIReader<Temperature> kelvin;
+	double ratio = WATER_MOLAR_MASS / AIR_MOLAR_MASS;
+	for (size_t i = 0; i < n; i++) {
+		double vapour = vapourPa(kelvin(T[i]), rh[i]);
+		out[i] = ratio * vapour / (pa(p[i]) - vapour);
+	}
+}
+
+void Thermo::moistAirDensity(const Pressure* p, const Temperature* T, const double* rh, size_t n, Density* out) {
+	SIReader<Pressure> pa;
+	SIReader<Temperature> kelvin;
+	for (size_t i = 0; i < n; i++) {
+		double absolute = kelvin(T[i]);
+		double vapour = vapourPa(absolute, rh[i]);
+		double dry = pa(p[i]) - vapour;
+		out[i] = fromSI<Density>((dry * AIR_MOLAR_MASS + vapour * WATER_MOLAR_MASS) / (GAS_CONSTANT * absolute));
+	}
+}
+
+void Thermo::dewPoint(const Temperature* T, const double* rh, size_t n, Temperature* out) {
+	SIReader<Temperature> kelvin;
+	for (size_t i = 0; i < n; i++) {
+		out[i] = fromSI<Temperature>(condensationK(vapourPa(kelvin(T[i]), rh[i])));
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+/*
+THERMO
+======
+
+Batch property kernels over arrays of Pressure and Temperature.
+
+Thermo::idealGasDensity(p, T, n, Thermo::AIR_MOLAR_MASS, rho);
+Thermo::waterDensity(p, T, n, rho);
+Thermo::moistAirDensity(p, T, rh, n, rho);
+
+Every kernel reads n inputs and writes n outputs, converting each input to SI
+once and working in SI from then on. The conversions are set up once per call
+and read the stored doubles directly, so there are no per-sample value() calls.
+
+Water and steam use the IAPWS-IF97 industrial formulation, limited to:
+region 1	compressed liquid, 273.15 K to 623.15 K, up to 100 MPa
+region 2	superheated steam, 273.15 K to 1073.15 K, below the region 2/3 boundary
+region 4	saturation line, 273.15 K to 647.096 K
+States outside these regions come back as NaN. The coefficient tables are
+stored as separate exponent and coefficient arrays, and each sample builds
+its powers once by repeated multiplication instead of calling pow() per term.
+
+Psychrometrics treat moist air as an ideal mixture of dry air and water vapour,
+saturated over liquid water from IF97 region 4 at 273.15 K and above, and over
+ice from the IAPWS 2011 sublimation curve below that, down to 50 K. Relative
+humidity is a fraction from 0 to 1, and at 0 the air is dry at any temperature.
+Below freezing dewPoint() gives the frost point.
+*/
+
+#include <cstddef>
+#include "Measurement.h"
+
+namespace Thermo {
+	//J / (mol K)
+	const double GAS_CONSTANT = 8.314462618;
+	//kg / mol
+	const double AIR_MOLAR_MASS = 0.0289647;
+	const double WATER_MOLAR_MASS = 0.018015268;
+
+	//ideal gas: rho = p M / (R T), molarMass in kg/mol
+	void idealGasDensity(const Pressure* p, const Temperature* T, size_t n, double molarMass, Density* out);
+	//volume taken by mass of an ideal gas: V = m R T / (M p)
+	void idealGasVolume(const Pressure* p, const Temperature* T, size_t n, Mass mass, double molarMass, Volume* out);
+	//internal energy above 0 K of mass of an ideal gas with constant molar heat capacity cv in J/(mol K): U = m / M cv T
+	void idealGasEnergy(const Temperature* T, size_t n, Mass mass, double molarMass, double cv, Energy* out);
+
+	//IF97 regions 1 and 2
+	void waterDensity(const Pressure* p, const Temperature* T, size_t n, Density* out);
+	//enthalpy of mass of water or steam, relative to the IF97 reference state
+	void waterEnthalpy(const Pressure* p, const Temperature* T, size_t n, Mass mass, Energy* out);
+	//IF97 region 4
+	void saturationPressure(const Temperature* T, size_t n, Pressure* out);
+	void saturationTemperature(const Pressure* p, size_t n, Temperature* out);
+
+	//kg of water vapour per kg of dry air
+	void humidityRatio(const Pressure* p, const Temperature* T, const double* rh, size_t n, double* out);
+	void moistAirDensity(const Pressure* p, const Temperature* T, const double* rh, size_t n, Density* out);
+	void dewPoint(const Temperature* T, const double* rh, size_t n, Temperature* out);
+}
@@ -0,0 +1,366 @@
+#pragma once
+
+/*
+VECTORS
+=======
+
+Vec3<T> is a three-component vector of one measurement type.
+
+Vec3<Length> r(Length(0.2, UNITS::m), Length(0, UNITS::m), Length(0, UNITS::m));
+Vec3<Force> f(Force(0, UNITS::N), Force(50, UNITS::N), Force(0, UNITS::N));
+Torque t = cross(r, f).z();				//10 Nm
+Energy w = dot(r, f);					//0 J
+
+dot() and scaling by a measurement follow the operators in Measurement.h, so
+dot(Length, Force) is Energy and Vec3<Speed> * TimeDuration is Vec3<Length>.
+cross() also follows them except where the cross product is a different
+quantity to the dot product: Length x Force is Torque, not Energy.
+
+For large sets, Vec3SoA keeps x, y and z in separate arrays and Vec3AoSoA keeps
+them in blocks of Width lanes. The Vec3Batch kernels run over either layout in
+loops with no branches, which the compiler turns into SIMD code.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "MeasurementTraits.h"
+
+//result type of dot products
+template <class A, class B>
+struct DotType {
+	typedef typename ProductType<A, B>::type type;
+};
+
+//result type of cross products
+template <class A, class B>
+struct CrossType {
+	typedef typename ProductType<A, B>::type type;
+};
+
+//r x F is a moment, not work
+template <>
+struct CrossType<Length, Force> {
+	typedef Torque type;
+};
+
+template <>
+struct CrossType<Force, Length> {
+	typedef Torque type;
+};
+
+template <class T>
+class Vec3 {
+public:
+	Vec3() {
+		xyz[0] = 0;
+		xyz[1] = 0;
+		xyz[2] = 0;
+	}
+	Vec3(T x, T y, T z) {
+		xyz[0] = toSI(x);
+		xyz[1] = toSI(y);
+		xyz[2] = toSI(z);
+	}
+	//components given in SI units
+	static Vec3 fromSI(double x, double y, double z) {
+		Vec3 result;
+		result.xyz[0] = x;
+		result.xyz[1] = y;
+		result.xyz[2] = z;
+		return result;
+	}
+	T x() {
+		return ::fromSI<T>(xyz[0]);
+	}
+	T y() {
+		return ::fromSI<T>(xyz[1]);
+	}
+	T z() {
+		return ::fromSI<T>(xyz[2]);
+	}
+	//component i in SI units, 0 = x, 1 = y, 2 = z
+	double si(int i) {
+		return xyz[i];
+	}
+	T norm() {
+		return ::fromSI<T>(std::sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2]));
+	}
+	Vec3 operator+ (Vec3 v) {
+		return fromSI(xyz[0] + v.xyz[0], xyz[1] + v.xyz[1], xyz[2] + v.xyz[2]);
+	}
+	Vec3 operator- (Vec3 v) {
+		return fromSI(xyz[0] - v.xyz[0], xyz[1] - v.xyz[1], xyz[2] - v.xyz[2]);
+	}
+	Vec3 operator* (double val) {
+		return fromSI(xyz[0] * val, xyz[1] * val, xyz[2] * val);
+	}
+	Vec3 operator/ (double val) {
+		return fromSI(xyz[0] / val, xyz[1] / val, xyz[2] / val);
+	}
+	//scaling by a measurement, e.g. Vec3<Acceleration> * Mass is Vec3<Force>
+	template <class U>
+	Vec3<typename ProductType<T, U>::type> operator* (U val) {
+		double s = toSI(val);
+		return Vec3<typename ProductType<T, U>::type>::fromSI(xyz[0] * s, xyz[1] * s, xyz[2] * s);
+	}
+	template <class U>
+	Vec3<typename QuotientType<T, U>::type> operator/ (U val) {
+		double s = toSI(val);
+		return Vec3<typename QuotientType<T, U>::type>::fromSI(xyz[0] / s, xyz[1] / s, xyz[2] / s);
+	}
+	void operator+= (Vec3 v) {
+		xyz[0] += v.xyz[0];
+		xyz[1] += v.xyz[1];
+		xyz[2] += v.xyz[2];
+	}
+	void operator-= (Vec3 v) {
+		xyz[0] -= v.xyz[0];
+		xyz[1] -= v.xyz[1];
+		xyz[2] -= v.xyz[2];
+	}
+	bool operator== (Vec3 v) {
+		return (xyz[0] == v.xyz[0] && xyz[1] == v.xyz[1] && xyz[2] == v.xyz[2]);
+	}
+	bool operator!= (Vec3 v) {
+		return !(*this == v);
+	}
+
+protected:
+	double xyz[3];
+};
+
+template <class A, class B>
+typename DotType<A, B>::type dot(Vec3<A> a, Vec3<B> b) {
+	return fromSI<typename DotType<A, B>::type>(a.si(0) * b.si(0) + a.si(1) * b.si(1) + a.si(2) * b.si(2));
+}
+
+template <class A, class B>
+Vec3<typename CrossType<A, B>::type> cross(Vec3<A> a, Vec3<B> b) {
+	return Vec3<typename CrossType<A, B>::type>::fromSI(
+		a.si(1) * b.si(2) - a.si(2) * b.si(1),
+		a.si(2) * b.si(0) - a.si(0) * b.si(2),
+		a.si(0) * b.si(1) - a.si(1) * b.si(0));
+}
+
+//kernels over separate x, y, z arrays of SI values, n elements each
+namespace Vec3Batch {
+	inline void add(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz,
+		double* x, double* y, double* z, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			x[i] = ax[i] + bx[i];
+			y[i] = ay[i] + by[i];
+			z[i] = az[i] + bz[i];
+		}
+	}
+	//a * s + b, per element scale, e.g. position + velocity * dt
+	inline void multiplyAdd(const double* ax, const double* ay, const double* az, const double* s,
+		const double* bx, const double* by, const double* bz, double* x, double* y, double* z, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			x[i] = ax[i] * s[i] + bx[i];
+			y[i] = ay[i] * s[i] + by[i];
+			z[i] = az[i] * s[i] + bz[i];
+		}
+	}
+	inline void scale(const double* ax, const double* ay, const double* az, double s, double* x, double* y, double* z, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			x[i] = ax[i] * s;
+			y[i] = ay[i] * s;
+			z[i] = az[i] * s;
+		}
+	}
+	inline void dot(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz,
+		double* out, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+		}
+	}
+	inline void cross(const double* ax, const double* ay, const double* az, const double* bx, const double* by, const double* bz,
+		double* x, double* y, double* z, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			double cx = ay[i] * bz[i] - az[i] * by[i];
+			double cy = az[i] * bx[i] - ax[i] * bz[i];
+			double cz = ax[i] * by[i] - ay[i] * bx[i];
+			x[i] = cx;
+			y[i] = cy;
+			z[i] = cz;
+		}
+	}
+	inline void norm(const double* ax, const double* ay, const double* az, double* out, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+		}
+	}
+}
+
+//structure of arrays: all x, then all y, then all z
+template <class T>
+class Vec3SoA {
+public:
+	Vec3SoA() {}
+	Vec3SoA(size_t count) : xs(count), ys(count), zs(count) {}
+	size_t size() {
+		return xs.size();
+	}
+	void resize(size_t count) {
+		xs.resize(count);
+		ys.resize(count);
+		zs.resize(count);
+	}
+	void push_back(Vec3<T> v) {
+		xs.push_back(v.si(0));
+		ys.push_back(v.si(1));
+		zs.push_back(v.si(2));
+	}
+	Vec3<T> get(size_t i) {
+		return Vec3<T>::fromSI(xs[i], ys[i], zs[i]);
+	}
+	void set(size_t i, Vec3<T> v) {
+		xs[i] = v.si(0);
+		ys[i] = v.si(1);
+		zs[i] = v.si(2);
+	}
+	double* x() {
+		return xs.data();
+	}
+	double* y() {
+		return ys.data();
+	}
+	double* z() {
+		return zs.data();
+	}
+	Vec3SoA operator+ (Vec3SoA& other) {
+		Vec3SoA result(size());
+		Vec3Batch::add(x(), y(), z(), other.x(), other.y(), other.z(), result.x(), result.y(), result.z(), size());
+		return result;
+	}
+	Vec3SoA operator* (double val) {
+		Vec3SoA result(size());
+		Vec3Batch::scale(x(), y(), z(), val, result.x(), result.y(), result.z(), size());
+		return result;
+	}
+
+protected:
+	std::vector<double> xs;
+	std::vector<double> ys;
+	std::vector<double> zs;
+};
+
+template <class A, class B>
+std::vector<typename DotType<A, B>::type> dot(Vec3SoA<A>& a, Vec3SoA<B>& b) {
+	typedef typename DotType<A, B>::type R;
+	std::vector<double> si(a.size());
+	Vec3Batch::dot(a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), si.data(), a.size());
+	std::vector<R> result;
+	result.reserve(si.size());
+	for (size_t i = 0; i < si.size(); i++) {
+		result.push_back(fromSI<R>(si[i]));
+	}
+	return result;
+}
+
+template <class A, class B>
+Vec3SoA<typename CrossType<A, B>::type> cross(Vec3SoA<A>& a, Vec3SoA<B>& b) {
+	Vec3SoA<typename CrossType<A, B>::type> result(a.size());
+	Vec3Batch::cross(a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), result.x(), result.y(), result.z(), a.size());
+	return result;
+}
+
+//array of structures of arrays: blocks of Width vectors, each block holding Width x, then Width y, then Width z
+//the last block is padded with zero vectors
+template <class T, size_t Width = 8>
+class Vec3AoSoA {
+public:
+	struct Block {
+		double x[Width];
+		double y[Width];
+		double z[Width];
+	};
+
+	Vec3AoSoA() {
+		count = 0;
+	}
+	Vec3AoSoA(size_t n) {
+		count = 0;
+		resize(n);
+	}
+	size_t size() {
+		return count;
+	}
+	void resize(size_t n) {
+		blocks.resize((n + Width - 1) / Width, Block());
+		count = n;
+	}
+	void push_back(Vec3<T> v) {
+		resize(count + 1);
+		set(count - 1, v);
+	}
+	Vec3<T> get(size_t i) {
+		Block& b = blocks[i / Width];
+		return Vec3<T>::fromSI(b.x[i % Width], b.y[i % Width], b.z[i % Width]);
+	}
+	void set(size_t i, Vec3<T> v) {
+		Block& b = blocks[i / Width];
+		b.x[i % Width] = v.si(0);
+		b.y[i % Width] = v.si(1);
+		b.z[i % Width] = v.si(2);
+	}
+	size_t blockCount() {
+		return blocks.size();
+	}
+	Block* data() {
+		return blocks.data();
+	}
+	Vec3AoSoA operator+ (Vec3AoSoA& other) {
+		Vec3AoSoA result(size());
+		for (size_t i = 0; i < blocks.size(); i++) {
+			Block& a = blocks[i];
+			Block& b = other.blocks[i];
+			Block& r = result.blocks[i];
+			Vec3Batch::add(a.x, a.y, a.z, b.x, b.y, b.z, r.x, r.y, r.z, Width);
+		}
+		return result;
+	}
+	Vec3AoSoA operator* (double val) {
+		Vec3AoSoA result(size());
+		for (size_t i = 0; i < blocks.size(); i++) {
+			Block& a = blocks[i];
+			Block& r = result.blocks[i];
+			Vec3Batch::scale(a.x, a.y, a.z, val, r.x, r.y, r.z, Width);
+		}
+		return result;
+	}
+
+protected:
+	std::vector<Block> blocks;
+	size_t count;
+};
+
+template <class A, class B, size_t Width>
+std::vector<typename DotType<A, B>::type> dot(Vec3AoSoA<A, Width>& a, Vec3AoSoA<B, Width>& b) {
+	typedef typename DotType<A, B>::type R;
+	std::vector<R> result;
+	result.reserve(a.size());
+	double si[Width];
+	for (size_t i = 0; i < a.blockCount(); i++) {
+		typename Vec3AoSoA<A, Width>::Block& ba = a.data()[i];
+		typename Vec3AoSoA<B, Width>::Block& bb = b.data()[i];
+		Vec3Batch::dot(ba.x, ba.y, ba.z, bb.x, bb.y, bb.z, si, Width);
+		for (size_t l = 0; l < Width && result.size() < a.size(); l++) {
+			result.push_back(fromSI<R>(si[l]));
+		}
+	}
+	return result;
+}
+
+template <class A, class B, size_t Width>
+Vec3AoSoA<typename CrossType<A, B>::type, Width> cross(Vec3AoSoA<A, Width>& a, Vec3AoSoA<B, Width>& b) {
+	Vec3AoSoA<typename CrossType<A, B>::type, Width> result(a.size());
+	for (size_t i = 0; i < a.blockCount(); i++) {
+		typename Vec3AoSoA<A, Width>::Block& ba = a.data()[i];
+		typename Vec3AoSoA<B, Width>::Block& bb = b.data()[i];
+		typename Vec3AoSoA<typename CrossType<A, B>::type, Width>::Block& r = result.data()[i];
+		Vec3Batch::cross(ba.x, ba.y, ba.z, bb.x, bb.y, bb.z, r.x, r.y, r.z, Width);
+	}
+	return result;
+}
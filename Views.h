@@ -0,0 +1,78 @@
+#pragma once
+
+/*
+VIEWS
+=====
+
+C++20 range adaptors that convert lazily, element by element, without
+building a new array.
+
+std::vector<Pressure> readings;
+plot(readings | measurement::views::in<UNITS::psi>);				//doubles in psi
+plot(readings | measurement::views::si);						//doubles in Pa
+
+std::vector<double> raw;
+for (Pressure p : raw | measurement::views::as<Pressure>(UNITS::psi)) { ... }
+
+The unit's scale and offset are worked out once when the adaptor is made, and
+elements are read and built through the double each class keeps, so each
+element costs one inlined multiply-add and no call to value() or set(). The views are sized and random access
+whenever the underlying range is, which keeps std algorithms and auto-vectorized
+loops working on them. They cannot be contiguous since each element is computed.
+*/
+
+#include <ranges>
+#include "MeasurementTraits.h"
+
+namespace measurement {
+
+	//measurement -> double in units
+	template <class T>
+	struct ToUnit {
+		UnitConversion conv;
+		ToUnit(typename SIUnit<T>::Units units) : conv(conversionFromStored<T>(units)) {}
+		double operator() (T val) const {
+			return conv.apply(storedValue(val));
+		}
+	};
+
+	//double in units -> measurement
+	template <class T>
+	struct FromUnit {
+		UnitConversion conv;
+		FromUnit(typename SIUnit<T>::Units units) : conv(conversionToStored<T>(units)) {}
+		T operator() (double val) const {
+			return fromStored<T>(conv.apply(val));
+		}
+	};
+
+	//measurement -> double in its SI unit
+	struct ToSI {
+		template <class T>
+		double operator() (T val) const {
+			return storedValue(val) * storedScale<T>();
+		}
+	};
+
+	namespace views {
+
+		//range of measurements as doubles in Unit, e.g. views::in<UNITS::psi>
+		template <auto Unit>
+		inline const auto in = std::views::transform(ToUnit<typename MeasurementOf<decltype(Unit)>::type>(Unit));
+
+		//range of measurements as doubles in their SI unit
+		inline const auto si = std::views::transform(ToSI());
+
+		//range of doubles in units as measurements of type T
+		template <class T>
+		auto as(typename SIUnit<T>::Units units) {
+			return std::views::transform(FromUnit<T>(units));
+		}
+
+		//range of doubles already in SI units as measurements of type T
+		template <class T>
+		auto asSI() {
+			return std::views::transform(FromUnit<T>(SIUnit<T>::unit));
+		}
+	}
+}
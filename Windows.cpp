@@ -0,0 +1,268 @@
+#include "Windows.h"
+#include <cmath>
+#include <limits>
+
+static const double INF = std::numeric_limits<double>::infinity();
+//ring slots a sliding window starts with, doubled as needed
+static const size_t INITIAL_RING = 16;
+//times within this fraction of a window of a tumbling boundary are on it
+static const double EDGE_FRACTION = 1e-9;
+
+//start of the tumbling window holding t, snapped to a boundary t is within rounding of,
+//since 300 ms over 100 ms windows is 2.9999999999999996 windows
+static double windowStart(double t, double width) {
+	double position = t / width;
+	double nearest = std::nearbyint(position);
+	double index = std::fabs(position - nearest) < EDGE_FRACTION * std::fmax(1, std::fabs(nearest)) ? nearest : std::floor(position);
+	return index * width;
+}
+
+WindowEngine::WindowEngine(WindowKind windowKind, size_t streams, double size, double lateness) {
+	kind = windowKind;
+	width = size;
+	allowed = lateness > 0 ? lateness : 0;
+	late = 0;
+	states.resize(streams);
+	for (size_t i = 0; i < streams; i++) {
+		Stream& s = states[i];
+		s.count = 0;
+		s.shift = 0;
+		s.sum = 0;
+		s.squares = 0;
+		s.min = INF;
+		s.max = -INF;
+		s.start = 0;
+		s.last = 0;
+		s.newest = -INF;
+		s.applied = -INF;
+		s.pendingHead = 0;
+		s.head = 0;
+		s.split = 0;
+		s.tail = 0;
+		s.backMin = INF;
+		s.backMax = -INF;
+	}
+}
+
+bool WindowEngine::push(size_t stream, double t, double v) {
+	Stream& s = states[stream];
+	if (t < s.applied) {
+		late++;
+		return false;
+	}
+	if (v != v) {
+		return true;
+	}
+	if (allowed == 0 && s.pendingHead == s.pending.size()) {
+		//in order and nothing held back, straight in
+		s.newest = t > s.newest ? t : s.newest;
+		apply(stream, t, v);
+		return true;
+	}
+	//insertion from the back, samples are mostly in order
+	Sample sample = { t, v };
+	size_t i = s.pending.size();
+	s.pending.push_back(sample);
+	while (i > s.pendingHead && s.pending[i - 1].t > t) {
+		s.pending[i] = s.pending[i - 1];
+		i--;
+	}
+	s.pending[i] = sample;
+	s.newest = t > s.newest ? t : s.newest;
+	release(stream, s.newest - allowed);
+	return true;
+}
+
+//applies the held back samples up to watermark
+void WindowEngine::release(size_t stream, double watermark) {
+	Stream& s = states[stream];
+	while (s.pendingHead < s.pending.size() && s.pending[s.pendingHead].t <= watermark) {
+		Sample sample = s.pending[s.pendingHead++];
+		apply(stream, sample.t, sample.v);
+	}
+	if (s.pendingHead == s.pending.size()) {
+		s.pending.clear();
+		s.pendingHead = 0;
+	}
+	else if (s.pendingHead > 64 && s.pendingHead * 2 > s.pending.size()) {
+		s.pending.erase(s.pending.begin(), s.pending.begin() + s.pendingHead);
+		s.pendingHead = 0;
+	}
+}
+
+void WindowEngine::advance(double watermark) {
+	for (size_t i = 0; i < states.size(); i++) {
+		Stream& s = states[i];
+		release(i, watermark);
+		s.applied = watermark > s.applied ? watermark : s.applied;
+		if (!s.count) {
+			continue;
+		}
+		if ((kind == TUMBLING_WINDOW && watermark >= s.start + width) || (kind == SESSION_WINDOW && watermark > s.last + width)) {
+			close(i);
+		}
+		else if (kind == SLIDING_WINDOW) {
+			evict(s, watermark - width);
+		}
+	}
+}
+
+void WindowEngine::flush() {
+	for (size_t i = 0; i < states.size(); i++) {
+		release(i, INF);
+		if (states[i].count && kind != SLIDING_WINDOW) {
+			close(i);
+		}
+	}
+}
+
+void WindowEngine::apply(size_t stream, double t, double v) {
+	Stream& s = states[stream];
+	s.applied = t;
+	if (kind == TUMBLING_WINDOW) {
+		double start = windowStart(t, width);
+		if (s.count && start != s.start) {
+			close(stream);
+		}
+		if (!s.count) {
+			s.start = start;
+		}
+	}
+	else if (kind == SESSION_WINDOW) {
+		if (s.count && t - s.last > width) {
+			close(stream);
+		}
+		if (!s.count) {
+			s.start = t;
+		}
+	}
+	else {
+		evict(s, t - width);
+		if (s.tail - s.head == s.ring.size()) {
+			//full, double the ring and keep every sample at the same index
+			size_t size = s.ring.empty() ? INITIAL_RING : s.ring.size() * 2;
+			std::vector<Sample> ring(size);
+			std::vector<double> suffixMin(size);
+			std::vector<double> suffixMax(size);
+			for (uint64_t i = s.head; i < s.tail; i++) {
+				ring[i & (size - 1)] = s.ring[i & (s.ring.size() - 1)];
+				suffixMin[i & (size - 1)] = s.suffixMin[i & (s.ring.size() - 1)];
+				suffixMax[i & (size - 1)] = s.suffixMax[i & (s.ring.size() - 1)];
+			}
+			s.ring.swap(ring);
+			s.suffixMin.swap(suffixMin);
+			s.suffixMax.swap(suffixMax);
+		}
+		Sample sample = { t, v };
+		s.ring[s.tail & (s.ring.size() - 1)] = sample;
+		s.tail++;
+		s.backMin = v < s.backMin ? v : s.backMin;
+		s.backMax = v > s.backMax ? v : s.backMax;
+		if (!s.count) {
+			s.start = t;
+		}
+	}
+	s.last = t;
+	add(s, v);
+}
+
+void WindowEngine::add(Stream& s, double v) {
+	if (!s.count) {
+		s.shift = v;
+		s.sum = 0;
+		s.squares = 0;
+	}
+	double d = v - s.shift;
+	s.sum += d;
+	s.squares += d * d;
+	s.count++;
+	if (kind != SLIDING_WINDOW) {
+		s.min = v < s.min ? v : s.min;
+		s.max = v > s.max ? v : s.max;
+	}
+}
+
+//drops samples at or before the time before
+void WindowEngine::evict(Stream& s, double before) {
+	size_t mask = s.ring.size() - 1;
+	while (s.head < s.tail && s.ring[s.head & mask].t <= before) {
+		if (s.head == s.split) {
+			rebuild(s);
+		}
+		double d = s.ring[s.head & mask].v - s.shift;
+		s.sum -= d;
+		s.squares -= d * d;
+		s.count--;
+		s.head++;
+	}
+	if (s.head < s.tail) {
+		s.start = s.ring[s.head & mask].t;
+	}
+	else {
+		s.count = 0;
+		s.split = s.head;
+		s.backMin = INF;
+		s.backMax = -INF;
+	}
+}
+
+//moves the back stack to the front, with the min and max of every suffix, and recomputes the sums
+void WindowEngine::rebuild(Stream& s) {
+	size_t mask = s.ring.size() - 1;
+	double low = INF;
+	double high = -INF;
+	for (uint64_t i = s.tail; i > s.head; i--) {
+		double v = s.ring[(i - 1) & mask].v;
+		low = v < low ? v : low;
+		high = v > high ? v : high;
+		s.suffixMin[(i - 1) & mask] = low;
+		s.suffixMax[(i - 1) & mask] = high;
+	}
+	s.split = s.tail;
+	s.backMin = INF;
+	s.backMax = -INF;
+	s.shift = s.ring[s.head & mask].v;
+	s.sum = 0;
+	s.squares = 0;
+	for (uint64_t i = s.head; i < s.tail; i++) {
+		double d = s.ring[i & mask].v - s.shift;
+		s.sum += d;
+		s.squares += d * d;
+	}
+}
+
+WindowStats WindowEngine::stats(size_t stream) {
+	Stream& s = states[stream];
+	WindowStats w;
+	w.stream = stream;
+	w.start = s.start;
+	w.end = kind == TUMBLING_WINDOW ? s.start + width : s.last;
+	w.count = s.count;
+	w.sum = s.sum + s.shift * s.count;
+	w.min = s.min;
+	w.max = s.max;
+	if (kind == SLIDING_WINDOW) {
+		size_t mask = s.ring.size() - 1;
+		bool front = s.head < s.split;
+		w.min = front && s.suffixMin[s.head & mask] < s.backMin ? s.suffixMin[s.head & mask] : s.backMin;
+		w.max = front && s.suffixMax[s.head & mask] > s.backMax ? s.suffixMax[s.head & mask] : s.backMax;
+	}
+	w.variance = 0;
+	if (s.count > 1) {
+		double variance = (s.squares - s.sum * s.sum / s.count) / (s.count - 1);
+		w.variance = variance > 0 ? variance : 0;
+	}
+	return w;
+}
+
+WindowStats WindowEngine::current(size_t stream) {
+	return stats(stream);
+}
+
+void WindowEngine::close(size_t stream) {
+	closed.push_back(stats(stream));
+	Stream& s = states[stream];
+	s.count = 0;
+	s.min = INF;
+	s.max = -INF;
+}
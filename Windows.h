@@ -0,0 +1,219 @@
+#pragma once
+
+/*
+WINDOWS
+=======
+
+Incremental window aggregates over many streams of one quantity: count, sum,
+mean, min, max and variance, with window sizes given as TimeDuration.
+
+Windows<Power> rolling = Windows<Power>::sliding(streams, TimeDuration(1, UNITS::min));
+Windows<Acceleration> peaks = Windows<Acceleration>::tumbling(streams, TimeDuration(10, UNITS::s));
+Windows<Volume> hourly = Windows<Volume>::tumbling(streams, TimeDuration(1, UNITS::hr), TimeDuration(5, UNITS::s));	//5 s late allowed
+Windows<Pressure> bursts = Windows<Pressure>::session(streams, TimeDuration(30, UNITS::s));	//a 30 s gap ends a session
+
+rolling.push(pump, now, Power(3.2, UNITS::kW));
+WindowResult<Power> last = rolling.current(pump);
+double kW = last.mean.value(UNITS::kW);
+
+hourly.push(meter, now, volume);
+for (WindowResult<Volume>& hour : hourly.results())
+	total(hour.stream, hour.start, hour.sum);
+hourly.clear();
+
+Tumbling windows are aligned to time zero, so every stream of a quantity closes
+its minute on the same boundary. A sample within rounding of a boundary opens
+the window starting there, so 300 ms is in the fourth 100 ms window. Closed tumbling and session windows are
+appended to results(). A sliding window covers (t - size, t] for the latest
+sample t of its stream, and is read with current().
+
+Every update is O(1) amortized. Tumbling and session windows only ever add to
+their totals. Sliding windows subtract evicted samples from the sum and the sum
+of squares, and keep min and max with two stacks over the stream's ring of
+samples: the front stack keeps a min and max for each suffix, the back stack a
+running one, and the front is rebuilt from the back only when it runs out. The
+rebuild also recomputes the sums from the samples left, so rounding does not
+build up across evictions. Sums are kept relative to a reference value from the
+window, which keeps the variance accurate when the spread is small next to the
+values themselves.
+
+Samples may arrive out of order by up to the allowed lateness. Each stream
+holds them back until its watermark (the latest time seen less the lateness)
+passes them, then applies them in time order. Samples older than what was
+already applied are dropped and counted. advance() moves the watermark of every
+stream, which closes windows of streams that have gone quiet, and flush()
+applies and closes everything.
+
+All streams share one flat array of state, and the hot totals of a stream sit
+together at its start. Aggregates work on the stored doubles, so variance()
+converts from squared stored units. NaN samples are skipped.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MeasurementTraits.h"
+
+enum WindowKind { TUMBLING_WINDOW, SLIDING_WINDOW, SESSION_WINDOW };
+
+//aggregates of one window in stored doubles, times in seconds
+struct WindowStats {
+	size_t stream;
+	double start;
+	double end;
+	uint64_t count;
+	double sum;
+	double min;
+	double max;
+	double variance;	//sample variance, 0 below two samples
+};
+
+class WindowEngine {
+public:
+	WindowEngine(WindowKind windowKind, size_t streams, double size, double lateness);
+	//false when the sample is too late and was dropped
+	bool push(size_t stream, double t, double v);
+	void advance(double watermark);
+	void flush();
+	//open window of a stream, the sliding window for sliding windows
+	WindowStats current(size_t stream);
+	std::vector<WindowStats>& results() {
+		return closed;
+	}
+	uint64_t dropped() {
+		return late;
+	}
+
+protected:
+	struct Sample {
+		double t;
+		double v;
+	};
+	struct Stream {
+		//window totals, relative to shift
+		uint64_t count;
+		double shift;
+		double sum;
+		double squares;
+		double min;
+		double max;
+		double start;
+		double last;
+		//latest time seen and latest applied
+		double newest;
+		double applied;
+		//samples waiting for the watermark, in time order from pendingHead
+		std::vector<Sample> pending;
+		size_t pendingHead;
+		//sliding window ring, [head, split) is the front stack and [split, tail) the back
+		std::vector<Sample> ring;
+		std::vector<double> suffixMin;
+		std::vector<double> suffixMax;
+		uint64_t head;
+		uint64_t split;
+		uint64_t tail;
+		double backMin;
+		double backMax;
+	};
+
+	void release(size_t stream, double watermark);
+	void apply(size_t stream, double t, double v);
+	void add(Stream& s, double v);
+	void close(size_t stream);
+	void evict(Stream& s, double before);
+	void rebuild(Stream& s);
+	WindowStats stats(size_t stream);
+
+	WindowKind kind;
+	double width;
+	double allowed;
+	uint64_t late;
+	std::vector<Stream> states;
+	std::vector<WindowStats> closed;
+};
+
+//one window in the units of T
+template <class T>
+struct WindowResult {
+	size_t stream;
+	TimeDuration start;
+	TimeDuration end;	//tumbling windows end on their boundary, the others on their latest sample
+	uint64_t count;
+	T sum;
+	T mean;
+	T min;
+	T max;
+	double storedVariance;	//sample variance in squared stored units
+
+	double variance(typename SIUnit<T>::Units units) {
+		double scale = conversionFromStored<T>(units).scale;
+		return storedVariance * scale * scale;
+	}
+
+	static WindowResult of(WindowStats s) {
+		WindowResult r;
+		r.stream = s.stream;
+		r.start = TimeDuration(s.start, UNITS::s);
+		r.end = TimeDuration(s.end, UNITS::s);
+		r.count = s.count;
+		r.sum = fromStored<T>(s.sum);
+		r.mean = fromStored<T>(s.count ? s.sum / s.count : 0);
+		r.min = fromStored<T>(s.min);
+		r.max = fromStored<T>(s.max);
+		r.storedVariance = s.variance;
+		return r;
+	}
+};
+
+template <class T>
+class Windows {
+public:
+	static Windows tumbling(size_t streams, TimeDuration size, TimeDuration lateness = TimeDuration(0, UNITS::s)) {
+		return Windows(TUMBLING_WINDOW, streams, size, lateness);
+	}
+	static Windows sliding(size_t streams, TimeDuration size, TimeDuration lateness = TimeDuration(0, UNITS::s)) {
+		return Windows(SLIDING_WINDOW, streams, size, lateness);
+	}
+	//a session ends when its stream has no sample for gap
+	static Windows session(size_t streams, TimeDuration gap, TimeDuration lateness = TimeDuration(0, UNITS::s)) {
+		return Windows(SESSION_WINDOW, streams, gap, lateness);
+	}
+
+	//false when the sample is older than what the stream already applied
+	bool push(size_t stream, TimeDuration t, T v) {
+		return engine.push(stream, t.value(UNITS::s), storedValue(v));
+	}
+	//watermark for every stream, nothing older can arrive any more
+	void advance(TimeDuration watermark) {
+		engine.advance(watermark.value(UNITS::s));
+	}
+	//applies everything held back and closes every window
+	void flush() {
+		engine.flush();
+	}
+	WindowResult<T> current(size_t stream) {
+		return WindowResult<T>::of(engine.current(stream));
+	}
+	//closed tumbling and session windows, in the order they closed
+	std::vector<WindowResult<T> >& results() {
+		std::vector<WindowStats>& closed = engine.results();
+		for (size_t i = typed.size(); i < closed.size(); i++) {
+			typed.push_back(WindowResult<T>::of(closed[i]));
+		}
+		return typed;
+	}
+	void clear() {
+		engine.results().clear();
+		typed.clear();
+	}
+	uint64_t dropped() {
+		return engine.dropped();
+	}
+
+protected:
+	Windows(WindowKind kind, size_t streams, TimeDuration size, TimeDuration lateness)
+		: engine(kind, streams, size.value(UNITS::s), lateness.value(UNITS::s)) {}
+
+	WindowEngine engine;
+	std::vector<WindowResult<T> > typed;
+};
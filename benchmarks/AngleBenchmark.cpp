@@ -0,0 +1,69 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Angle.h"
+#include "Bench.h"
+
+int main() {
+	const size_t n = 1000000;
+	std::mt19937_64 random(5);
+	std::uniform_real_distribution<double> turns(-20, 20);
+	std::vector<double> x(n);
+	std::vector<double> y(n);
+	for (size_t i = 0; i < n; i++) {
+		x[i] = turns(random);
+		y[i] = turns(random);
+	}
+	std::vector<double> s(n);
+	std::vector<double> c(n);
+
+	double ns = bestOf(5, [&] {
+		for (size_t i = 0; i < n; i++) {
+			s[i] = std::sin(x[i]);
+		}
+	});
+	keep(s[n - 1]);
+	report("std::sin loop", ns, n);
+
+	ns = bestOf(5, [&] {
+		for (size_t i = 0; i < n; i++) {
+			s[i] = std::sin(x[i]);
+			c[i] = std::cos(x[i]);
+		}
+	});
+	keep(s[n - 1] + c[n - 1]);
+	report("std::sin and std::cos loop", ns, n);
+
+	ns = bestOf(5, [&] {
+		for (size_t i = 0; i < n; i++) {
+			s[i] = std::atan2(y[i], x[i]);
+		}
+	});
+	keep(s[n - 1]);
+	report("std::atan2 loop", ns, n);
+
+	ns = bestOf(5, [&] { AngleBatch::sin(x.data(), n, s.data()); });
+	keep(s[n - 1]);
+	report("AngleBatch::sin", ns, n);
+
+	ns = bestOf(5, [&] { AngleBatch::sincos(x.data(), n, s.data(), c.data()); });
+	keep(s[n - 1] + c[n - 1]);
+	report("AngleBatch::sincos", ns, n);
+
+	ns = bestOf(5, [&] { AngleBatch::atan2(y.data(), x.data(), n, s.data()); });
+	keep(s[n - 1]);
+	report("AngleBatch::atan2", ns, n);
+
+	ns = bestOf(5, [&] { AngleBatch::fastSin(x.data(), n, s.data()); });
+	keep(s[n - 1]);
+	report("AngleBatch::fastSin", ns, n);
+
+	ns = bestOf(5, [&] { AngleBatch::fastSincos(x.data(), n, s.data(), c.data()); });
+	keep(s[n - 1] + c[n - 1]);
+	report("AngleBatch::fastSincos", ns, n);
+
+	ns = bestOf(5, [&] { AngleBatch::fastAtan2(y.data(), x.data(), n, s.data()); });
+	keep(s[n - 1]);
+	report("AngleBatch::fastAtan2", ns, n);
+	return 0;
+}
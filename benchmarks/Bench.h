@@ -0,0 +1,41 @@
+#pragma once
+
+/*
+BENCH
+=====
+
+Timing for the benchmarks, with no framework behind them. bestOf() runs a job
+several times and returns the fastest run in nanoseconds, which is the number
+least disturbed by whatever else the machine is doing.
+
+double ns = bestOf(5, [&] { integrateDormandPrince(spring, batch, t0, t1); });
+report("DormandPrince batch", ns, systems);
+*/
+
+#include <chrono>
+#include <cstdio>
+
+template <class F>
+double bestOf(int runs, F job) {
+	double best = 0;
+	for (int r = 0; r < runs; r++) {
+		auto start = std::chrono::steady_clock::now();
+		job();
+		double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		if (r == 0 || ns < best) {
+			best = ns;
+		}
+	}
+	return best;
+}
+
+//prints the total and the time per item
+inline void report(const char* name, double ns, double items) {
+	printf("%-40s %12.3f ms %10.2f ns/item\n", name, ns / 1e6, ns / items);
+}
+
+//keeps a result alive so the optimizer cannot drop the work producing it
+inline void keep(double val) {
+	static volatile double sink;
+	sink = val;
+}
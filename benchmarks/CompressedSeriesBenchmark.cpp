@@ -0,0 +1,94 @@
+#include <cmath>
+#include <vector>
+#include "Bench.h"
+#include "CompressedSeries.h"
+#include "Measurement.h"
+
+int main() {
+	//a temperature sampled every 100 ms with a little jitter on the clock and noise on the value
+	const size_t n = 1000000;
+	std::vector<TimeDuration> t(n);
+	std::vector<Temperature> v(n);
+	for (size_t i = 0; i < n; i++) {
+		t[i] = TimeDuration((double)(i * 100 + (i % 7 == 0 ? 1 : 0)), UNITS::ms);
+		v[i] = Temperature(20 + std::round(std::sin(i * 1e-4) * 50) * 0.1, UNITS::C);
+	}
+
+	CompressedSeries<Temperature> series;
+	double ns = bestOf(5, [&] {
+		series.clear();
+		for (size_t i = 0; i < n; i++) {
+			series.push_back(t[i], v[i]);
+		}
+	});
+	report("push_back", ns, n);
+	printf("%zu blocks, ratio %.1f\n", series.blocks(), series.ratio());
+
+	std::vector<TimeDuration> outT(CompressedSeries<Temperature>::MAX_BLOCK_SAMPLES);
+	std::vector<Temperature> outV(CompressedSeries<Temperature>::MAX_BLOCK_SAMPLES);
+	ns = bestOf(5, [&] {
+		double sum = 0;
+		for (size_t b = 0; b < series.blocks(); b++) {
+			size_t count = series.decode(b, outT.data(), outV.data());
+			sum += storedValue(outV[count - 1]);
+		}
+		keep(sum);
+	});
+	report("decode every block", ns, n);
+
+	//in order, each block is unpacked once
+	ns = bestOf(5, [&] {
+		double sum = 0;
+		TimeDuration at;
+		Temperature val;
+		for (size_t i = 0; i < n; i++) {
+			series.at(i, at, val);
+			sum += storedValue(val);
+		}
+		keep(sum);
+	});
+	report("at() in order", ns, n);
+
+	//what at() did before, a walk over the headers and a whole block decoded into fresh arrays on every call
+	const size_t lookups = 2000;
+	ns = bestOf(5, [&] {
+		double sum = 0;
+		for (size_t k = 0; k < lookups; k++) {
+			size_t i = k * 499;
+			size_t block = 0;
+			while (block + 1 < series.blocks() && i >= series.header(block).first + series.header(block).count) {
+				block++;
+			}
+			std::vector<TimeDuration> times(CompressedSeries<Temperature>::MAX_BLOCK_SAMPLES);
+			std::vector<Temperature> values(CompressedSeries<Temperature>::MAX_BLOCK_SAMPLES);
+			series.decode(block, times.data(), values.data());
+			sum += storedValue(values[i - series.header(block).first]);
+		}
+		keep(sum);
+	});
+	report("old at(), fresh arrays every call", ns, lookups);
+
+	//every lookup in another block, so each one decodes
+	ns = bestOf(5, [&] {
+		double sum = 0;
+		TimeDuration at;
+		Temperature val;
+		for (size_t k = 0; k < lookups; k++) {
+			series.at((k * 7919 * 499) % n, at, val);
+			sum += storedValue(val);
+		}
+		keep(sum);
+	});
+	report("at() scattered", ns, lookups);
+
+	std::vector<TimeDuration> foundT;
+	std::vector<Temperature> foundV;
+	ns = bestOf(5, [&] {
+		foundT.clear();
+		foundV.clear();
+		series.between(Temperature(24.9, UNITS::C), Temperature(30, UNITS::C), foundT, foundV);
+	});
+	report("between, top of the range", ns, n);
+	printf("%zu found\n", foundT.size());
+	return 0;
+}
@@ -0,0 +1,55 @@
+#include <random>
+#include <vector>
+#include "Bench.h"
+#include "Histogram.h"
+#include "Measurement.h"
+
+int main() {
+	//speeds spread over the range with a few outside it and a few NaN, the uniform target is over 1 G samples/s on one core
+	const size_t n = 1 << 24;
+	std::mt19937_64 random(11);
+	std::uniform_real_distribution<double> spread(-5, 105);
+	std::vector<Speed> speeds(n);
+	std::vector<Temperature> temps(n);
+	for (size_t i = 0; i < n; i++) {
+		speeds[i] = Speed(i % 1000 == 7 ? NAN : spread(random), UNITS::mph);
+		temps[i] = Temperature(spread(random), UNITS::F);
+	}
+
+	Histogram<Speed> uniform(0, 100, 20, UNITS::mph);
+	double ns = bestOf(5, [&] {
+		uniform.clear();
+		uniform.add(speeds.data(), n, 1);
+	});
+	report("uniform 20 bins, 1 thread", ns, n);
+	printf("%.2f G samples/s\n", n / ns);
+	ns = bestOf(5, [&] {
+		uniform.clear();
+		uniform.add(speeds.data(), n, 4);
+	});
+	report("uniform 20 bins, 4 threads", ns, n);
+
+	Histogram<Speed> fine(0, 100, 4096, UNITS::mph);
+	ns = bestOf(5, [&] {
+		fine.clear();
+		fine.add(speeds.data(), n, 1);
+	});
+	report("uniform 4096 bins, 1 thread", ns, n);
+
+	double edges[] = { 0, 1, 2, 5, 10, 20, 30, 50, 65, 80, 100 };
+	Histogram<Speed> uneven(edges, 11, UNITS::mph);
+	ns = bestOf(5, [&] {
+		uneven.clear();
+		uneven.add(speeds.data(), n, 1);
+	});
+	report("10 uneven bins, 1 thread", ns, n);
+
+	Histogram2D<Speed, Temperature> map(HistogramAxis::uniform(0, 100, 50), UNITS::mph, HistogramAxis::edges(edges, 11), UNITS::F);
+	ns = bestOf(5, [&] {
+		map.clear();
+		map.add(speeds.data(), temps.data(), n, 1);
+	});
+	report("2D 50 x 10 bins, 1 thread", ns, n);
+	keep((double)(uniform.count(3) + fine.count(100) + uneven.count(2) + map.count(1, 1)));
+	return 0;
+}
@@ -0,0 +1,52 @@
+#include <vector>
+#include "Bench.h"
+#include "Measurement.h"
+
+//built twice, with and without MEASUREMENT_INSTRUMENT, compare the two runs for the cost of the counters
+int main() {
+	const size_t n = 1000000;
+	std::vector<double> feet(n);
+	for (size_t i = 0; i < n; i++) {
+		feet[i] = i * 0.25;
+	}
+#ifdef MEASUREMENT_INSTRUMENT
+	printf("instrumented\n");
+#else
+	printf("not instrumented\n");
+#endif
+
+	double ns = bestOf(5, [&] {
+		double sum = 0;
+		for (size_t i = 0; i < n; i++) {
+			sum += Length(feet[i], UNITS::ft).value(UNITS::m);
+		}
+		keep(sum);
+	});
+	report("set in ft, value in m", ns, n);
+
+	ns = bestOf(5, [&] {
+		MEASUREMENT_SITE("benchmark");
+		double sum = 0;
+		for (size_t i = 0; i < n; i++) {
+			sum += Length(feet[i], UNITS::ft).value(UNITS::m);
+		}
+		keep(sum);
+	});
+	report("same, inside a site", ns, n);
+
+	ns = bestOf(5, [&] {
+		double sum = 0;
+		for (size_t i = 0; i < n; i++) {
+			Pressure p(feet[i], UNITS::psi);
+			sum += p.value(UNITS::psi);
+		}
+		keep(sum);
+	});
+	report("round trip in psi", ns, n);
+
+#ifdef MEASUREMENT_INSTRUMENT
+	//nothing to report at exit
+	Instrumentation::reset();
+#endif
+	return 0;
+}
@@ -0,0 +1,48 @@
+#include <tuple>
+#include "Bench.h"
+#include "Integrator.h"
+#include "Measurement.h"
+
+typedef std::tuple<Length, Speed> State;
+
+//inline all the way down, so the time is the integrator's own
+struct Spring {
+	double omega2;
+	std::tuple<Speed, Acceleration> operator()(TimeDuration, State y) {
+		return std::make_tuple(std::get<1>(y), fromSI<Acceleration>(-omega2 * storedValue(std::get<0>(y))));
+	}
+};
+
+int main() {
+	const size_t systems = 100000;
+	Spring spring = { 4 };
+	StateBatch<Length, Speed> start;
+	for (size_t i = 0; i < systems; i++) {
+		start.push_back(State(Length(1 + (i % 97) * 0.01, UNITS::m), Speed()));
+	}
+	StateBatch<Length, Speed> batch;
+	double ns = bestOf(3, [&] {
+		batch = start;
+		integrateDormandPrince(spring, batch, TimeDuration(0, UNITS::s), TimeDuration(3, UNITS::s), 1e-8, 1e-10, 1);
+	});
+	keep(batch.component(0)[systems - 1]);
+	report("DormandPrince batch, 1 thread", ns, systems);
+
+	ns = bestOf(3, [&] {
+		DormandPrince<Length, Speed> solver(1e-8, 1e-10);
+		double sum = 0;
+		for (size_t i = 0; i < systems; i++) {
+			sum += toSI(std::get<0>(solver.integrate(spring, TimeDuration(0, UNITS::s), start.get(i), TimeDuration(3, UNITS::s))));
+		}
+		keep(sum);
+	});
+	report("DormandPrince one system at a time", ns, systems);
+
+	ns = bestOf(3, [&] {
+		batch = start;
+		integrateRK4(spring, batch, TimeDuration(0, UNITS::s), TimeDuration(10, UNITS::ms), 300, 1);
+	});
+	keep(batch.component(0)[0]);
+	report("RK4 batch, 300 steps, 1 thread", ns, systems);
+	return 0;
+}
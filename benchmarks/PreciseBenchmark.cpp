@@ -0,0 +1,89 @@
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "Measurement.h"
+#include "Precise.h"
+
+//times one pass of each, repeated reps times, and prints how many times slower the double-double one is
+template <class Plain, class Precise>
+static void compare(const char* name, size_t n, int reps, Plain plain, Precise precise) {
+	double plainNs = bestOf(5, [&] {
+		for (int r = 0; r < reps; r++) {
+			plain();
+		}
+	});
+	double preciseNs = bestOf(5, [&] {
+		for (int r = 0; r < reps; r++) {
+			precise();
+		}
+	});
+	report((std::string("plain ") + name).c_str(), plainNs, double(n) * reps);
+	report((std::string("PreciseBatch ") + name).c_str(), preciseNs, double(n) * reps);
+	printf("%-40s %12.2fx\n", "", preciseNs / plainNs);
+}
+
+//each double-double kernel against the same loop on plain doubles
+static void run(size_t n, int reps) {
+	std::vector<double> in(n), out(n), hi(n), lo(n), hi2(n), lo2(n);
+	for (size_t i = 0; i < n; i++) {
+		in[i] = 1 + i * 1e-3;
+	}
+	UnitConversion inches = conversionToSI<Length>(UNITS::in);
+	UnitConversion fahrenheit = conversionToSI<Temperature>(UNITS::F);
+	UnitConversion millimetres = conversionFromSI<Length>(UNITS::mm);
+
+	compare("in -> m", n, reps, [&] {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = inches.apply(in[i]);
+		}
+		keep(out[n - 1]);
+	}, [&] {
+		PreciseBatch::fromUnits<Length>(in.data(), n, UNITS::in, hi.data(), lo.data());
+		keep(hi[n - 1]);
+	});
+	compare("F -> K", n, reps, [&] {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = fahrenheit.apply(in[i]);
+		}
+		keep(out[n - 1]);
+	}, [&] {
+		PreciseBatch::fromUnits<Temperature>(in.data(), n, UNITS::F, hi.data(), lo.data());
+		keep(hi[n - 1]);
+	});
+	PreciseBatch::fromUnits<Length>(in.data(), n, UNITS::in, hi.data(), lo.data());
+	compare("m -> mm", n, reps, [&] {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = millimetres.apply(in[i]);
+		}
+		keep(out[n - 1]);
+	}, [&] {
+		PreciseBatch::toUnits<Length>(hi.data(), lo.data(), n, UNITS::mm, out.data());
+		keep(out[n - 1]);
+	});
+	compare("add", n, reps, [&] {
+		for (size_t i = 0; i < n; i++) {
+			out[i] = in[i] + in[n - 1 - i];
+		}
+		keep(out[n - 1]);
+	}, [&] {
+		PreciseBatch::add(hi.data(), lo.data(), hi.data(), lo.data(), n, hi2.data(), lo2.data());
+		keep(hi2[n - 1]);
+	});
+	compare("sum", n, reps, [&] {
+		double total = 0;
+		for (size_t i = 0; i < n; i++) {
+			total += in[i];
+		}
+		keep(total);
+	}, [&] {
+		keep(PreciseBatch::sum(hi.data(), lo.data(), n).hi);
+	});
+}
+
+int main() {
+	printf("in cache, 4096 values\n");
+	run(4096, 1000);
+	printf("\nfrom memory, 4M values\n");
+	run(4000000, 1);
+	return 0;
+}
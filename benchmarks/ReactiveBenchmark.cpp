@@ -0,0 +1,87 @@
+#include <vector>
+#include "Bench.h"
+#include "Measurement.h"
+#include "Parallel.h"
+#include "Reactive.h"
+
+//1000 independent pipelines of an input and 99 derived nodes, levels 1000 wide
+static void pipelines(ReactiveGraph& graph, std::vector<Reactive<Length> >& inputs, std::vector<Reactive<Length> >& outputs) {
+	for (int p = 0; p < 1000; p++) {
+		Reactive<Length> node = graph.input(Length(p, UNITS::m));
+		inputs.push_back(node);
+		for (int k = 0; k < 99; k++) {
+			node = graph.derive([](Length x) { return x * 1.0001 + Length(1, UNITS::mm); }, node);
+		}
+		outputs.push_back(node);
+	}
+}
+
+//20 levels of 5000 nodes, each the sum of two nodes of the level before
+static void layers(ReactiveGraph& graph, std::vector<Reactive<Length> >& inputs, std::vector<Reactive<Length> >& outputs) {
+	const size_t width = 5000;
+	std::vector<Reactive<Length> > level;
+	for (size_t i = 0; i < width; i++) {
+		level.push_back(graph.input(Length((double)i, UNITS::m)));
+	}
+	inputs = level;
+	for (int l = 1; l < 20; l++) {
+		std::vector<Reactive<Length> > next;
+		for (size_t i = 0; i < width; i++) {
+			next.push_back(graph.derive([](Length a, Length b) { return (a + b) * 0.5; }, level[i], level[(i + 1) % width]));
+		}
+		level.swap(next);
+	}
+	outputs = level;
+}
+
+template <class Build>
+static void run(const char* name, Build build) {
+	ReactiveGraph graph;
+	std::vector<Reactive<Length> > inputs;
+	std::vector<Reactive<Length> > outputs;
+	build(graph, inputs, outputs);
+	size_t nodes = graph.nodeCount();
+	printf("%s, %zu nodes\n", name, nodes);
+	graph.refresh(1);
+	double shift = 0;
+	//every input set, then refresh() alone timed, on one thread and on four
+	unsigned threadCounts[2] = { 1, 4 };
+	for (int t = 0; t < 2; t++) {
+		double best = 0;
+		for (int r = 0; r < 5; r++) {
+			shift += 1;
+			for (size_t i = 0; i < inputs.size(); i++) {
+				graph.set(inputs[i], Length(shift + i, UNITS::m));
+			}
+			double ns = bestOf(1, [&] { graph.refresh(threadCounts[t]); });
+			best = r == 0 || ns < best ? ns : best;
+		}
+		keep(storedValue(graph.get(outputs[0])));
+		report(t == 0 ? "  refresh of every node, 1 thread" : "  refresh of every node, 4 threads", best, (double)nodes);
+	}
+	//one input changed, then its output read, as a dashboard would
+	size_t changes = 1000;
+	double ns = bestOf(5, [&] {
+		for (size_t c = 0; c < changes; c++) {
+			shift += 1;
+			size_t i = c * 7919 % inputs.size();
+			graph.set(inputs[i], Length(shift, UNITS::m));
+			keep(storedValue(graph.get(outputs[i])));
+		}
+	});
+	report("  one input set and its output read", ns, (double)changes);
+}
+
+int main() {
+	run("pipelines", pipelines);
+	run("layers", layers);
+
+	//cost of handing one short job to the pool, what a level split between threads pays on top of its work
+	double ns = bestOf(5, [&] {
+		for (int r = 0; r < 1000; r++) {
+			keep(parallelSum(64, 4, [](size_t begin, size_t end) { return (double)(end - begin); }));
+		}
+	});
+	report("pool hand-off of one level", ns, 1000);
+	return 0;
+}
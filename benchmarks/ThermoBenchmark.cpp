@@ -0,0 +1,43 @@
+#include <vector>
+#include "Bench.h"
+#include "Measurement.h"
+#include "Thermo.h"
+
+int main() {
+	const size_t n = 1000000;
+	std::vector<Pressure> p;
+	std::vector<Temperature> T;
+	std::vector<double> rh;
+	for (size_t i = 0; i < n; i++) {
+		p.push_back(Pressure(14 + (i % 100) * 0.01, UNITS::psi));
+		T.push_back(Temperature(40 + (i % 50), UNITS::F));
+		rh.push_back((i % 10) * 0.1);
+	}
+	std::vector<Density> rho(n);
+	std::vector<Temperature> dew(n);
+
+	double ns = bestOf(5, [&] {
+		Thermo::idealGasDensity(p.data(), T.data(), n, Thermo::AIR_MOLAR_MASS, rho.data());
+	});
+	keep(rho[n - 1].value(UNITS::kg_m3));
+	report("idealGasDensity", ns, n);
+
+	ns = bestOf(5, [&] {
+		Thermo::moistAirDensity(p.data(), T.data(), rh.data(), n, rho.data());
+	});
+	keep(rho[n - 1].value(UNITS::kg_m3));
+	report("moistAirDensity", ns, n);
+
+	ns = bestOf(5, [&] {
+		Thermo::dewPoint(T.data(), rh.data(), n, dew.data());
+	});
+	keep(dew[n - 1].value(UNITS::K));
+	report("dewPoint", ns, n);
+
+	ns = bestOf(3, [&] {
+		Thermo::waterDensity(p.data(), T.data(), n, rho.data());
+	});
+	keep(rho[n - 1].value(UNITS::kg_m3));
+	report("waterDensity", ns, n);
+	return 0;
+}
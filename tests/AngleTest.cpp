@@ -0,0 +1,168 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Angle.h"
+#include "Check.h"
+
+//the double nearest k pi/2 and the three either side of it
+static void nearMultiples(long first, long last, long step, std::vector<double>& x) {
+	const long double PIO2 = 1.57079632679489661923132169163975144L;
+	for (long k = first; k <= last; k += step) {
+		double center = (double)(k * PIO2);
+		double below = center;
+		double above = center;
+		x.push_back(center);
+		for (int i = 0; i < 3; i++) {
+			below = std::nextafter(below, -HUGE_VAL);
+			above = std::nextafter(above, HUGE_VAL);
+			x.push_back(below);
+			x.push_back(above);
+		}
+	}
+}
+
+int main() {
+	//units convert through radians
+	Angle heading(270, DEGREES);
+	CHECK_NEAR(heading.value(RADIANS), 3 * M_PI / 2, 1e-15);
+	CHECK_NEAR(heading.value(REVOLUTIONS), 0.75, 1e-15);
+	CHECK_NEAR(Angle(100, GRADIANS).value(DEGREES), 90, 1e-12);
+	CHECK_NEAR(Angle(60, ARCMINUTES).value(DEGREES), 1, 1e-12);
+	CHECK_NEAR(heading.wrapped().value(DEGREES), -90, 1e-12);
+	CHECK(Angle(M_PI, RADIANS).wrapped().value(RADIANS) == M_PI);
+	CHECK(Angle(-M_PI, RADIANS).wrapped().value(RADIANS) == M_PI);
+
+	//an argument whose reduction is 1e-16, where a reduction missing the tail of pi/2 had no correct digits
+	double hard = 642615.9188844458;
+	double out;
+	AngleBatch::sin(&hard, 1, &out);
+	CHECK_ULPS(out, std::sin(hard), 2);
+
+	//right next to multiples of pi/2, small k and up to the reduction limit
+	std::vector<double> x;
+	nearMultiples(1, 2000, 1, x);
+	nearMultiples(2000, 509000, 97, x);
+	nearMultiples(-2000, -1, 1, x);
+	std::vector<double> sines(x.size());
+	std::vector<double> cosines(x.size());
+	AngleBatch::sin(x.data(), x.size(), sines.data());
+	AngleBatch::cos(x.data(), x.size(), cosines.data());
+	uint64_t worstSin = 0;
+	uint64_t worstCos = 0;
+	for (size_t i = 0; i < x.size(); i++) {
+		worstSin = std::max(worstSin, ulpDistance(sines[i], std::sin(x[i])));
+		worstCos = std::max(worstCos, ulpDistance(cosines[i], std::cos(x[i])));
+	}
+	CHECK(worstSin <= 2);
+	CHECK(worstCos <= 2);
+
+	//random arguments in the reduced range and up to the limit, sincos gives what sin and cos give
+	std::mt19937_64 random(11);
+	std::uniform_real_distribution<double> small(-10, 10);
+	std::uniform_real_distribution<double> large(-8e5, 8e5);
+	size_t n = 200000;
+	x.resize(n);
+	for (size_t i = 0; i < n; i++) {
+		x[i] = i % 2 ? large(random) : small(random);
+	}
+	sines.resize(n);
+	cosines.resize(n);
+	std::vector<double> s(n);
+	std::vector<double> c(n);
+	AngleBatch::sincos(x.data(), n, s.data(), c.data());
+	AngleBatch::sin(x.data(), n, sines.data());
+	AngleBatch::cos(x.data(), n, cosines.data());
+	worstSin = 0;
+	worstCos = 0;
+	bool same = true;
+	for (size_t i = 0; i < n; i++) {
+		worstSin = std::max(worstSin, ulpDistance(s[i], std::sin(x[i])));
+		worstCos = std::max(worstCos, ulpDistance(c[i], std::cos(x[i])));
+		same = same && s[i] == sines[i] && c[i] == cosines[i];
+	}
+	CHECK(worstSin <= 2);
+	CHECK(worstCos <= 2);
+	CHECK(same);
+
+	//the fast versions stay within their absolute bounds
+	double fastWorst = 0;
+	AngleBatch::fastSincos(x.data(), n, s.data(), c.data());
+	AngleBatch::fastSin(x.data(), n, sines.data());
+	AngleBatch::fastCos(x.data(), n, cosines.data());
+	same = true;
+	for (size_t i = 0; i < n; i++) {
+		fastWorst = std::fmax(fastWorst, std::fabs(s[i] - std::sin(x[i])));
+		fastWorst = std::fmax(fastWorst, std::fabs(c[i] - std::cos(x[i])));
+		same = same && s[i] == sines[i] && c[i] == cosines[i];
+	}
+	CHECK(fastWorst < 5e-8);
+	CHECK(same);
+
+	//atan2 in every octant and on the axes
+	std::vector<double> y(n);
+	std::vector<double> angles(n);
+	std::vector<double> fast(n);
+	for (size_t i = 0; i < n; i++) {
+		y[i] = small(random);
+		x[i] = i % 50 == 0 ? 0 : small(random);
+	}
+	AngleBatch::atan2(y.data(), x.data(), n, angles.data());
+	AngleBatch::fastAtan2(y.data(), x.data(), n, fast.data());
+	uint64_t worstAtan = 0;
+	fastWorst = 0;
+	for (size_t i = 0; i < n; i++) {
+		worstAtan = std::max(worstAtan, ulpDistance(angles[i], std::atan2(y[i], x[i])));
+		fastWorst = std::fmax(fastWorst, std::fabs(fast[i] - std::atan2(y[i], x[i])));
+	}
+	CHECK(worstAtan <= 3);
+	CHECK(fastWorst < 1e-8);
+
+	//signed zeros, infinities, NaN and arguments past the limit are what the C library gives
+	double special[] = { 0.0, -0.0, INFINITY, -INFINITY, NAN, 8e5, 8.0000001e5, -1e6, 1e22, 1e300 };
+	size_t m = sizeof(special) / sizeof(special[0]);
+	double specialSin[10];
+	double specialCos[10];
+	AngleBatch::sincos(special, m, specialSin, specialCos);
+	for (size_t i = 0; i < m; i++) {
+		CHECK(std::isnan(specialSin[i]) ? std::isnan(std::sin(special[i])) : ulpDistance(specialSin[i], std::sin(special[i])) <= 2);
+		CHECK(std::isnan(specialCos[i]) ? std::isnan(std::cos(special[i])) : ulpDistance(specialCos[i], std::cos(special[i])) <= 2);
+	}
+	CHECK(std::signbit(specialSin[1]) && !std::signbit(specialSin[0]));
+	double zy[] = { 0.0, -0.0, 0.0, -0.0, INFINITY, 1, NAN };
+	double zx[] = { 0.0, 0.0, -0.0, -0.0, INFINITY, -INFINITY, 1 };
+	double za[7];
+	AngleBatch::atan2(zy, zx, 7, za);
+	for (size_t i = 0; i < 7; i++) {
+		double expected = std::atan2(zy[i], zx[i]);
+		CHECK(std::isnan(expected) ? std::isnan(za[i]) : za[i] == expected && std::signbit(za[i]) == std::signbit(expected));
+	}
+
+	//out may be in, across more than one block, including the arguments sent to the C library
+	std::vector<double> inPlace(1000);
+	std::vector<double> copy(1000);
+	for (size_t i = 0; i < inPlace.size(); i++) {
+		inPlace[i] = i % 100 == 7 ? 1e7 + i : i * 0.37 - 100;
+		copy[i] = inPlace[i];
+	}
+	AngleBatch::sin(inPlace.data(), inPlace.size(), inPlace.data());
+	same = true;
+	for (size_t i = 0; i < copy.size(); i++) {
+		same = same && ulpDistance(inPlace[i], std::sin(copy[i])) <= 2;
+	}
+	CHECK(same);
+
+	//the Angle overloads read radians
+	Angle turns[3] = { Angle(90, DEGREES), Angle(0.5, REVOLUTIONS), Angle(-45, DEGREES) };
+	double ts[3];
+	double tc[3];
+	AngleBatch::sincos(turns, 3, ts, tc);
+	CHECK_NEAR(ts[0], 1, 1e-15);
+	CHECK_NEAR(tc[1], -1, 1e-15);
+	CHECK_NEAR(ts[2], -std::sqrt(0.5), 1e-15);
+	Angle back[1];
+	double oneY[1] = { 1 };
+	double oneX[1] = { -1 };
+	AngleBatch::atan2(oneY, oneX, 1, back);
+	CHECK_NEAR(back[0].value(DEGREES), 135, 1e-12);
+	return checkResult();
+}
@@ -0,0 +1,128 @@
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Arrow.h"
+#include "Check.h"
+#include "Measurement.h"
+
+static std::string exportedUnit(ArrowSchema* schema) {
+	std::string quantity;
+	std::string unit;
+	arrowReadField(schema, quantity, unit);
+	return unit;
+}
+
+//every class exports in the unit it stores, named as in UNITS, and reads back its own export
+template <class T>
+static void checkField(const char* stored) {
+	std::vector<T> values(3, T(1.5, SIUnit<T>::stored));
+	ArrowArray array;
+	ArrowSchema schema;
+	exportArrow(values.data(), values.size(), "column", &array, &schema);
+	CHECK(exportedUnit(&schema) == stored);
+	std::vector<T> back;
+	CHECK(importArrow(&array, &schema, back));
+	CHECK(back.size() == 3 && storedValue(back[2]) == storedValue(values[2]));
+}
+
+//a float64 field with metadata written the way another Arrow library would
+static void makeField(const char* quantity, const char* unit, ArrowSchema* schema) {
+	arrowExportSchema("column", quantity, unit, schema);
+}
+
+int main() {
+	checkField<TimeDuration>("s");
+	checkField<Length>("m");
+	checkField<Area>("m2");
+	checkField<Volume>("L");
+	checkField<Speed>("m_s");
+	checkField<Acceleration>("m_s2");
+	checkField<Mass>("kg");
+	checkField<Force>("N");
+	checkField<Pressure>("Pa");
+	checkField<Energy>("J");
+	checkField<Power>("W");
+	checkField<Density>("g_cm3");
+	checkField<Temperature>("K");
+	checkField<Voltage>("V");
+	checkField<Current>("A");
+	checkField<Capacitance>("Farad");
+	checkField<Resistance>("Ohm");
+	checkField<RotationSpeed>("rpm");
+	checkField<Torque>("Nm");
+
+	//unit lookups only find units of the quantity asked for
+	CHECK(arrowUnitIndex(MSR_PRESSURE, "psi") == UNITS::psi);
+	CHECK(arrowUnitIndex(MSR_VOLUME, "barrel") == UNITS::barrel);
+	CHECK(arrowUnitIndex(MSR_LENGTH, "psi") == -1);
+	CHECK(arrowUnitIndex(MSR_LENGTH, "") == -1);
+	CHECK(arrowUnitIndex(MSR_LENGTH, "m ") == -1);
+	CHECK(std::strcmp(arrowUnitName(MSR_TORQUE, UNITS::ftlb), "ftlb") == 0);
+	CHECK(arrowUnitName(MSR_TORQUE, 3) == 0);
+
+	//export does not copy
+	std::vector<Pressure> pressures;
+	pressures.push_back(Pressure(14.7, UNITS::psi));
+	pressures.push_back(Pressure(1, UNITS::atm));
+	ArrowArray array;
+	ArrowSchema schema;
+	exportArrow(pressures.data(), pressures.size(), "pressure", &array, &schema);
+	CHECK(array.length == 2 && array.n_buffers == 2 && array.null_count == 0);
+	CHECK(array.buffers[1] == static_cast<const void*>(pressures.data()));
+	CHECK(std::strcmp(schema.format, "g") == 0 && std::strcmp(schema.name, "pressure") == 0);
+	arrowRelease(&array, &schema);
+	CHECK(!array.release && !schema.release);
+
+	//a vector handed over by rvalue lives until the array is released
+	std::vector<Length> lengths(1000, Length(2, UNITS::ft));
+	const void* buffer = lengths.data();
+	exportArrow(std::move(lengths), "length", &array, &schema);
+	CHECK(array.buffers[1] == buffer && array.length == 1000);
+	std::vector<Length> moved;
+	CHECK(importArrow(&array, &schema, moved));
+	CHECK(moved.size() == 1000);
+	CHECK_NEAR(moved[999].value(UNITS::ft), 2, 1e-12);
+
+	//import converts from any unit of the quantity, and honours offset and nulls
+	double psi[4] = { 10, 14.7, 30, 60 };
+	uint8_t valid[1] = { 0x0b };	//value 2 is null
+	ArrowArray foreign;
+	ArrowSchema foreignSchema;
+	arrowExportArray(psi, 4, 0, 0, &foreign);
+	foreign.offset = 1;
+	foreign.length = 3;
+	foreign.null_count = 1;
+	foreign.buffers[0] = valid;
+	makeField("Pressure", "psi", &foreignSchema);
+	std::vector<Pressure> imported;
+	CHECK(importArrow(&foreign, &foreignSchema, imported));
+	CHECK(!foreign.release && !foreignSchema.release);
+	CHECK(imported.size() == 3);
+	CHECK_NEAR(imported[0].value(UNITS::psi), 14.7, 1e-12);
+	CHECK(std::isnan(imported[1].value(UNITS::psi)));
+	CHECK_NEAR(imported[2].value(UNITS::psi), 60, 1e-12);
+
+	double fahrenheit[2] = { 32, 212 };
+	arrowExportArray(fahrenheit, 2, 0, 0, &foreign);
+	makeField("Temperature", "F", &foreignSchema);
+	std::vector<Temperature> temps;
+	CHECK(importArrow(&foreign, &foreignSchema, temps));
+	CHECK_NEAR(temps[0].value(UNITS::K), 273.15, 1e-12);
+	CHECK_NEAR(temps[1].value(UNITS::C), 100, 1e-12);
+
+	//wrong quantity, a unit of another quantity or an unknown one fail and still release both
+	std::vector<Length> wrong;
+	arrowExportArray(psi, 4, 0, 0, &foreign);
+	makeField("Pressure", "psi", &foreignSchema);
+	CHECK(!importArrow(&foreign, &foreignSchema, wrong));
+	CHECK(!foreign.release && !foreignSchema.release);
+	arrowExportArray(psi, 4, 0, 0, &foreign);
+	makeField("Length", "psi", &foreignSchema);
+	CHECK(!importArrow(&foreign, &foreignSchema, wrong));
+	arrowExportArray(psi, 4, 0, 0, &foreign);
+	makeField("Length", "furlong", &foreignSchema);
+	CHECK(!importArrow(&foreign, &foreignSchema, wrong));
+	CHECK(!foreign.release && !foreignSchema.release);
+	CHECK(wrong.empty());
+	return checkResult();
+}
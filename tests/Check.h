@@ -0,0 +1,80 @@
+#pragma once
+
+/*
+CHECK
+=====
+
+The few checks the tests need, with no framework behind them. A failed check
+prints the file, line and expression and the test carries on, so one run shows
+every failure. main() returns checkResult().
+
+CHECK(area.value(UNITS::m2) == 6);
+CHECK_NEAR(pressure.value(UNITS::kPa), 101.325, 1e-12);
+CHECK_ULPS(out[i], std::sin(in[i]), 2);
+return checkResult();
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+inline int& checkFailures() {
+	static int failures = 0;
+	return failures;
+}
+
+inline void checkFailed(const char* file, int line, const char* what) {
+	checkFailures()++;
+	printf("%s:%d: check failed: %s\n", file, line, what);
+}
+
+//distance between two doubles in units in the last place, same sign only
+inline uint64_t ulpDistance(double a, double b) {
+	if (a == b) {
+		return 0;
+	}
+	if (std::isnan(a) || std::isnan(b) || std::signbit(a) != std::signbit(b)) {
+		return UINT64_MAX;
+	}
+	int64_t ia;
+	int64_t ib;
+	memcpy(&ia, &a, sizeof(double));
+	memcpy(&ib, &b, sizeof(double));
+	return ia > ib ? uint64_t(ia - ib) : uint64_t(ib - ia);
+}
+
+inline int checkResult() {
+	if (checkFailures()) {
+		printf("%d checks failed\n", checkFailures());
+		return 1;
+	}
+	return 0;
+}
+
+#define CHECK(COND) \
+	do { \
+		if (!(COND)) { \
+			checkFailed(__FILE__, __LINE__, #COND); \
+		} \
+	} while (0)
+
+#define CHECK_NEAR(A, B, TOL) \
+	do { \
+		double checkA = (A); \
+		double checkB = (B); \
+		if (!(std::fabs(checkA - checkB) <= (TOL))) { \
+			checkFailed(__FILE__, __LINE__, #A " near " #B); \
+			printf("\t%.17g vs %.17g\n", checkA, checkB); \
+		} \
+	} while (0)
+
+#define CHECK_ULPS(A, B, ULPS) \
+	do { \
+		double checkA = (A); \
+		double checkB = (B); \
+		if (ulpDistance(checkA, checkB) > (uint64_t)(ULPS)) { \
+			checkFailed(__FILE__, __LINE__, #A " within " #ULPS " ulp of " #B); \
+			printf("\t%.17g vs %.17g\n", checkA, checkB); \
+		} \
+	} while (0)
@@ -0,0 +1,58 @@
+#include <cmath>
+#include "Check.h"
+#include "Circuit.h"
+
+//a ladder of series resistors from a source down to ground, big enough to go parallel
+static Circuit ladder(int rungs, unsigned threads) {
+	Circuit c;
+	c.setThreads(threads);
+	int top = c.addNode();
+	c.addVoltageSource(top, Voltage(10, UNITS::V));
+	int previous = top;
+	for (int i = 0; i < rungs; i++) {
+		int node = c.addNode();
+		c.addResistor(previous, node, Resistance(1, UNITS::Ohm));
+		c.addResistor(node, Circuit::GROUND, Resistance(1000, UNITS::Ohm));
+		previous = node;
+	}
+	return c;
+}
+
+int main() {
+	//the divider from the header
+	Circuit grid;
+	int a = grid.addNode();
+	int b = grid.addNode();
+	int source = grid.addVoltageSource(a, Voltage(12, UNITS::V));
+	int r1 = grid.addResistor(a, b, Resistance(10, UNITS::Ohm));
+	grid.addResistor(b, Circuit::GROUND, Resistance(20, UNITS::Ohm));
+	CHECK(grid.solve());
+	CHECK_NEAR(grid.voltage(b).value(UNITS::V), 8, 1e-8);
+	CHECK_NEAR(grid.current(r1).value(UNITS::A), 0.4, 1e-9);
+	CHECK_NEAR(grid.sourceCurrent(source).value(UNITS::A), 0.4, 1e-9);
+
+	//an RC charging through 1 kOhm into 1 mF, one time constant in
+	Circuit rc;
+	int in = rc.addNode();
+	int out = rc.addNode();
+	rc.addVoltageSource(in, Voltage(1, UNITS::V));
+	rc.addResistor(in, out, Resistance(1000, UNITS::Ohm));
+	rc.addCapacitor(out, Circuit::GROUND, Capacitance(1, UNITS::mF));
+	for (int i = 0; i < 1000; i++) {
+		CHECK(rc.step(TimeDuration(1e-3, UNITS::s)));
+	}
+	CHECK_NEAR(rc.voltage(out).value(UNITS::V), 1 - std::exp(-1.0), 1e-3);
+
+	//the threaded solve gives the serial answer
+	Circuit serial = ladder(30000, 1);
+	Circuit threaded = ladder(30000, 4);
+	CHECK(serial.solve());
+	CHECK(threaded.solve());
+	CHECK(serial.lastIterations() == threaded.lastIterations());
+	double worst = 0;
+	for (int node = 1; node < (int)serial.nodeCount(); node++) {
+		worst = std::fmax(worst, std::fabs(serial.voltage(node).value(UNITS::V) - threaded.voltage(node).value(UNITS::V)));
+	}
+	CHECK(worst < 1e-9);
+	return checkResult();
+}
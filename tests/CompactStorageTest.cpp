@@ -0,0 +1,78 @@
+#include <cmath>
+#include <vector>
+#include "Check.h"
+#include "CompactStorage.h"
+
+int main() {
+	//NaN and infinities keep their own codes and leave the rest of the block alone
+	std::vector<double> in(1024);
+	for (size_t i = 0; i < in.size(); i++) {
+		in[i] = 250 + i * 0.5;
+	}
+	in[3] = NAN;
+	in[10] = HUGE_VAL;
+	in[11] = -HUGE_VAL;
+	std::vector<ScaledInt16Storage::Code> codes(in.size());
+	ScaledInt16Storage::Block block;
+	ScaledInt16Storage::encode(in.data(), in.size(), codes.data(), block);
+	std::vector<double> out(in.size());
+	ScaledInt16Storage::decode(codes.data(), codes.size(), block, out.data());
+	CHECK(std::isnan(out[3]));
+	CHECK(out[10] == HUGE_VAL);
+	CHECK(out[11] == -HUGE_VAL);
+	for (size_t i = 0; i < in.size(); i++) {
+		if (std::isfinite(in[i])) {
+			CHECK_NEAR(out[i], in[i], block.scale);
+		}
+	}
+	CHECK(block.scale < 0.01);
+
+	//a block with no finite values at all
+	std::vector<double> bad(8, NAN);
+	bad[2] = HUGE_VAL;
+	ScaledInt16Storage::encode(bad.data(), bad.size(), codes.data(), block);
+	ScaledInt16Storage::decode(codes.data(), bad.size(), block, out.data());
+	CHECK(std::isnan(out[0]) && out[2] == HUGE_VAL);
+
+	//through CompactArray, with a full block and a tail
+	CompactArray<Temperature, ScaledInt16Storage> temps;
+	for (int i = 0; i < 1500; i++) {
+		temps.push_back(Temperature(20 + (i % 100) * 0.1, UNITS::C));
+	}
+	CHECK(temps.size() == 1500);
+	CHECK_NEAR(temps[57].value(UNITS::C), 25.7, 0.001);
+	CHECK_NEAR(temps[1499].value(UNITS::C), 29.9, 1e-12);
+	CHECK(temps.bytes() < 1500 * sizeof(double) / 2);
+
+	//half precision scales each block, so pressures in Pa do not overflow
+	CompactArray<Pressure, Float16Storage> pressures;
+	for (int i = 0; i < 2048; i++) {
+		pressures.push_back(Pressure(1 + i * 0.001, UNITS::atm));
+	}
+	for (int i = 0; i < 2048; i += 37) {
+		double want = Pressure(1 + i * 0.001, UNITS::atm).value(UNITS::Pa);
+		double got = pressures[i].value(UNITS::Pa);
+		CHECK(std::isfinite(got));
+		CHECK_NEAR(got / want, 1, 1.0 / 1024);
+	}
+	std::vector<double> tiny(1024, 3e-9);
+	tiny[5] = NAN;
+	std::vector<Float16Storage::Code> halves(tiny.size());
+	Float16Storage::Block halfBlock;
+	Float16Storage::encode(tiny.data(), tiny.size(), halves.data(), halfBlock);
+	Float16Storage::decode(halves.data(), halves.size(), halfBlock, out.data());
+	CHECK_NEAR(out[0] / 3e-9, 1, 1.0 / 1024);
+	CHECK(std::isnan(out[5]));
+
+	//half conversions round to nearest even and keep specials
+	CHECK(Float16Storage::toFloat(Float16Storage::fromFloat(1.0f)) == 1.0f);
+	CHECK(Float16Storage::toFloat(Float16Storage::fromFloat(65504.0f)) == 65504.0f);
+	CHECK(std::isinf(Float16Storage::toFloat(Float16Storage::fromFloat(1e6f))));
+	CHECK(Float16Storage::toFloat(Float16Storage::fromFloat(1.0f + 1.0f / 4096)) == 1.0f);
+	CHECK(Float16Storage::toFloat(Float16Storage::fromFloat(5.96046448e-8f)) == 5.96046448e-8f);
+
+	CompactArray<Length, Float32Storage> lengths;
+	lengths.push_back(Length(1.5, UNITS::m));
+	CHECK(lengths[0].value(UNITS::m) == 1.5);
+	return checkResult();
+}
@@ -0,0 +1,137 @@
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "Check.h"
+#include "CompressedSeries.h"
+#include "Measurement.h"
+
+static bool sameBits(double a, double b) {
+	return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+int main() {
+	//regular ticks, jitter, big gaps, times off the tick grid and going backwards, and NaN values
+	const size_t n = 50000;
+	std::vector<TimeDuration> t(n);
+	std::vector<Pressure> v(n);
+	for (size_t i = 0; i < n; i++) {
+		double ms = (double)(i * 10);
+		ms += i % 13 == 0 ? 3 : 0;
+		ms += i > 30000 ? 1e7 : 0;
+		ms += i % 1001 == 0 ? 0.37 : 0;
+		ms -= i == 40000 ? 25 : 0;
+		t[i] = TimeDuration(ms, UNITS::ms);
+		v[i] = Pressure(i % 997 == 0 ? NAN : 101 + std::round(std::sin(i * 0.01) * 100) * 0.01, UNITS::kPa);
+	}
+	CompressedSeries<Pressure> series(TimeDuration(1, UNITS::ms), 1024);
+	for (size_t i = 0; i < n; i++) {
+		series.push_back(t[i], v[i]);
+	}
+	CHECK(series.size() == n);
+	CHECK(series.blocks() > 10);
+	CHECK(series.ratio() > 4);
+
+	//blocks decode to the very same bits, and their headers hold the first index and the extremes
+	std::vector<TimeDuration> outT(CompressedSeries<Pressure>::MAX_BLOCK_SAMPLES);
+	std::vector<Pressure> outV(CompressedSeries<Pressure>::MAX_BLOCK_SAMPLES);
+	size_t first = 0;
+	bool exact = true;
+	bool headers = true;
+	for (size_t b = 0; b < series.blocks(); b++) {
+		XorSeries::Header& h = series.header(b);
+		size_t count = series.decode(b, outT.data(), outV.data());
+		headers = headers && h.first == first && count == h.count;
+		double low = INFINITY;
+		double high = -INFINITY;
+		for (size_t i = 0; i < count; i++) {
+			exact = exact && sameBits(storedValue(outT[i]), storedValue(t[first + i])) && sameBits(storedValue(outV[i]), storedValue(v[first + i]));
+			double val = storedValue(v[first + i]);
+			if (val == val) {
+				low = std::fmin(low, val);
+				high = std::fmax(high, val);
+			}
+			headers = headers && h.minTime <= storedValue(t[first + i]) && storedValue(t[first + i]) <= h.maxTime;
+		}
+		headers = headers && h.minValue == low && h.maxValue == high;
+		first += count;
+	}
+	CHECK(exact);
+	CHECK(headers);
+	CHECK(first == n);
+
+	//at() in order, backwards and scattered
+	bool inOrder = true;
+	TimeDuration at;
+	Pressure val;
+	for (size_t i = 0; i < n; i++) {
+		series.at(i, at, val);
+		inOrder = inOrder && sameBits(storedValue(at), storedValue(t[i])) && sameBits(storedValue(val), storedValue(v[i]));
+	}
+	CHECK(inOrder);
+	bool scattered = true;
+	for (size_t k = 0; k < 5000; k++) {
+		size_t i = k % 2 ? n - 1 - k : (k * 7919) % n;
+		series.at(i, at, val);
+		scattered = scattered && sameBits(storedValue(at), storedValue(t[i])) && sameBits(storedValue(val), storedValue(v[i]));
+	}
+	CHECK(scattered);
+
+	//reading the open block while it fills sees every new sample
+	CompressedSeries<Temperature> growing;
+	bool fresh = true;
+	for (size_t i = 0; i < 3000; i++) {
+		growing.push_back(TimeDuration((double)i, UNITS::s), Temperature(20 + (i % 5), UNITS::C));
+		TimeDuration lastT;
+		Temperature lastV;
+		growing.at(i, lastT, lastV);
+		fresh = fresh && lastT.value(UNITS::s) == i && storedValue(lastV) == storedValue(Temperature(20 + (i % 5), UNITS::C));
+		growing.at(i / 2, lastT, lastV);
+		fresh = fresh && lastT.value(UNITS::s) == i / 2;
+	}
+	CHECK(fresh);
+	CHECK(growing.blocks() > 1);
+
+	//between and during find exactly the samples a plain scan finds, in order
+	std::vector<TimeDuration> foundT;
+	std::vector<Pressure> foundV;
+	series.between(Pressure(101.9, UNITS::kPa), Pressure(102, UNITS::kPa), foundT, foundV);
+	std::vector<size_t> expected;
+	for (size_t i = 0; i < n; i++) {
+		double p = storedValue(v[i]);
+		if (p >= storedValue(Pressure(101.9, UNITS::kPa)) && p <= storedValue(Pressure(102, UNITS::kPa))) {
+			expected.push_back(i);
+		}
+	}
+	CHECK(!expected.empty());
+	CHECK(foundT.size() == expected.size());
+	for (size_t k = 0; k < expected.size() && k < foundT.size(); k++) {
+		CHECK(sameBits(storedValue(foundT[k]), storedValue(t[expected[k]])));
+	}
+	foundT.clear();
+	foundV.clear();
+	series.during(TimeDuration(100, UNITS::s), TimeDuration(200, UNITS::s), foundT, foundV);
+	size_t inWindow = 0;
+	for (size_t i = 0; i < n; i++) {
+		inWindow += storedValue(t[i]) >= 100 && storedValue(t[i]) <= 200;
+	}
+	CHECK(foundT.size() == inWindow && inWindow > 0);
+	//a NaN-only range finds nothing
+	foundT.clear();
+	series.between(Pressure(500, UNITS::kPa), Pressure(600, UNITS::kPa), foundT, foundV);
+	CHECK(foundT.empty());
+
+	//a regular series costs about two bits a sample
+	CompressedSeries<Voltage> flat;
+	for (size_t i = 0; i < 100000; i++) {
+		flat.push_back(TimeDuration((double)i, UNITS::ms), Voltage(5, UNITS::V));
+	}
+	CHECK(flat.ratio() > 40);
+	flat.clear();
+	CHECK(flat.size() == 0 && flat.blocks() == 0 && flat.bytes() == 0);
+	flat.push_back(TimeDuration(1, UNITS::s), Voltage(3, UNITS::V));
+	TimeDuration oneT;
+	Voltage oneV;
+	flat.at(0, oneT, oneV);
+	CHECK(oneV.value(UNITS::V) == 3);
+	return checkResult();
+}
@@ -0,0 +1,114 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "Check.h"
+#include "CsvLoader.h"
+#include "Measurement.h"
+
+static bool parse(CsvTable& table, const std::string& text, unsigned threads = 0) {
+	return table.parse(text.data(), text.size(), threads);
+}
+
+int main() {
+	//byte order mark, CRLF, blank lines and a plain column
+	CsvTable table;
+	CHECK(parse(table, "\xEF\xBB\xBFpressure[psi], temp [ F ],flow[gallon],count\r\n14.7,68,1200,3\r\n\r\n+30,-40,0.5,4\r\n"));
+	CHECK(table.rows() == 2);
+	CHECK(table.columns() == 4);
+	CHECK(table.find("temp") == 1);
+	CHECK(table.find("count") == 3);
+	CHECK(table.find("missing") == -1);
+	CHECK(table.name(1) == "temp");
+	CHECK(table.unit(0) == MSR_psi);
+	CHECK(table.unit(1) == MSR_F);
+	CHECK(table.unit(3) == MSR_INVALID_UNIT);
+	const Pressure* pressure = table.column<Pressure>("pressure");
+	const Temperature* temp = table.column<Temperature>("temp");
+	const Volume* flow = table.column<Volume>("flow");
+	CHECK(pressure && temp && flow);
+	CHECK_NEAR(Pressure(pressure[0]).value(UNITS::psi), 14.7, 1e-12);
+	CHECK_NEAR(Pressure(pressure[1]).value(UNITS::psi), 30, 1e-12);
+	CHECK_NEAR(Temperature(temp[0]).value(UNITS::F), 68, 1e-12);
+	CHECK_NEAR(Temperature(temp[1]).value(UNITS::C), -40, 1e-12);
+	CHECK_NEAR(Volume(flow[0]).value(UNITS::gallon), 1200, 1e-9);
+	CHECK(table.values(3)[0] == 3 && table.values(3)[1] == 4);
+	//the column is the class's stored double, with no copy
+	CHECK(static_cast<const void*>(pressure) == static_cast<const void*>(table.values(0)));
+	CHECK_NEAR(table.values(0)[0], Pressure(14.7, UNITS::psi).value(UNITS::Pa), 1e-9);
+	CHECK_NEAR(table.values(2)[0], 1200 * 3.785411784, 1e-9);
+	//wrong quantity, or not a measurement column
+	CHECK(table.column<Length>("pressure") == 0);
+	CHECK(table.column<Pressure>("count") == 0);
+	CHECK(table.column<Pressure>("missing") == 0);
+
+	//the header from the top of CsvLoader.h, and other spellings that are not UNITS names
+	CHECK(parse(table, "pressure[psi],temp[F],flow[gal]\n14.7,68,1200\n"));
+	CHECK(table.unit(2) == MSR_gallon);
+	CHECK(table.column<Volume>("flow") && Volume(table.column<Volume>("flow")[0]).value(UNITS::gallon) == 1200);
+	CHECK(parse(table, "t[sec],v[km/h],m[lbs],T[degC],q[l],r[ohm]\n1,2,3,4,5,6\n"));
+	CHECK(table.unit(0) == MSR_s && table.unit(1) == MSR_kph && table.unit(2) == MSR_lb);
+	CHECK(table.unit(3) == MSR_C && table.unit(4) == MSR_L && table.unit(5) == MSR_Ohm);
+	CHECK_NEAR(Speed(table.column<Speed>("v")[0]).value(UNITS::kph), 2, 1e-12);
+
+	//empty, unparsable and missing cells are NaN
+	CHECK(parse(table, "a[m],b[m],c\n1,,x\n2\n\n3,4,5"));
+	CHECK(table.rows() == 3);
+	CHECK(table.values(0)[0] == 1 && table.values(0)[1] == 2 && table.values(0)[2] == 3);
+	CHECK(std::isnan(table.values(1)[0]) && std::isnan(table.values(1)[1]) && table.values(1)[2] == 4);
+	CHECK(std::isnan(table.values(2)[0]) && std::isnan(table.values(2)[1]) && table.values(2)[2] == 5);
+
+	//header only
+	CHECK(parse(table, "\n\nspeed[mph]\n"));
+	CHECK(table.rows() == 0 && table.columns() == 1);
+
+	//errors say why
+	CHECK(!parse(table, ""));
+	CHECK(table.error() == "no header line");
+	CHECK(!parse(table, " \r\n\n"));
+	CHECK(!parse(table, "x[furlong],y\n1,2\n"));
+	CHECK(table.error().find("furlong") != std::string::npos);
+	CHECK(table.columns() <= 1);
+	CHECK(!table.load("/nonexistent/file.csv"));
+	CHECK(table.error().find("cannot open") == 0);
+
+	//enough rows for several chunks and conversion blocks, the same on one thread and four
+	std::string big = "t[ms],d[ft],note\n";
+	size_t rows = 70000;
+	char line[64];
+	for (size_t i = 0; i < rows; i++) {
+		snprintf(line, sizeof(line), "%zu,%.3f,%zu\n", i, i * 0.125, i % 7);
+		big += line;
+	}
+	CHECK(big.size() > (1 << 20));
+	CsvTable serial;
+	CsvTable threaded;
+	CHECK(parse(serial, big, 1));
+	CHECK(parse(threaded, big, 4));
+	CHECK(serial.rows() == rows && threaded.rows() == rows);
+	const TimeDuration* t = threaded.column<TimeDuration>("t");
+	const Length* d = threaded.column<Length>("d");
+	bool same = true;
+	bool right = true;
+	for (size_t i = 0; i < rows; i++) {
+		same = same && serial.values(0)[i] == threaded.values(0)[i] && serial.values(1)[i] == threaded.values(1)[i];
+		right = right && std::fabs(TimeDuration(t[i]).value(UNITS::ms) - i) < 1e-9 && std::fabs(Length(d[i]).value(UNITS::ft) - i * 0.125) < 1e-9 &&
+			threaded.values(2)[i] == i % 7;
+	}
+	CHECK(same);
+	CHECK(right);
+
+	//load() reads the same as parse()
+	const char* path = "CsvLoaderTest.csv";
+	FILE* file = fopen(path, "wb");
+	CHECK(file != 0);
+	if (file) {
+		fwrite(big.data(), 1, big.size(), file);
+		fclose(file);
+		CsvTable loaded;
+		CHECK(loaded.load(path, 4));
+		CHECK(loaded.rows() == rows);
+		CHECK(std::memcmp(loaded.values(1), serial.values(1), rows * sizeof(double)) == 0);
+		remove(path);
+	}
+	return checkResult();
+}
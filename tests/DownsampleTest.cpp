@@ -0,0 +1,176 @@
+#include <cmath>
+#include <vector>
+#include "Check.h"
+#include "Downsample.h"
+#include "Measurement.h"
+
+using namespace Downsample;
+
+static bool increasing(const std::vector<TimeDuration>& times, size_t count) {
+	for (size_t i = 1; i < count; i++) {
+		if (!(storedValue(times[i - 1]) < storedValue(times[i]))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool contains(const std::vector<Voltage>& values, size_t count, double volts) {
+	for (size_t i = 0; i < count; i++) {
+		if (Voltage(values[i]).value(UNITS::V) == volts) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int main() {
+	//a slow sine with one spike up and one down
+	size_t n = 10000;
+	std::vector<TimeDuration> t(n);
+	std::vector<Voltage> v(n);
+	for (size_t i = 0; i < n; i++) {
+		t[i] = TimeDuration((double)i, UNITS::ms);
+		v[i] = Voltage(std::sin(i * 0.001), UNITS::V);
+	}
+	v[4321] = Voltage(50, UNITS::V);
+	v[7777] = Voltage(-50, UNITS::V);
+
+	//lttb keeps exactly the points asked for, the ends, and the spikes
+	std::vector<TimeDuration> outT(n);
+	std::vector<Voltage> outV(n);
+	size_t kept = lttb(t.data(), v.data(), n, 200, outT.data(), outV.data());
+	CHECK(kept == 200);
+	CHECK(storedValue(outT[0]) == storedValue(t[0]));
+	CHECK(storedValue(outT[199]) == storedValue(t[n - 1]));
+	CHECK(increasing(outT, kept));
+	CHECK(contains(outV, kept, 50));
+	CHECK(contains(outV, kept, -50));
+	//every point is one of the inputs, with its own time
+	bool paired = true;
+	for (size_t i = 0; i < kept; i++) {
+		size_t index = (size_t)std::llround(outT[i].value(UNITS::ms));
+		paired = paired && storedValue(outV[i]) == storedValue(v[index]);
+	}
+	CHECK(paired);
+
+	//too few points asked for to form triangles, or more than there are
+	CHECK(lttb(t.data(), v.data(), n, 2, outT.data(), outV.data()) == 2);
+	CHECK(storedValue(outT[0]) == storedValue(t[0]) && storedValue(outT[1]) == storedValue(t[n - 1]));
+	CHECK(lttb(t.data(), v.data(), 5, 100, outT.data(), outV.data()) == 5);
+	CHECK(storedValue(outT[4]) == storedValue(t[4]));
+	CHECK(lttb(t.data(), v.data(), n, 0, outT.data(), outV.data()) == 0);
+	CHECK(lttb(t.data(), v.data(), 0, 10, outT.data(), outV.data()) == 0);
+
+	//minMax keeps the extremes of each bucket in time order, NaN is a gap
+	v[100] = Voltage(NAN, UNITS::V);
+	kept = minMax(t.data(), v.data(), n, 50, outT.data(), outV.data());
+	CHECK(kept <= 100 && kept >= 50);
+	CHECK(increasing(outT, kept));
+	CHECK(contains(outV, kept, 50));
+	CHECK(contains(outV, kept, -50));
+	bool noNaN = true;
+	for (size_t i = 0; i < kept; i++) {
+		noNaN = noNaN && !std::isnan(storedValue(outV[i]));
+	}
+	CHECK(noNaN);
+	//each bucket of 200 ms gives its own min and max
+	size_t indexes[100];
+	std::vector<double> x(n);
+	std::vector<double> y(n);
+	for (size_t i = 0; i < n; i++) {
+		x[i] = storedValue(t[i]);
+		y[i] = storedValue(v[i]);
+	}
+	size_t count = minMaxIndices(x.data(), y.data(), n, 50, indexes);
+	CHECK(count == kept);
+	size_t first = 0;
+	for (size_t b = 0; b < 50 && first < count; b++) {
+		double low = INFINITY;
+		double high = -INFINITY;
+		size_t end = b == 49 ? n : (size_t)std::ceil((b + 1) * (n - 1) / 50.0);
+		for (size_t i = b == 0 ? 0 : (size_t)std::ceil(b * (n - 1) / 50.0); i < end; i++) {
+			if (!std::isnan(y[i])) {
+				low = std::fmin(low, y[i]);
+				high = std::fmax(high, y[i]);
+			}
+		}
+		CHECK(y[indexes[first]] == std::fmin(y[indexes[first]], y[indexes[first + 1]]) ? y[indexes[first]] == low : y[indexes[first]] == high);
+		CHECK(std::fmin(y[indexes[first]], y[indexes[first + 1]]) == low && std::fmax(y[indexes[first]], y[indexes[first + 1]]) == high);
+		first += 2;
+	}
+	CHECK(minMaxIndices(x.data(), y.data(), 0, 10, indexes) == 0);
+	CHECK(minMaxIndices(x.data(), y.data(), 1, 10, indexes) == 1 && indexes[0] == 0);
+	//all at one time is one bucket
+	double sameTime[3] = { 5, 5, 5 };
+	double values[3] = { 2, 9, 1 };
+	CHECK(minMaxIndices(sameTime, values, 3, 4, indexes) == 2 && indexes[0] == 1 && indexes[1] == 2);
+
+	//many series at once give what one at a time gives
+	SeriesView<Voltage> views[3] = { { t.data(), v.data(), n }, { t.data(), v.data(), n / 2 }, { t.data() + 10, v.data() + 10, 100 } };
+	SeriesPoints<Voltage> lttbOut[3];
+	SeriesPoints<Voltage> minMaxOut[3];
+	Downsample::lttb(views, 3, 64, lttbOut, 4);
+	Downsample::minMax(views, 3, 20, minMaxOut, 4);
+	for (int s = 0; s < 3; s++) {
+		kept = lttb(views[s].times, views[s].values, views[s].n, 64, outT.data(), outV.data());
+		CHECK(lttbOut[s].times.size() == kept);
+		for (size_t i = 0; i < kept; i++) {
+			CHECK(storedValue(lttbOut[s].values[i]) == storedValue(outV[i]));
+		}
+		kept = minMax(views[s].times, views[s].values, views[s].n, 20, outT.data(), outV.data());
+		CHECK(minMaxOut[s].times.size() == kept);
+		for (size_t i = 0; i < kept; i++) {
+			CHECK(storedValue(minMaxOut[s].times[i]) == storedValue(outT[i]));
+		}
+	}
+
+	//the min-max stream emits each closed 100 ms bucket, low and high in time order
+	MinMaxStream<Voltage> minMaxStream(TimeDuration(0, UNITS::s), TimeDuration(100, UNITS::ms));
+	for (size_t i = 0; i < 1000; i++) {
+		minMaxStream.push(t[i], v[i]);
+	}
+	CHECK(minMaxStream.times().size() == 18);
+	minMaxStream.flush();
+	CHECK(minMaxStream.times().size() == 20);
+	CHECK(increasing(minMaxStream.times(), minMaxStream.times().size()));
+	for (size_t b = 0; b < 10; b++) {
+		double low = INFINITY;
+		double high = -INFINITY;
+		for (size_t i = b * 100; i < b * 100 + 100; i++) {
+			if (!std::isnan(y[i])) {
+				low = std::fmin(low, y[i]);
+				high = std::fmax(high, y[i]);
+			}
+		}
+		double a = storedValue(minMaxStream.values()[2 * b]);
+		double c = storedValue(minMaxStream.values()[2 * b + 1]);
+		CHECK(std::fmin(a, c) == low && std::fmax(a, c) == high);
+	}
+	minMaxStream.clear();
+	CHECK(minMaxStream.times().empty());
+	//a bucket of one point emits it once
+	minMaxStream.push(TimeDuration(5, UNITS::s), Voltage(3, UNITS::V));
+	minMaxStream.flush();
+	CHECK(minMaxStream.values().size() == 1);
+
+	//the lttb stream keeps the first and last points and one per bucket between, spikes included
+	LttbStream<Voltage> lttbStream(TimeDuration(0, UNITS::s), TimeDuration(100, UNITS::ms));
+	for (size_t i = 0; i < n; i++) {
+		lttbStream.push(t[i], v[i]);
+	}
+	lttbStream.flush();
+	std::vector<TimeDuration>& streamT = lttbStream.times();
+	std::vector<Voltage>& streamV = lttbStream.values();
+	CHECK(streamT.size() == 101);
+	CHECK(storedValue(streamT.front()) == storedValue(t[0]));
+	CHECK(storedValue(streamT.back()) == storedValue(t[n - 1]));
+	CHECK(increasing(streamT, streamT.size()));
+	CHECK(contains(streamV, streamV.size(), 50));
+	CHECK(contains(streamV, streamV.size(), -50));
+	//after a flush the next push starts a new series
+	lttbStream.clear();
+	lttbStream.push(TimeDuration(20, UNITS::s), Voltage(1, UNITS::V));
+	CHECK(lttbStream.values().size() == 1);
+	return checkResult();
+}
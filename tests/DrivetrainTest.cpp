@@ -0,0 +1,115 @@
+#include <cmath>
+#include <vector>
+#include "Check.h"
+#include "Drivetrain.h"
+#include "Measurement.h"
+
+int main() {
+	//torque times speed is rad/s times Nm either way round, negative when braking
+	Power forward = Torque(100, UNITS::Nm) * RotationSpeed(3000, UNITS::rpm);
+	Power backward = RotationSpeed(3000, UNITS::rpm) * Torque(100, UNITS::Nm);
+	CHECK_NEAR(forward.value(UNITS::W), 100 * 3000 * 2 * M_PI / 60, 1e-9);
+	CHECK(storedValue(forward) == storedValue(backward));
+	CHECK(Power(Torque(-100, UNITS::Nm) * RotationSpeed(3000, UNITS::rpm)).value(UNITS::W) < 0);
+	CHECK_NEAR(Power(RotationSpeed(10, UNITS::rad_s) * Torque(1, UNITS::ftlb)).value(UNITS::W), 13.558179483314004, 1e-9);
+
+	//the batch gives what the operator gives
+	Torque torque[3] = { Torque(50, UNITS::Nm), Torque(-20, UNITS::Nm), Torque(10, UNITS::ftlb) };
+	RotationSpeed speed[3] = { RotationSpeed(1000, UNITS::rpm), RotationSpeed(4000, UNITS::rpm), RotationSpeed(-60, UNITS::rad_s) };
+	Power power[3];
+	Drivetrain::shaftPower(torque, speed, 3, power);
+	for (int i = 0; i < 3; i++) {
+		CHECK_NEAR(power[i].value(UNITS::W), Power(torque[i] * speed[i]).value(UNITS::W), 1e-9);
+	}
+
+	//16 bit counters on two axes, one counting up through the wrap, one down
+	const size_t frames = 6;
+	uint32_t raw[frames * 2];
+	for (size_t f = 0; f < frames; f++) {
+		raw[f * 2] = (uint32_t)((65530 + f * 3) & 0xffff);
+		raw[f * 2 + 1] = (uint32_t)((5 - (int)f * 4) & 0xffff);
+	}
+	int64_t counts[frames * 2];
+	CHECK(Drivetrain::unwrapCounts(raw, frames, 2, 16, counts));
+	bool unwrapped = true;
+	for (size_t f = 0; f < frames; f++) {
+		unwrapped = unwrapped && counts[f * 2] == 65530 + (int64_t)f * 3 && counts[f * 2 + 1] == 5 - (int64_t)f * 4;
+	}
+	CHECK(unwrapped);
+	//a second batch carries on from the last frame of the first
+	int64_t more[2];
+	uint32_t next[2] = { (65530 + 18) & 0xffff, (uint32_t)((5 - 24) & 0xffff) };
+	CHECK(Drivetrain::unwrapCounts(next, 1, 2, 16, more, counts + (frames - 1) * 2));
+	CHECK(more[0] == 65548 && more[1] == -19);
+	//32 bit counters, and widths with no defined shift are refused without writing
+	uint32_t wide[2] = { 0xfffffffeu, 3 };
+	int64_t wideCounts[2];
+	CHECK(Drivetrain::unwrapCounts(wide, 2, 1, 32, wideCounts));
+	CHECK(wideCounts[1] - wideCounts[0] == 5);
+	int64_t untouched[2] = { 7, 7 };
+	CHECK(!Drivetrain::unwrapCounts(wide, 2, 1, 0, untouched));
+	CHECK(!Drivetrain::unwrapCounts(wide, 2, 1, 33, untouched));
+	CHECK(untouched[0] == 7 && untouched[1] == 7);
+	CHECK(Drivetrain::unwrapCounts(wide, 0, 1, 16, untouched));
+	CHECK(Drivetrain::unwrapCounts(wide, 2, 1, 1, untouched));
+
+	//counts to angles and backward difference speeds
+	int64_t encoder[4] = { 0, 1024, 1024, 0 };
+	Angle angles[4];
+	Drivetrain::encoderAngles(encoder, 4, 4096, angles);
+	CHECK_NEAR(angles[1].value(DEGREES), 90, 1e-12);
+	RotationSpeed speeds[4];
+	Drivetrain::encoderSpeeds(angles, 2, 2, TimeDuration(1, UNITS::s), speeds);
+	CHECK(speeds[0].value(UNITS::rpm) == 0 && speeds[1].value(UNITS::rpm) == 0);
+	CHECK_NEAR(speeds[2].value(UNITS::rev_s), 0.25, 1e-12);
+	CHECK_NEAR(speeds[3].value(UNITS::rev_s), -0.25, 1e-12);
+	Angle last[2] = { Angle(-90, DEGREES), Angle(0, DEGREES) };
+	Drivetrain::encoderSpeeds(angles, 2, 2, TimeDuration(500, UNITS::ms), speeds, last);
+	CHECK_NEAR(speeds[0].value(UNITS::rev_s), 0.5, 1e-12);
+	CHECK_NEAR(speeds[1].value(UNITS::rev_s), 0.5, 1e-12);
+
+	//a 3 x 3 map over 0 to 6000 rpm and 0 to 200 Nm, zero at standstill
+	double table[9] = {
+		0, 0, 0,
+		0.8, 0.9, 0.85,
+		0.7, 0.95, 0.9
+	};
+	EfficiencyMap map(RotationSpeed(6000, UNITS::rpm), 3, Torque(200, UNITS::Nm), 3, table);
+	CHECK(map.efficiency(RotationSpeed(3000, UNITS::rpm), Torque(100, UNITS::Nm)) == 0.9);
+	CHECK_NEAR(map.efficiency(RotationSpeed(4500, UNITS::rpm), Torque(150, UNITS::Nm)), (0.9 + 0.85 + 0.95 + 0.9) / 4, 1e-12);
+	CHECK_NEAR(map.efficiency(RotationSpeed(1500, UNITS::rpm), Torque(100, UNITS::Nm)), 0.45, 1e-12);
+	//mirrored into the other quadrants and clamped past the edges
+	CHECK(map.efficiency(RotationSpeed(-3000, UNITS::rpm), Torque(-100, UNITS::Nm)) == 0.9);
+	CHECK(map.efficiency(RotationSpeed(9000, UNITS::rpm), Torque(500, UNITS::Nm)) == 0.9);
+
+	//motoring draws shaft / efficiency, generating returns shaft * efficiency, zero efficiency stays finite
+	RotationSpeed s[4] = { RotationSpeed(3000, UNITS::rpm), RotationSpeed(3000, UNITS::rpm), RotationSpeed(0, UNITS::rpm), RotationSpeed(1e-3, UNITS::rpm) };
+	Torque t[4] = { Torque(100, UNITS::Nm), Torque(-100, UNITS::Nm), Torque(100, UNITS::Nm), Torque(100, UNITS::Nm) };
+	Power electrical[4];
+	map.electricalPower(s, t, 4, electrical);
+	double shaft = Power(s[0] * t[0]).value(UNITS::W);
+	CHECK_NEAR(electrical[0].value(UNITS::W), shaft / 0.9, 1e-9);
+	CHECK_NEAR(electrical[1].value(UNITS::W), -shaft * 0.9, 1e-9);
+	CHECK(electrical[2].value(UNITS::W) == 0);
+	CHECK(std::isfinite(electrical[3].value(UNITS::W)));
+	CHECK(electrical[3].value(UNITS::W) <= Power(s[3] * t[3]).value(UNITS::W) / EfficiencyMap::MIN_EFFICIENCY);
+
+	CHECK(map.ok());
+	//zero speeds or torques are rejected instead of read past the table
+	EfficiencyMap empty(RotationSpeed(6000, UNITS::rpm), 0, Torque(200, UNITS::Nm), 3, table);
+	CHECK(!empty.ok());
+	CHECK(std::isnan(empty.efficiency(RotationSpeed(3000, UNITS::rpm), Torque(100, UNITS::Nm))));
+	Power none;
+	empty.electricalPower(s, t, 1, &none);
+	CHECK(std::isnan(none.value(UNITS::W)));
+	CHECK(!EfficiencyMap(RotationSpeed(6000, UNITS::rpm), 3, Torque(200, UNITS::Nm), 0, table).ok());
+	CHECK(!EfficiencyMap(RotationSpeed(6000, UNITS::rpm), 3, Torque(200, UNITS::Nm), 3, nullptr).ok());
+
+	//more values than one lookup block
+	std::vector<RotationSpeed> manyS(1000, RotationSpeed(4500, UNITS::rpm));
+	std::vector<Torque> manyT(1000, Torque(150, UNITS::Nm));
+	std::vector<Power> manyP(1000);
+	map.electricalPower(manyS.data(), manyT.data(), 1000, manyP.data());
+	CHECK_NEAR(manyP[999].value(UNITS::W), Power(manyS[0] * manyT[0]).value(UNITS::W) / 0.9, 1e-6);
+	return checkResult();
+}
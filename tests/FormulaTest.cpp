@@ -0,0 +1,111 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "Formula.h"
+#include "Measurement.h"
+
+int main() {
+	//the example from Formula.h, over enough rows for several blocks
+	Formulas formulas;
+	CHECK(formulas.input<Voltage>("voltage"));
+	CHECK(formulas.input<Current>("current"));
+	CHECK(formulas.input<Force>("force"));
+	CHECK(formulas.input<Area>("area"));
+	CHECK(!formulas.input<Length>("voltage"));
+	CHECK(formulas.compile("power = voltage * current\n"
+		"pressure = force / area + 1 atm\n"
+		"headroom = 1.5 kW - power"));
+	size_t rows = 1000;
+	std::vector<Voltage> volts(rows);
+	std::vector<Current> amps(rows);
+	std::vector<Force> force(rows);
+	std::vector<Area> area(rows);
+	for (size_t i = 0; i < rows; i++) {
+		volts[i] = Voltage(100 + i, UNITS::V);
+		amps[i] = Current((double)i, UNITS::mA);
+		force[i] = Force((double)i, UNITS::lbf);
+		area[i] = Area(1 + i % 10, UNITS::in2);
+	}
+	std::vector<Power> power(rows);
+	std::vector<Pressure> pressure(rows);
+	std::vector<Power> headroom(rows);
+	CHECK(formulas.bind("voltage", volts.data()));
+	CHECK(formulas.bind("current", amps.data()));
+	CHECK(formulas.bind("force", force.data()));
+	CHECK(formulas.bind("area", area.data()));
+	CHECK(formulas.bind("power", power.data()));
+	CHECK(formulas.bind("pressure", pressure.data()));
+	CHECK(formulas.bind("headroom", headroom.data()));
+	//binding an array of another quantity is refused
+	CHECK(!formulas.bind("pressure", headroom.data()));
+	CHECK(std::string(formulas.error()).find("Pressure") != std::string::npos);
+	CHECK(formulas.run(rows, 1));
+	bool right = true;
+	for (size_t i = 0; i < rows; i++) {
+		Power p = volts[i] * amps[i];
+		right = right && std::fabs(power[i].value(UNITS::W) - p.value(UNITS::W)) < 1e-9;
+		right = right && std::fabs(headroom[i].value(UNITS::W) - (1500 - p.value(UNITS::W))) < 1e-9;
+		double psi = force[i].value(UNITS::lbf) / area[i].value(UNITS::in2);
+		right = right && std::fabs(pressure[i].value(UNITS::psi) - (psi + 14.695948775513449)) < 1e-9;
+	}
+	CHECK(right);
+	//the same on four threads
+	std::vector<Power> threaded(rows);
+	CHECK(formulas.bind("power", threaded.data()));
+	CHECK(formulas.run(rows, 4));
+	CHECK(storedValue(threaded[rows - 1]) == storedValue(power[rows - 1]));
+
+	//quantities the classes keep in other units than SI, and plain numbers
+	Formulas stored;
+	CHECK(stored.input<Volume>("tank"));
+	CHECK(stored.input<TimeDuration>("time"));
+	CHECK(stored.input<double>("share"));
+	CHECK(stored.compile("half = tank * share; spin = 60 rpm * 2"));
+	msr_quantity q;
+	CHECK(stored.quantity("spin", q) && q == MSR_ROTATION_SPEED);
+	CHECK(stored.quantity("half", q) && q == MSR_VOLUME);
+	CHECK(!stored.quantity("nothing", q));
+	Volume tank[2] = { Volume(10, UNITS::L), Volume(1, UNITS::m3) };
+	TimeDuration time[2] = { TimeDuration(1, UNITS::s), TimeDuration(1, UNITS::min) };
+	double share[2] = { 0.5, 0.25 };
+	Volume half[2];
+	RotationSpeed spin[2];
+	CHECK(stored.bind("tank", tank));
+	CHECK(stored.bind("time", time));
+	CHECK(stored.bind("share", share));
+	CHECK(stored.bind("half", half));
+	CHECK(stored.bind("spin", spin));
+	CHECK(stored.run(2));
+	CHECK_NEAR(half[0].value(UNITS::L), 5, 1e-12);
+	CHECK_NEAR(half[1].value(UNITS::L), 250, 1e-9);
+	CHECK_NEAR(spin[1].value(UNITS::rpm), 120, 1e-9);
+
+	//dimension errors, unknown names and units, and syntax, with nothing added
+	Formulas bad;
+	CHECK(bad.input<Force>("force"));
+	CHECK(bad.input<Area>("area"));
+	CHECK(bad.input<Length>("length"));
+	CHECK(!bad.compile("ok = force / area\nwrong = force * area"));
+	CHECK(std::string(bad.error()).find("line 2") == 0);
+	CHECK(std::string(bad.error()).find("Force * Area") != std::string::npos);
+	CHECK(!bad.quantity("ok", q));
+	CHECK(!bad.compile("x = force + length"));
+	CHECK(!bad.compile("x = force + 1"));
+	CHECK(!bad.compile("x = min(force, area)"));
+	CHECK(!bad.compile("x = speed * 2"));
+	CHECK(!bad.compile("x = 3 furlong"));
+	CHECK(std::string(bad.error()).find("furlong") != std::string::npos);
+	CHECK(!bad.compile("x = (force"));
+	CHECK(!bad.compile("force = 2 * force"));
+	//names in messages come from the class names, one quantity over itself only where the classes have it
+	CHECK(!bad.compile("x = force / force"));
+	CHECK(std::string(bad.error()) == "line 1: Force / Force has no operator in Measurement.h");
+	CHECK(!bad.compile("x = length - 2"));
+	CHECK(std::string(bad.error()).find("number") != std::string::npos);
+	CHECK(bad.compile("x = abs(-length) / 2 m + max(length, 1 ft) / 1 m"));
+	CHECK(bad.quantity("x", q) && q == MSR_QUANTITY_COUNT);
+	//an input with no array bound
+	CHECK(!bad.run(1));
+	return checkResult();
+}
@@ -0,0 +1,99 @@
+#include <cmath>
+#include <vector>
+#include "Check.h"
+#include "Geodesy.h"
+#include "Measurement.h"
+
+static Angle dms(double degrees, double minutes, double seconds) {
+	double sign = degrees < 0 ? -1 : 1;
+	return Angle(sign * (std::fabs(degrees) + minutes / 60 + seconds / 3600), DEGREES);
+}
+
+int main() {
+	const double quarter = Angle::RADIANS_PER_REVOLUTION / 4;
+
+	//a quarter of the equator, on the sphere and on the ellipsoid
+	Angle zero(0, DEGREES);
+	Angle east(90, DEGREES);
+	Length distance[1];
+	Geodesy::haversine(&zero, &zero, &zero, &east, 1, distance);
+	CHECK_NEAR(distance[0].value(UNITS::m), Geodesy::EARTH_RADIUS * quarter, 1e-6);
+	Geodesy::vincenty(&zero, &zero, &zero, &east, 1, distance);
+	CHECK_NEAR(distance[0].value(UNITS::m), Geodesy::WGS84_A * quarter, 1e-3);
+
+	//Flinders Peak to Buninyong, the test line from Vincenty's paper, 54972.271 m
+	Angle lat1 = dms(-37, 57, 3.72030);
+	Angle lon1 = dms(144, 25, 29.52440);
+	Angle lat2 = dms(-37, 39, 10.15610);
+	Angle lon2 = dms(143, 55, 35.38390);
+	Geodesy::vincenty(&lat1, &lon1, &lat2, &lon2, 1, distance);
+	CHECK_NEAR(distance[0].value(UNITS::m), 54972.271, 1e-3);
+	Length sphere[1];
+	Geodesy::haversine(&lat1, &lon1, &lat2, &lon2, 1, sphere);
+	CHECK(std::fabs(sphere[0].value(UNITS::m) / 54972.271 - 1) < 0.006);
+	//the same point, and nearly antipodal points stay finite
+	Geodesy::vincenty(&lat1, &lon1, &lat1, &lon1, 1, distance);
+	CHECK(distance[0].value(UNITS::m) == 0);
+	Angle south(-0.5, DEGREES);
+	Angle back(179.7, DEGREES);
+	Geodesy::vincenty(&zero, &zero, &south, &back, 1, distance);
+	CHECK(std::isfinite(distance[0].value(UNITS::m)) && distance[0].value(UNITS::m) > 1.99e7);
+
+	//north, east, south and west from the origin, then back to it
+	Angle lat[6] = { Angle(0, DEGREES), Angle(1, DEGREES), Angle(1, DEGREES), Angle(0, DEGREES), Angle(0, DEGREES), Angle(0, DEGREES) };
+	Angle lon[6] = { Angle(0, DEGREES), Angle(0, DEGREES), Angle(1, DEGREES), Angle(1, DEGREES), Angle(0, DEGREES), Angle(0, DEGREES) };
+	Angle headings[5];
+	Geodesy::bearings(lat, lon, 6, headings);
+	CHECK(headings[0].value(RADIANS) == 0);
+	CHECK_NEAR(headings[1].value(DEGREES), 90, 0.01);
+	CHECK_NEAR(headings[2].value(DEGREES), 180, 1e-9);
+	CHECK_NEAR(headings[3].value(DEGREES), 270, 1e-9);
+	//no movement is a bearing of +0
+	CHECK(headings[4].value(RADIANS) == 0 && !std::signbit(headings[4].value(RADIANS)));
+
+	//a hair west of north is just under a whole turn, not 2 pi
+	double northLat[2] = { 0, 1e-3 };
+	double northLon[2] = { 1e-300, 0 };
+	double bearing[1];
+	Geodesy::bearings(northLat, northLon, 2, bearing);
+	CHECK(bearing[0] >= 0 && bearing[0] < Angle::RADIANS_PER_REVOLUTION);
+	CHECK(bearing[0] == std::nextafter(Angle::RADIANS_PER_REVOLUTION, 0.0));
+	//across more than one block every bearing is in range, and NaN fixes give NaN
+	size_t n = 1000;
+	std::vector<double> trackLat(n);
+	std::vector<double> trackLon(n);
+	for (size_t i = 0; i < n; i++) {
+		trackLat[i] = 0.5 * std::sin(i * 0.1);
+		trackLon[i] = i % 3 == 0 ? -1e-300 * i : 1e-300 * i;
+	}
+	trackLat[500] = NAN;
+	std::vector<double> trackBearings(n - 1);
+	Geodesy::bearings(trackLat.data(), trackLon.data(), n, trackBearings.data());
+	bool inRange = true;
+	for (size_t i = 0; i + 1 < n; i++) {
+		if (i == 499 || i == 500) {
+			inRange = inRange && std::isnan(trackBearings[i]);
+		}
+		else {
+			inRange = inRange && trackBearings[i] >= 0 && trackBearings[i] < Angle::RADIANS_PER_REVOLUTION;
+		}
+	}
+	CHECK(inRange);
+	//fewer than two fixes have no legs
+	bearing[0] = 7;
+	Geodesy::bearings(northLat, northLon, 1, bearing);
+	CHECK(bearing[0] == 7);
+
+	//leg speeds are distance over time, a repeated time gives infinity
+	Angle legLat[3] = { Angle(0, DEGREES), Angle(0, DEGREES), Angle(0, DEGREES) };
+	Angle legLon[3] = { Angle(0, DEGREES), Angle(0.01, DEGREES), Angle(0.02, DEGREES) };
+	TimeDuration times[3] = { TimeDuration(0, UNITS::s), TimeDuration(60, UNITS::s), TimeDuration(60, UNITS::s) };
+	Length legDistances[2];
+	Speed speeds[2];
+	Geodesy::legs(legLat, legLon, times, 3, legDistances, speeds);
+	double leg = Geodesy::EARTH_RADIUS * 0.01 * Angle::RADIANS_PER_DEGREE;
+	CHECK_NEAR(legDistances[0].value(UNITS::m), leg, 1e-6);
+	CHECK_NEAR(speeds[0].value(UNITS::m_s), leg / 60, 1e-9);
+	CHECK(std::isinf(speeds[1].value(UNITS::m_s)));
+	return checkResult();
+}
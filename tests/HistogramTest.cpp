@@ -0,0 +1,132 @@
+#include <cmath>
+#include <vector>
+#include "Check.h"
+#include "Histogram.h"
+#include "Measurement.h"
+
+//every edge, made into a sample the way a caller would, lands in the bin it starts, the last edge in the last bin
+template <class T>
+static void checkEdges(Histogram<T>& histogram, const double* edges, size_t count, typename SIUnit<T>::Units units) {
+	std::vector<T> samples;
+	for (size_t i = 0; i < count; i++) {
+		samples.push_back(T(edges[i], units));
+	}
+	histogram.clear();
+	histogram.add(samples.data(), samples.size(), 1);
+	CHECK(histogram.below() == 0);
+	CHECK(histogram.above() == 0);
+	for (size_t b = 0; b + 1 < histogram.bins(); b++) {
+		CHECK(histogram.count(b) == 1);
+	}
+	CHECK(histogram.count(histogram.bins() - 1) == 2);
+}
+
+int main() {
+	//uniform bins in F and C, including edges that are not exact in K
+	Histogram<Temperature> fahrenheit(-40, 212, 9, UNITS::F);
+	double fEdges[10];
+	for (int i = 0; i <= 9; i++) {
+		fEdges[i] = -40 + 28 * i;
+	}
+	checkEdges(fahrenheit, fEdges, 10, UNITS::F);
+	Histogram<Temperature> celsius(-17.3, 41.9, 37, UNITS::C);
+	double cEdges[38];
+	for (int i = 0; i <= 37; i++) {
+		cEdges[i] = -17.3 + (41.9 - -17.3) * i / 37;
+	}
+	checkEdges(celsius, cEdges, 38, UNITS::C);
+	for (int i = 0; i <= 9; i++) {
+		CHECK(storedValue(fahrenheit.edge(i)) == storedValue(Temperature(fEdges[i], UNITS::F)));
+	}
+
+	//uneven edges
+	double body[] = { 32, 50, 68, 86, 98.6, 104.9 };
+	Histogram<Temperature> uneven(body, 6, UNITS::F);
+	checkEdges(uneven, body, 6, UNITS::F);
+	double kelvinEdges[] = { 233.15, 273.15, 310.15 };
+	Histogram<Temperature> kelvin(kelvinEdges, 3, UNITS::K);
+	double asC[] = { -40, 0, 37 };
+	std::vector<Temperature> inC;
+	for (int i = 0; i < 3; i++) {
+		inC.push_back(Temperature(asC[i], UNITS::C));
+	}
+	kelvin.add(inC.data(), 3);
+	CHECK(kelvin.below() + kelvin.count(0) + kelvin.count(1) + kelvin.above() == 3);
+
+	//15 mph is the start of a bin, not the end of the one before
+	Histogram<Speed> speeds(0, 100, 20, UNITS::mph);
+	double mph[21];
+	for (int i = 0; i <= 20; i++) {
+		mph[i] = 5 * i;
+	}
+	checkEdges(speeds, mph, 21, UNITS::mph);
+	double gallons[] = { 0.1, 0.3, 1, 2.5 };
+	Histogram<Volume> volumes(gallons, 4, UNITS::gallon);
+	checkEdges(volumes, gallons, 4, UNITS::gallon);
+
+	//below, above and NaN each have their own count
+	Temperature odd[] = { Temperature(-40.001, UNITS::F), Temperature(212.001, UNITS::F), Temperature(NAN, UNITS::F), Temperature(100, UNITS::F) };
+	fahrenheit.clear();
+	fahrenheit.add(odd, 4);
+	CHECK(fahrenheit.below() == 1 && fahrenheit.above() == 1 && fahrenheit.nan() == 1);
+	CHECK(fahrenheit.count(5) == 1);
+	CHECK_NEAR(fahrenheit.edge(5).value(UNITS::F), 100, 1e-12);
+
+	//the same on uniform bins, which only fall back to the edges for blocks that need it
+	Speed oddSpeeds[] = { Speed(NAN, UNITS::mph), Speed(100, UNITS::mph), Speed(-0.001, UNITS::mph), Speed(100.001, UNITS::mph), Speed(0, UNITS::mph) };
+	Histogram<Speed> uniformOdd(0, 100, 20, UNITS::mph);
+	uniformOdd.add(oddSpeeds, 5);
+	CHECK(uniformOdd.nan() == 1 && uniformOdd.below() == 1 && uniformOdd.above() == 1);
+	CHECK(uniformOdd.count(19) == 1 && uniformOdd.count(0) == 1);
+	//a NaN now and then among in-range samples, against counting by the edges
+	std::vector<Speed> sparse(5000);
+	std::vector<uint64_t> expected(20, 0);
+	for (size_t i = 0; i < sparse.size(); i++) {
+		double mph = std::fmod(i * 0.731, 100);
+		sparse[i] = Speed(i % 997 == 3 ? NAN : mph, UNITS::mph);
+		expected[(size_t)(mph / 5)] += i % 997 == 3 ? 0 : 1;
+	}
+	Histogram<Speed> uniformSparse(0, 100, 20, UNITS::mph);
+	uniformSparse.add(sparse.data(), sparse.size(), 1);
+	CHECK(uniformSparse.nan() == 6 && uniformSparse.below() == 0 && uniformSparse.above() == 0);
+	for (size_t b = 0; b < 20; b++) {
+		CHECK(uniformSparse.count(b) == expected[b]);
+	}
+
+	//threads and merged partial histograms add up to the same counts
+	size_t n = 300000;
+	std::vector<Speed> samples(n);
+	for (size_t i = 0; i < n; i++) {
+		samples[i] = Speed(std::fmod(i * 0.37, 110) - 5, UNITS::mph);
+	}
+	Histogram<Speed> one(0, 100, 20, UNITS::mph);
+	Histogram<Speed> four(0, 100, 20, UNITS::mph);
+	Histogram<Speed> half(0, 100, 20, UNITS::mph);
+	Histogram<Speed> otherHalf(0, 100, 20, UNITS::mph);
+	one.add(samples.data(), n, 1);
+	four.add(samples.data(), n, 4);
+	half.add(samples.data(), n / 2, 1);
+	otherHalf.add(samples.data() + n / 2, n - n / 2, 1);
+	half.merge(otherHalf);
+	uint64_t total = one.below() + one.above() + one.nan();
+	for (size_t b = 0; b < one.bins(); b++) {
+		CHECK(one.count(b) == four.count(b) && one.count(b) == half.count(b));
+		total += one.count(b);
+	}
+	CHECK(one.below() == four.below() && one.above() == four.above() && one.above() == half.above());
+	CHECK(total == n);
+
+	//2D counts and slots
+	Pressure p[3] = { Pressure(14.7, UNITS::psi), Pressure(30, UNITS::psi), Pressure(100, UNITS::psi) };
+	Temperature t[3] = { Temperature(32, UNITS::F), Temperature(50, UNITS::F), Temperature(50, UNITS::F) };
+	double tEdges[] = { 32, 50, 68 };
+	Histogram2D<Pressure, Temperature> map(HistogramAxis::uniform(0, 50, 5), UNITS::psi, HistogramAxis::edges(tEdges, 3), UNITS::F);
+	map.add(p, t, 3);
+	CHECK(map.xBins() == 5 && map.yBins() == 2);
+	CHECK(map.count(1, 0) == 1);
+	CHECK(map.count(3, 1) == 1);
+	//100 psi is above the x axis, in the last x slot, and the second y bin
+	size_t ySlots = map.yBins() + 3;
+	CHECK(map.slotCounts()[(map.xBins() + 1) * ySlots + 2] == 1);
+	return checkResult();
+}
@@ -0,0 +1,56 @@
+#include <cstring>
+#include "Check.h"
+#include "Measurement.h"
+
+static Length twice(Length length) {
+	MEASUREMENT_SITE("twice");
+	return Length(length.value(UNITS::ft) * 2, UNITS::ft);
+}
+
+int main() {
+	Instrumentation::reset();
+
+	//set then value in the same unit on the same object is a round trip, value in another unit is not
+	Pressure p(30, UNITS::psi);
+	CHECK_NEAR(p.value(UNITS::psi), 30, 1e-12);
+	CHECK(p.value(UNITS::kPa) > 206);
+	//value then set into another measurement in the same unit is one too
+	Length a(3, UNITS::m);
+	Length doubled = twice(a);
+	CHECK_NEAR(doubled.value(UNITS::m), 6, 1e-12);
+
+	Instrumentation::Snapshot counts = Instrumentation::snapshot();
+	CHECK(counts.sets[Instrumentation::PRESSURE][UNITS::psi] == 1);
+	CHECK(counts.values[Instrumentation::PRESSURE][UNITS::psi] == 1);
+	CHECK(counts.values[Instrumentation::PRESSURE][UNITS::kPa] == 1);
+	CHECK(counts.roundTrips[Instrumentation::PRESSURE][UNITS::psi] == 1);
+	CHECK(counts.roundTrips[Instrumentation::PRESSURE][UNITS::kPa] == 0);
+	CHECK(counts.values[Instrumentation::LENGTH][UNITS::ft] == 1);
+	CHECK(counts.sets[Instrumentation::LENGTH][UNITS::ft] == 1);
+	CHECK(counts.roundTrips[Instrumentation::LENGTH][UNITS::ft] == 1);
+
+	//only what ran inside the scope is the site's
+	bool found = false;
+	for (size_t i = 0; i < counts.sites.size(); i++) {
+		if (std::strcmp(counts.sites[i].name, "twice") == 0) {
+			found = true;
+			CHECK(counts.sites[i].sets == 1);
+			CHECK(counts.sites[i].values == 1);
+			CHECK(counts.sites[i].roundTrips == 1);
+		}
+	}
+	CHECK(found);
+
+	//names come from the same list as the C API's
+	CHECK(std::strcmp(Instrumentation::unitName(Instrumentation::PRESSURE, UNITS::psi), "psi") == 0);
+	CHECK(std::strcmp(Instrumentation::unitName(Instrumentation::TEMPERATURE, UNITS::F), "F") == 0);
+	CHECK(std::strcmp(Instrumentation::unitName(Instrumentation::TORQUE, UNITS::ftlb), "ftlb") == 0);
+	CHECK(std::strcmp(Instrumentation::unitName(Instrumentation::MASS, 31), "?") == 0);
+	CHECK(std::strcmp(Instrumentation::quantityName(Instrumentation::ROTATION_SPEED), "RotationSpeed") == 0);
+
+	Instrumentation::reset();
+	counts = Instrumentation::snapshot();
+	CHECK(counts.sets[Instrumentation::PRESSURE][UNITS::psi] == 0);
+	CHECK(counts.sites.size() >= 1 && counts.sites[0].sets == 0);
+	return checkResult();
+}
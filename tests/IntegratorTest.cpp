@@ -0,0 +1,59 @@
+#include <cmath>
+#include <tuple>
+#include "Check.h"
+#include "Integrator.h"
+#include "Measurement.h"
+
+typedef std::tuple<Length, Speed> State;
+
+//x'' = -omega^2 x, with omega differing between systems through the start length
+struct Spring {
+	double omega2;
+	std::tuple<Speed, Acceleration> operator()(TimeDuration, State y) {
+		return std::make_tuple(std::get<1>(y), Acceleration(-omega2 * std::get<0>(y).value(UNITS::m), UNITS::m_s2));
+	}
+};
+
+int main() {
+	auto fall = [](TimeDuration, State y) {
+		return std::make_tuple(std::get<1>(y), Acceleration(-1, UNITS::G));
+	};
+	State dropped = RK4<Length, Speed>::integrate(fall, TimeDuration(0, UNITS::s), State(Length(100, UNITS::m), Speed()), TimeDuration(1, UNITS::ms), 1000);
+	CHECK_NEAR(std::get<0>(dropped).value(UNITS::m), 100 - 9.80665 / 2, 1e-9);
+	CHECK_NEAR(std::get<1>(dropped).value(UNITS::m_s), -9.80665, 1e-9);
+
+	Spring spring = { 4 };
+	DormandPrince<Length, Speed> solver(1e-10, 1e-12);
+	State end = solver.integrate(spring, TimeDuration(0, UNITS::s), State(Length(1, UNITS::m), Speed()), TimeDuration(3, UNITS::s));
+	CHECK(solver.ok());
+	CHECK(solver.acceptedSteps() > 0);
+	CHECK_NEAR(std::get<0>(end).value(UNITS::m), std::cos(6.0), 1e-8);
+	CHECK_NEAR(std::get<1>(end).value(UNITS::m_s), -2 * std::sin(6.0), 1e-8);
+
+	//side by side lanes take the scalar solver's steps exactly, including a part-filled last block
+	const size_t systems = 21;
+	StateBatch<Length, Speed> batch;
+	StateBatch<Length, Speed> threaded;
+	StateBatch<Length, Speed> fixed;
+	for (size_t i = 0; i < systems; i++) {
+		State y(Length(1 + i * 0.37, UNITS::ft), Speed(i * 0.5 - 3, UNITS::m_s));
+		batch.push_back(y);
+		threaded.push_back(y);
+		fixed.push_back(y);
+	}
+	CHECK(integrateDormandPrince(spring, batch, TimeDuration(0, UNITS::s), TimeDuration(3, UNITS::s), 1e-8, 1e-10, 1));
+	CHECK(integrateDormandPrince(spring, threaded, TimeDuration(0, UNITS::s), TimeDuration(3, UNITS::s), 1e-8, 1e-10, 3));
+	integrateRK4(spring, fixed, TimeDuration(0, UNITS::s), TimeDuration(10, UNITS::ms), 300, 2);
+	for (size_t i = 0; i < systems; i++) {
+		State y(Length(1 + i * 0.37, UNITS::ft), Speed(i * 0.5 - 3, UNITS::m_s));
+		DormandPrince<Length, Speed> alone(1e-8, 1e-10);
+		State want = alone.integrate(spring, TimeDuration(0, UNITS::s), y, TimeDuration(3, UNITS::s));
+		CHECK(toSI(std::get<0>(batch.get(i))) == toSI(std::get<0>(want)));
+		CHECK(toSI(std::get<1>(batch.get(i))) == toSI(std::get<1>(want)));
+		CHECK(toSI(std::get<0>(threaded.get(i))) == toSI(std::get<0>(want)));
+		State stepped = RK4<Length, Speed>::integrate(spring, TimeDuration(0, UNITS::s), y, TimeDuration(10, UNITS::ms), 300);
+		CHECK(toSI(std::get<0>(fixed.get(i))) == toSI(std::get<0>(stepped)));
+		CHECK(toSI(std::get<1>(fixed.get(i))) == toSI(std::get<1>(stepped)));
+	}
+	return checkResult();
+}
@@ -0,0 +1,96 @@
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Check.h"
+#include "Interval.h"
+#include "Measurement.h"
+
+int main() {
+	const double inf = std::numeric_limits<double>::infinity();
+
+	//rounding goes outward, past the exact result
+	Interval<Length> a(Length(0.1, UNITS::m));
+	Interval<Length> b(Length(0.2, UNITS::m));
+	Interval<Length> sum = a + b;
+	CHECK(sum.lowerSI() < 0.1 + 0.2);
+	CHECK(sum.upperSI() > 0.1 + 0.2);
+	CHECK(sum.lowerSI() <= 0.3 && 0.3 <= sum.upperSI());
+	CHECK(sum.upperSI() - sum.lowerSI() < 1e-15);
+	Interval<Length> difference = b - a;
+	CHECK(difference.lowerSI() < 0.1 && difference.upperSI() > 0.1);
+	CHECK(IntervalBatch::roundDown(1.0) < 1.0);
+	CHECK(IntervalBatch::roundUp(1.0) > 1.0);
+	CHECK(IntervalBatch::roundDown(0.0) < 0.0);
+	CHECK(IntervalBatch::roundUp(0.0) > 0.0);
+
+	//overflow keeps a finite inner bound, never NaN
+	Interval<Length> huge = Interval<Length>::fromBounds(DBL_MAX, DBL_MAX);
+	Interval<Length> over = huge + huge;
+	CHECK(over.lowerSI() == DBL_MAX);
+	CHECK(over.upperSI() == inf);
+	Interval<Length> under = Interval<Length>::fromBounds(-DBL_MAX, -DBL_MAX) + Interval<Length>::fromBounds(-DBL_MAX, -DBL_MAX);
+	CHECK(under.lowerSI() == -inf);
+	CHECK(under.upperSI() == -DBL_MAX);
+	Interval<Area> squared = huge * huge;
+	CHECK(squared.lowerSI() == DBL_MAX && squared.upperSI() == inf);
+	CHECK(IntervalBatch::roundDown(-inf) == -inf);
+	CHECK(IntervalBatch::roundUp(inf) == inf);
+
+	//products take the extreme corners
+	Interval<Length> span(Length(-2, UNITS::m), Length(3, UNITS::m));
+	Interval<Length> positive(Length(4, UNITS::m), Length(5, UNITS::m));
+	Interval<Area> product = span * positive;
+	CHECK(product.lowerSI() < -10 && product.lowerSI() > -10.000001);
+	CHECK(product.upperSI() > 15 && product.upperSI() < 15.000001);
+	Interval<Length> negated = span * -1.0;
+	CHECK(negated.lowerSI() < -3 && negated.upperSI() > 2);
+
+	//division by intervals spanning zero, or touching it, gives everything
+	Interval<Force> force(Force(10, UNITS::N), Force(20, UNITS::N));
+	Interval<Area> acrossZero = Interval<Area>::fromBounds(-1, 1);
+	Interval<Pressure> anything = force / acrossZero;
+	CHECK(anything.lowerSI() == -inf && anything.upperSI() == inf);
+	Interval<Pressure> touching = force / Interval<Area>::fromBounds(0, 2);
+	CHECK(touching.lowerSI() == -inf && touching.upperSI() == inf);
+	Interval<Pressure> p = force / Interval<Area>(Area(1, UNITS::m2), Area(2, UNITS::m2));
+	CHECK(p.lowerSI() < 5 && p.lowerSI() > 4.999999);
+	CHECK(p.upperSI() > 20 && p.upperSI() < 20.000001);
+	Interval<Length> halved = positive / 2.0;
+	CHECK(halved.contains(Length(2, UNITS::m)) && halved.contains(Length(2.5, UNITS::m)));
+
+	Interval<Force> tol = Interval<Force>::tolerance(Force(500, UNITS::N), Force(5, UNITS::N));
+	CHECK(tol.contains(Force(495, UNITS::N)) && tol.contains(Force(505, UNITS::N)));
+	CHECK(tol.below(Force(506, UNITS::N)) && !tol.below(Force(505, UNITS::N)));
+
+	//the batch kernels give the same bounds as the scalar operators
+	IntervalArray<Force> forces;
+	IntervalArray<Area> areas;
+	for (int i = 0; i < 100; i++) {
+		forces.push_back(Interval<Force>(Force(i - 50, UNITS::N), Force(i - 40, UNITS::N)));
+		areas.push_back(Interval<Area>(Area(i % 7 - 3, UNITS::m2), Area(i % 5 + 1, UNITS::m2)));
+	}
+	IntervalArray<Pressure> pressures = forces / areas;
+	for (int i = 0; i < 100; i++) {
+		Interval<Pressure> scalar = forces[i] / areas[i];
+		CHECK(pressures[i] == scalar);
+	}
+
+	//classes stored in other units still enclose what they were made from
+	std::mt19937_64 random(5);
+	std::uniform_real_distribution<double> exponent(-20, 20);
+	bool enclosed = true;
+	for (int i = 0; i < 10000; i++) {
+		double x = std::exp(exponent(random));
+		Interval<Volume> single(Volume(x, UNITS::L));
+		Interval<Volume> pair(Volume(x, UNITS::L), Volume(2000, UNITS::L));
+		enclosed = enclosed && single.lower().value(UNITS::L) <= x && x <= single.upper().value(UNITS::L);
+		enclosed = enclosed && pair.lower().value(UNITS::L) <= x && single.contains(Volume(x, UNITS::L));
+	}
+	CHECK(enclosed);
+	Interval<Volume> known(Volume(503.90076373599572, UNITS::L));
+	CHECK(known.upper().value(UNITS::L) >= 503.90076373599572);
+	//SI classes stay exact
+	CHECK(Interval<Length>(Length(0.1, UNITS::m)).lowerSI() == 0.1);
+	return checkResult();
+}
@@ -0,0 +1,165 @@
+#include "Check.h"
+#include "Literals.h"
+#include "MeasurementTraits.h"
+
+using namespace measurement::literals;
+
+//a literal is the same double as the constructor given the same number and unit
+#define LITERAL_CHECK(TYPE, UNIT) \
+	do { \
+		CHECK(storedValue(2.5_##UNIT) == storedValue(TYPE(2.5, UNITS::UNIT))); \
+		CHECK(storedValue(7_##UNIT) == storedValue(TYPE(7, UNITS::UNIT))); \
+		CHECK(storedValue(0.3_##UNIT) == storedValue(TYPE(0.3, UNITS::UNIT))); \
+		CHECK(storedValue(123.456_##UNIT) == storedValue(TYPE(123.456, UNITS::UNIT))); \
+	} while (0)
+
+int main() {
+	LITERAL_CHECK(TimeDuration, s);
+	LITERAL_CHECK(TimeDuration, min);
+	LITERAL_CHECK(TimeDuration, hr);
+	LITERAL_CHECK(TimeDuration, day);
+	LITERAL_CHECK(TimeDuration, week);
+	LITERAL_CHECK(TimeDuration, yr);
+	LITERAL_CHECK(TimeDuration, ms);
+	LITERAL_CHECK(TimeDuration, us);
+	LITERAL_CHECK(TimeDuration, ns);
+
+	LITERAL_CHECK(Length, m);
+	LITERAL_CHECK(Length, cm);
+	LITERAL_CHECK(Length, mm);
+	LITERAL_CHECK(Length, um);
+	LITERAL_CHECK(Length, km);
+	LITERAL_CHECK(Length, in);
+	LITERAL_CHECK(Length, ft);
+	LITERAL_CHECK(Length, yd);
+	LITERAL_CHECK(Length, mi);
+
+	LITERAL_CHECK(Area, m2);
+	LITERAL_CHECK(Area, cm2);
+	LITERAL_CHECK(Area, mm2);
+	LITERAL_CHECK(Area, um2);
+	LITERAL_CHECK(Area, km2);
+	LITERAL_CHECK(Area, in2);
+	LITERAL_CHECK(Area, ft2);
+	LITERAL_CHECK(Area, yd2);
+	LITERAL_CHECK(Area, mi2);
+	LITERAL_CHECK(Area, acre);
+	LITERAL_CHECK(Area, hectare);
+
+	LITERAL_CHECK(Volume, m3);
+	LITERAL_CHECK(Volume, cm3);
+	LITERAL_CHECK(Volume, mm3);
+	LITERAL_CHECK(Volume, km3);
+	LITERAL_CHECK(Volume, L);
+	LITERAL_CHECK(Volume, mL);
+	LITERAL_CHECK(Volume, in3);
+	LITERAL_CHECK(Volume, ft3);
+	LITERAL_CHECK(Volume, yd3);
+	LITERAL_CHECK(Volume, mi3);
+	LITERAL_CHECK(Volume, tsp);
+	LITERAL_CHECK(Volume, tbsp);
+	LITERAL_CHECK(Volume, cup);
+	LITERAL_CHECK(Volume, pint);
+	LITERAL_CHECK(Volume, quart);
+	LITERAL_CHECK(Volume, gallon);
+	LITERAL_CHECK(Volume, barrel);
+
+	LITERAL_CHECK(Speed, m_s);
+	LITERAL_CHECK(Speed, kph);
+	LITERAL_CHECK(Speed, mph);
+	LITERAL_CHECK(Speed, ft_s);
+
+	LITERAL_CHECK(Acceleration, m_s2);
+	LITERAL_CHECK(Acceleration, kph_s);
+	LITERAL_CHECK(Acceleration, mph_s);
+	LITERAL_CHECK(Acceleration, ft_s2);
+	LITERAL_CHECK(Acceleration, G);
+
+	LITERAL_CHECK(Mass, gram);
+	LITERAL_CHECK(Mass, kg);
+	LITERAL_CHECK(Mass, lb);
+	LITERAL_CHECK(Mass, oz);
+	LITERAL_CHECK(Mass, tonne);
+	LITERAL_CHECK(Mass, ton);
+
+	LITERAL_CHECK(Force, N);
+	LITERAL_CHECK(Force, lbf);
+
+	LITERAL_CHECK(Pressure, Pa);
+	LITERAL_CHECK(Pressure, kPa);
+	LITERAL_CHECK(Pressure, MPa);
+	LITERAL_CHECK(Pressure, psi);
+	LITERAL_CHECK(Pressure, mmHg);
+	LITERAL_CHECK(Pressure, inH2O);
+	LITERAL_CHECK(Pressure, bar);
+	LITERAL_CHECK(Pressure, atm);
+
+	LITERAL_CHECK(Energy, J);
+	LITERAL_CHECK(Energy, kJ);
+	LITERAL_CHECK(Energy, MJ);
+	LITERAL_CHECK(Energy, kWh);
+	LITERAL_CHECK(Energy, hph);
+	LITERAL_CHECK(Energy, BTU);
+	LITERAL_CHECK(Energy, cal);
+	LITERAL_CHECK(Energy, kCal);
+
+	LITERAL_CHECK(Power, W);
+	LITERAL_CHECK(Power, kW);
+	LITERAL_CHECK(Power, MW);
+	LITERAL_CHECK(Power, mW);
+	LITERAL_CHECK(Power, hp);
+	LITERAL_CHECK(Power, BTU_h);
+
+	LITERAL_CHECK(Density, kg_m3);
+	LITERAL_CHECK(Density, g_cm3);
+	LITERAL_CHECK(Density, lb_gal);
+
+	LITERAL_CHECK(Voltage, V);
+	LITERAL_CHECK(Voltage, mV);
+	LITERAL_CHECK(Voltage, kV);
+	LITERAL_CHECK(Voltage, MV);
+
+	LITERAL_CHECK(Current, A);
+	LITERAL_CHECK(Current, mA);
+	LITERAL_CHECK(Current, kA);
+	LITERAL_CHECK(Current, MA);
+
+	LITERAL_CHECK(Capacitance, Farad);
+	LITERAL_CHECK(Capacitance, uF);
+	LITERAL_CHECK(Capacitance, mF);
+	LITERAL_CHECK(Capacitance, nF);
+	LITERAL_CHECK(Capacitance, pF);
+
+	LITERAL_CHECK(Resistance, Ohm);
+	LITERAL_CHECK(Resistance, mOhm);
+	LITERAL_CHECK(Resistance, kOhm);
+	LITERAL_CHECK(Resistance, MOhm);
+
+	LITERAL_CHECK(RotationSpeed, rpm);
+	LITERAL_CHECK(RotationSpeed, rev_s);
+	LITERAL_CHECK(RotationSpeed, rad_s);
+	LITERAL_CHECK(RotationSpeed, deg_s);
+
+	LITERAL_CHECK(Torque, Nm);
+	LITERAL_CHECK(Torque, inlb);
+	LITERAL_CHECK(Torque, ftlb);
+
+	CHECK(toSI(20_C) == 293.15);
+	//F and R use the constructor's factors, so they agree exactly
+	CHECK(toSI(98.6_F) == toSI(Temperature(98.6, UNITS::F)));
+	CHECK(toSI(32_F) == toSI(Temperature(32, UNITS::F)));
+	CHECK(toSI(212.0_F) == toSI(Temperature(212, UNITS::F)));
+	CHECK(toSI(451_F) == toSI(Temperature(451, UNITS::F)));
+	CHECK(toSI(0.5_F) == toSI(Temperature(0.5, UNITS::F)));
+	CHECK(toSI(491.67_R) == toSI(Temperature(491.67, UNITS::R)));
+	CHECK(toSI(100_R) == toSI(Temperature(100, UNITS::R)));
+	CHECK_NEAR(toSI(32_F), 273.15, 1e-12);
+	CHECK(toSI(20.0_K) == 20);
+	CHECK_NEAR(Temperature(37.0_C).value(UNITS::C), 37, 1e-12);
+
+	//literals fold to constants
+	constexpr Length board = 12.5_ft;
+	CHECK_NEAR(Length(board).value(UNITS::m), 3.81, 1e-15);
+	CHECK_NEAR((3_kWh).value(UNITS::J), 1.08e7, 1e-6);
+	return checkResult();
+}
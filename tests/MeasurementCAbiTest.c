@@ -0,0 +1,54 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "MeasurementC.h"
+
+//the C interface from C, linked to the shared library alone
+
+static int failures = 0;
+
+#define CHECK(EXPRESSION) \
+	do { \
+		if (!(EXPRESSION)) { \
+			failures++; \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #EXPRESSION); \
+		} \
+	} while (0)
+
+int main(void) {
+	double psi[4] = { 14.7, 30, 60, 120 };
+	double kPa[4];
+	double force[2] = { 10, 20 };
+	double distance[2] = { 3, 0.5 };
+	double work[2];
+	double total;
+	float fahrenheit[2] = { 32, 212 };
+	float celsius[2];
+	size_t i;
+
+	CHECK(msr_abi_version() == MSR_ABI_VERSION);
+	CHECK(msr_unit_from_name("psi") == MSR_psi);
+	CHECK(msr_unit_from_name("furlong") == MSR_INVALID_UNIT);
+	CHECK(msr_unit_name(MSR_kPa) != 0 && strcmp(msr_unit_name(MSR_kPa), "kPa") == 0);
+	CHECK(msr_unit_quantity(MSR_ft_s2) == MSR_ACCELERATION);
+	CHECK(msr_product_quantity(MSR_FORCE, MSR_LENGTH) == MSR_ENERGY);
+
+	msr_set_threads(1);
+	CHECK(msr_convert_f64(psi, kPa, 4, MSR_psi, MSR_kPa) == MSR_OK);
+	for (i = 0; i < 4; i++) {
+		CHECK(fabs(kPa[i] - psi[i] * 6.894757293168361) < 1e-9 * kPa[i]);
+	}
+	CHECK(msr_convert_f64(psi, kPa, 4, MSR_psi, MSR_m) != MSR_OK);
+	CHECK(msr_convert_f32(fahrenheit, celsius, 2, MSR_F, MSR_C) == MSR_OK);
+	CHECK(fabsf(celsius[0]) < 1e-4f && fabsf(celsius[1] - 100) < 1e-4f);
+
+	//lbf times ft, as J
+	CHECK(msr_multiply_f64(force, MSR_lbf, distance, MSR_ft, work, MSR_J, 2) == MSR_OK);
+	CHECK(fabs(work[0] - 30 * 1.3558179483314004) < 1e-12);
+	CHECK(msr_sum_f64(work, MSR_J, 2, &total, MSR_kJ) == MSR_OK);
+	CHECK(fabs(total - (work[0] + work[1]) / 1000) < 1e-15);
+	if (failures) {
+		printf("%d checks failed\n", failures);
+	}
+	return failures ? 1 : 0;
+}
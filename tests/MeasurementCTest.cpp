@@ -0,0 +1,125 @@
+#include <cstring>
+#include <vector>
+#include "Check.h"
+#include "Measurement.h"
+#include "MeasurementC.h"
+
+//every unit of the list has its name, its quantity and converts to itself
+#define CHECK_UNIT(QUANTITY, UNIT) \
+	CHECK(msr_unit_from_name(#UNIT) == MSR_##UNIT); \
+	CHECK(msr_unit_name(MSR_##UNIT) && std::strcmp(msr_unit_name(MSR_##UNIT), #UNIT) == 0); \
+	CHECK(msr_unit_quantity(MSR_##UNIT) == QUANTITY);
+
+int main() {
+	CHECK(msr_abi_version() == MSR_ABI_VERSION);
+	MSR_UNIT_LIST(CHECK_UNIT)
+	CHECK(msr_unit_from_name("furlong") == MSR_INVALID_UNIT);
+	CHECK(msr_unit_from_name(0) == MSR_INVALID_UNIT);
+	CHECK(msr_unit_name(MSR_INVALID_UNIT) == 0);
+	CHECK(msr_unit_name(MSR_UNIT_ID(MSR_FORCE, 2)) == 0);
+	CHECK(msr_unit_quantity(MSR_UNIT_ID(MSR_TORQUE, 3)) == MSR_QUANTITY_COUNT);
+
+	//conversions match the classes, to the rounding of the SI step the classes take
+	double psi[4] = { 14.7, 30, 60, 120 };
+	double kPa[4];
+	CHECK(msr_convert_f64(psi, kPa, 4, MSR_psi, MSR_kPa) == MSR_OK);
+	for (int i = 0; i < 4; i++) {
+		CHECK_ULPS(kPa[i], Pressure(psi[i], UNITS::psi).value(UNITS::kPa), 2);
+	}
+	double fahrenheit[3] = { -40, 32, 98.6 };
+	double celsius[3];
+	CHECK(msr_convert_f64(fahrenheit, celsius, 3, MSR_F, MSR_C) == MSR_OK);
+	CHECK(celsius[0] == -40);
+	CHECK(celsius[1] == 0);
+	CHECK_NEAR(celsius[2], 37, 1e-13);
+	float feet[2] = { 1, 5280 };
+	float meters[2];
+	CHECK(msr_convert_f32(feet, meters, 2, MSR_ft, MSR_m) == MSR_OK);
+	CHECK(meters[0] == 0.3048f);
+	CHECK(meters[1] == 1609.344f);
+
+	//in place, and the same unit copies
+	double inPlace[2] = { 1, 2 };
+	CHECK(msr_convert_f64(inPlace, inPlace, 2, MSR_km, MSR_m) == MSR_OK);
+	CHECK(inPlace[0] == 1000 && inPlace[1] == 2000);
+	double copy[2];
+	CHECK(msr_convert_f64(inPlace, copy, 2, MSR_m, MSR_m) == MSR_OK);
+	CHECK(copy[0] == 1000 && copy[1] == 2000);
+
+	//errors leave out untouched
+	double untouched[1] = { 7 };
+	CHECK(msr_convert_f64(psi, untouched, 1, MSR_psi, MSR_m) == MSR_INCOMPATIBLE_UNITS);
+	CHECK(msr_convert_f64(psi, untouched, 1, MSR_psi, MSR_INVALID_UNIT) == MSR_UNKNOWN_UNIT);
+	CHECK(msr_convert_f64(psi, untouched, 1, 0x1300, MSR_psi) == MSR_UNKNOWN_UNIT);
+	CHECK(msr_convert_f64(0, untouched, 1, MSR_psi, MSR_kPa) == MSR_NULL_ARRAY);
+	CHECK(msr_convert_f32(0, 0, 1, MSR_ft, MSR_m) == MSR_NULL_ARRAY);
+	CHECK(untouched[0] == 7);
+	CHECK(msr_convert_f64(0, 0, 0, MSR_psi, MSR_kPa) == MSR_OK);
+
+	//temperatures are absolute, as in Temperature::operator+
+	double tenC[1] = { 10 };
+	double sum[1];
+	CHECK(msr_add_f64(tenC, MSR_C, tenC, MSR_C, sum, MSR_C, 1) == MSR_OK);
+	CHECK_NEAR(sum[0], (Temperature(10, UNITS::C) + Temperature(10, UNITS::C)).value(UNITS::C), 1e-12);
+	CHECK_NEAR(sum[0], 293.15, 1e-12);
+	double meters3[1] = { 3 };
+	double feet1[1] = { 1 };
+	double difference[1];
+	CHECK(msr_subtract_f64(meters3, MSR_m, feet1, MSR_ft, difference, MSR_cm, 1) == MSR_OK);
+	CHECK_NEAR(difference[0], 300 - 30.48, 1e-12);
+	CHECK(msr_add_f64(meters3, MSR_m, feet1, MSR_s, difference, MSR_m, 1) == MSR_INCOMPATIBLE_UNITS);
+	CHECK(msr_add_f64(meters3, MSR_m, 0, MSR_ft, difference, MSR_m, 1) == MSR_NULL_ARRAY);
+
+	//products and quotients take the quantity of the C++ operator
+	CHECK(msr_product_quantity(MSR_FORCE, MSR_LENGTH) == MSR_ENERGY);
+	CHECK(msr_product_quantity(MSR_LENGTH, MSR_FORCE) == MSR_ENERGY);
+	CHECK(msr_product_quantity(MSR_TIME_DURATION, MSR_SPEED) == MSR_LENGTH);
+	CHECK(msr_product_quantity(MSR_TEMPERATURE, MSR_LENGTH) == MSR_QUANTITY_COUNT);
+	CHECK(msr_quotient_quantity(MSR_VOLTAGE, MSR_CURRENT) == MSR_RESISTANCE);
+	CHECK(msr_quotient_quantity(MSR_LENGTH, MSR_VOLTAGE) == MSR_QUANTITY_COUNT);
+	CHECK(msr_product_quantity(MSR_QUANTITY_COUNT, MSR_LENGTH) == MSR_QUANTITY_COUNT);
+	double force[2] = { 10, 20 };
+	double distance[2] = { 3, 4 };
+	double work[2];
+	CHECK(msr_multiply_f64(force, MSR_lbf, distance, MSR_ft, work, MSR_J, 2) == MSR_OK);
+	for (int i = 0; i < 2; i++) {
+		CHECK_ULPS(work[i], (Force(force[i], UNITS::lbf) * Length(distance[i], UNITS::ft)).value(UNITS::J), 4);
+	}
+	CHECK(msr_multiply_f64(force, MSR_lbf, distance, MSR_ft, work, MSR_W, 2) == MSR_INCOMPATIBLE_UNITS);
+	double volts[1] = { 12 };
+	double amps[1] = { 4 };
+	double ohms[1];
+	CHECK(msr_divide_f64(volts, MSR_V, amps, MSR_mA, ohms, MSR_kOhm, 1) == MSR_OK);
+	CHECK_NEAR(ohms[0], 3, 1e-15);
+	CHECK(msr_divide_f64(volts, MSR_V, amps, MSR_A, ohms, MSR_A, 1) == MSR_INCOMPATIBLE_UNITS);
+
+	//the sum adds an offset per value, and does not mind n == 0
+	double temps[3] = { 0, 10, 20 };
+	double total;
+	CHECK(msr_sum_f64(temps, MSR_C, 3, &total, MSR_K) == MSR_OK);
+	CHECK_NEAR(total, 30 + 3 * 273.15, 1e-9);
+	CHECK(msr_sum_f64(0, MSR_m, 0, &total, MSR_ft) == MSR_OK);
+	CHECK(total == 0);
+	CHECK(msr_sum_f64(temps, MSR_C, 3, 0, MSR_K) == MSR_NULL_ARRAY);
+
+	//arrays long enough to split between threads give what one thread gives
+	size_t n = (1 << 19) + 17;
+	std::vector<double> in(n);
+	for (size_t i = 0; i < n; i++) {
+		in[i] = i * 0.25 - 1000;
+	}
+	std::vector<double> serial(n);
+	std::vector<double> threaded(n);
+	double serialSum;
+	double threadedSum;
+	msr_set_threads(1);
+	CHECK(msr_convert_f64(in.data(), serial.data(), n, MSR_F, MSR_K) == MSR_OK);
+	CHECK(msr_sum_f64(in.data(), MSR_m, n, &serialSum, MSR_km) == MSR_OK);
+	msr_set_threads(4);
+	CHECK(msr_convert_f64(in.data(), threaded.data(), n, MSR_F, MSR_K) == MSR_OK);
+	CHECK(msr_sum_f64(in.data(), MSR_m, n, &threadedSum, MSR_km) == MSR_OK);
+	msr_set_threads(0);
+	CHECK(serial == threaded);
+	CHECK_NEAR(threadedSum, serialSum, 1e-9 * std::fabs(serialSum));
+	return checkResult();
+}
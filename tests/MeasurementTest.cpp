@@ -0,0 +1,34 @@
+#include "Check.h"
+#include "Measurement.h"
+
+//operators between quantities, the ones defined after every class
+int main() {
+	Length a(2, UNITS::m);
+	Length b(3, UNITS::m);
+	CHECK((a * b).value(UNITS::m2) == 6);
+	CHECK_NEAR((a * (a * b)).value(UNITS::m3), 12, 1e-12);
+	CHECK_NEAR((Volume(12, UNITS::m3) / a).value(UNITS::m2), 6, 1e-12);
+	CHECK_NEAR((Volume(12, UNITS::m3) / Area(6, UNITS::m2)).value(UNITS::m), 2, 1e-12);
+	CHECK_NEAR((a / TimeDuration(4, UNITS::s)).value(UNITS::m_s), 0.5, 1e-15);
+	CHECK_NEAR((Speed(10, UNITS::m_s) / TimeDuration(2, UNITS::s)).value(UNITS::m_s2), 5, 1e-15);
+
+	Force f = Mass(2, UNITS::kg) * Acceleration(3, UNITS::m_s2);
+	CHECK_NEAR(f.value(UNITS::N), 6, 1e-15);
+	CHECK_NEAR((f / Area(2, UNITS::m2)).value(UNITS::Pa), 3, 1e-15);
+	CHECK_NEAR((f * Length(2, UNITS::m)).value(UNITS::J), 12, 1e-15);
+	CHECK_NEAR((Energy(10, UNITS::J) / TimeDuration(2, UNITS::s)).value(UNITS::W), 5, 1e-15);
+
+	CHECK_NEAR((Voltage(12, UNITS::V) / Current(4, UNITS::A)).value(UNITS::Ohm), 3, 1e-15);
+	CHECK_NEAR((Resistance(5, UNITS::Ohm) * Current(2, UNITS::A)).value(UNITS::V), 10, 1e-15);
+	CHECK_NEAR((Voltage(10, UNITS::V) * Current(2, UNITS::A)).value(UNITS::W), 20, 1e-15);
+
+	Mass m(4, UNITS::kg);
+	Volume v(2, UNITS::L);
+	CHECK_NEAR((m / v).value(UNITS::kg_m3), 2000, 1e-9);
+	CHECK_NEAR((Density(2000, UNITS::kg_m3) * v).value(UNITS::kg), 4, 1e-12);
+	CHECK_NEAR((Energy(10, UNITS::J) / Volume(2, UNITS::m3)).value(UNITS::Pa), 5, 1e-12);
+	CHECK_NEAR((Power(10, UNITS::W) / Force(2, UNITS::N)).value(UNITS::m_s), 5, 1e-12);
+	CHECK_NEAR((Torque(10, UNITS::Nm) * RotationSpeed(2, UNITS::rad_s)).value(UNITS::W), 20, 1e-12);
+	CHECK_NEAR((RotationSpeed(60, UNITS::rpm) * TimeDuration(2, UNITS::s)).value(REVOLUTIONS), 2, 1e-12);
+	return checkResult();
+}
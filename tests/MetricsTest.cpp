@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include "Check.h"
+#include "Measurement.h"
+#include "Metrics.h"
+
+static std::string scrape(MetricsWriter& metrics) {
+	return std::string(metrics.data(), metrics.size());
+}
+
+int main() {
+	//the example from the header
+	MetricsWriter metrics;
+	metrics.begin();
+	metrics.family<Power>("asset_power", "Electrical power drawn by the asset");
+	metrics.sample("asset_power", "asset", "pump7", Power(1.5205, UNITS::kW));
+	metrics.end();
+	CHECK(scrape(metrics) ==
+		"# TYPE asset_power_watts gauge\n"
+		"# UNIT asset_power_watts watts\n"
+		"# HELP asset_power_watts Electrical power drawn by the asset\n"
+		"asset_power_watts{asset=\"pump7\"} 1520.5\n"
+		"# EOF\n");
+
+	//counters get _total, label values and help are escaped, values go out in the base unit
+	metrics.begin();
+	metrics.family<Energy>("pump_energy", "Energy used, \"metered\"\nat the panel", MetricsWriter::COUNTER);
+	metrics.sampleLabels("pump_energy", "site=\"north\",asset=\"p1\"", Energy(2, UNITS::kWh));
+	metrics.sample("pump_energy", "asset", "a\\b\"c", Energy(1, UNITS::kJ));
+	metrics.family<Mass>("tank_load", "");
+	metrics.sample("tank_load", Mass(1.5, UNITS::kg));
+	metrics.end();
+	CHECK(scrape(metrics) ==
+		"# TYPE pump_energy_joules counter\n"
+		"# UNIT pump_energy_joules joules\n"
+		"# HELP pump_energy_joules Energy used, \\\"metered\\\"\\nat the panel\n"
+		"pump_energy_joules_total{site=\"north\",asset=\"p1\"} 7200000\n"
+		"pump_energy_joules_total{asset=\"a\\\\b\\\"c\"} 1000\n"
+		"# TYPE tank_load_grams gauge\n"
+		"# UNIT tank_load_grams grams\n"
+		"tank_load_grams 1500\n"
+		"# EOF\n");
+
+	//numbers read back as the value() they came from, and the non-finite ones have their own names
+	Temperature fever(98.6, UNITS::F);
+	metrics.begin();
+	metrics.sample("body", fever);
+	metrics.sample("body", Temperature(std::numeric_limits<double>::infinity(), UNITS::K));
+	metrics.sample("body", Temperature(std::numeric_limits<double>::quiet_NaN(), UNITS::K));
+	std::string lines = scrape(metrics);
+	size_t space = lines.find(' ');
+	CHECK(lines.compare(0, space, "body_celsius") == 0);
+	CHECK(std::strtod(lines.c_str() + space + 1, 0) == fever.value(UNITS::C));
+	CHECK(lines.find("body_celsius +Inf\nbody_celsius NaN\n") != std::string::npos);
+
+	//a scrape bigger than the starting buffer, sent in pieces, and the next scrape reuses the memory
+	metrics.begin();
+	for (int i = 0; i < 1000; i++) {
+		metrics.sample("gap", "sensor", "s", Length(i, UNITS::mm));
+	}
+	metrics.end();
+	std::string whole = scrape(metrics);
+	CHECK(whole.size() > 4096);
+	std::string sent;
+	while (metrics.size()) {
+		size_t piece = metrics.size() < 1000 ? metrics.size() : 1000;
+		sent.append(metrics.data(), piece);
+		metrics.consume(piece);
+	}
+	CHECK(sent == whole);
+	CHECK(sent.find("gap_meters{sensor=\"s\"} 0.999\n") != std::string::npos);
+	metrics.begin();
+	const char* before = metrics.data();
+	for (int i = 0; i < 1000; i++) {
+		metrics.sample("gap", "sensor", "s", Length(i, UNITS::mm));
+	}
+	metrics.end();
+	CHECK(metrics.data() == before);
+	CHECK(scrape(metrics) == whole);
+	return checkResult();
+}
@@ -0,0 +1,62 @@
+#include <atomic>
+#include <vector>
+#include "Check.h"
+#include "Parallel.h"
+
+struct Counts {
+	std::vector<std::atomic<int>>* hits;
+	ThreadPool* pool;
+	std::atomic<int>* nested;
+};
+
+int main() {
+	//every index runs exactly once, job after job, on a pool with real workers
+	ThreadPool pool(3);
+	std::vector<std::atomic<int>> hits(1000);
+	std::atomic<int> nested(0);
+	Counts counts = { &hits, &pool, &nested };
+	for (int round = 0; round < 200; round++) {
+		pool.run(hits.size(), [](void* context, size_t i) {
+			Counts* c = (Counts*)context;
+			(*c->hits)[i]++;
+		}, &counts);
+	}
+	bool exact = true;
+	for (size_t i = 0; i < hits.size(); i++) {
+		exact = exact && hits[i] == 200;
+	}
+	CHECK(exact);
+
+	//a job started from inside a job runs on that thread instead of waiting on the pool
+	pool.run(8, [](void* context, size_t) {
+		Counts* c = (Counts*)context;
+		c->pool->run(4, [](void* inner, size_t) {
+			(*(std::atomic<int>*)inner)++;
+		}, c->nested);
+	}, &counts);
+	CHECK(nested == 32);
+
+	//parallelFor covers [0, n) in threads contiguous chunks, parallelSum adds them in chunk order
+	for (unsigned threads = 1; threads <= 9; threads++) {
+		std::vector<int> seen(1001, 0);
+		parallelFor(seen.size(), threads, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				seen[i]++;
+			}
+		});
+		bool once = true;
+		for (size_t i = 0; i < seen.size(); i++) {
+			once = once && seen[i] == 1;
+		}
+		CHECK(once);
+		double total = parallelSum(seen.size(), threads, [&](size_t begin, size_t end) {
+			double sum = 0;
+			for (size_t i = begin; i < end; i++) {
+				sum += double(i);
+			}
+			return sum;
+		});
+		CHECK(total == 1000.0 * 1001.0 / 2);
+	}
+	return checkResult();
+}
@@ -0,0 +1,52 @@
+#include <vector>
+#include "Check.h"
+#include "Measurement.h"
+#include "Precise.h"
+
+//the batch kernels give what Precise<T> gives one value at a time
+template <class T>
+void checkBatch(typename SIUnit<T>::Units units) {
+	std::vector<double> in, hi(100), lo(100), out(100);
+	for (int i = 0; i < 100; i++) {
+		in.push_back(-50 + i * 1.37);
+	}
+	PreciseBatch::fromUnits<T>(in.data(), in.size(), units, hi.data(), lo.data());
+	PreciseBatch::toUnits<T>(hi.data(), lo.data(), in.size(), units, out.data());
+	for (size_t i = 0; i < in.size(); i++) {
+		Precise<T> scalar(in[i], units);
+		CHECK(hi[i] == scalar.siValue().hi && lo[i] == scalar.siValue().lo);
+		CHECK_ULPS(out[i], scalar.value(units), 1);
+		CHECK(out[i] == in[i]);
+	}
+}
+
+int main() {
+	checkBatch<Length>(UNITS::in);
+	checkBatch<Length>(UNITS::mi);
+	checkBatch<Volume>(UNITS::gallon);
+	checkBatch<Pressure>(UNITS::psi);
+	checkBatch<Temperature>(UNITS::F);
+	checkBatch<Temperature>(UNITS::C);
+	checkBatch<RotationSpeed>(UNITS::rpm);
+
+	//digits past a double survive the trip through inches
+	Precise<Length> gauge(1.00000000000001, UNITS::in);
+	Precise<Length> sum = gauge + gauge;
+	CHECK(sum.value(UNITS::in) == 2.00000000000002);
+	DoubleDouble mm = sum.precise(UNITS::mm);
+	CHECK_NEAR(mm.hi, 50.8000000000005, 1e-12);
+	CHECK(sum.measurement().value(UNITS::m) == sum.siValue().hi);
+	CHECK(sum > gauge && gauge < sum && gauge != sum && gauge == gauge);
+
+	//sums that lose the small terms in double keep them here
+	std::vector<double> hi(1001), lo(1001);
+	hi[0] = 1e16;
+	lo[0] = 0;
+	for (int i = 1; i <= 1000; i++) {
+		hi[i] = 1;
+		lo[i] = 0;
+	}
+	DoubleDouble total = PreciseBatch::sum(hi.data(), lo.data(), hi.size());
+	CHECK(total.hi == 1e16 + 1000 && total.lo == 0);
+	return checkResult();
+}
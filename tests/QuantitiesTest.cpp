@@ -0,0 +1,36 @@
+#include <cstring>
+#include "Check.h"
+#include "Measurement.h"
+#include "Quantities.h"
+
+//the class of a quantity maps back to it, and its stored unit is the one SIUnit gives
+template <int Q>
+static void checkQuantity() {
+	typedef typename QuantityClass<Q>::type T;
+	CHECK(QuantityOf<T>::value == Q);
+	CHECK(std::strcmp(QuantityOf<T>::name(), quantityName((msr_quantity)Q)) == 0);
+	CHECK(storedUnit((msr_quantity)Q) == MSR_UNIT_ID(Q, SIUnit<T>::stored));
+	CHECK(msr_unit_quantity(storedUnit((msr_quantity)Q)) == Q);
+}
+
+#define CHECK_QUANTITY(QUANTITY, TYPE) checkQuantity<QUANTITY>();
+
+int main() {
+	MEASUREMENT_QUANTITY_LIST(CHECK_QUANTITY)
+
+	CHECK(QuantityOf<Pressure>::value == MSR_PRESSURE);
+	CHECK(std::strcmp(QuantityOf<RotationSpeed>::name(), "RotationSpeed") == 0);
+	CHECK(storedUnit(MSR_VOLUME) == MSR_L);
+	CHECK(storedUnit(MSR_DENSITY) == MSR_g_cm3);
+	CHECK(storedUnit(MSR_ROTATION_SPEED) == MSR_rpm);
+	CHECK(storedUnit(MSR_TEMPERATURE) == MSR_K);
+	CHECK(std::strcmp(quantityName(MSR_TIME_DURATION), "TimeDuration") == 0);
+
+	//anything else is no quantity
+	CHECK(QuantityOf<double>::value == MSR_QUANTITY_COUNT);
+	CHECK(QuantityOf<Angle>::value == MSR_QUANTITY_COUNT);
+	CHECK(storedUnit(MSR_QUANTITY_COUNT) == MSR_INVALID_UNIT);
+	CHECK(quantityName(MSR_QUANTITY_COUNT) == 0);
+	CHECK(quantityName((msr_quantity)-1) == 0);
+	return checkResult();
+}
@@ -0,0 +1,133 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Check.h"
+#include "Measurement.h"
+#include "Reactive.h"
+
+//a random DAG of sums and scalings, evaluated again from scratch to check the graph against
+struct Spec {
+	int a;
+	int b;
+	double scale;
+};
+
+static std::vector<double> bruteForce(const std::vector<double>& inputValues, const std::vector<Spec>& specs) {
+	std::vector<double> v(inputValues);
+	for (size_t i = 0; i < specs.size(); i++) {
+		v.push_back((v[specs[i].a] + v[specs[i].b]) * specs[i].scale);
+	}
+	return v;
+}
+
+int main() {
+	//the example from Reactive.h
+	ReactiveGraph graph;
+	Reactive<Mass> mass = graph.input(Mass(1200, UNITS::kg));
+	Reactive<Acceleration> accel = graph.input(Acceleration(0.3, UNITS::G));
+	Reactive<Area> piston = graph.input(Area(50, UNITS::cm2));
+	Reactive<Force> force = graph.product(mass, accel);
+	Reactive<Pressure> pressure = graph.quotient(force, piston);
+	Reactive<Pressure> margin = graph.derive([](Pressure p) { return Pressure(10, UNITS::bar) - p; }, pressure);
+	Reactive<Area> spare = graph.input(Area(1, UNITS::cm2));
+	Reactive<Area> total = graph.sum(piston, spare);
+	CHECK_NEAR(graph.get(margin).value(UNITS::Pa), 1e6 - 1200 * 0.3 * 9.80665 / 50e-4, 1e-6);
+	CHECK(graph.recomputations() == 3);
+	CHECK(graph.isStale(total));
+	//a change reaches only its cone
+	CHECK(graph.set(mass, Mass(1500, UNITS::kg)));
+	CHECK(graph.isStale(force) && graph.isStale(margin) && graph.isStale(total));
+	CHECK(!graph.isStale(piston));
+	graph.get(margin);
+	CHECK(graph.recomputations() == 6);
+	CHECK(graph.isStale(total));
+	CHECK_NEAR(graph.get(total).value(UNITS::cm2), 51, 1e-9);
+	CHECK(graph.recomputations() == 7);
+	//the same value marks nothing, and derived nodes cannot be set
+	CHECK(graph.set(mass, Mass(1500, UNITS::kg)));
+	CHECK(!graph.isStale(margin));
+	CHECK(!graph.set(force, Force(1, UNITS::N)));
+	CHECK(graph.nodeCount() == 8);
+
+	//a change absorbed part way down stops there
+	ReactiveGraph clamp;
+	Reactive<Temperature> sensor = clamp.input(Temperature(20, UNITS::C));
+	Reactive<Temperature> limited = clamp.derive([](Temperature t) {
+		return t.value(UNITS::C) > 100 ? Temperature(100, UNITS::C) : t;
+	}, sensor);
+	Reactive<Energy> heat = clamp.derive([](Temperature t) { return Energy(t.value(UNITS::K), UNITS::kJ); }, limited);
+	clamp.set(sensor, Temperature(150, UNITS::C));
+	clamp.get(heat);
+	uint64_t before = clamp.recomputations();
+	clamp.set(sensor, Temperature(180, UNITS::C));
+	CHECK_NEAR(clamp.get(heat).value(UNITS::kJ), 373.15, 1e-9);
+	CHECK(clamp.recomputations() == before + 1);
+
+	//a chain far longer than the call stack would take
+	ReactiveGraph chain;
+	Reactive<Length> first = chain.input(Length(0, UNITS::m));
+	Reactive<Length> last = first;
+	for (int i = 0; i < 200000; i++) {
+		last = chain.derive([](Length x) { return x + Length(1, UNITS::mm); }, last);
+	}
+	CHECK_NEAR(chain.get(last).value(UNITS::m), 200, 1e-6);
+	chain.set(first, Length(1, UNITS::m));
+	CHECK_NEAR(chain.get(last).value(UNITS::m), 201, 1e-6);
+
+	//total() of many nodes
+	ReactiveGraph sums;
+	std::vector<Reactive<Power> > loads;
+	for (int i = 0; i < 10; i++) {
+		loads.push_back(sums.input(Power(i + 1, UNITS::kW)));
+	}
+	Reactive<Power> all = sums.total(loads);
+	CHECK_NEAR(sums.get(all).value(UNITS::kW), 55, 1e-9);
+	sums.set(loads[3], Power(0, UNITS::W));
+	CHECK_NEAR(sums.get(all).value(UNITS::kW), 51, 1e-9);
+
+	//a random DAG wide enough to split levels between threads, refresh and get against brute force
+	std::mt19937_64 random(17);
+	const size_t inputCount = 2000;
+	const size_t derivedCount = 20000;
+	std::vector<double> inputValues(inputCount);
+	std::vector<Spec> specs;
+	ReactiveGraph dag[2];
+	for (size_t i = 0; i < inputCount; i++) {
+		inputValues[i] = (double)(random() % 1000);
+		for (int g = 0; g < 2; g++) {
+			dag[g].addInput(inputValues[i]);
+		}
+	}
+	for (size_t i = 0; i < derivedCount; i++) {
+		size_t existing = inputCount + i;
+		//mostly near the end, so the graph is deep as well as wide
+		size_t reach = existing < 3000 ? existing : 3000;
+		Spec s = { (int)(existing - 1 - random() % reach), (int)(random() % existing), 0.5 };
+		specs.push_back(s);
+		unsigned ids[2] = { (unsigned)s.a, (unsigned)s.b };
+		for (int g = 0; g < 2; g++) {
+			dag[g].addDerived(ids, 2, [](const double* values, const unsigned* in) { return (values[in[0]] + values[in[1]]) * 0.5; });
+		}
+	}
+	bool matches = true;
+	for (int round = 0; round < 5; round++) {
+		for (int c = 0; c < 300; c++) {
+			size_t i = random() % inputCount;
+			inputValues[i] = (double)(random() % 1000);
+			for (int g = 0; g < 2; g++) {
+				dag[g].setValue((unsigned)i, inputValues[i]);
+			}
+		}
+		std::vector<double> expected = bruteForce(inputValues, specs);
+		//one graph refreshed on four threads, the other read node by node
+		dag[0].refresh(round % 2 ? 4 : 1);
+		for (size_t n = 0; n < expected.size(); n++) {
+			matches = matches && !dag[0].isStale((unsigned)n) && dag[0].value((unsigned)n) == expected[n];
+		}
+		for (size_t n = expected.size(); n-- > 0;) {
+			matches = matches && dag[1].value((unsigned)n) == expected[n];
+		}
+	}
+	CHECK(matches);
+	return checkResult();
+}
@@ -0,0 +1,93 @@
+#include <deque>
+#include <thread>
+#include <vector>
+#include "Check.h"
+#include "Measurement.h"
+#include "SampleRing.h"
+
+int main() {
+	//draining gives what the constructors give, bit for bit, whatever the unit
+	SpscRing<Temperature> temperatures(8);
+	CHECK(temperatures.capacity() == 8);
+	const double readings[4] = { 98.6, -40, 37, 310.15 };
+	const UNITS::TemperatureUnits units[4] = { UNITS::F, UNITS::F, UNITS::C, UNITS::K };
+	for (int i = 0; i < 4; i++) {
+		CHECK(temperatures.push(readings[i], units[i]));
+	}
+	Temperature drained[4];
+	CHECK(temperatures.drain(drained, 4) == 4);
+	for (int i = 0; i < 4; i++) {
+		CHECK(storedValue(drained[i]) == storedValue(Temperature(readings[i], units[i])));
+	}
+	CHECK(temperatures.drain(drained, 4) == 0);
+
+	//full rings refuse, and indices wrap past the capacity
+	SpscRing<Pressure> pressures(5);
+	CHECK(pressures.capacity() == 8);
+	//a plain queue alongside says what should come out
+	std::deque<double> expected;
+	bool ordered = true;
+	double si[8];
+	for (int round = 0; round < 10; round++) {
+		double block[6] = { 1, 2, 3, 4, 5, 6 };
+		size_t pushed = pressures.push(block, 6, UNITS::kPa);
+		CHECK(pushed == (expected.size() + 6 > 8 ? 8 - expected.size() : 6));
+		expected.insert(expected.end(), block, block + pushed);
+		size_t count = pressures.drainSI(si, 3);
+		for (size_t i = 0; i < count; i++) {
+			ordered = ordered && si[i] == 1000 * expected.front();
+			expected.pop_front();
+		}
+	}
+	CHECK(ordered);
+	while (expected.size() < 8) {
+		CHECK(pressures.push(1, UNITS::kPa));
+		expected.push_back(1);
+	}
+	CHECK(!pressures.push(760, UNITS::mmHg));
+	CHECK(pressures.drainSI(si, 2) == 2);
+	CHECK(pressures.push(760, UNITS::mmHg));
+	Pressure rest[8];
+	CHECK(pressures.drain(rest, 8) == 7);
+	CHECK(storedValue(rest[6]) == storedValue(Pressure(760, UNITS::mmHg)));
+
+	//many producers, every sample arrives once
+	MpscRing<Length> lengths(1024);
+	const int producers = 4;
+	const int each = 20000;
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; p++) {
+		threads.push_back(std::thread([&lengths, p] {
+			for (int i = 0; i < each; i++) {
+				while (!lengths.push(p * each + i, UNITS::m)) {
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+	std::vector<int> seen(producers * each, 0);
+	int received = 0;
+	Length batch[256];
+	while (received < producers * each) {
+		size_t count = lengths.drain(batch, 256);
+		for (size_t i = 0; i < count; i++) {
+			int id = (int)batch[i].value(UNITS::m);
+			if (id >= 0 && id < producers * each) {
+				seen[id]++;
+			}
+		}
+		received += (int)count;
+		if (!count) {
+			std::this_thread::yield();
+		}
+	}
+	for (size_t t = 0; t < threads.size(); t++) {
+		threads[t].join();
+	}
+	int once = 0;
+	for (size_t i = 0; i < seen.size(); i++) {
+		once += seen[i] == 1;
+	}
+	CHECK(once == producers * each);
+	return checkResult();
+}
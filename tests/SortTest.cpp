@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Check.h"
+#include "Measurement.h"
+#include "MeasurementTraits.h"
+#include "Sort.h"
+
+using namespace QuantitySort;
+
+static uint64_t bitsOf(double val) {
+	uint64_t bits;
+	std::memcpy(&bits, &val, sizeof(bits));
+	return bits;
+}
+
+//sorted by std::stable_sort on the ordered keys, the order the radix sort promises
+static std::vector<double> reference(std::vector<double> values) {
+	std::stable_sort(values.begin(), values.end(), [](double a, double b) { return orderedBits(a) < orderedBits(b); });
+	return values;
+}
+
+static bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+	return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+}
+
+int main() {
+	//the keys order like the doubles, with -0 below +0 and each NaN at its end
+	const double inf = std::numeric_limits<double>::infinity();
+	double ascending[] = { -NAN, -inf, -DBL_MAX, -1, -DBL_MIN, -4.9e-324, -0.0, 0.0, 4.9e-324, DBL_MIN, 1, DBL_MAX, inf, NAN };
+	for (size_t i = 1; i < sizeof(ascending) / sizeof(ascending[0]); i++) {
+		CHECK(orderedBits(ascending[i - 1]) < orderedBits(ascending[i]));
+	}
+	for (size_t i = 0; i < sizeof(ascending) / sizeof(ascending[0]); i++) {
+		CHECK(bitsOf(fromOrderedBits(orderedBits(ascending[i]))) == bitsOf(ascending[i]));
+	}
+
+	//sorts measurements by what they are, whatever unit they were set in
+	Temperature temps[4] = { Temperature(100, UNITS::F), Temperature(0, UNITS::C), Temperature(-300, UNITS::F), Temperature(300, UNITS::K) };
+	sort(temps, 4);
+	CHECK_NEAR(temps[0].value(UNITS::F), -300, 1e-9);
+	CHECK_NEAR(temps[1].value(UNITS::C), 0, 1e-9);
+	CHECK_NEAR(temps[2].value(UNITS::K), 300, 1e-9);
+	CHECK_NEAR(temps[3].value(UNITS::F), 100, 1e-9);
+
+	//small, one thread and many threads, wide and narrow ranges, all match the reference bit for bit
+	std::mt19937_64 random(7);
+	std::uniform_real_distribution<double> wide(-1e6, 1e6);
+	std::uniform_real_distribution<double> narrow(100, 101);
+	size_t sizes[] = { 0, 1, 2, 17, 5000, 200000 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		size_t n = sizes[s];
+		std::vector<double> values(n);
+		std::vector<double> close(n);
+		for (size_t i = 0; i < n; i++) {
+			values[i] = i % 97 == 5 ? NAN : i % 89 == 3 ? -0.0 : i % 83 == 1 ? 0.0 : wide(random);
+			close[i] = narrow(random);
+		}
+		std::vector<double> expected = reference(values);
+		std::vector<double> expectedClose = reference(close);
+		for (unsigned threads = 1; threads <= 4; threads += 3) {
+			std::vector<double> sorted(values);
+			sort(sorted.data(), n, threads);
+			CHECK(sameBits(sorted, expected));
+			std::vector<double> sortedClose(close);
+			sort(sortedClose.data(), n, threads);
+			CHECK(sameBits(sortedClose, expectedClose));
+		}
+	}
+
+	//equal keys keep their order, and payload follows its key
+	size_t n = 100000;
+	std::vector<Pressure> keys(n);
+	std::vector<size_t> payload(n);
+	for (size_t i = 0; i < n; i++) {
+		keys[i] = Pressure((double)(i * 7919 % 1000), UNITS::kPa);
+		payload[i] = i;
+	}
+	std::vector<Pressure> original(keys);
+	for (unsigned threads = 1; threads <= 4; threads += 3) {
+		std::vector<Pressure> k(original);
+		std::vector<size_t> p(payload);
+		sortByKey(k.data(), p.data(), n, threads);
+		bool stable = true;
+		for (size_t i = 0; i < n; i++) {
+			stable = stable && storedValue(k[i]) == storedValue(original[p[i]]);
+			if (i) {
+				stable = stable && (storedValue(k[i - 1]) < storedValue(k[i]) || (storedValue(k[i - 1]) == storedValue(k[i]) && p[i - 1] < p[i]));
+			}
+		}
+		CHECK(stable);
+	}
+
+	//top and bottom k, ties in index order, any thread count
+	std::vector<double> scores(n);
+	for (size_t i = 0; i < n; i++) {
+		scores[i] = (double)(i * 7919 % 1000);
+	}
+	for (unsigned threads = 1; threads <= 4; threads += 3) {
+		double top[5];
+		size_t topIndex[5];
+		largest(scores.data(), payload.data(), n, 5, top, topIndex, threads);
+		CHECK(top[0] == 999 && top[4] == 999);
+		CHECK(topIndex[0] < topIndex[1] && topIndex[3] < topIndex[4]);
+		for (int i = 0; i < 5; i++) {
+			CHECK(scores[topIndex[i]] == 999);
+		}
+		double bottom[3];
+		smallest(scores.data(), n, 3, bottom, threads);
+		CHECK(bottom[0] == 0 && bottom[1] == 0 && bottom[2] == 0);
+		double lowest[2];
+		size_t lowestIndex[2];
+		smallest(scores.data(), payload.data(), n, 2, lowest, lowestIndex, threads);
+		CHECK(lowestIndex[0] == 0 && lowestIndex[1] < n && scores[lowestIndex[1]] == 0 && lowestIndex[1] > 0);
+	}
+	double few[3] = { 2, -1, 5 };
+	double all[3];
+	largest(few, 3, 10, all);
+	CHECK(all[0] == 5 && all[1] == 2 && all[2] == -1);
+	CHECK(selectLargest(0, 0, 3, 1).empty());
+
+	//quantiles interpolate between the nearest ranks, q outside 0 to 1 is clamped
+	double data[5] = { 5, 1, 4, 2, 3 };
+	CHECK(median(data, 5) == 3);
+	CHECK(quantile(data, 4, 0.25) == 2.5 - 0.75);
+	double q[4] = { -1, 0, 0.9, 2 };
+	double out[4];
+	quantiles(data, 5, q, 4, out);
+	CHECK(out[0] == 1 && out[1] == 1 && out[3] == 5);
+	CHECK_NEAR(out[2], 4.6, 1e-12);
+	CHECK(median(data, 1) == 5);
+	//data is only read
+	CHECK(data[0] == 5 && data[4] == 3);
+	Length lengths[3] = { Length(3, UNITS::ft), Length(1, UNITS::m), Length(2, UNITS::yd) };
+	Length middle = median(lengths, 3);
+	CHECK_NEAR(middle.value(UNITS::m), 1, 1e-12);
+	return checkResult();
+}
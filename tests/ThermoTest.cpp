@@ -0,0 +1,82 @@
+#include <cmath>
+#include <vector>
+#include "Check.h"
+#include "Measurement.h"
+#include "Thermo.h"
+
+int main() {
+	//air at sea level and 15 C, with inputs given in other units
+	Pressure p[2] = { Pressure(101.325, UNITS::kPa), Pressure(14.6959488, UNITS::psi) };
+	Temperature T[2] = { Temperature(15, UNITS::C), Temperature(59, UNITS::F) };
+	Density rho[2];
+	Thermo::idealGasDensity(p, T, 2, Thermo::AIR_MOLAR_MASS, rho);
+	CHECK_NEAR(rho[0].value(UNITS::kg_m3), 1.2250, 1e-4);
+	CHECK_NEAR(rho[1].value(UNITS::kg_m3), rho[0].value(UNITS::kg_m3), 1e-8);
+	Volume v[1];
+	Thermo::idealGasVolume(p, T, 1, Mass(1.2250, UNITS::kg), Thermo::AIR_MOLAR_MASS, v);
+	CHECK_NEAR(v[0].value(UNITS::m3), 1, 1e-4);
+
+	//IF97 verification points: region 1 at 300 K and 3 MPa, region 2 at 300 K and 3.5 kPa
+	Pressure wp[3] = { Pressure(3, UNITS::MPa), Pressure(3.5, UNITS::kPa), Pressure(3, UNITS::MPa) };
+	Temperature wT[3] = { Temperature(300, UNITS::K), Temperature(300, UNITS::K), Temperature(2000, UNITS::K) };
+	Density water[3];
+	Energy h[3];
+	Thermo::waterDensity(wp, wT, 3, water);
+	Thermo::waterEnthalpy(wp, wT, 3, Mass(1, UNITS::kg), h);
+	CHECK_NEAR(1 / water[0].value(UNITS::kg_m3), 0.100215168e-2, 1e-11);
+	CHECK_NEAR(h[0].value(UNITS::kJ), 0.115331273e3, 1e-6);
+	CHECK_NEAR(1 / water[1].value(UNITS::kg_m3), 0.394913866e2, 1e-6);
+	CHECK_NEAR(h[1].value(UNITS::kJ), 0.254991145e4, 1e-5);
+	CHECK(std::isnan(water[2].value(UNITS::kg_m3)));
+
+	//region 4: 300 K saturates at 3.53658941 kPa, and back
+	Temperature boiling[1] = { Temperature(300, UNITS::K) };
+	Pressure saturated[1];
+	Temperature back[1];
+	Thermo::saturationPressure(boiling, 1, saturated);
+	Thermo::saturationTemperature(saturated, 1, back);
+	CHECK_NEAR(saturated[0].value(UNITS::kPa), 3.53658941, 1e-7);
+	CHECK_NEAR(back[0].value(UNITS::K), 300, 1e-6);
+
+	//saturated air has its dew point at its own temperature, drier air below it
+	Temperature room[2] = { Temperature(25, UNITS::C), Temperature(77, UNITS::F) };
+	double rh[2] = { 1, 0.5 };
+	Temperature dew[2];
+	double w[2];
+	Thermo::dewPoint(room, rh, 2, dew);
+	Thermo::humidityRatio(p, room, rh, 2, w);
+	CHECK_NEAR(dew[0].value(UNITS::C), 25, 1e-6);
+	CHECK(dew[1].value(UNITS::C) < 15 && dew[1].value(UNITS::C) > 13);
+	CHECK_NEAR(w[0], 0.0201, 2e-4);
+	Density moist[2];
+	Thermo::moistAirDensity(p, room, rh, 2, moist);
+	CHECK(moist[0].value(UNITS::kg_m3) < moist[1].value(UNITS::kg_m3));
+
+	//below freezing: dry air is ideal gas air, saturated air sits over ice at 259.9 Pa at -10 C
+	Pressure sea[3] = { Pressure(101.325, UNITS::kPa), Pressure(101.325, UNITS::kPa), Pressure(101.325, UNITS::kPa) };
+	Temperature cold[3] = { Temperature(-10, UNITS::C), Temperature(-10, UNITS::C), Temperature(5, UNITS::C) };
+	double coldRh[3] = { 0, 1, 0.3 };
+	double coldW[3];
+	Density coldAir[3];
+	Density dryAir[1];
+	Temperature frost[3];
+	Thermo::humidityRatio(sea, cold, coldRh, 3, coldW);
+	Thermo::moistAirDensity(sea, cold, coldRh, 3, coldAir);
+	Thermo::idealGasDensity(sea, cold, 1, Thermo::AIR_MOLAR_MASS, dryAir);
+	Thermo::dewPoint(cold, coldRh, 3, frost);
+	CHECK(coldW[0] == 0);
+	CHECK_NEAR(coldAir[0].value(UNITS::kg_m3), dryAir[0].value(UNITS::kg_m3), 1e-12);
+	double ratio = Thermo::WATER_MOLAR_MASS / Thermo::AIR_MOLAR_MASS;
+	CHECK_NEAR(coldW[1], ratio * 259.9 / (101325 - 259.9), 2e-6);
+	CHECK(coldAir[1].value(UNITS::kg_m3) < coldAir[0].value(UNITS::kg_m3));
+	CHECK(std::isnan(frost[0].value(UNITS::C)));
+	CHECK_NEAR(frost[1].value(UNITS::C), -10, 1e-9);
+	//5 C at 30 % holds 262 Pa of vapour, which frosts at about -9.9 C and holds the same water there
+	CHECK(frost[2].value(UNITS::C) > -11 && frost[2].value(UNITS::C) < -9);
+	Temperature atFrost[1] = { frost[2] };
+	double saturatedRh[1] = { 1 };
+	double frostW[1];
+	Thermo::humidityRatio(sea, atFrost, saturatedRh, 1, frostW);
+	CHECK_NEAR(frostW[0], coldW[2], 1e-12);
+	return checkResult();
+}
@@ -0,0 +1,85 @@
+#include <cmath>
+#include <limits>
+#include <typeinfo>
+#include "Check.h"
+#include "Measurement.h"
+#include "MeasurementTraits.h"
+
+//set() and value() in every unit against the exact factors, to within rounding
+template <class T>
+void checkUnits(int unitCount) {
+	typedef typename SIUnit<T>::Units Units;
+	const double samples[3] = { 1, 12.5, 0.001 };
+	for (int u = 0; u < unitCount; u++) {
+		Units units = (Units)u;
+		DoubleDouble scale = UnitFactors<T>::scale(units);
+		DoubleDouble offset = UnitFactors<T>::offset(units);
+		for (double x : samples) {
+			double si = (scale * x + offset).hi;
+			uint64_t setError = ulpDistance(toSI(T(x, units)), si);
+			//an offset unit near its zero cancels most of the SI value, so value() is held to the SI value's ulps
+			double exact = ((DoubleDouble{ si, 0 } - offset) / scale).hi;
+			double tolerance = 2 * std::numeric_limits<double>::epsilon() * std::fmax(std::fabs(exact), std::fabs(si / scale.hi));
+			double valueError = std::fabs(fromSI<T>(si).value(units) - exact);
+			if (setError > 2 || valueError > tolerance) {
+				checkFailed(__FILE__, __LINE__, typeid(T).name());
+				printf("\tunit %d, %g: set %llu ulp, value off by %g\n", u, x, (unsigned long long)setError, valueError);
+			}
+		}
+	}
+}
+
+int main() {
+	checkUnits<TimeDuration>(9);
+	checkUnits<Length>(9);
+	checkUnits<Area>(11);
+	checkUnits<Volume>(17);
+	checkUnits<Speed>(4);
+	checkUnits<Acceleration>(5);
+	checkUnits<Mass>(6);
+	checkUnits<Force>(2);
+	checkUnits<Pressure>(8);
+	checkUnits<Energy>(8);
+	checkUnits<Power>(6);
+	checkUnits<Density>(3);
+	checkUnits<Temperature>(4);
+	checkUnits<Voltage>(4);
+	checkUnits<Current>(4);
+	checkUnits<Capacitance>(5);
+	checkUnits<Resistance>(4);
+	checkUnits<RotationSpeed>(4);
+	checkUnits<Torque>(3);
+
+	//each conversion that was once wrong, against its legal definition
+	CHECK_ULPS(Mass(1, UNITS::tonne).value(UNITS::kg), 1000, 0);
+	CHECK_ULPS(Mass(2500, UNITS::kg).value(UNITS::tonne), 2.5, 0);
+	CHECK_ULPS(Mass(3, UNITS::ton).value(UNITS::kg), 3 * 907.18474, 1);
+	CHECK_ULPS(Mass(907.18474, UNITS::kg).value(UNITS::ton), 1, 1);
+	CHECK_ULPS(Mass(1, UNITS::oz).value(UNITS::kg), 0.028349523125, 1);
+	CHECK_ULPS(Volume(2, UNITS::km3).value(UNITS::m3), 2e9, 0);
+	//the US liquid barrel of 31.5 gallons
+	CHECK_ULPS(Volume(1, UNITS::barrel).value(UNITS::L), 119.240471196, 1);
+	CHECK_ULPS(Volume(119.240471196, UNITS::L).value(UNITS::barrel), 1, 1);
+	CHECK_ULPS(Volume(8, UNITS::pint).value(UNITS::barrel), 1 / 31.5, 1);
+	CHECK_ULPS(Volume(1, UNITS::gallon).value(UNITS::L), 3.785411784, 1);
+	CHECK_ULPS(Volume(1, UNITS::tsp).value(UNITS::mL), 4.92892159375, 1);
+	CHECK_ULPS(Area(3, UNITS::um2).value(UNITS::m2), 3e-12, 1);
+	CHECK_ULPS(Density(1, UNITS::lb_gal).value(UNITS::kg_m3), 119.82642731689663, 1);
+	CHECK_ULPS(RotationSpeed(1, UNITS::rev_s).value(UNITS::rad_s), 6.283185307179586, 1);
+	CHECK_ULPS(RotationSpeed(60, UNITS::rpm).value(UNITS::rev_s), 1, 1);
+	CHECK_ULPS(RotationSpeed(1, UNITS::deg_s).value(UNITS::rad_s), 0.017453292519943295, 1);
+	CHECK_ULPS(Power(1, UNITS::BTU_h).value(UNITS::W), 0.29307107017222222, 1);
+	CHECK_ULPS(Power(1, UNITS::hp).value(UNITS::W), 745.69987158227022, 1);
+	CHECK_ULPS(Force(1, UNITS::lbf).value(UNITS::N), 4.4482216152605, 1);
+	CHECK_ULPS(Pressure(1, UNITS::psi).value(UNITS::Pa), 6894.7572931683613, 1);
+	CHECK_ULPS(Energy(1, UNITS::hph).value(UNITS::J), 2684519.5376961729, 1);
+	CHECK_ULPS(Torque(1, UNITS::inlb).value(UNITS::Nm), 0.1129848290276167, 1);
+	CHECK_ULPS(Capacitance(47, UNITS::uF).value(UNITS::Farad), 47e-6, 1);
+	CHECK_ULPS(Resistance(4.7, UNITS::kOhm).value(UNITS::Ohm), 4700, 1);
+	CHECK_ULPS(Length(1, UNITS::mi).value(UNITS::m), 1609.344, 0);
+	CHECK_ULPS(Length(3, UNITS::ft).value(UNITS::yd), 1, 1);
+	CHECK_ULPS(Speed(60, UNITS::mph).value(UNITS::m_s), 26.8224, 1);
+	CHECK_ULPS(Speed(1, UNITS::ft_s).value(UNITS::m_s), 0.3048, 0);
+	CHECK_ULPS(Acceleration(1, UNITS::G).value(UNITS::ft_s2), 9.80665 / 0.3048, 1);
+	return checkResult();
+}
@@ -0,0 +1,53 @@
+#include "Check.h"
+#include "Vec3.h"
+
+int main() {
+	Vec3<Length> r(Length(0.2, UNITS::m), Length(0, UNITS::m), Length(0, UNITS::m));
+	Vec3<Force> f(Force(0, UNITS::N), Force(50, UNITS::N), Force(0, UNITS::N));
+	Vec3<Torque> moment = cross(r, f);
+	CHECK_NEAR(moment.z().value(UNITS::Nm), 10, 1e-12);
+	CHECK(moment.x().value(UNITS::Nm) == 0 && moment.y().value(UNITS::Nm) == 0);
+	Energy work = dot(r, f);
+	CHECK(work.value(UNITS::J) == 0);
+	CHECK_NEAR(dot(r, Vec3<Force>(Force(5, UNITS::N), Force(1, UNITS::N), Force(2, UNITS::N))).value(UNITS::J), 1, 1e-12);
+
+	Vec3<Speed> v(Speed(3, UNITS::m_s), Speed(4, UNITS::m_s), Speed(0, UNITS::m_s));
+	CHECK_NEAR(v.norm().value(UNITS::m_s), 5, 1e-15);
+	Vec3<Length> travelled = v * TimeDuration(2, UNITS::s);
+	CHECK_NEAR(travelled.y().value(UNITS::m), 8, 1e-15);
+	CHECK((r + r - r) == r);
+
+	//both batch layouts give what the scalar operations give, including a padded last block
+	const size_t n = 21;
+	Vec3SoA<Length> aSoA;
+	Vec3SoA<Force> bSoA;
+	Vec3AoSoA<Length> aBlocks;
+	Vec3AoSoA<Force> bBlocks;
+	for (size_t i = 0; i < n; i++) {
+		Vec3<Length> a(Length(i * 0.5, UNITS::m), Length(1.0 - i, UNITS::m), Length(2, UNITS::ft));
+		Vec3<Force> b(Force(3, UNITS::N), Force(i * 0.25, UNITS::N), Force(-1.0 * i, UNITS::lbf));
+		aSoA.push_back(a);
+		bSoA.push_back(b);
+		aBlocks.push_back(a);
+		bBlocks.push_back(b);
+	}
+	std::vector<Energy> dots = dot(aSoA, bSoA);
+	std::vector<Energy> blockDots = dot(aBlocks, bBlocks);
+	Vec3SoA<Torque> crosses = cross(aSoA, bSoA);
+	Vec3AoSoA<Torque> blockCrosses = cross(aBlocks, bBlocks);
+	CHECK(dots.size() == n && blockDots.size() == n && aBlocks.size() == n);
+	for (size_t i = 0; i < n; i++) {
+		double want = toSI(dot(aSoA.get(i), bSoA.get(i)));
+		CHECK(toSI(dots[i]) == want);
+		CHECK(toSI(blockDots[i]) == want);
+		CHECK(crosses.get(i) == cross(aSoA.get(i), bSoA.get(i)));
+		CHECK(blockCrosses.get(i) == crosses.get(i));
+	}
+	Vec3SoA<Length> doubled = aSoA + aSoA;
+	Vec3AoSoA<Length> scaled = aBlocks * 2.0;
+	for (size_t i = 0; i < n; i++) {
+		CHECK(doubled.get(i) == aSoA.get(i) * 2.0);
+		CHECK(scaled.get(i) == doubled.get(i));
+	}
+	return checkResult();
+}
@@ -0,0 +1,65 @@
+#include <vector>
+#include "Check.h"
+#include "Views.h"
+
+//conversions through UnitConversion match set() and value() for every unit of T
+template <class T>
+void checkConversions(int unitCount, double val) {
+	typedef typename SIUnit<T>::Units Units;
+	for (int u = 0; u < unitCount; u++) {
+		Units units = (Units)u;
+		T scalar(val, units);
+		CHECK_ULPS(conversionToSI<T>(units).apply(val), toSI(scalar), 2);
+		CHECK_ULPS(conversionFromSI<T>(units).apply(toSI(scalar)), scalar.value(units), 2);
+		CHECK_ULPS(conversionToStored<T>(units).apply(val), storedValue(scalar), 2);
+		CHECK_ULPS(conversionFromStored<T>(units).apply(storedValue(scalar)), scalar.value(units), 2);
+	}
+}
+
+int main() {
+	checkConversions<TimeDuration>(9, 12.5);
+	checkConversions<Length>(9, 12.5);
+	checkConversions<Area>(11, 12.5);
+	checkConversions<Volume>(17, 12.5);
+	checkConversions<Speed>(4, 12.5);
+	checkConversions<Mass>(6, 12.5);
+	checkConversions<Pressure>(8, 12.5);
+	checkConversions<Energy>(8, 12.5);
+	checkConversions<Density>(3, 12.5);
+	checkConversions<Temperature>(4, 98.6);
+	checkConversions<RotationSpeed>(4, 12.5);
+	checkConversions<Torque>(3, 12.5);
+
+	//offset units used to lose thousands of ulps to f(1) - f(0)
+	CHECK(conversionToSI<Temperature>(UNITS::F).apply(98.6) == Temperature(98.6, UNITS::F).value(UNITS::K));
+	CHECK_ULPS(conversionFromSI<Temperature>(UNITS::F).apply(310.15), Temperature(310.15, UNITS::K).value(UNITS::F), 1);
+
+	std::vector<Temperature> temps;
+	std::vector<double> fahrenheit;
+	for (int i = 0; i < 200; i++) {
+		fahrenheit.push_back(-40 + i * 0.7);
+		temps.push_back(Temperature(fahrenheit.back(), UNITS::F));
+	}
+	size_t i = 0;
+	for (double f : temps | measurement::views::in<UNITS::F>) {
+		CHECK_ULPS(f, temps[i].value(UNITS::F), 2);
+		i++;
+	}
+	CHECK(i == temps.size());
+	i = 0;
+	for (Temperature t : fahrenheit | measurement::views::as<Temperature>(UNITS::F)) {
+		CHECK_ULPS(t.value(UNITS::K), temps[i].value(UNITS::K), 1);
+		i++;
+	}
+
+	std::vector<Volume> volumes = { Volume(2, UNITS::L), Volume(1, UNITS::gallon), Volume(3, UNITS::m3) };
+	i = 0;
+	for (double si : volumes | measurement::views::si) {
+		CHECK_ULPS(si, volumes[i].value(UNITS::m3), 1);
+		i++;
+	}
+	auto inGallons = volumes | measurement::views::in<UNITS::gallon>;
+	CHECK(inGallons.size() == 3);
+	CHECK_ULPS(inGallons[1], 1, 2);
+	return checkResult();
+}
@@ -0,0 +1,160 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Check.h"
+#include "Measurement.h"
+#include "Windows.h"
+
+struct Point {
+	double t;
+	double v;
+};
+
+//count, sum, min, max and sample variance of the points with from < t <= to, or from <= t < to
+struct Brute {
+	uint64_t count;
+	double sum;
+	double min;
+	double max;
+	double variance;
+};
+
+static Brute brute(const std::vector<Point>& points, double from, double to, bool closedStart) {
+	Brute b = { 0, 0, INFINITY, -INFINITY, 0 };
+	for (size_t i = 0; i < points.size(); i++) {
+		double t = points[i].t;
+		if (closedStart ? (t >= from && t < to) : (t > from && t <= to)) {
+			b.count++;
+			b.sum += points[i].v;
+			b.min = std::fmin(b.min, points[i].v);
+			b.max = std::fmax(b.max, points[i].v);
+		}
+	}
+	if (b.count > 1) {
+		double mean = b.sum / b.count;
+		for (size_t i = 0; i < points.size(); i++) {
+			double t = points[i].t;
+			if (closedStart ? (t >= from && t < to) : (t > from && t <= to)) {
+				b.variance += (points[i].v - mean) * (points[i].v - mean);
+			}
+		}
+		b.variance /= b.count - 1;
+	}
+	return b;
+}
+
+int main() {
+	//tumbling windows over ms samples, every window boundary on a sample
+	Windows<Power> tumbling = Windows<Power>::tumbling(2, TimeDuration(100, UNITS::ms));
+	for (int i = 0; i < 100; i++) {
+		tumbling.push(0, TimeDuration(i * 10.0, UNITS::ms), Power(i, UNITS::W));
+		tumbling.push(1, TimeDuration(i * 10.0, UNITS::ms), Power(2 * i, UNITS::kW));
+	}
+	tumbling.flush();
+	std::vector<WindowResult<Power> >& hours = tumbling.results();
+	CHECK(hours.size() == 20);
+	bool aligned = true;
+	for (size_t k = 0; k < hours.size(); k++) {
+		WindowResult<Power>& w = hours[k];
+		int window = (int)std::lround(w.start.value(UNITS::ms) / 100);
+		double first = window * 10.0;
+		double scale = w.stream ? 2000 : 1;
+		aligned = aligned && w.count == 10;
+		aligned = aligned && std::fabs(w.end.value(UNITS::ms) - w.start.value(UNITS::ms) - 100) < 1e-9;
+		aligned = aligned && std::fabs(w.sum.value(UNITS::W) - scale * (10 * first + 45)) < 1e-6 * scale;
+		aligned = aligned && std::fabs(w.min.value(UNITS::W) - scale * first) < 1e-9 * scale;
+		aligned = aligned && std::fabs(w.max.value(UNITS::W) - scale * (first + 9)) < 1e-9 * scale;
+		aligned = aligned && std::fabs(w.mean.value(UNITS::W) - scale * (first + 4.5)) < 1e-9 * scale;
+		//variance of 0..9 is 55 / 6, in kW squared for the second stream
+		double variance = w.stream ? w.variance(UNITS::kW) / 4 : w.variance(UNITS::W);
+		aligned = aligned && std::fabs(variance - 55.0 / 6) < 1e-9;
+	}
+	CHECK(aligned);
+	tumbling.clear();
+	CHECK(tumbling.results().empty());
+
+	//a sliding window matches a brute force count of (t - size, t] after every sample
+	std::mt19937_64 random(3);
+	std::uniform_real_distribution<double> gap(0, 0.4);
+	std::uniform_real_distribution<double> noise(-1, 1);
+	Windows<Pressure> sliding = Windows<Pressure>::sliding(1, TimeDuration(5, UNITS::s));
+	std::vector<Point> points;
+	double t = 0;
+	bool matches = true;
+	for (int i = 0; i < 3000; i++) {
+		t += gap(random);
+		//a large value with a small spread, which a plain sum of squares would lose
+		double kPa = 1e6 + noise(random) + (i % 500 == 0 ? 50 : 0);
+		Pressure p(kPa, UNITS::kPa);
+		points.push_back(Point{ t, storedValue(p) });
+		sliding.push(0, TimeDuration(t, UNITS::s), p);
+		WindowResult<Pressure> w = sliding.current(0);
+		Brute b = brute(points, t - 5, t, false);
+		matches = matches && w.count == b.count;
+		matches = matches && std::fabs(storedValue(w.sum) - b.sum) < 1e-6 * std::fabs(b.sum);
+		matches = matches && storedValue(w.min) == b.min && storedValue(w.max) == b.max;
+		matches = matches && std::fabs(w.storedVariance - b.variance) < 1e-6 * (b.variance + 1e6);
+	}
+	CHECK(matches);
+	CHECK(sliding.results().empty());
+	//advance evicts what has aged out of every stream
+	sliding.advance(TimeDuration(t + 4.9, UNITS::s));
+	CHECK(sliding.current(0).count >= 1);
+	sliding.advance(TimeDuration(t + 5, UNITS::s));
+	CHECK(sliding.current(0).count == 0);
+
+	//sessions end after a gap, advance closes a stream that went quiet
+	Windows<Current> sessions = Windows<Current>::session(2, TimeDuration(30, UNITS::s));
+	double times[] = { 0, 10, 35, 100, 129, 170 };
+	for (int i = 0; i < 6; i++) {
+		sessions.push(0, TimeDuration(times[i], UNITS::s), Current(i + 1, UNITS::A));
+	}
+	sessions.push(1, TimeDuration(5, UNITS::s), Current(7, UNITS::mA));
+	CHECK(sessions.results().size() == 2);
+	sessions.advance(TimeDuration(36, UNITS::s));
+	CHECK(sessions.results().size() == 3 && sessions.results()[2].stream == 1);
+	CHECK(sessions.results().size() == 3 && std::fabs(sessions.results()[2].sum.value(UNITS::mA) - 7) < 1e-12);
+	sessions.flush();
+	std::vector<WindowResult<Current> >& closed = sessions.results();
+	CHECK(closed.size() == 4);
+	if (closed.size() == 4) {
+		CHECK(closed[0].count == 3 && closed[0].start.value(UNITS::s) == 0 && closed[0].end.value(UNITS::s) == 35);
+		CHECK(closed[1].count == 2 && closed[1].start.value(UNITS::s) == 100);
+		CHECK(closed[3].count == 1 && closed[3].start.value(UNITS::s) == 170);
+		CHECK_NEAR(closed[1].mean.value(UNITS::A), 4.5, 1e-12);
+	}
+
+	//late samples within the lateness are applied in time order, older ones are dropped and counted
+	Windows<Length> late = Windows<Length>::tumbling(1, TimeDuration(10, UNITS::s), TimeDuration(3, UNITS::s));
+	CHECK(late.push(0, TimeDuration(1, UNITS::s), Length(1, UNITS::m)));
+	CHECK(late.push(0, TimeDuration(9, UNITS::s), Length(9, UNITS::m)));
+	CHECK(late.push(0, TimeDuration(11, UNITS::s), Length(11, UNITS::m)));
+	CHECK(late.push(0, TimeDuration(8.5, UNITS::s), Length(8.5, UNITS::m)));
+	CHECK(late.results().empty());
+	//the watermark passes 8.5 and 9, but the window only closes once 11 is applied
+	CHECK(late.push(0, TimeDuration(13.5, UNITS::s), Length(13.5, UNITS::m)));
+	CHECK(late.results().empty());
+	CHECK(late.push(0, TimeDuration(14.5, UNITS::s), Length(14.5, UNITS::m)));
+	CHECK(late.results().size() == 1 && late.results()[0].count == 3);
+	CHECK(late.results().size() == 1 && late.results()[0].sum.value(UNITS::m) == 18.5);
+	CHECK(!late.push(0, TimeDuration(7, UNITS::s), Length(7, UNITS::m)));
+	CHECK(late.dropped() == 1);
+	//NaN is skipped, not dropped
+	CHECK(late.push(0, TimeDuration(12, UNITS::s), Length(NAN, UNITS::m)));
+	late.flush();
+	CHECK(late.results().size() == 2 && late.results()[1].count == 3);
+	CHECK(late.dropped() == 1);
+
+	//variance is reported in any unit, temperature steps have no offset
+	Windows<Temperature> temps = Windows<Temperature>::tumbling(1, TimeDuration(1, UNITS::hr));
+	temps.push(0, TimeDuration(1, UNITS::s), Temperature(10, UNITS::C));
+	temps.push(0, TimeDuration(2, UNITS::s), Temperature(20, UNITS::C));
+	temps.flush();
+	CHECK(temps.results().size() == 1);
+	if (temps.results().size() == 1) {
+		CHECK_NEAR(temps.results()[0].variance(UNITS::C), 50, 1e-9);
+		CHECK_NEAR(temps.results()[0].variance(UNITS::F), 50 * 1.8 * 1.8, 1e-9);
+		CHECK_NEAR(temps.results()[0].mean.value(UNITS::C), 15, 1e-12);
+	}
+	return checkResult();
+}